@@ -40,6 +40,7 @@
 #include "log.h"
 #include "node.h"
 #include "nodeFactory.h"
+#include "observer.h"
 #include "pipe.h"
 #include "pixelData.h"
 #include "server.h"
@@ -72,6 +73,7 @@
 #endif
 
 #include <bitset>
+#include <limits>
 #include <set>
 
 #include "detail/channel.ipp"
@@ -448,6 +450,24 @@ void Channel::_overrideContext(RenderContext& context)
     window->_addRenderContext(context);
 }
 
+void Channel::_latchHeadMatrix(RenderContext& context)
+{
+    const FrustumSetup& setup = context.frustumSetup;
+    if (!setup.latchable)
+        return;
+
+    const View* view = getPipe()->getView(context.view);
+    const Observer* observer = view ? view->getObserver() : 0;
+    Matrix4f head;
+    if (!observer || !getNode()->getLatchedHeadMatrix(*observer, head))
+        return;
+
+    const Vector3f& eye = observer->getEyePosition(context.eye);
+    const Vector3f& cyclop = observer->getEyePosition(EYE_CYCLOP);
+    setup.compute(context, setup.getEyePosition(head, eye),
+                  setup.getEyePosition(head, cyclop), head.inverse());
+}
+
 Frustumf Channel::getScreenFrustum() const
 {
     const Pixel& pixel = getPixel();
@@ -793,33 +813,70 @@ bool _hasOverlap(PixelViewports& regions)
 }
 #endif
 
-/** Remove overlapping regions by merging them */
-bool _removeOverlap(PixelViewports& regions)
+bool _overlaps(PixelViewport lhs, const PixelViewport& rhs)
 {
-    if (regions.size() < 2)
-        return false;
+    lhs.intersect(rhs);
+    return lhs.hasArea();
+}
 
-    for (size_t i = 0; i < regions.size() - 1; ++i)
-        for (size_t j = i + 1; j < regions.size(); ++j)
+/**
+ * Insert a region into a set of non-overlapping regions, merging it with all
+ * regions it overlaps. The merged region may overlap further regions, which are
+ * absorbed until the set is non-overlapping again.
+ */
+void _insertRegion(PixelViewports& regions, PixelViewport region)
+{
+    for (bool merged = true; merged;)
+    {
+        merged = false;
+        for (size_t i = 0; i < regions.size(); ++i)
         {
-            PixelViewport pvp = regions[i];
-            if (!pvp.hasArea())
-            {
-                std::swap(regions[i], regions.back());
-                regions.pop_back();
-                return true;
-            }
+            if (!_overlaps(region, regions[i]))
+                continue;
+
+            region.merge(regions[i]);
+            regions[i] = regions.back();
+            regions.pop_back();
+            merged = true;
+            break;
+        }
+    }
+    regions.push_back(region);
+}
+
+/** @return the area covered by the union of two disjoint regions only. */
+int64_t _getWaste(const PixelViewport& lhs, const PixelViewport& rhs)
+{
+    PixelViewport merged = lhs;
+    merged.merge(rhs);
+    return int64_t(merged.getArea()) - lhs.getArea() - rhs.getArea();
+}
 
-            pvp.intersect(regions[j]);
-            if (pvp.hasArea())
+/** Merge the pair of regions wasting the least area until maxRegions fit. */
+void _limitRegions(PixelViewports& regions, const size_t maxRegions)
+{
+    while (regions.size() > maxRegions)
+    {
+        size_t first = 0;
+        size_t second = 1;
+        int64_t minWaste = std::numeric_limits<int64_t>::max();
+        for (size_t i = 0; i < regions.size() - 1; ++i)
+            for (size_t j = i + 1; j < regions.size(); ++j)
             {
-                regions[i].merge(regions[j]);
-                std::swap(regions[j], regions.back());
-                regions.pop_back();
-                return true;
+                const int64_t waste = _getWaste(regions[i], regions[j]);
+                if (waste >= minWaste)
+                    continue;
+                minWaste = waste;
+                first = i;
+                second = j;
             }
-        }
-    return false;
+
+        PixelViewport region = regions[first];
+        region.merge(regions[second]);
+        regions.erase(regions.begin() + second); // second > first
+        regions.erase(regions.begin() + first);
+        _insertRegion(regions, region);
+    }
 }
 }
 
@@ -834,13 +891,24 @@ void Channel::declareRegion(const PixelViewport& region)
     clippedRegion.intersect(pvp);
     if (clippedRegion.hasArea())
     {
-        regions.push_back(clippedRegion);
+        if (regions.size() == 1 && !regions.front().hasArea())
+            regions.clear(); // replace previously declared empty ROI
+
+        // common case: many small draws inside an already covered region
+        for (const PixelViewport& covered : regions)
+        {
+            PixelViewport intersection = covered;
+            intersection.intersect(clippedRegion);
+            if (intersection == clippedRegion)
+                return;
+        }
+
 #ifndef NDEBUG
-        const PixelViewport pvpBefore = getRegion();
+        PixelViewport pvpBefore = getRegion();
+        pvpBefore.merge(clippedRegion);
 #endif
-        while (_removeOverlap(regions))
-        { /* nop */
-        }
+        _insertRegion(regions, clippedRegion);
+        _limitRegions(regions, _impl->maxRegions);
 
 #ifndef NDEBUG
         LBASSERT(!_hasOverlap(regions));
@@ -853,6 +921,18 @@ void Channel::declareRegion(const PixelViewport& region)
         regions.push_back(PixelViewport(0, 0, 0, 0));
 }
 
+void Channel::setMaxRegions(const size_t maxRegions)
+{
+    LBASSERT(maxRegions > 0);
+    _impl->maxRegions = std::max(maxRegions, size_t(1));
+    _limitRegions(_impl->regions, _impl->maxRegions);
+}
+
+size_t Channel::getMaxRegions() const
+{
+    return _impl->maxRegions;
+}
+
 PixelViewport Channel::getRegion() const
 {
     PixelViewport region;
@@ -916,7 +996,7 @@ bool Channel::processEvent(Statistic& event)
 {
     Config* config = getConfig();
     updateEvent(event, config->getTime());
-    config->sendEvent(EVENT_STATISTIC) << event;
+    getNode()->queueStatistic(event);
     return true;
 }
 
@@ -1725,6 +1805,7 @@ bool Channel::_cmdFrameDraw(co::ICommand& cmd)
                      << context << std::endl;
 
     bindDrawFrameBuffer();
+    _latchHeadMatrix(context);
     _overrideContext(context);
     const uint32_t frameNumber = getCurrentFrame();
     ChannelStatistics event(Statistic::CHANNEL_DRAW, this, frameNumber,
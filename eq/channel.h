@@ -334,6 +334,21 @@ public:
      * @version 1.3
      */
     EQ_API const PixelViewports& getRegions() const;
+
+    /**
+     * Set the maximum number of regions kept for this channel.
+     *
+     * When more non-overlapping regions are declared, the two regions wasting
+     * the least area when combined are merged. The cost of a declaration is
+     * bounded by this number. The default is 16 regions.
+     *
+     * @param maxRegions the maximum number of regions, at least one.
+     * @version 2.1
+     */
+    EQ_API void setMaxRegions(size_t maxRegions);
+
+    /** @return the maximum number of regions. @version 2.1 */
+    EQ_API size_t getMaxRegions() const;
     //@}
 
     /** @name Events */
@@ -626,6 +641,9 @@ private:
     /** Setup the current rendering context. */
     void _overrideContext(RenderContext& context);
 
+    /** Recompute the frusta for the latest head matrix, if available. */
+    void _latchHeadMatrix(RenderContext& context);
+
     /** Initialize the channel's drawable config. */
     void _initDrawableConfig();
 
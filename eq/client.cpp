@@ -48,6 +48,8 @@
 #include <boost/program_options/parsers.hpp>
 #include <boost/program_options/variables_map.hpp>
 
+#include <sstream>
+
 #ifdef _MSC_VER
 #include <direct.h>
 #define chdir _chdir
@@ -344,6 +346,13 @@ bool Client::exitLocal()
 
 void Client::exitClient()
 {
+    if (_impl->queue.hasStatistics())
+    {
+        std::ostringstream os;
+        _impl->queue.dumpStatistics(os);
+        LBINFO << "Command statistics of node main thread" << std::endl
+               << os.str();
+    }
     _impl->queue.flush();
     bool ret = exitLocal();
     LBINFO << "Exit " << lunchbox::className(this) << " process used "
@@ -23,18 +23,118 @@
 #include <co/iCommand.h>
 #include <lunchbox/clock.h>
 
+#include <algorithm>
+#include <cstdlib>
+#include <deque>
+#include <iomanip>
+#include <map>
+#include <mutex>
+
+#define N_BUCKETS 24 // log2 histogram buckets, 1 us .. 8 s
+
 namespace eq
 {
 namespace
 {
 static lunchbox::Clock _clock;
+
+/** A latency histogram with power-of-two buckets in microseconds. */
+class Histogram
+{
+public:
+    Histogram()
+        : _count(0)
+        , _sum(0.)
+    {
+        std::fill(_buckets, _buckets + N_BUCKETS, 0);
+    }
+
+    void add(const double time)
+    {
+        const double us = time * 1000.;
+        size_t bucket = 0;
+        while (bucket < N_BUCKETS - 1 && us >= double(1u << bucket))
+            ++bucket;
+        ++_buckets[bucket];
+        ++_count;
+        _sum += us;
+    }
+
+    double getMean() const { return _count ? _sum / double(_count) : 0.; }
+    /** @return the upper bound of the bucket containing the percentile. */
+    double getPercentile(const double percentile) const
+    {
+        const size_t target = size_t(percentile * double(_count));
+        size_t count = 0;
+        for (size_t i = 0; i < N_BUCKETS; ++i)
+        {
+            count += _buckets[i];
+            if (count > target)
+                return double(1u << i);
+        }
+        return double(1u << (N_BUCKETS - 1));
+    }
+
+private:
+    size_t _buckets[N_BUCKETS];
+    size_t _count;
+    double _sum;
+};
+
+std::ostream& operator<<(std::ostream& os, const Histogram& histogram)
+{
+    return os << std::setw(9) << std::fixed << std::setprecision(1)
+              << histogram.getMean() << std::setw(8) << std::setprecision(0)
+              << histogram.getPercentile(.5) << std::setw(8)
+              << histogram.getPercentile(.99);
+}
+
+const uint32_t CMD_NONE = 0xffffffffu; // invalid commands: wakeups, timeouts
+}
+
+namespace detail
+{
+class CommandStatistics
+{
+public:
+    CommandStatistics()
+        : command(CMD_NONE)
+        , popTime(-1.)
+    {
+    }
+
+    struct Entry
+    {
+        Entry()
+            : count(0)
+        {
+        }
+
+        size_t count;
+        Histogram queued;
+        Histogram executed;
+    };
+
+    std::mutex lock;
+    std::deque<double> pushTimes; //!< in the order of the queued commands
+    std::map<uint32_t, Entry> entries;
+
+    uint32_t command; //!< the last popped command
+    double popTime;   //!< when the last command was popped, -1 if executed
+};
 }
 
 CommandQueue::CommandQueue(const size_t maxSize)
     : co::CommandQueue(maxSize)
     , _messagePump(0)
     , _waitTime(0)
+    , _awake(true)
+    , _wakeups(0)
+    , _coalescedWakeups(0)
+    , _statistics(nullptr)
 {
+    if (getenv("EQ_COMMAND_STATISTICS"))
+        enableStatistics();
 }
 
 CommandQueue::~CommandQueue()
@@ -42,24 +142,25 @@ CommandQueue::~CommandQueue()
     LBASSERT(!_messagePump);
     delete _messagePump;
     _messagePump = 0;
+    delete _statistics;
+    _statistics = nullptr;
 }
 
 void CommandQueue::push(const co::ICommand& command)
 {
-    co::CommandQueue::push(command);
-    if (_messagePump)
-        _messagePump->postWakeup();
+    _push(command, false);
+    _wakeup();
 }
 
 void CommandQueue::pushFront(const co::ICommand& command)
 {
-    co::CommandQueue::pushFront(command);
-    if (_messagePump)
-        _messagePump->postWakeup();
+    _push(command, true);
+    _wakeup();
 }
 
 co::ICommand CommandQueue::pop(const uint32_t timeout)
 {
+    _executed();
     const int64_t start = _clock.getTime64();
     int64_t waitBegin = -1;
     while (true)
@@ -72,14 +173,18 @@ co::ICommand CommandQueue::pop(const uint32_t timeout)
         {
             if (waitBegin > -1)
                 _waitTime += (_clock.getTime64() - waitBegin);
-            return co::CommandQueue::pop(0);
+            const co::ICommand& command = co::CommandQueue::pop(0);
+            _popped(command);
+            return command;
         }
 
         if (_messagePump)
         {
             if (waitBegin == -1)
                 waitBegin = _clock.getTime64();
-            _messagePump->dispatchOne(timeout); // blocks - push sends wakeup
+            if (_sleep())
+                _messagePump->dispatchOne(timeout); // blocks until _wakeup
+            _awake = true;
         }
         else
         {
@@ -87,6 +192,7 @@ co::ICommand CommandQueue::pop(const uint32_t timeout)
             // blocking
             const co::ICommand& command = co::CommandQueue::pop(timeout);
             _waitTime += (_clock.getTime64() - waitBegin);
+            _popped(command);
             return command;
         }
 
@@ -97,6 +203,7 @@ co::ICommand CommandQueue::pop(const uint32_t timeout)
 
 co::ICommands CommandQueue::popAll(const uint32_t timeout)
 {
+    _executed();
     const int64_t start = _clock.getTime64();
     int64_t waitBegin = -1;
     while (true)
@@ -109,14 +216,20 @@ co::ICommands CommandQueue::popAll(const uint32_t timeout)
         {
             if (waitBegin > -1)
                 _waitTime += (_clock.getTime64() - waitBegin);
-            return co::CommandQueue::popAll(0);
+            const co::ICommands& commands = co::CommandQueue::popAll(0);
+            for (const co::ICommand& command : commands)
+                _popped(command);
+            _executed(); // not attributable to a single command
+            return commands;
         }
 
         if (_messagePump)
         {
             if (waitBegin == -1)
                 waitBegin = _clock.getTime64();
-            _messagePump->dispatchOne(timeout); // blocks - push sends wakeup
+            if (_sleep())
+                _messagePump->dispatchOne(timeout); // blocks until _wakeup
+            _awake = true;
         }
         else
         {
@@ -124,6 +237,9 @@ co::ICommands CommandQueue::popAll(const uint32_t timeout)
             // blocking
             const co::ICommands& commands = co::CommandQueue::popAll(timeout);
             _waitTime += (_clock.getTime64() - waitBegin);
+            for (const co::ICommand& command : commands)
+                _popped(command);
+            _executed();
             return commands;
         }
 
@@ -134,10 +250,14 @@ co::ICommands CommandQueue::popAll(const uint32_t timeout)
 
 co::ICommand CommandQueue::tryPop()
 {
+    _executed();
     if (_messagePump)
         _messagePump->dispatchAll(); // non-blocking
 
-    return co::CommandQueue::tryPop();
+    const co::ICommand& command = co::CommandQueue::tryPop();
+    if (command.isValid())
+        _popped(command);
+    return command;
 }
 
 void CommandQueue::pump()
@@ -145,4 +265,117 @@ void CommandQueue::pump()
     if (_messagePump)
         _messagePump->dispatchAll(); // non-blocking
 }
+
+void CommandQueue::enableStatistics()
+{
+    if (!_statistics)
+        _statistics = new detail::CommandStatistics;
+}
+
+void CommandQueue::dumpStatistics(std::ostream& os) const
+{
+    os << "  " << _wakeups << " wakeups, " << _coalescedWakeups
+       << " coalesced" << std::endl;
+    if (!_statistics)
+        return;
+
+    std::lock_guard<std::mutex> mutex(_statistics->lock);
+    os << "  " << std::setw(10) << "command" << std::setw(9) << "count"
+       << "  " << std::setw(25) << "queued mean/p50/p99 us" << "    "
+       << std::setw(25) << "executed mean/p50/p99 us" << std::endl;
+    for (const auto& i : _statistics->entries)
+    {
+        os << "  ";
+        if (i.first == CMD_NONE)
+            os << "      none";
+        else
+            os << std::setw(10) << i.first;
+        os << std::setw(9) << i.second.count << "  " << i.second.queued
+           << "    " << i.second.executed << std::endl;
+    }
+}
+
+void CommandQueue::_wakeup()
+{
+    if (!_messagePump)
+        return;
+
+    // The consumer polls the queue until it blocks in the pump, only wake
+    // it up once after it announced blocking in _sleep()
+    if (_awake.exchange(true))
+    {
+        ++_coalescedWakeups;
+        return;
+    }
+    ++_wakeups;
+    _messagePump->postWakeup();
+}
+
+bool CommandQueue::_sleep()
+{
+    _awake = false;
+    return isEmpty(); // commands pushed before _awake was cleared
+}
+
+void CommandQueue::_push(const co::ICommand& command, const bool front)
+{
+    if (!_statistics)
+    {
+        if (front)
+            co::CommandQueue::pushFront(command);
+        else
+            co::CommandQueue::push(command);
+        return;
+    }
+
+    // keep the push times in the order of the queue
+    std::lock_guard<std::mutex> mutex(_statistics->lock);
+    const double now = _clock.getTimed();
+    if (front)
+    {
+        co::CommandQueue::pushFront(command);
+        _statistics->pushTimes.push_front(now);
+    }
+    else
+    {
+        co::CommandQueue::push(command);
+        _statistics->pushTimes.push_back(now);
+    }
+}
+
+void CommandQueue::_executed()
+{
+    if (!_statistics || _statistics->popTime < 0.)
+        return;
+
+    std::lock_guard<std::mutex> mutex(_statistics->lock);
+    detail::CommandStatistics::Entry& entry =
+        _statistics->entries[_statistics->command];
+    entry.executed.add(_clock.getTimed() - _statistics->popTime);
+    _statistics->popTime = -1.;
+}
+
+void CommandQueue::_popped(const co::ICommand& command)
+{
+    if (!_statistics)
+        return;
+
+    std::lock_guard<std::mutex> mutex(_statistics->lock);
+    std::deque<double>& pushTimes = _statistics->pushTimes;
+    // drop the times of flushed commands
+    while (pushTimes.size() > getSize() + 1)
+        pushTimes.pop_front();
+
+    const uint32_t type = command.isValid() ? command.getCommand() : CMD_NONE;
+    detail::CommandStatistics::Entry& entry = _statistics->entries[type];
+    const double now = _clock.getTimed();
+    ++entry.count;
+    if (!pushTimes.empty())
+    {
+        entry.queued.add(now - pushTimes.front());
+        pushTimes.pop_front();
+    }
+    _statistics->command = type;
+    _statistics->popTime = now;
+}
 }
@@ -23,12 +23,24 @@
 #include <eq/types.h>
 #include <eq/windowSystem.h> // enum
 
+#include <atomic>
+
 namespace eq
 {
+namespace detail
+{
+class CommandStatistics;
+}
+
 /**
  * @internal
  * Augments an co::CommandQueue to pump system-specific events where
  * required by the underlying window/operating system.
+ *
+ * The message pump is only woken up when the consumer is about to block in
+ * it, which coalesces the wakeups for bursts of commands. Per-command
+ * dispatch statistics are gathered if the environment variable
+ * EQ_COMMAND_STATISTICS is set, or after enableStatistics().
  */
 class CommandQueue : public co::CommandQueue
 {
@@ -64,11 +76,44 @@ public:
     MessagePump* getMessagePump() { return _messagePump; }
     virtual void pump(); //!< @sa co::CommandQueue::pump()
 
+    /** @return the number of wakeups posted to the message pump. */
+    size_t getWakeups() const { return _wakeups; }
+
+    /** @return the number of wakeups skipped for an awake pump. */
+    size_t getCoalescedWakeups() const { return _coalescedWakeups; }
+
+    /**
+     * Gather the count, queue and execution time of each command type.
+     *
+     * The execution time of a command is the time until the next pop(). Must
+     * be called before commands are pushed.
+     */
+    void enableStatistics();
+
+    /** @return true if statistics are gathered. */
+    bool hasStatistics() const { return _statistics != nullptr; }
+
+    /** Print the gathered statistics, if enabled. */
+    void dumpStatistics(std::ostream& os) const;
+
 private:
     MessagePump* _messagePump;
 
     /** The time spent waiting in pop(). */
     int64_t _waitTime;
+
+    /** False while the consumer blocks, or is about to block, in the pump */
+    std::atomic<bool> _awake;
+    std::atomic<size_t> _wakeups;
+    std::atomic<size_t> _coalescedWakeups;
+
+    detail::CommandStatistics* _statistics;
+
+    void _wakeup();
+    bool _sleep();
+    void _push(const co::ICommand& command, bool front);
+    void _executed();
+    void _popped(const co::ICommand& command);
 };
 }
 
@@ -45,6 +45,9 @@
 #include <lunchbox/os.h>
 #include <pression/plugins/compressor.h>
 
+#include <algorithm>
+#include <cmath>
+
 using lunchbox::Monitor;
 
 namespace eq
@@ -64,12 +67,15 @@ static lunchbox::PerThread<Image> _resultImage;
 
 struct CPUAssemblyFormat
 {
-    CPUAssemblyFormat(const bool blend_)
+    CPUAssemblyFormat(const bool blend_, const bool pixel_,
+                      const bool subPixel_)
         : colorInt(0)
         , colorExt(0)
         , depthInt(0)
         , depthExt(0)
         , blend(blend_)
+        , pixel(pixel_)
+        , subPixel(subPixel_)
     {
     }
 
@@ -78,17 +84,45 @@ struct CPUAssemblyFormat
     uint32_t depthInt;
     uint32_t depthExt;
     const bool blend;
+    const bool pixel;    //!< all images are from a pixel decomposition
+    const bool subPixel; //!< images from more than one subpixel step
 };
 
-bool _useCPUAssembly(const Image* image, CPUAssemblyFormat& format)
+bool _isPixelDecomposition(const Frames& frames)
+{
+    for (const Frame* frame : frames)
+        if (frame->getFrameData()->getContext().pixel == Pixel::ALL)
+            return false;
+    return !frames.empty();
+}
+
+bool _isPixelDecomposition(const ImageOps& ops)
+{
+    for (const ImageOp& op : ops)
+        if (op.image->getContext().pixel == Pixel::ALL)
+            return false;
+    return !ops.empty();
+}
+
+bool _useCPUAssembly(const ImageOp& op, CPUAssemblyFormat& format)
 {
+    const Image* image = op.image;
     const bool hasColor = image->hasPixelData(Frame::Buffer::color);
     const bool hasDepth = image->hasPixelData(Frame::Buffer::depth);
 
     if ( // Not an alpha-blending compositing
         (!format.blend || !hasColor || !image->hasAlpha()) &&
         // and not a depth-sorting compositing
-        (!hasColor || !hasDepth))
+        (!hasColor || !hasDepth) &&
+        // and not a pixel or subpixel recomposition
+        (!hasColor || (!format.pixel && !format.subPixel)))
+    {
+        return false;
+    }
+
+    // zoom filtering is only implemented for color-only, non-blended images
+    if (op.zoom != Zoom::NONE &&
+        (hasDepth || format.blend || image->getContext().pixel != Pixel::ALL))
     {
         return false;
     }
@@ -108,8 +142,8 @@ bool _useCPUAssembly(const Image* image, CPUAssemblyFormat& format)
     {
     case EQ_COMPRESSOR_DATATYPE_RGB10_A2:
     case EQ_COMPRESSOR_DATATYPE_BGR10_A2:
-        if (!hasDepth)
-            // blending of RGB10A2 not implemented
+        if (!hasDepth || format.subPixel)
+            // blending and averaging of RGB10A2 not implemented
             return false;
         break;
 
@@ -148,19 +182,29 @@ bool _useCPUAssembly(const Frames& frames, Channel* channel,
     // Test that the input frames have color and depth buffers or that
     // alpha-blended assembly is used with multiple RGBA buffers. We assume then
     // that we will have at least one image per frame so most likely it's worth
-    // to wait for the images and to do a CPU-based assembly. Also test early
-    // for unsupported decomposition modes
+    // to wait for the images and to do a CPU-based assembly. Pixel and
+    // subpixel decompositions are recombined in one pass, which is also worth
+    // it for color-only frames. Also test early for unsupported decomposition
+    // modes
+    const bool pixel = _isPixelDecomposition(frames);
+    const bool subPixel = Compositor::isSubPixelDecomposition(frames);
     const Frame::Buffer desiredBuffers =
         blend ? Frame::Buffer::color
               : Frame::Buffer::color | Frame::Buffer::depth;
     for (const Frame* frame : frames)
     {
         const RenderContext& context = frame->getFrameData()->getContext();
+        const Frame::Buffer buffers = frame->getBuffers();
+
+        if (buffers != desiredBuffers &&
+            (buffers != Frame::Buffer::color || (!pixel && !subPixel)))
+        {
+            return false;
+        }
 
-        if (frame->getBuffers() != desiredBuffers ||
-            context.pixel != Pixel::ALL || context.subPixel != SubPixel::ALL ||
-            frame->getFrameData()->getZoom() != Zoom::NONE ||
-            frame->getZoom() != Zoom::NONE) // Not supported by CPU compositor
+        if (context.pixel != Pixel::ALL &&
+            (frame->getFrameData()->getZoom() != Zoom::NONE ||
+             frame->getZoom() != Zoom::NONE)) // Not supported by CPU compositor
         {
             return false;
         }
@@ -169,9 +213,9 @@ bool _useCPUAssembly(const Frames& frames, Channel* channel,
     // Wait for all images to be ready and test if our assumption was correct,
     // that there are enough images to make a CPU-based assembly worthwhile and
     // all other preconditions for our CPU-based assembly code are true.
-    size_t nImages = 0;
+    ImageOps ops;
     const uint32_t timeout = channel->getConfig()->getTimeout();
-    CPUAssemblyFormat format(blend);
+    CPUAssemblyFormat format(blend, pixel, subPixel);
 
     for (const Frame* frame : frames)
     {
@@ -184,25 +228,32 @@ bool _useCPUAssembly(const Frames& frames, Channel* channel,
         const Images& images = frame->getImages();
         for (const Image* image : images)
         {
-            if (!_useCPUAssembly(image, format))
+            const ImageOp op(frame, image);
+            if (!_useCPUAssembly(op, format))
                 return false;
-            ++nImages;
+            ops.push_back(op);
         }
     }
-    return (nImages > 1);
+    if (pixel && !Compositor::isCompletePixelDecomposition(ops))
+        return false;
+    return (ops.size() > 1);
 }
 
 bool _useCPUAssembly(const ImageOps& ops, const bool blend)
 {
-    CPUAssemblyFormat format(blend);
+    CPUAssemblyFormat format(blend, _isPixelDecomposition(ops),
+                             Compositor::isSubPixelDecomposition(ops));
     size_t nImages = 0;
 
     for (const ImageOp& op : ops)
     {
-        if (!_useCPUAssembly(op.image, format))
+        if (!_useCPUAssembly(op, format))
             return false;
         ++nImages;
     }
+    // the CPU merge does not fill the pixels of missing or mixed kernels
+    if (format.pixel && !Compositor::isCompletePixelDecomposition(ops))
+        return false;
     return (nImages > 1);
 }
 
@@ -227,6 +278,42 @@ uint32_t _assembleCPUImage(const Image* image, Channel* channel)
     return 1;
 }
 
+Vector4f _getCoords(const ImageOp& op, const PixelViewport& pvp)
+{
+    const Pixel& pixel = op.image->getContext().pixel;
+    return Vector4f(op.offset.x() + pvp.x * pixel.w + pixel.x,
+                    op.offset.x() + pvp.getXEnd() * pixel.w * op.zoom.x() +
+                        pixel.x,
+                    op.offset.y() + pvp.y * pixel.h + pixel.y,
+                    op.offset.y() + pvp.getYEnd() * pixel.h * op.zoom.y() +
+                        pixel.y);
+}
+
+/** @return the destination pixels covered by an image. */
+PixelViewport _getDestPVP(const ImageOp& op)
+{
+    const PixelViewport& pvp = op.image->getPixelViewport();
+    const Pixel& pixel = op.image->getContext().pixel;
+    if (pixel != Pixel::ALL)
+    {
+        // every pixel.w-th column and pixel.h-th row, see setupStencilBuffer
+        const int32_t w = pixel.w;
+        const int32_t h = pixel.h;
+        return PixelViewport(op.offset.x() + pvp.x * w + int32_t(pixel.x),
+                             op.offset.y() + pvp.y * h + int32_t(pixel.y),
+                             (pvp.w - 1) * w + 1, (pvp.h - 1) * h + 1);
+    }
+    if (op.zoom == Zoom::NONE)
+        return pvp + op.offset;
+
+    // all pixels with their center on the zoomed quad
+    const Vector4f& coords = _getCoords(op, pvp);
+    const int32_t x = int32_t(std::ceil(coords[0] - .5f));
+    const int32_t y = int32_t(std::ceil(coords[2] - .5f));
+    return PixelViewport(x, y, int32_t(std::ceil(coords[1] - .5f)) - x,
+                         int32_t(std::ceil(coords[3] - .5f)) - y);
+}
+
 void _collectOutputData(const PixelData& pixelData, uint32_t& internalFormat,
                         uint32_t& pixelSize, uint32_t& externalFormat)
 {
@@ -247,9 +334,8 @@ bool _collectOutputData(const ImageOps& ops, PixelViewport& destPVP,
 {
     for (const ImageOp& op : ops)
     {
-        const RenderContext& context = op.image->getContext();
-        if (context.pixel != Pixel::ALL || context.subPixel != SubPixel::ALL ||
-            op.zoom != Zoom::NONE ||
+        if ((op.image->getContext().pixel != Pixel::ALL &&
+             op.zoom != Zoom::NONE) ||
             op.image->getStorageType() != Frame::TYPE_MEMORY)
         {
             return false;
@@ -258,7 +344,7 @@ bool _collectOutputData(const ImageOps& ops, PixelViewport& destPVP,
         if (!op.image->hasPixelData(Frame::Buffer::color))
             continue;
 
-        destPVP.merge(op.image->getPixelViewport() + op.offset);
+        destPVP.merge(_getDestPVP(op));
 
         _collectOutputData(op.image->getPixelData(Frame::Buffer::color),
                            colorInt, colorPixelSize, colorExt);
@@ -403,6 +489,130 @@ void _blendImage(void* dest, const eq::PixelViewport& destPVP,
     }
 }
 
+void _mergePixelImage(void* destColor, void* destDepth,
+                      const PixelViewport& destPVP, const ImageOp& op)
+{
+    LBVERB << "CPU-Pixel assembly" << std::endl;
+
+    uint8_t* destC = reinterpret_cast<uint8_t*>(destColor);
+    uint32_t* destD = reinterpret_cast<uint32_t*>(destDepth);
+
+    const Image* image = op.image;
+    const Pixel& pixel = image->getContext().pixel;
+    const int32_t stepX = pixel.w;
+    const int32_t stepY = pixel.h;
+    const PixelViewport& pvp = image->getPixelViewport();
+    const PixelViewport& area = _getDestPVP(op);
+    const int32_t destX = area.x - destPVP.x;
+    const int32_t destY = area.y - destPVP.y;
+
+    const uint8_t* color = image->getPixelPointer(Frame::Buffer::color);
+    const size_t pixelSize = image->getPixelSize(Frame::Buffer::color);
+    const uint32_t* depth =
+        image->hasPixelData(Frame::Buffer::depth)
+            ? reinterpret_cast<const uint32_t*>(
+                  image->getPixelPointer(Frame::Buffer::depth))
+            : 0;
+
+    // Images of a DB+pixel decomposition share pixels, depth-test them as
+    // _mergeDBImage does
+#pragma omp parallel for
+    for (int32_t y = 0; y < pvp.h; ++y)
+    {
+        const size_t skip = (destY + y * stepY) * destPVP.w + destX;
+        const size_t row = y * pvp.w;
+
+        for (int32_t x = 0; x < pvp.w; ++x)
+        {
+            const size_t dest = skip + x * stepX;
+            if (destD && depth)
+            {
+                if (destD[dest] <= depth[row + x])
+                    continue;
+                destD[dest] = depth[row + x];
+            }
+            else if (destD) // clear depth, for depth-assembly into existing FB
+                destD[dest] = 0;
+
+            memcpy(destC + dest * pixelSize, color + (row + x) * pixelSize,
+                   pixelSize);
+        }
+    }
+}
+
+void _mergeZoomImage(void* destColor, void* destDepth,
+                     const PixelViewport& destPVP, const ImageOp& op)
+{
+    LBVERB << "CPU-Zoom assembly" << std::endl;
+
+    uint8_t* destC = reinterpret_cast<uint8_t*>(destColor);
+    uint32_t* destD = reinterpret_cast<uint32_t*>(destDepth);
+
+    const Image* image = op.image;
+    const PixelViewport& pvp = image->getPixelViewport();
+    const PixelViewport& area = _getDestPVP(op);
+    const Vector4f& coords = _getCoords(op, pvp);
+
+    LBASSERT(image->getPixelSize(Frame::Buffer::color) == 4);
+    const uint8_t* color = image->getPixelPointer(Frame::Buffer::color);
+
+    // texture coordinates of the destination pixel centers, as sampled by
+    // the zoomed quad drawn in _drawPixelsFF
+    const float scaleX = float(pvp.w) / (coords[1] - coords[0]);
+    const float scaleY = float(pvp.h) / (coords[3] - coords[2]);
+    const bool linear = op.zoomFilter == FILTER_LINEAR;
+
+#pragma omp parallel for
+    for (int32_t y = 0; y < area.h; ++y)
+    {
+        const size_t skip =
+            (area.y - destPVP.y + y) * destPVP.w + area.x - destPVP.x;
+        uint8_t* dst = destC + skip * 4;
+        if (destD)
+            lunchbox::setZero(destD + skip, area.w * sizeof(uint32_t));
+
+        const float v = (area.y + y + .5f - coords[2]) * scaleY;
+        if (!linear)
+        {
+            const int32_t j = LB_MIN(int32_t(v), pvp.h - 1);
+            const uint8_t* src = color + j * pvp.w * 4;
+            for (int32_t x = 0; x < area.w; ++x)
+            {
+                const float u = (area.x + x + .5f - coords[0]) * scaleX;
+                memcpy(dst + x * 4, src + LB_MIN(int32_t(u), pvp.w - 1) * 4, 4);
+            }
+            continue;
+        }
+
+        // bilinear, clamped to edge, with 8 bit subtexel precision
+        const float fv = LB_MAX(v - .5f, 0.f);
+        const int32_t j0 = LB_MIN(int32_t(fv), pvp.h - 1);
+        const int32_t j1 = LB_MIN(j0 + 1, pvp.h - 1);
+        const uint32_t wy = uint32_t((fv - float(j0)) * 256.f + .5f);
+        const uint8_t* row0 = color + j0 * pvp.w * 4;
+        const uint8_t* row1 = color + j1 * pvp.w * 4;
+
+        for (int32_t x = 0; x < area.w; ++x)
+        {
+            const float u = (area.x + x + .5f - coords[0]) * scaleX;
+            const float fu = LB_MAX(u - .5f, 0.f);
+            const int32_t i0 = LB_MIN(int32_t(fu), pvp.w - 1);
+            const int32_t i1 = LB_MIN(i0 + 1, pvp.w - 1);
+            const uint32_t wx = uint32_t((fu - float(i0)) * 256.f + .5f);
+
+            for (size_t c = 0; c < 4; ++c)
+            {
+                const uint32_t top =
+                    row0[i0 * 4 + c] * (256 - wx) + row0[i1 * 4 + c] * wx;
+                const uint32_t bottom =
+                    row1[i0 * 4 + c] * (256 - wx) + row1[i1 * 4 + c] * wx;
+                dst[x * 4 + c] =
+                    uint8_t((top * (256 - wy) + bottom * wy + 32768) >> 16);
+            }
+        }
+    }
+}
+
 void _mergeImages(const ImageOps& ops, const bool blend, void* colorBuffer,
                   void* depthBuffer, const PixelViewport& destPVP)
 {
@@ -411,7 +621,11 @@ void _mergeImages(const ImageOps& ops, const bool blend, void* colorBuffer,
         if (!op.image->hasPixelData(Frame::Buffer::color))
             continue;
 
-        if (op.image->hasPixelData(Frame::Buffer::depth))
+        if (op.image->getContext().pixel != Pixel::ALL)
+            _mergePixelImage(colorBuffer, depthBuffer, destPVP, op);
+        else if (op.zoom != Zoom::NONE)
+            _mergeZoomImage(colorBuffer, depthBuffer, destPVP, op);
+        else if (op.image->hasPixelData(Frame::Buffer::depth))
             _mergeDBImage(colorBuffer, depthBuffer, destPVP, op.image,
                           op.offset);
         else if (blend && op.image->hasAlpha())
@@ -422,15 +636,41 @@ void _mergeImages(const ImageOps& ops, const bool blend, void* colorBuffer,
     }
 }
 
-Vector4f _getCoords(const ImageOp& op, const PixelViewport& pvp)
+/**
+ * Merge each subpixel step into the cleared color buffer of the result and
+ * average all steps with equal weight, as util::Accum does.
+ */
+void _mergeSubPixels(ImageOps ops, const bool blend, const bool withDepth,
+                     Image* result)
 {
-    const Pixel& pixel = op.image->getContext().pixel;
-    return Vector4f(op.offset.x() + pvp.x * pixel.w + pixel.x,
-                    op.offset.x() + pvp.getXEnd() * pixel.w * op.zoom.x() +
-                        pixel.x,
-                    op.offset.y() + pvp.y * pixel.h + pixel.y,
-                    op.offset.y() + pvp.getYEnd() * pixel.h * op.zoom.y() +
-                        pixel.y);
+    LBVERB << "CPU-SubPixel assembly" << std::endl;
+
+    const PixelViewport& destPVP = result->getPixelViewport();
+    const int32_t nBytes = destPVP.getArea() * 4;
+    std::vector<uint16_t> sums(nBytes, 0);
+    std::vector<uint32_t> depth(withDepth ? destPVP.getArea() : 0);
+    uint8_t* color = 0;
+    uint16_t nSteps = 0;
+
+    while (!ops.empty())
+    {
+        const ImageOps step = Compositor::extractOneSubPixel(ops);
+        result->clearPixelData(Frame::Buffer::color);
+        std::fill(depth.begin(), depth.end(), 0xffffffffu);
+
+        color = result->getPixelPointer(Frame::Buffer::color);
+        _mergeImages(step, blend, color, withDepth ? depth.data() : 0,
+                     destPVP);
+#pragma omp parallel for
+        for (int32_t i = 0; i < nBytes; ++i)
+            sums[i] += color[i];
+        ++nSteps;
+    }
+    LBASSERTINFO(nSteps <= 256, "Accumulation overflow");
+
+#pragma omp parallel for
+    for (int32_t i = 0; i < nBytes; ++i)
+        color[i] = uint8_t((sums[i] + nSteps / 2) / nSteps);
 }
 
 bool _setupDrawPixels(const ImageOp& op, const Frame::Buffer which,
@@ -689,8 +929,12 @@ uint32_t Compositor::assembleFrames(const Frames& frames, Channel* channel,
     if (frames.empty())
         return 0;
 
-    if (_useCPUAssembly(frames, channel))
+    // A given accumulation buffer is used for one step per subpixel
+    if ((!accum || !isSubPixelDecomposition(frames)) &&
+        _useCPUAssembly(frames, channel))
+    {
         return assembleFramesCPU(frames, channel);
+    }
 
     // else
     return assembleFramesUnsorted(frames, channel, accum);
@@ -702,7 +946,12 @@ uint32_t Compositor::blendImages(const ImageOps& ops, Channel* channel,
     if (ops.empty())
         return 0;
 
-    if (isSubPixelDecomposition(ops))
+    // A given accumulation buffer is used for one step per subpixel
+    const bool subPixel = isSubPixelDecomposition(ops);
+    if ((!accum || !subPixel) && _useCPUAssembly(ops, true))
+        return assembleImagesCPU(ops, channel, true);
+
+    if (subPixel)
     {
         const bool coreProfile =
             channel->getWindow()->getIAttribute(
@@ -741,13 +990,9 @@ uint32_t Compositor::blendImages(const ImageOps& ops, Channel* channel,
         return count;
     }
 
-    uint32_t count = 1;
-    if (_useCPUAssembly(ops, true))
-        count = assembleImagesCPU(ops, channel, true);
-    else
-        for (const ImageOp& op : ops)
-            assembleImage(op, channel);
-    return count;
+    for (const ImageOp& op : ops)
+        assembleImage(op, channel);
+    return 1;
 }
 
 uint32_t Compositor::blendFrames(const Frames& frames, Channel* channel,
@@ -795,6 +1040,36 @@ bool Compositor::isSubPixelDecomposition(const ImageOps& ops)
     return false;
 }
 
+bool Compositor::isCompletePixelDecomposition(const ImageOps& ops)
+{
+    if (ops.empty())
+        return false;
+
+    const Pixel& kernel = ops.front().image->getContext().pixel;
+    if (kernel == Pixel::ALL)
+        return false;
+
+    // number of images per kernel index, only depth images may share one
+    std::vector<size_t> nImages(kernel.w * kernel.h, 0);
+    bool depth = true;
+    for (const ImageOp& op : ops)
+    {
+        const Pixel& pixel = op.image->getContext().pixel;
+        if (pixel.w != kernel.w || pixel.h != kernel.h || pixel.x >= pixel.w ||
+            pixel.y >= pixel.h)
+        {
+            return false;
+        }
+        ++nImages[pixel.x + pixel.y * pixel.w];
+        depth = depth && op.image->hasPixelData(Frame::Buffer::depth);
+    }
+
+    for (const size_t n : nImages)
+        if (n == 0 || (n > 1 && !depth))
+            return false;
+    return true;
+}
+
 Frames Compositor::extractOneSubPixel(Frames& frames)
 {
     Frames current;
@@ -1008,8 +1283,8 @@ uint32_t Compositor::assembleFramesCPU(const Frames& frames, Channel* channel,
     if (frames.empty())
         return 0;
 
-    // Assembles images from DB and 2D compounds using the CPU and then
-    // assembles the result image. Does not support Pixel or Eye compounds.
+    // Assembles images from DB, 2D, pixel and subpixel compounds using the CPU
+    // and then assembles the result image. Does not support Eye compounds.
     LBVERB << "Sorted CPU assembly" << std::endl;
 
     const Image* result =
@@ -1023,8 +1298,8 @@ uint32_t Compositor::assembleImagesCPU(const ImageOps& images, Channel* channel,
     if (images.empty())
         return 0;
 
-    // Assembles images from DB and 2D compounds using the CPU and then
-    // assembles the result image. Does not support Pixel or Eye compounds.
+    // Assembles images from DB, 2D, pixel and subpixel compounds using the CPU
+    // and then assembles the result image. Does not support Eye compounds.
     LBVERB << "Sorted CPU assembly" << std::endl;
 
     const Image* result = mergeImagesCPU(images, blend);
@@ -1084,8 +1359,10 @@ const Image* Compositor::mergeImagesCPU(const ImageOps& ops, const bool blend)
     colorPixels.pvp = destPVP;
     result->setPixelData(Frame::Buffer::color, colorPixels);
 
+    // subpixel steps are averaged, only their color is used
+    const bool subPixel = isSubPixelDecomposition(ops);
     void* destDepth = 0;
-    if (depthInt != 0) // at least one depth assembly
+    if (depthInt != 0 && !subPixel) // at least one depth assembly
     {
         LBASSERT(depthExt == EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT);
         PixelData depthPixels;
@@ -1098,8 +1375,11 @@ const Image* Compositor::mergeImagesCPU(const ImageOps& ops, const bool blend)
     }
 
     // assembly
-    _mergeImages(ops, blend, result->getPixelPointer(Frame::Buffer::color),
-                 destDepth, destPVP);
+    if (subPixel)
+        _mergeSubPixels(ops, blend, depthInt != 0, result);
+    else
+        _mergeImages(ops, blend, result->getPixelPointer(Frame::Buffer::color),
+                     destDepth, destPVP);
     return result;
 }
 
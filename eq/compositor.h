@@ -115,6 +115,10 @@ public:
      * Merge the provided frames in the given order into one image in main
      * memory.
      *
+     * Pixel decompositions are interleaved, and subpixel decompositions are
+     * averaged with equal weight for each subpixel step. Zoomed color images
+     * are scaled using their zoom filter.
+     *
      * The returned image does not have to be freed. The compositor maintains
      * one image per thread, that is, the returned image is valid until the next
      * usage of the compositor in the current thread.
@@ -228,6 +232,13 @@ public:
     //@{
     static bool isSubPixelDecomposition(const Frames& frames);
     static bool isSubPixelDecomposition(const ImageOps& ops);
+
+    /**
+     * @return true if the images form exactly one pixel kernel where every
+     *         kernel index is covered, more than once only by depth images.
+     * @version 2.1
+     */
+    static bool isCompletePixelDecomposition(const ImageOps& ops);
     static Frames extractOneSubPixel(Frames& frames);
     static ImageOps extractOneSubPixel(ImageOps& ops);
     //@}
@@ -36,6 +36,8 @@
 #include "view.h"
 #include "window.h"
 
+#include "detail/statisticBatch.h"
+
 #include <eq/fabric/axisEvent.h>
 #include <eq/fabric/buttonEvent.h>
 #include <eq/fabric/commands.h>
@@ -650,6 +652,20 @@ bool Config::handleEvent(EventICommand command)
         addStatistic(command.read<Statistic>());
         return false;
 
+    case EVENT_STATISTICS:
+    {
+        Statistics statistics;
+        if (!detail::statisticBatch::decode(
+                command.read<std::vector<uint8_t>>(), statistics))
+        {
+            LBWARN << "Dropping corrupted statistics batch" << std::endl;
+            return false;
+        }
+        for (const Statistic& statistic : statistics)
+            addStatistic(statistic);
+        return false;
+    }
+
     case EVENT_CONFIG_ERROR:
     case EVENT_NODE_ERROR:
     case EVENT_PIPE_ERROR:
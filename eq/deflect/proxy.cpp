@@ -17,6 +17,7 @@
 
 #include "proxy.h"
 #include "eventHandler.h"
+#include "streamSender.h"
 
 #include "../channel.h"
 #include "../gl.h"
@@ -32,17 +33,26 @@
 #include <eq/util/texture.h>
 
 #include <deflect/Stream.h>
-#include <lunchbox/buffer.h>
 
 namespace eq
 {
 namespace deflect
 {
+namespace
+{
+float _getLatencyTarget()
+{
+    const char* env = getenv("EQ_DEFLECT_LATENCY");
+    return env ? std::max(0.f, float(atof(env))) : 0.f;
+}
+}
+
 class Proxy::Impl : public boost::noncopyable
 {
 public:
     explicit Impl(Channel& ch)
         : channel(ch)
+        , _sender(_getLatencyTarget(), getenv("EQ_DEFLECT_DELTA") != nullptr)
     {
         const DrawableConfig& dc = channel.getDrawableConfig();
         if (dc.colorBits != 8)
@@ -66,15 +76,6 @@ public:
         }
     }
 
-    ~Impl()
-    {
-        for (size_t i = 0; i < NUM_EYES; ++i)
-            if (_sendFuture[i].valid())
-                _sendFuture[i].wait();
-        if (_finishFuture.valid())
-            _finishFuture.wait();
-    }
-
     void notifyNewImage(Channel&, const Image& image)
     {
         switch (channel.getEye())
@@ -95,19 +96,8 @@ public:
 
     void finishFrame()
     {
-        if (_finishFuture.valid() && !_finishFuture.get())
+        if (stream && !_sender.finishFrame(*stream))
             stream.reset();
-        if (!stream)
-            return;
-
-        for (size_t i = 0; i < NUM_EYES; ++i)
-        {
-            if (_sendFuture[i].valid())
-            {
-                _finishFuture = stream->finishFrame();
-                return;
-            }
-        }
     }
 
     Channel& channel;
@@ -117,40 +107,27 @@ public:
 private:
     void _send(const ::deflect::View view, const Eye eye, const Image& image)
     {
-        if (_sendFuture[eye].valid() && !_sendFuture[eye].get())
-            stream.reset();
         if (!stream)
             return;
 
-        // copy pixels to perform swapYAxis()
-        const size_t dataSize = image.getPixelDataSize(Frame::Buffer::color);
-        _buffer[eye].replace(image.getPixelPointer(Frame::Buffer::color),
-                             dataSize);
-        const PixelViewport& pvp = image.getPixelViewport();
-        ::deflect::ImageWrapper::swapYAxis(_buffer[eye].getData(), pvp.w, pvp.h,
-                                           image.getPixelSize(
-                                               Frame::Buffer::color));
-
         // determine image offset wrt global view
+        const PixelViewport& pvp = image.getPixelViewport();
         const Viewport& vp = channel.getViewport();
         const int32_t width = pvp.w / vp.w;
         const int32_t height = pvp.h / vp.h;
         const int32_t offsX = vp.x * width;
         const int32_t offsY = height - (vp.y * height + vp.h * height);
 
-        ::deflect::ImageWrapper imageWrapper(_buffer[eye].getData(), pvp.w,
-                                             pvp.h, ::deflect::BGRA, offsX,
-                                             offsY);
-        imageWrapper.compressionPolicy = ::deflect::COMPRESSION_ON;
-        imageWrapper.compressionQuality = 100;
-        imageWrapper.view = view;
-
-        _sendFuture[eye] = stream->send(imageWrapper);
+        if (!_sender.send(*stream, view, eye,
+                          image.getPixelPointer(Frame::Buffer::color), pvp,
+                          image.getPixelSize(Frame::Buffer::color), offsX,
+                          offsY))
+        {
+            stream.reset();
+        }
     }
 
-    lunchbox::Bufferb _buffer[NUM_EYES];
-    ::deflect::Stream::Future _sendFuture[NUM_EYES];
-    ::deflect::Stream::Future _finishFuture;
+    StreamSender<::deflect::Stream> _sender;
 };
 
 Proxy::Proxy(Channel& channel)
@@ -0,0 +1,73 @@
+
+/* Copyright (c) 2026, The Equalizer authors, see AUTHORS
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQ_DEFLECT_RATECONTROL_H
+#define EQ_DEFLECT_RATECONTROL_H
+
+#include <algorithm>
+
+namespace eq
+{
+namespace deflect
+{
+/**
+ * @internal
+ * Adapts the JPEG quality of a Deflect stream to a transmission time target.
+ *
+ * The quality is reduced multiplicatively when a frame took longer than the
+ * target to be transmitted, and raised slowly when the transmission is well
+ * within the target.
+ */
+class RateControl
+{
+public:
+    /**
+     * Construct a new rate control.
+     *
+     * @param target the maximum transmission time of one frame in ms, 0 to
+     *               always use the maximum quality.
+     */
+    explicit RateControl(const float target = 0.f)
+        : _target(target)
+        , _quality(maxQuality)
+    {
+    }
+
+    static const unsigned minQuality = 30;
+    static const unsigned maxQuality = 100;
+
+    /** Account the transmission time in ms of the last frame. */
+    void update(const float time)
+    {
+        if (_target <= 0.f)
+            return;
+
+        if (time > _target)
+            _quality = std::max(unsigned(minQuality), _quality * 4 / 5);
+        else if (time < _target * .5f)
+            _quality = std::min(unsigned(maxQuality), _quality + 5);
+    }
+
+    /** @return the JPEG quality for the next frame. */
+    unsigned getQuality() const { return _quality; }
+private:
+    const float _target;
+    unsigned _quality;
+};
+}
+}
+#endif // EQ_DEFLECT_RATECONTROL_H
@@ -0,0 +1,180 @@
+
+/* Copyright (c) 2026, The Equalizer authors, see AUTHORS
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQ_DEFLECT_STREAMSENDER_H
+#define EQ_DEFLECT_STREAMSENDER_H
+
+#include <eq/deflect/rateControl.h>
+#include <eq/deflect/tileCache.h>
+
+#include <eq/fabric/eye.h>
+#include <eq/fabric/pixelViewport.h>
+
+#include <deflect/ImageWrapper.h>
+#include <lunchbox/clock.h>
+
+#include <vector>
+
+namespace eq
+{
+namespace deflect
+{
+/**
+ * @internal
+ * Streams the result images of one channel to a Deflect stream.
+ *
+ * Each eye keeps the tiles of its last image, which are sent asynchronously.
+ * With dirty tiles, only the changed tiles are sent and the host keeps the
+ * others. Otherwise each frame sends all tiles, including frames where the
+ * image did not change, since the host then replaces the whole frame on each
+ * finish. The JPEG quality adapts to the time the channel waits for the sends
+ * of the previous image. Every frame with an image is finished on the stream.
+ *
+ * The stream type provides send() and finishFrame() returning a Future with
+ * get(), valid() and wait(), as ::deflect::Stream does.
+ */
+template <class Stream>
+class StreamSender
+{
+public:
+    typedef typename Stream::Future Future;
+
+    /**
+     * Construct a new sender.
+     *
+     * @param latencyTarget the maximum wait for the sends of one frame in ms,
+     *                      0 to always use the maximum quality.
+     * @param sendDirtyTiles send only the changed tiles of an image.
+     */
+    StreamSender(const float latencyTarget, const bool sendDirtyTiles)
+        : _sendDirtyTiles(sendDirtyTiles)
+        , _rateControl(latencyTarget)
+        , _hasFrame(false)
+    {
+    }
+
+    ~StreamSender()
+    {
+        for (size_t i = 0; i < NUM_EYES; ++i)
+            for (Future& future : _sendFutures[i])
+                if (future.valid())
+                    future.wait();
+        if (_finishFuture.valid())
+            _finishFuture.wait();
+    }
+
+    /**
+     * Send the tiles of a new image of one eye, the changed ones only with
+     * dirty tiles.
+     *
+     * @param stream the stream to send to.
+     * @param view the Deflect view of the eye.
+     * @param eye the eye bit of the image.
+     * @param pixels the image data, rows bottom-up.
+     * @param pvp the size of the image.
+     * @param pixelSize the size of one pixel in bytes.
+     * @param offsX the horizontal image offset wrt the stream.
+     * @param offsY the vertical, top-down image offset wrt the stream.
+     * @return false if a previous send failed.
+     */
+    bool send(Stream& stream, const ::deflect::View view, const Eye eye,
+              const uint8_t* pixels, const PixelViewport& pvp,
+              const size_t pixelSize, const int32_t offsX,
+              const int32_t offsY)
+    {
+        if (!_waitSend(eye))
+            return false;
+
+        _hasFrame = true;
+
+        // The tiles are compared against the previously sent image, and hold
+        // the Y-swapped pixels for the asynchronous send
+        TileCache& tiles = _tiles[eye];
+        const size_t nDirty = tiles.update(pixels, pvp.w, pvp.h, pixelSize);
+        if (_sendDirtyTiles && nDirty == 0)
+            return true; // unchanged, the host keeps the last tiles
+
+        const unsigned quality = _rateControl.getQuality();
+        for (const TileCache::Tile& tile : tiles.getTiles())
+        {
+            if (_sendDirtyTiles && !tile.dirty)
+                continue;
+
+            ::deflect::ImageWrapper imageWrapper(tile.pixels.data(), tile.w,
+                                                 tile.h, ::deflect::BGRA,
+                                                 offsX + tile.x,
+                                                 offsY + tile.y);
+            imageWrapper.compressionPolicy = ::deflect::COMPRESSION_ON;
+            imageWrapper.compressionQuality = quality;
+            imageWrapper.view = view;
+
+            _sendFutures[eye].push_back(stream.send(imageWrapper));
+        }
+        return true;
+    }
+
+    /**
+     * Finish the current frame on the stream if an image was sent for it.
+     *
+     * @return false if finishing the previous frame failed.
+     */
+    bool finishFrame(Stream& stream)
+    {
+        if (_finishFuture.valid() && !_finishFuture.get())
+            return false;
+        if (!_hasFrame)
+            return true;
+
+        _hasFrame = false;
+        _finishFuture = stream.finishFrame();
+        return true;
+    }
+
+    /** @return the JPEG quality of the next send. */
+    unsigned getQuality() const { return _rateControl.getQuality(); }
+private:
+    const bool _sendDirtyTiles; //!< Send only the changed tiles of a frame
+    TileCache _tiles[NUM_EYES];
+    RateControl _rateControl;
+    lunchbox::Clock _clock;
+    bool _hasFrame; //!< An image was sent since the last finishFrame()
+
+    std::vector<Future> _sendFutures[NUM_EYES];
+    Future _finishFuture;
+
+    /**
+     * Wait for the last send of the given eye to complete and adapt the
+     * quality to the time spent waiting for it.
+     * @return false if a send failed.
+     */
+    bool _waitSend(const Eye eye)
+    {
+        if (_sendFutures[eye].empty())
+            return true;
+
+        bool ok = true;
+        const float start = _clock.getTimef();
+        for (Future& future : _sendFutures[eye])
+            ok = future.get() && ok;
+        _rateControl.update(_clock.getTimef() - start);
+        _sendFutures[eye].clear();
+        return ok;
+    }
+};
+}
+}
+#endif // EQ_DEFLECT_STREAMSENDER_H
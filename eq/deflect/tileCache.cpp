@@ -0,0 +1,97 @@
+
+/* Copyright (c) 2026, The Equalizer authors, see AUTHORS
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "tileCache.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace eq
+{
+namespace deflect
+{
+TileCache::TileCache(const uint32_t tileSize)
+    : _tileSize(tileSize)
+    , _width(0)
+    , _height(0)
+    , _pixelSize(0)
+    , _invalid(true)
+{
+    LBASSERT(tileSize > 0);
+}
+
+void TileCache::invalidate()
+{
+    _invalid = true;
+}
+
+size_t TileCache::update(const uint8_t* pixels, const int32_t width,
+                         const int32_t height, const size_t pixelSize)
+{
+    if (width != _width || height != _height || pixelSize != _pixelSize)
+        _resize(width, height, pixelSize);
+
+    const size_t stride = width * pixelSize;
+    size_t nDirty = 0;
+    for (Tile& tile : _tiles)
+    {
+        const size_t rowSize = tile.w * pixelSize;
+        tile.dirty = _invalid;
+        for (int32_t y = 0; y < tile.h; ++y)
+        {
+            // swap the Y axis while copying
+            const uint8_t* src = pixels + (height - 1 - tile.y - y) * stride +
+                                 tile.x * pixelSize;
+            uint8_t* dst = tile.pixels.data() + y * rowSize;
+            if (!_invalid && ::memcmp(dst, src, rowSize) == 0)
+                continue;
+
+            ::memcpy(dst, src, rowSize);
+            tile.dirty = true;
+        }
+        if (tile.dirty)
+            ++nDirty;
+    }
+    _invalid = false;
+    return nDirty;
+}
+
+void TileCache::_resize(const int32_t width, const int32_t height,
+                        const size_t pixelSize)
+{
+    _width = width;
+    _height = height;
+    _pixelSize = pixelSize;
+    _invalid = true;
+    _tiles.clear();
+
+    for (int32_t y = 0; y < height; y += _tileSize)
+    {
+        for (int32_t x = 0; x < width; x += _tileSize)
+        {
+            Tile tile;
+            tile.x = x;
+            tile.y = y;
+            tile.w = std::min(int32_t(_tileSize), width - x);
+            tile.h = std::min(int32_t(_tileSize), height - y);
+            tile.pixels.resize(tile.w * tile.h * pixelSize);
+            _tiles.push_back(tile);
+        }
+    }
+}
+}
+}
@@ -0,0 +1,95 @@
+
+/* Copyright (c) 2026, The Equalizer authors, see AUTHORS
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQ_DEFLECT_TILECACHE_H
+#define EQ_DEFLECT_TILECACHE_H
+
+#include <eq/api.h>
+#include <eq/types.h>
+
+namespace eq
+{
+namespace deflect
+{
+/**
+ * @internal
+ * The tiles of the image last streamed for one eye of a Deflect proxy.
+ *
+ * Each update compares the new image row by row against the previous content
+ * of each tile and copies only the changed rows. The rows are stored top-down
+ * as expected by Deflect, which avoids a copy of the full frame to swap the Y
+ * axis.
+ */
+class TileCache
+{
+public:
+    /** One rectangular area of the image, in top-down coordinates. */
+    struct Tile
+    {
+        Tile()
+            : x(0)
+            , y(0)
+            , w(0)
+            , h(0)
+            , dirty(true)
+        {
+        }
+
+        int32_t x;
+        int32_t y;
+        int32_t w;
+        int32_t h;
+        std::vector<uint8_t> pixels; //!< w * h pixels, rows top-down
+        bool dirty;                  //!< changed by the last update
+    };
+    typedef std::vector<Tile> Tiles;
+
+    /** Construct a new cache using square tiles of the given size. */
+    EQ_API explicit TileCache(uint32_t tileSize = 256);
+
+    /**
+     * Update the tiles with a new image.
+     *
+     * A change of the image size or pixel size resets all tiles.
+     *
+     * @param pixels the image data, rows bottom-up as read back by OpenGL.
+     * @param width the width of the image in pixels.
+     * @param height the height of the image in pixels.
+     * @param pixelSize the size of one pixel in bytes.
+     * @return the number of tiles which changed.
+     */
+    EQ_API size_t update(const uint8_t* pixels, int32_t width, int32_t height,
+                         size_t pixelSize);
+
+    /** Mark all tiles dirty for the next update. */
+    EQ_API void invalidate();
+
+    /** @return all tiles of the last update. */
+    const Tiles& getTiles() const { return _tiles; }
+private:
+    const uint32_t _tileSize;
+    int32_t _width;
+    int32_t _height;
+    size_t _pixelSize;
+    bool _invalid;
+    Tiles _tiles;
+
+    void _resize(int32_t width, int32_t height, size_t pixelSize);
+};
+}
+}
+#endif // EQ_DEFLECT_TILECACHE_H
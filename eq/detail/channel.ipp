@@ -176,6 +176,9 @@ public:
         necessary to be non overlapping. */
     PixelViewports regions;
 
+    /** The maximum number of regions kept in regions. */
+    size_t maxRegions = 16;
+
     /** The number of the last finished frame. */
     lunchbox::Monitor<uint32_t> finishedFrame;
 
@@ -0,0 +1,150 @@
+
+/* Copyright (c) 2026, The Equalizer authors, see AUTHORS
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "numa.h"
+
+#include <lunchbox/debug.h>
+#include <lunchbox/thread.h>
+
+#ifdef EQUALIZER_USE_HWLOC
+#include <hwloc.h>
+#endif
+
+namespace eq
+{
+namespace detail
+{
+namespace numa
+{
+#ifdef EQUALIZER_USE_HWLOC
+namespace
+{
+/** The topology of this machine, loaded once on first use. */
+class Topology
+{
+public:
+    Topology()
+        : topology(0)
+    {
+        if (hwloc_topology_init(&topology) < 0)
+        {
+            LBINFO << "NUMA placement disabled: hwloc_topology_init() failed"
+                   << std::endl;
+            topology = 0;
+            return;
+        }
+        if (hwloc_topology_load(topology) < 0)
+        {
+            LBINFO << "NUMA placement disabled: hwloc_topology_load() failed"
+                   << std::endl;
+            hwloc_topology_destroy(topology);
+            topology = 0;
+        }
+    }
+
+    ~Topology()
+    {
+        if (topology)
+            hwloc_topology_destroy(topology);
+    }
+
+    size_t getNumNodes() const
+    {
+        if (!topology)
+            return 1;
+        const int nNodes =
+            hwloc_get_nbobjs_by_type(topology, HWLOC_OBJ_NUMANODE);
+        return nNodes > 1 ? size_t(nNodes) : 1;
+    }
+
+    hwloc_obj_t getObject(const int32_t affinity) const
+    {
+        if (affinity >= lunchbox::Thread::CORE)
+            return hwloc_get_obj_by_type(topology, HWLOC_OBJ_CORE,
+                                         unsigned(affinity -
+                                                  lunchbox::Thread::CORE));
+        if (affinity >= lunchbox::Thread::SOCKET &&
+            affinity <= lunchbox::Thread::SOCKET_MAX)
+            return hwloc_get_obj_by_type(topology, HWLOC_OBJ_SOCKET,
+                                         unsigned(affinity -
+                                                  lunchbox::Thread::SOCKET));
+        return 0;
+    }
+
+    hwloc_topology_t topology;
+};
+
+Topology& _getTopology()
+{
+    static Topology topology;
+    return topology;
+}
+}
+
+size_t getNumNodes()
+{
+    return _getTopology().getNumNodes();
+}
+
+bool bindMemory(const int32_t affinity)
+{
+    Topology& topology = _getTopology();
+    if (topology.getNumNodes() < 2)
+        return false;
+
+    const hwloc_obj_t object = topology.getObject(affinity);
+    bool bound = false;
+    if (object)
+    {
+        hwloc_nodeset_t nodes = hwloc_bitmap_alloc();
+        hwloc_cpuset_to_nodeset(topology.topology, object->cpuset, nodes);
+        bound = !hwloc_bitmap_iszero(nodes) &&
+                !hwloc_bitmap_isequal(nodes,
+                                      hwloc_topology_get_topology_nodeset(
+                                          topology.topology));
+        hwloc_bitmap_free(nodes);
+    }
+
+    const int result =
+        bound ? hwloc_set_membind(topology.topology, object->cpuset,
+                                  HWLOC_MEMBIND_BIND, HWLOC_MEMBIND_THREAD)
+              : hwloc_set_membind(topology.topology,
+                                  hwloc_topology_get_topology_cpuset(
+                                      topology.topology),
+                                  HWLOC_MEMBIND_DEFAULT, HWLOC_MEMBIND_THREAD);
+    if (result < 0)
+    {
+        LBINFO << "NUMA memory binding for affinity " << affinity
+               << " failed: " << lunchbox::sysError << std::endl;
+        return false;
+    }
+    return bound;
+}
+#else
+size_t getNumNodes()
+{
+    return 1;
+}
+
+bool bindMemory(const int32_t)
+{
+    return false;
+}
+#endif
+}
+}
+}
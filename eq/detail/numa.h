@@ -0,0 +1,54 @@
+
+/* Copyright (c) 2026, The Equalizer authors, see AUTHORS
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQ_DETAIL_NUMA_H
+#define EQ_DETAIL_NUMA_H
+
+#include <eq/types.h>
+
+namespace eq
+{
+namespace detail
+{
+/**
+ * @internal
+ * NUMA memory placement for the threads of a render node.
+ *
+ * All functions are no-ops on machines with a single NUMA node, and without
+ * hwloc support.
+ */
+namespace numa
+{
+/** @return the number of NUMA nodes of this machine, 1 if unknown. */
+size_t getNumNodes();
+
+/**
+ * Bind the memory allocations of the calling thread to the NUMA nodes local
+ * to the cores of the given lunchbox::Thread affinity.
+ *
+ * Memory subsequently allocated by this thread is placed on these nodes,
+ * regardless of the CPU the thread is running on. Affinities which do not
+ * resolve to a socket or core restore the default placement.
+ *
+ * @return true if the memory of the thread is bound to a subset of the nodes.
+ */
+bool bindMemory(int32_t affinity);
+}
+}
+}
+
+#endif // EQ_DETAIL_NUMA_H
@@ -0,0 +1,321 @@
+
+/* Copyright (c) 2026, The Equalizer authors, see AUTHORS
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "statisticBatch.h"
+
+#include <eq/fabric/statistic.h>
+
+#include <cstring>
+
+namespace eq
+{
+namespace detail
+{
+namespace statisticBatch
+{
+namespace
+{
+/** The optional fields of a statistic. */
+enum Fields
+{
+    FIELD_TASK = 1 << 0,
+    FIELD_PLUGINS = 1 << 1,
+    FIELD_IDLE = 1 << 2,
+    FIELD_RATIO = 1 << 3,
+    FIELD_FPS = 1 << 4
+};
+
+const size_t nameSize = sizeof(Statistic::resourceName);
+
+uint64_t _zigzag(const int64_t value)
+{
+    return (uint64_t(value) << 1) ^ uint64_t(value >> 63);
+}
+
+int64_t _unzigzag(const uint64_t value)
+{
+    return int64_t(value >> 1) ^ -int64_t(value & 1);
+}
+
+uint32_t _getBits(const float value)
+{
+    uint32_t bits;
+    ::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+float _getFloat(const uint32_t bits)
+{
+    float value;
+    ::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+class Writer
+{
+public:
+    explicit Writer(std::vector<uint8_t>& data)
+        : _data(data)
+    {
+    }
+
+    void write(uint64_t value)
+    {
+        while (value >= 0x80)
+        {
+            _data.push_back(uint8_t(value) | 0x80);
+            value >>= 7;
+        }
+        _data.push_back(uint8_t(value));
+    }
+
+    void writeSigned(const int64_t value) { write(_zigzag(value)); }
+    void write(const void* ptr, const size_t size)
+    {
+        const uint8_t* bytes = static_cast<const uint8_t*>(ptr);
+        _data.insert(_data.end(), bytes, bytes + size);
+    }
+
+private:
+    std::vector<uint8_t>& _data;
+};
+
+class Reader
+{
+public:
+    explicit Reader(const std::vector<uint8_t>& data)
+        : _data(data)
+        , _pos(0)
+        , _error(false)
+    {
+    }
+
+    uint64_t read()
+    {
+        uint64_t value = 0;
+        for (unsigned shift = 0; shift < 64; shift += 7)
+        {
+            if (_pos >= _data.size())
+                break;
+            const uint8_t byte = _data[_pos++];
+            value |= uint64_t(byte & 0x7f) << shift;
+            if (!(byte & 0x80))
+                return value;
+        }
+        _error = true;
+        return 0;
+    }
+
+    int64_t readSigned() { return _unzigzag(read()); }
+    void read(void* ptr, const size_t size)
+    {
+        if (_pos + size > _data.size())
+        {
+            _error = true;
+            return;
+        }
+        ::memcpy(ptr, &_data[_pos], size);
+        _pos += size;
+    }
+
+    bool isValid() const { return !_error; }
+    bool isEmpty() const { return _pos >= _data.size(); }
+private:
+    const std::vector<uint8_t>& _data;
+    size_t _pos;
+    bool _error;
+};
+
+bool _isSameEntity(const Statistic& a, const Statistic& b)
+{
+    return a.originator == b.originator && a.serial == b.serial &&
+           ::strncmp(a.resourceName, b.resourceName, nameSize) == 0;
+}
+
+/** The previous statistic, the base of the delta encoding. */
+struct Base
+{
+    Base()
+        : frameNumber(0)
+        , time(0)
+        , startTime(0)
+    {
+    }
+
+    void update(const Statistic& statistic)
+    {
+        frameNumber = statistic.frameNumber;
+        time = statistic.time;
+        startTime = statistic.startTime;
+    }
+
+    uint32_t frameNumber;
+    int64_t time;
+    int64_t startTime;
+};
+}
+
+void encode(const Statistics& statistics, std::vector<uint8_t>& data)
+{
+    Writer writer(data);
+    writer.write(statistics.size());
+
+    Statistics entities;
+    Base base;
+    for (const Statistic& statistic : statistics)
+    {
+        size_t entity = 0;
+        while (entity < entities.size() &&
+               !_isSameEntity(entities[entity], statistic))
+        {
+            ++entity;
+        }
+
+        writer.write(entity);
+        if (entity == entities.size()) // new entity: send its identity
+        {
+            entities.push_back(statistic);
+            writer.write(&statistic.originator, sizeof(statistic.originator));
+            writer.write(statistic.serial);
+
+            const size_t length =
+                ::strnlen(statistic.resourceName, nameSize);
+            writer.write(length);
+            writer.write(statistic.resourceName, length);
+        }
+
+        uint32_t fields = 0;
+        if (statistic.task != 0)
+            fields |= FIELD_TASK;
+        if (statistic.plugins[0] != 0 || statistic.plugins[1] != 0)
+            fields |= FIELD_PLUGINS;
+        if (statistic.idleTime != 0 || statistic.totalTime != 0)
+            fields |= FIELD_IDLE;
+        if (_getBits(statistic.ratio) != 0)
+            fields |= FIELD_RATIO;
+        if (_getBits(statistic.currentFPS) != 0 ||
+            _getBits(statistic.averageFPS) != 0)
+        {
+            fields |= FIELD_FPS;
+        }
+
+        writer.write(statistic.type);
+        writer.write(fields);
+        writer.writeSigned(int64_t(statistic.frameNumber) - base.frameNumber);
+        writer.writeSigned(statistic.time - base.time);
+        writer.writeSigned(statistic.startTime - base.startTime);
+        writer.writeSigned(statistic.endTime - statistic.startTime);
+
+        if (fields & FIELD_TASK)
+            writer.write(statistic.task);
+        if (fields & FIELD_PLUGINS)
+        {
+            writer.write(statistic.plugins[0]);
+            writer.write(statistic.plugins[1]);
+        }
+        if (fields & FIELD_IDLE)
+        {
+            writer.writeSigned(statistic.idleTime);
+            writer.writeSigned(statistic.totalTime);
+        }
+        if (fields & FIELD_RATIO)
+            writer.write(_getBits(statistic.ratio));
+        if (fields & FIELD_FPS)
+        {
+            writer.write(_getBits(statistic.currentFPS));
+            writer.write(_getBits(statistic.averageFPS));
+        }
+        base.update(statistic);
+    }
+}
+
+bool decode(const std::vector<uint8_t>& data, Statistics& statistics)
+{
+    Reader reader(data);
+    const uint64_t size = reader.read();
+    if (size > data.size()) // each statistic uses more than one byte
+        return false;
+
+    Statistics entities;
+    Base base;
+    statistics.reserve(statistics.size() + size);
+    for (uint64_t i = 0; i < size && reader.isValid(); ++i)
+    {
+        Statistic statistic;
+        const uint64_t entity = reader.read();
+        if (entity == entities.size())
+        {
+            Statistic& identity = statistic;
+            reader.read(&identity.originator, sizeof(identity.originator));
+            identity.serial = uint32_t(reader.read());
+
+            const uint64_t length = reader.read();
+            if (length > nameSize)
+                return false;
+            ::memset(identity.resourceName, 0, nameSize);
+            reader.read(identity.resourceName, length);
+            entities.push_back(identity);
+        }
+        else if (entity < entities.size())
+            statistic = entities[entity];
+        else
+            return false;
+
+        statistic.type = Statistic::Type(reader.read());
+        const uint64_t fields = reader.read();
+        statistic.frameNumber = uint32_t(base.frameNumber + reader.readSigned());
+        statistic.time = base.time + reader.readSigned();
+        statistic.startTime = base.startTime + reader.readSigned();
+        statistic.endTime = statistic.startTime + reader.readSigned();
+
+        statistic.task = (fields & FIELD_TASK) ? uint32_t(reader.read()) : 0;
+        statistic.plugins[0] = 0;
+        statistic.plugins[1] = 0;
+        if (fields & FIELD_PLUGINS)
+        {
+            statistic.plugins[0] = uint32_t(reader.read());
+            statistic.plugins[1] = uint32_t(reader.read());
+        }
+        statistic.idleTime = 0;
+        statistic.totalTime = 0;
+        if (fields & FIELD_IDLE)
+        {
+            statistic.idleTime = reader.readSigned();
+            statistic.totalTime = reader.readSigned();
+        }
+        statistic.ratio = 0.f;
+        if (fields & FIELD_RATIO)
+            statistic.ratio = _getFloat(uint32_t(reader.read()));
+        statistic.currentFPS = 0.f;
+        statistic.averageFPS = 0.f;
+        if (fields & FIELD_FPS)
+        {
+            statistic.currentFPS = _getFloat(uint32_t(reader.read()));
+            statistic.averageFPS = _getFloat(uint32_t(reader.read()));
+        }
+        statistic.pad = 0.f;
+
+        if (!reader.isValid())
+            return false;
+        statistics.push_back(statistic);
+        base.update(statistic);
+    }
+    return reader.isValid() && reader.isEmpty();
+}
+}
+}
+}
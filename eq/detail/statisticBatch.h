@@ -0,0 +1,53 @@
+
+/* Copyright (c) 2026, The Equalizer authors, see AUTHORS
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQ_DETAIL_STATISTICBATCH_H
+#define EQ_DETAIL_STATISTICBATCH_H
+
+#include <eq/api.h>
+#include <eq/types.h>
+
+namespace eq
+{
+namespace detail
+{
+/**
+ * @internal
+ * Compact encoding of the statistics sent by a node to the application.
+ *
+ * The originator, serial and resource name of each entity are sent once per
+ * batch and referenced by index afterwards. Frame numbers and times are
+ * delta-encoded against the previous statistic, and all integers are written
+ * as variable-length integers. Optional fields are only written if they are
+ * set.
+ */
+namespace statisticBatch
+{
+/** Append the encoding of the given statistics to the data. */
+EQ_API void encode(const Statistics& statistics, std::vector<uint8_t>& data);
+
+/**
+ * Append the statistics encoded in the given data.
+ *
+ * @return true if the data was decoded, false if it is corrupted.
+ */
+EQ_API bool decode(const std::vector<uint8_t>& data, Statistics& statistics);
+}
+}
+}
+
+#endif // EQ_DETAIL_STATISTICBATCH_H
@@ -0,0 +1,63 @@
+
+/* Copyright (c) 2026, The Equalizer authors, see AUTHORS
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQ_EGL_MESSAGEPUMP_H
+#define EQ_EGL_MESSAGEPUMP_H
+
+#include <eq/egl/types.h>
+#include <eq/messagePump.h> // base class
+#include <eq/types.h>
+
+#include <co/connectionSet.h> // member
+#include <unordered_map>
+
+namespace eq
+{
+namespace egl
+{
+/**
+ * A message pump for headless EGL pipes.
+ *
+ * EGL windows do not generate events. The pump blocks until it is woken up,
+ * and dispatches the events of registered Deflect connections.
+ */
+class MessagePump : public eq::MessagePump
+{
+public:
+    /** Construct a new EGL message pump. @version 2.1 */
+    MessagePump();
+
+    /** Destruct this message pump. @version 2.1 */
+    virtual ~MessagePump();
+
+    void postWakeup() final;
+    void dispatchAll() final;
+    void dispatchOne(const uint32_t timeout = LB_TIMEOUT_INDEFINITE) final;
+
+    /** Register a new Deflect connection for event dispatch. @version 2.1 */
+    void register_(deflect::Proxy* proxy) override;
+
+    /** Deregister a Deflect connection from event dispatch. @version 2.1 */
+    void deregister(deflect::Proxy* proxy) override;
+
+private:
+    co::ConnectionSet _connections; //!< Registered Deflect connections
+    std::unordered_map<void*, size_t> _referenced; //!< # of registrations
+};
+}
+}
+#endif // EQ_EGL_MESSAGEPUMP_H
@@ -0,0 +1,267 @@
+
+/* Copyright (c) 2026, The Equalizer authors, see AUTHORS
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "pipe.h"
+
+#include "../gl.h"
+#include "../log.h"
+#include "../pipe.h"
+
+#define EGL_NO_X11
+#define MESA_EGL_NO_X11_HEADERS
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#ifndef EGL_PLATFORM_SURFACELESS_MESA
+#define EGL_PLATFORM_SURFACELESS_MESA 0x31DD
+#endif
+
+namespace eq
+{
+namespace egl
+{
+namespace
+{
+/** Headless pipes have no screen, use a common display size instead. */
+const PixelViewport _defaultPVP(0, 0, 1920, 1080);
+
+bool _hasExtension(EGLDisplay display, const std::string& name)
+{
+    const char* extensions = eglQueryString(display, EGL_EXTENSIONS);
+    if (!extensions)
+        return false;
+
+    // the extension string is a space-separated list
+    const std::string list = std::string(" ") + extensions + " ";
+    return list.find(" " + name + " ") != std::string::npos;
+}
+}
+
+namespace detail
+{
+class Pipe
+{
+public:
+    Pipe()
+        : display(EGL_NO_DISPLAY)
+        , surfaceless(false)
+    {
+    }
+
+    /** The initialized EGL display. */
+    EGLDisplay display;
+
+    /** Contexts can be bound without a surface. */
+    bool surfaceless;
+};
+}
+
+Pipe::Pipe(eq::Pipe* parent)
+    : SystemPipe(parent)
+    , _impl(new detail::Pipe)
+{
+}
+
+Pipe::~Pipe()
+{
+    delete _impl;
+}
+
+EGLDisplay Pipe::getEGLDisplay() const
+{
+    return _impl->display;
+}
+
+bool Pipe::isSurfaceless() const
+{
+    return _impl->surfaceless;
+}
+
+//---------------------------------------------------------------------------
+// EGL init
+//---------------------------------------------------------------------------
+bool Pipe::configInit()
+{
+    const uint32_t device = getPipe()->getDevice();
+    EGLDisplay display = _getDisplay();
+    if (display == EGL_NO_DISPLAY)
+    {
+        sendError(ERROR_EGLPIPE_DEVICE_NOTFOUND) << device;
+        return false;
+    }
+
+    EGLint major = 0, minor = 0;
+    if (!eglInitialize(display, &major, &minor))
+    {
+        sendError(ERROR_EGLPIPE_EGL_NOTFOUND) << eglGetError();
+        return false;
+    }
+
+    if (!eglBindAPI(EGL_OPENGL_API))
+    {
+        sendError(ERROR_EGLPIPE_OPENGL_UNSUPPORTED);
+        eglTerminate(display);
+        return false;
+    }
+
+    _impl->display = display;
+    _impl->surfaceless = _hasExtension(display, "EGL_KHR_surfaceless_context");
+    LBVERB << "Opened EGL " << major << "." << minor << " display @" << display
+           << ", device " << device << ", vendor "
+           << eglQueryString(display, EGL_VENDOR) << std::endl;
+
+    if (getPipe()->getPort() != LB_UNDEFINED_UINT32)
+        LBWARN << "Ignoring pipe port " << getPipe()->getPort()
+               << ", EGL pipes are selected by device" << std::endl;
+
+    if (!getPipe()->getPixelViewport().isValid())
+        getPipe()->setPixelViewport(_defaultPVP);
+
+    if (_configInitGL())
+        return true;
+
+    configExit();
+    return false;
+}
+
+void Pipe::configExit()
+{
+    EGLDisplay display = _impl->display;
+    if (display == EGL_NO_DISPLAY)
+        return;
+
+    _impl->display = EGL_NO_DISPLAY;
+    _impl->surfaceless = false;
+    eglTerminate(display);
+    LBVERB << "Terminated EGL display " << display << std::endl;
+}
+
+EGLDisplay Pipe::_getDisplay()
+{
+    const uint32_t device = getPipe()->getDevice();
+
+    // client extensions are queried without a display
+    PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay = 0;
+    if (_hasExtension(EGL_NO_DISPLAY, "EGL_EXT_platform_base"))
+        getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress(
+            "eglGetPlatformDisplayEXT");
+
+    // EGL devices are GPUs, or the software rasterizer of Mesa
+    if (getPlatformDisplay &&
+        _hasExtension(EGL_NO_DISPLAY, "EGL_EXT_device_enumeration") &&
+        _hasExtension(EGL_NO_DISPLAY, "EGL_EXT_platform_device"))
+    {
+        PFNEGLQUERYDEVICESEXTPROC queryDevices =
+            (PFNEGLQUERYDEVICESEXTPROC)eglGetProcAddress("eglQueryDevicesEXT");
+
+        EGLint nDevices = 0;
+        if (queryDevices && queryDevices(0, 0, &nDevices) && nDevices > 0)
+        {
+            std::vector<EGLDeviceEXT> devices(nDevices);
+            queryDevices(nDevices, devices.data(), &nDevices);
+
+            const uint32_t index = device == LB_UNDEFINED_UINT32 ? 0 : device;
+            if (index < uint32_t(nDevices))
+                return getPlatformDisplay(EGL_PLATFORM_DEVICE_EXT,
+                                          devices[index], 0);
+
+            LBWARN << "EGL device " << device << " not found, have "
+                   << nDevices << " devices" << std::endl;
+            return EGL_NO_DISPLAY;
+        }
+    }
+
+    if (device != LB_UNDEFINED_UINT32 && device != 0)
+    {
+        LBWARN << "EGL device enumeration not supported, can't use device "
+               << device << std::endl;
+        return EGL_NO_DISPLAY;
+    }
+
+    if (getPlatformDisplay &&
+        _hasExtension(EGL_NO_DISPLAY, "EGL_MESA_platform_surfaceless"))
+    {
+        return getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA,
+                                  EGL_DEFAULT_DISPLAY, 0);
+    }
+    return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+}
+
+bool Pipe::_configInitGL()
+{
+    LBASSERT(_impl->display != EGL_NO_DISPLAY);
+
+    //----- Create and make current a temporary GL context
+    const EGLint attributes[] = {EGL_SURFACE_TYPE,
+                                 _impl->surfaceless ? EGL_DONT_CARE
+                                                    : EGL_PBUFFER_BIT,
+                                 EGL_RENDERABLE_TYPE,
+                                 EGL_OPENGL_BIT,
+                                 EGL_NONE};
+    EGLConfig config = 0;
+    EGLint nConfigs = 0;
+    if (!eglChooseConfig(_impl->display, attributes, &config, 1, &nConfigs) ||
+        nConfigs == 0)
+    {
+        sendError(ERROR_SYSTEMPIPE_PIXELFORMAT_NOTFOUND);
+        return false;
+    }
+
+    EGLContext context =
+        eglCreateContext(_impl->display, config, EGL_NO_CONTEXT, 0);
+    if (context == EGL_NO_CONTEXT)
+    {
+        sendError(ERROR_SYSTEMPIPE_CREATECONTEXT_FAILED);
+        return false;
+    }
+
+    EGLSurface surface = EGL_NO_SURFACE;
+    if (!_impl->surfaceless)
+    {
+        const EGLint pbufferAttributes[] = {EGL_WIDTH, 1, EGL_HEIGHT, 1,
+                                            EGL_NONE};
+        surface =
+            eglCreatePbufferSurface(_impl->display, config, pbufferAttributes);
+        if (surface == EGL_NO_SURFACE)
+        {
+            eglDestroyContext(_impl->display, context);
+            sendError(ERROR_SYSTEMPIPE_CREATEWINDOW_FAILED);
+            return false;
+        }
+    }
+
+    eglMakeCurrent(_impl->display, surface, surface, context);
+
+    const bool success = configInitGL();
+    const char* glVersion = (const char*)glGetString(GL_VERSION);
+    if (success && glVersion)
+        _maxOpenGLVersion = static_cast<float>(atof(glVersion));
+
+    const char* renderer = (const char*)glGetString(GL_RENDERER);
+    LBVERB << "Pipe OpenGL " << (glVersion ? glVersion : "unknown") << " on "
+           << (renderer ? renderer : "unknown renderer") << std::endl;
+
+    eglMakeCurrent(_impl->display, EGL_NO_SURFACE, EGL_NO_SURFACE,
+                   EGL_NO_CONTEXT);
+    if (surface != EGL_NO_SURFACE)
+        eglDestroySurface(_impl->display, surface);
+    eglDestroyContext(_impl->display, context);
+
+    return success;
+}
+}
+}
@@ -0,0 +1,91 @@
+
+/* Copyright (c) 2026, The Equalizer authors, see AUTHORS
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQ_EGL_PIPE_H
+#define EQ_EGL_PIPE_H
+
+#include <eq/egl/types.h>
+
+#include <eq/systemPipe.h> // base class
+
+namespace eq
+{
+namespace egl
+{
+namespace detail
+{
+class Pipe;
+}
+
+/**
+ * Default implementation of an EGL system pipe.
+ *
+ * The pipe renders without a display server. Its device selects the EGL
+ * device, in the order enumerated by EGL_EXT_device_enumeration. Without a
+ * device the first EGL device, or the Mesa surfaceless platform, is used.
+ */
+class Pipe : public SystemPipe
+{
+public:
+    /** Construct a new EGL system pipe. @version 2.1 */
+    Pipe(eq::Pipe* parent);
+
+    /** Destruct this EGL pipe. @version 2.1 */
+    virtual ~Pipe();
+
+    /** @name EGL initialization */
+    //@{
+    /**
+     * Initialize this pipe for the EGL window system.
+     *
+     * @return true if the initialization was successful, false otherwise.
+     * @version 2.1
+     */
+    EQ_API bool configInit() override;
+
+    /** Deinitialize this pipe for the EGL window system. @version 2.1 */
+    EQ_API void configExit() override;
+    //@}
+
+    /** @return the EGL display connection for this pipe. @version 2.1 */
+    EQ_API EGLDisplay getEGLDisplay() const;
+
+    /**
+     * @return true if contexts can be made current without a surface.
+     * @version 2.1
+     */
+    EQ_API bool isSurfaceless() const;
+
+protected:
+    /**
+     * Initialize this pipe for OpenGL.
+     *
+     * A temporary GL context is current during this call. The context is
+     * not the one used by the windows of this pipe.
+     *
+     * @version 2.1
+     */
+    virtual bool configInitGL() { return true; }
+private:
+    detail::Pipe* const _impl;
+
+    EGLDisplay _getDisplay();
+    bool _configInitGL();
+};
+}
+}
+#endif // EQ_EGL_PIPE_H
@@ -0,0 +1,44 @@
+
+/* Copyright (c) 2026, The Equalizer authors, see AUTHORS
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQ_EGL_TYPES_H
+#define EQ_EGL_TYPES_H
+
+#include <lunchbox/types.h>
+
+/** @cond INTERNAL */
+typedef void* EGLConfig;
+typedef void* EGLContext;
+typedef void* EGLDisplay;
+typedef void* EGLSurface;
+/** @endcond */
+
+namespace eq
+{
+/**
+ * @namespace eq::egl
+ * @brief The system abstraction layer for headless EGL rendering.
+ */
+namespace egl
+{
+class MessagePump;
+class Pipe;
+class Window;
+}
+}
+
+#endif // EQ_EGL_TYPES_H
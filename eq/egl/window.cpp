@@ -0,0 +1,279 @@
+
+/* Copyright (c) 2026, The Equalizer authors, see AUTHORS
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "window.h"
+
+#include "../error.h"
+#include "../gl.h"
+
+#define EGL_NO_X11
+#define MESA_EGL_NO_X11_HEADERS
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+namespace eq
+{
+namespace egl
+{
+namespace detail
+{
+#define getIAttribute(attr) getIAttribute(WindowSettings::attr)
+
+class Window
+{
+public:
+    Window(EGLDisplay display_, const bool surfaceless_)
+        : display(display_)
+        , context(EGL_NO_CONTEXT)
+        , surface(EGL_NO_SURFACE)
+        , surfaceless(surfaceless_)
+    {
+    }
+
+    /** The display connection (maintained by egl::Pipe) */
+    EGLDisplay display;
+    /** The EGL rendering context. */
+    EGLContext context;
+    /** The pbuffer the context is bound to, if any. */
+    EGLSurface surface;
+    /** Contexts can be bound without a surface. */
+    const bool surfaceless;
+};
+}
+
+Window::Window(NotifierInterface& parent, const WindowSettings& settings,
+               EGLDisplay display, const bool surfaceless)
+    : GLWindow(parent, settings)
+    , _impl(new detail::Window(display, surfaceless))
+{
+}
+
+Window::~Window()
+{
+    delete _impl;
+}
+
+//---------------------------------------------------------------------------
+// EGL init
+//---------------------------------------------------------------------------
+bool Window::configInit()
+{
+    if (_impl->display == EGL_NO_DISPLAY)
+    {
+        sendError(ERROR_EGLWINDOW_NO_DISPLAY);
+        return false;
+    }
+
+    EGLConfig config = chooseEGLConfig();
+    if (!config)
+    {
+        sendError(ERROR_SYSTEMWINDOW_PIXELFORMAT_NOTFOUND);
+        return false;
+    }
+
+    _impl->context = createEGLContext(config);
+    if (_impl->context == EGL_NO_CONTEXT || !configInitEGLSurface(config))
+        return false;
+
+    makeCurrent();
+    initGLEW();
+    if (getIAttribute(IATTR_HINT_DRAWABLE) == FBO)
+        return configInitFBO();
+    return true;
+}
+
+EGLConfig Window::chooseEGLConfig()
+{
+    // Rendering goes to an FBO, the config only needs to describe the context
+    std::vector<EGLint> attributes;
+    attributes.push_back(EGL_SURFACE_TYPE);
+    attributes.push_back(_impl->surfaceless ? EGL_DONT_CARE : EGL_PBUFFER_BIT);
+    attributes.push_back(EGL_RENDERABLE_TYPE);
+    attributes.push_back(EGL_OPENGL_BIT);
+
+    if (getIAttribute(IATTR_PLANES_COLOR) != OFF)
+    {
+        attributes.push_back(EGL_RED_SIZE);
+        attributes.push_back(8);
+        attributes.push_back(EGL_GREEN_SIZE);
+        attributes.push_back(8);
+        attributes.push_back(EGL_BLUE_SIZE);
+        attributes.push_back(8);
+
+        const int alphaSize = getIAttribute(IATTR_PLANES_ALPHA);
+        if (alphaSize != OFF)
+        {
+            attributes.push_back(EGL_ALPHA_SIZE);
+            attributes.push_back(alphaSize > 0 ? alphaSize : 8);
+        }
+    }
+    attributes.push_back(EGL_NONE);
+
+    EGLConfig config = 0;
+    EGLint nConfigs = 0;
+    if (!eglChooseConfig(_impl->display, attributes.data(), &config, 1,
+                         &nConfigs) ||
+        nConfigs == 0)
+    {
+        return 0;
+    }
+    return config;
+}
+
+EGLContext Window::createEGLContext(EGLConfig config)
+{
+    if (_impl->display == EGL_NO_DISPLAY)
+    {
+        sendError(ERROR_EGLWINDOW_NO_DISPLAY);
+        return EGL_NO_CONTEXT;
+    }
+    if (!config)
+    {
+        sendError(ERROR_SYSTEMWINDOW_NO_PIXELFORMAT);
+        return EGL_NO_CONTEXT;
+    }
+
+    EGLContext shCtx = EGL_NO_CONTEXT;
+    const Window* shareWindow =
+        dynamic_cast<const Window*>(getSharedContextWindow());
+    if (shareWindow)
+        shCtx = shareWindow->getEGLContext();
+    else if (getSharedContextWindow())
+        LBWARN << "Can't share context with non-EGL window" << std::endl;
+
+    std::vector<EGLint> attributes;
+    if (getIAttribute(IATTR_HINT_CORE_PROFILE) == ON)
+    {
+        attributes.push_back(EGL_CONTEXT_MAJOR_VERSION_KHR);
+        attributes.push_back(getIAttribute(IATTR_HINT_OPENGL_MAJOR));
+        attributes.push_back(EGL_CONTEXT_MINOR_VERSION_KHR);
+        attributes.push_back(getIAttribute(IATTR_HINT_OPENGL_MINOR));
+        attributes.push_back(EGL_CONTEXT_OPENGL_PROFILE_MASK_KHR);
+        attributes.push_back(EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT_KHR);
+    }
+    attributes.push_back(EGL_NONE);
+
+    // the current API is per-thread state
+    eglBindAPI(EGL_OPENGL_API);
+    EGLContext context =
+        eglCreateContext(_impl->display, config, shCtx, attributes.data());
+    if (context == EGL_NO_CONTEXT)
+    {
+        sendError(ERROR_EGLWINDOW_CREATECONTEXT_FAILED) << eglGetError();
+        return EGL_NO_CONTEXT;
+    }
+    return context;
+}
+
+bool Window::configInitEGLSurface(EGLConfig config)
+{
+    const int32_t drawable = getIAttribute(IATTR_HINT_DRAWABLE);
+    if (drawable != FBO && drawable != OFF)
+        LBWARN << "Unsupported drawable type " << drawable
+               << ", using offscreen surface" << std::endl;
+
+    if (_impl->surfaceless)
+        return true;
+
+    const EGLint attributes[] = {EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE};
+    _impl->surface = eglCreatePbufferSurface(_impl->display, config, attributes);
+    if (_impl->surface == EGL_NO_SURFACE)
+    {
+        sendError(ERROR_EGLWINDOW_NO_DRAWABLE) << eglGetError();
+        return false;
+    }
+    return true;
+}
+
+void Window::configExit()
+{
+    if (_impl->display == EGL_NO_DISPLAY)
+        return;
+
+    configExitFBO();
+    exitGLEW();
+
+    eglMakeCurrent(_impl->display, EGL_NO_SURFACE, EGL_NO_SURFACE,
+                   EGL_NO_CONTEXT);
+
+    if (_impl->context != EGL_NO_CONTEXT)
+        eglDestroyContext(_impl->display, _impl->context);
+    if (_impl->surface != EGL_NO_SURFACE)
+        eglDestroySurface(_impl->display, _impl->surface);
+
+    _impl->context = EGL_NO_CONTEXT;
+    _impl->surface = EGL_NO_SURFACE;
+    LBVERB << "Destroyed EGL context and surface" << std::endl;
+}
+
+EGLDisplay Window::getEGLDisplay() const
+{
+    return _impl->display;
+}
+
+EGLContext Window::getEGLContext() const
+{
+    return _impl->context;
+}
+
+EGLSurface Window::getEGLSurface() const
+{
+    return _impl->surface;
+}
+
+void Window::makeCurrent(const bool cache) const
+{
+    LBASSERT(_impl->display != EGL_NO_DISPLAY);
+    if (cache && isCurrent())
+        return;
+
+    eglBindAPI(EGL_OPENGL_API);
+    eglMakeCurrent(_impl->display, _impl->surface, _impl->surface,
+                   _impl->context);
+    GLWindow::makeCurrent();
+    if (_impl->context != EGL_NO_CONTEXT)
+    {
+        EQ_GL_ERROR("After eglMakeCurrent");
+    }
+}
+
+void Window::doneCurrent() const
+{
+    LBASSERT(_impl->display != EGL_NO_DISPLAY);
+    if (!isCurrent())
+        return;
+
+    eglMakeCurrent(_impl->display, EGL_NO_SURFACE, EGL_NO_SURFACE,
+                   EGL_NO_CONTEXT);
+    GLWindow::doneCurrent();
+}
+
+void Window::swapBuffers()
+{
+    // FBO and pbuffer drawables have no back buffer
+}
+
+void Window::joinNVSwapBarrier(const uint32_t group, const uint32_t)
+{
+    if (group == 0)
+        return;
+
+    LBWARN << "NV swap barriers are not supported by EGL windows, ignoring "
+           << "swap group " << group << std::endl;
+}
+}
+}
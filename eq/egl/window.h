@@ -0,0 +1,139 @@
+
+/* Copyright (c) 2026, The Equalizer authors, see AUTHORS
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQ_EGL_WINDOW_H
+#define EQ_EGL_WINDOW_H
+
+#include <eq/egl/types.h>
+#include <eq/glWindow.h> // base class
+
+namespace eq
+{
+namespace egl
+{
+namespace detail
+{
+class Window;
+}
+
+/**
+ * Equalizer default implementation of a headless EGL window.
+ *
+ * EGL windows have no on-screen drawable. They render into a frame buffer
+ * object, using a context bound without a surface or with a 1x1 pbuffer.
+ */
+class Window : public GLWindow
+{
+public:
+    /**
+     * Construct a new EGL system window.
+     *
+     * @param display the initialized EGL display of the pipe.
+     * @param surfaceless true if contexts can be bound without a surface.
+     * @version 2.1
+     */
+    Window(NotifierInterface& parent, const WindowSettings& settings,
+           EGLDisplay display, bool surfaceless);
+
+    /** Destruct this EGL window. @version 2.1 */
+    virtual ~Window();
+
+    /** @name EGL initialization */
+    //@{
+    /**
+     * Initialize this window for the EGL window system.
+     *
+     * This method first calls chooseEGLConfig(), then createEGLContext()
+     * with the chosen config, and finally creates a surface using
+     * configInitEGLSurface(). FBO drawables are initialized afterwards.
+     *
+     * @return true if the initialization was successful, false otherwise.
+     * @version 2.1
+     */
+    bool configInit() override;
+
+    /** @version 2.1 */
+    void configExit() override;
+
+    /**
+     * Choose an EGL framebuffer config based on the window's attributes.
+     *
+     * @return a config, or 0 if no config was found.
+     * @version 2.1
+     */
+    virtual EGLConfig chooseEGLConfig();
+
+    /**
+     * Create an EGL context.
+     *
+     * This method does not set the window's EGL context.
+     *
+     * @param config the framebuffer config for the context.
+     * @return the context, or 0 if context creation failed.
+     * @version 2.1
+     */
+    virtual EGLContext createEGLContext(EGLConfig config);
+
+    /**
+     * Initialize the surface the window's context is bound to.
+     *
+     * No surface is created if the display supports surfaceless contexts,
+     * otherwise a 1x1 pbuffer is used.
+     *
+     * @param config the framebuffer config for the context.
+     * @return true if the surface was created, false otherwise.
+     * @version 2.1
+     */
+    virtual bool configInitEGLSurface(EGLConfig config);
+    //@}
+
+    /** @name Data Access. */
+    //@{
+    /** @return the EGL display. @version 2.1 */
+    EGLDisplay getEGLDisplay() const;
+
+    /** @return the EGL rendering context. @version 2.1 */
+    EGLContext getEGLContext() const;
+
+    /** @return the EGL surface, 0 for surfaceless contexts. @version 2.1 */
+    EGLSurface getEGLSurface() const;
+    //@}
+
+    /** @name Operations. */
+    //@{
+    /** @version 2.1 */
+    void makeCurrent(const bool cache = true) const override;
+
+    /** @version 2.1 */
+    void doneCurrent() const override;
+
+    /** @version 2.1 */
+    void swapBuffers() override;
+
+    /** Not supported for EGL windows. @version 2.1 */
+    void joinNVSwapBarrier(const uint32_t group,
+                           const uint32_t barrier) override;
+    //@}
+
+private:
+    detail::Window* const _impl;
+
+    void _resize(const PixelViewport&) override {}
+};
+}
+}
+#endif // EQ_EGL_WINDOW_H
@@ -0,0 +1,75 @@
+
+/* Copyright (c) 2026, The Equalizer authors, see AUTHORS
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include "../windowSystem.h"
+
+#include "../config.h"
+#include "../pipe.h"
+#include "../window.h"
+#include "messagePump.h"
+#include "pipe.h"
+#include "window.h"
+
+namespace eq
+{
+namespace egl
+{
+class WindowSystem : public WindowSystemIF
+{
+public:
+    WindowSystem() {}
+private:
+    std::string getName() const final { return "EGL"; }
+    eq::SystemWindow* createWindow(eq::Window* window,
+                                   const WindowSettings& settings) final
+    {
+        EGLDisplay display = 0;
+        bool surfaceless = false;
+        eq::Pipe* pipe = window->getPipe();
+        const Pipe* eglPipe = dynamic_cast<const Pipe*>(pipe->getSystemPipe());
+        if (eglPipe)
+        {
+            display = eglPipe->getEGLDisplay();
+            surfaceless = eglPipe->isSurfaceless();
+        }
+
+        // there is no display server, on-screen windows render to an FBO
+        WindowSettings eglSettings = settings;
+        const int32_t drawable =
+            settings.getIAttribute(WindowSettings::IATTR_HINT_DRAWABLE);
+        if (drawable != FBO && drawable != OFF)
+        {
+            LBINFO << "EGL window " << window->getName()
+                   << " has no on-screen drawable, using FBO" << std::endl;
+            eglSettings.setIAttribute(WindowSettings::IATTR_HINT_DRAWABLE,
+                                      FBO);
+        }
+        return new Window(*window, eglSettings, display, surfaceless);
+    }
+
+    eq::SystemPipe* createPipe(eq::Pipe* pipe) final { return new Pipe(pipe); }
+    eq::MessagePump* createMessagePump() final { return new MessagePump; }
+    bool setupFont(util::ObjectManager&, const void*, const std::string&,
+                   const uint32_t) const final
+    {
+        return false; // no bitmap fonts without a display server
+    }
+};
+}
+}
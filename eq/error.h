@@ -88,6 +88,12 @@ using fabric::ERROR_PBO_UNSUPPORTED;
 using fabric::ERROR_PBO_NOT_INITIALIZED;
 using fabric::ERROR_PBO_SIZE_TOO_SMALL;
 using fabric::ERROR_PBO_TYPE_UNSUPPORTED;
+using fabric::ERROR_EGLPIPE_DEVICE_NOTFOUND;
+using fabric::ERROR_EGLPIPE_EGL_NOTFOUND;
+using fabric::ERROR_EGLPIPE_OPENGL_UNSUPPORTED;
+using fabric::ERROR_EGLWINDOW_NO_DISPLAY;
+using fabric::ERROR_EGLWINDOW_CREATECONTEXT_FAILED;
+using fabric::ERROR_EGLWINDOW_NO_DRAWABLE;
 using fabric::ERROR_CUSTOM;
 }
 #endif // EQ_ERROR_H
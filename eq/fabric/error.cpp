@@ -127,6 +127,14 @@ ErrorData _errors[] = {
     {ERROR_PBO_SIZE_TOO_SMALL, "PBO size is too small, it has to be > 0"},
     {ERROR_PBO_TYPE_UNSUPPORTED, "Unsupported PBO type"},
 
+    {ERROR_EGLPIPE_DEVICE_NOTFOUND, "Can't get EGL display for device"},
+    {ERROR_EGLPIPE_EGL_NOTFOUND, "Can't initialize EGL display"},
+    {ERROR_EGLPIPE_OPENGL_UNSUPPORTED, "EGL display does not support OpenGL"},
+
+    {ERROR_EGLWINDOW_NO_DISPLAY, "Missing EGL display"},
+    {ERROR_EGLWINDOW_CREATECONTEXT_FAILED, "Can't create EGL context"},
+    {ERROR_EGLWINDOW_NO_DRAWABLE, "Can't create EGL pbuffer surface"},
+
     {0, ""} // last!
 };
 }
@@ -91,6 +91,12 @@ enum ErrorCode
     ERROR_PBO_NOT_INITIALIZED,
     ERROR_PBO_SIZE_TOO_SMALL,
     ERROR_PBO_TYPE_UNSUPPORTED,
+    ERROR_EGLPIPE_DEVICE_NOTFOUND,
+    ERROR_EGLPIPE_EGL_NOTFOUND,
+    ERROR_EGLPIPE_OPENGL_UNSUPPORTED,
+    ERROR_EGLWINDOW_NO_DISPLAY,
+    ERROR_EGLWINDOW_CREATECONTEXT_FAILED,
+    ERROR_EGLWINDOW_NO_DRAWABLE,
 
     ERROR_CUSTOM = LB_64KB, // 0x10000
 };
@@ -51,6 +51,7 @@ public:
         _names[EVENT_KEY_RELEASE] = "key release";
         _names[EVENT_CHANNEL_RESIZE] = "channel resize";
         _names[EVENT_STATISTIC] = "statistic";
+        _names[EVENT_STATISTICS] = "statistics";
         _names[EVENT_VIEW_RESIZE] = "view resize";
         _names[EVENT_EXIT] = "exit";
         _names[EVENT_MAGELLAN_AXIS] = "magellan axis";
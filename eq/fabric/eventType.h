@@ -71,6 +71,9 @@ enum EventType // Also update string table in event.cpp
      */
     EVENT_OBSERVER_MOTION,
 
+    /** Compact batch of the statistics of one node and frame. @internal */
+    EVENT_STATISTICS,
+
     /**
      * Config error event. Contains the originator id, the error code and
      * 0-n Strings with additional information.
@@ -0,0 +1,148 @@
+
+/* Copyright (c) 2026, The Equalizer authors, see AUTHORS
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "frustumSetup.h"
+
+#include "pixel.h"
+#include "renderContext.h"
+#include "viewport.h"
+#include "wall.h"
+
+namespace eq
+{
+namespace fabric
+{
+namespace
+{
+void _computeHeadTransform(Matrix4f& result, const Matrix4f& xfm,
+                           const Vector3f& eye)
+{
+    // headTransform = -trans(eye) * view matrix (frustum position)
+    for (int i = 0; i < 16; i += 4)
+    {
+        result.array[i] = xfm.array[i] - eye[0] * xfm.array[i + 3];
+        result.array[i + 1] = xfm.array[i + 1] - eye[1] * xfm.array[i + 3];
+        result.array[i + 2] = xfm.array[i + 2] - eye[2] * xfm.array[i + 3];
+        result.array[i + 3] = xfm.array[i + 3];
+    }
+}
+}
+
+FrustumSetup::FrustumSetup()
+    : destination(0, 0)
+    , width(0.f)
+    , height(0.f)
+    , modelUnit(1.f)
+    , type(Wall::TYPE_FIXED)
+    , latchable(false)
+    , alignDummy(0)
+{
+}
+
+void FrustumSetup::compute(RenderContext& context, const Vector3f& eyeWorld,
+                           const Vector3f& cyclopWorld,
+                           const Matrix4f& inverseHead) const
+{
+    // compute eye position in screen space
+    const Vector3f eye = transform * eyeWorld;
+
+    computeCorners(context.frustum, eye, false, context.pixel, context.vp);
+    _computeHeadTransform(context.headTransform, transform, eye);
+    if (isHMD())
+        context.headTransform *= inverseHead;
+
+    // Compute corners for cyclop eye without perspective correction:
+    const Vector3f cyclop = transform * cyclopWorld;
+
+    computeCorners(context.ortho, cyclop, true, context.pixel, context.vp);
+    _computeHeadTransform(context.orthoTransform, transform, eye);
+
+    // Apply stereo shearing
+    context.orthoTransform.array[8] += (cyclop[0] - eye[0]) / eye[2];
+    context.orthoTransform.array[9] += (cyclop[1] - eye[1]) / eye[2];
+
+    if (isHMD())
+        context.orthoTransform *= inverseHead;
+}
+
+void FrustumSetup::computeCorners(Frustumf& frustum, const Vector3f& eye,
+                                  const bool ortho, const Pixel& pixel,
+                                  const Viewport& vp) const
+{
+    const float ratio = ortho ? 1.0f : frustum.nearPlane() / eye.z();
+    const float width_2 = width * .5f;
+    const float height_2 = height * .5f;
+
+    if (eye.z() > 0 || ortho)
+    {
+        frustum.left() = (-width_2 - eye.x()) * ratio;
+        frustum.right() = (width_2 - eye.x()) * ratio;
+        frustum.bottom() = (-height_2 - eye.y()) * ratio;
+        frustum.top() = (height_2 - eye.y()) * ratio;
+    }
+    else // eye behind near plane - 'mirror' x
+    {
+        frustum.left() = (width_2 - eye.x()) * ratio;
+        frustum.right() = (-width_2 - eye.x()) * ratio;
+        frustum.bottom() = (height_2 + eye.y()) * ratio;
+        frustum.top() = (-height_2 + eye.y()) * ratio;
+    }
+
+    // move frustum according to pixel decomposition
+    if (pixel != Pixel::ALL && pixel.isValid())
+    {
+        if (pixel.w > 1)
+        {
+            const float frustumWidth = frustum.right() - frustum.left();
+            const float pixelWidth =
+                frustumWidth / static_cast<float>(destination.x());
+            const float jitter = pixelWidth * pixel.x - pixelWidth * .5f;
+
+            frustum.left() += jitter;
+            frustum.right() += jitter;
+        }
+        if (pixel.h > 1)
+        {
+            const float frustumHeight = frustum.bottom() - frustum.top();
+            const float pixelHeight = frustumHeight / float(destination.y());
+            const float jitter = pixelHeight * pixel.y + pixelHeight * .5f;
+
+            frustum.top() -= jitter;
+            frustum.bottom() -= jitter;
+        }
+    }
+
+    // adjust to viewport (screen-space decomposition)
+    if (vp != Viewport::FULL && vp.isValid())
+    {
+        const float frustumWidth = frustum.right() - frustum.left();
+        frustum.left() += frustumWidth * vp.x;
+        frustum.right() = frustum.left() + frustumWidth * vp.w;
+
+        const float frustumHeight = frustum.top() - frustum.bottom();
+        frustum.bottom() += frustumHeight * vp.y;
+        frustum.top() = frustum.bottom() + frustumHeight * vp.h;
+    }
+}
+
+Vector3f FrustumSetup::getEyePosition(const Matrix4f& head,
+                                      const Vector3f& eye) const
+{
+    return modelUnit * (isHMD() ? eye : head * eye);
+}
+}
+}
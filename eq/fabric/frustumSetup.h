@@ -0,0 +1,94 @@
+
+/* Copyright (c) 2026, The Equalizer authors, see AUTHORS
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQFABRIC_FRUSTUMSETUP_H
+#define EQFABRIC_FRUSTUMSETUP_H
+
+#include <eq/fabric/api.h>
+#include <eq/fabric/types.h>
+#include <eq/fabric/vmmlib.h>
+
+namespace eq
+{
+namespace fabric
+{
+/**
+ * The wall description used to compute the frusta of a render context.
+ *
+ * The server computes the frusta of each task from this description and the
+ * observer's eye positions. The description is passed with the render context,
+ * which allows render clients to recompute the frusta for a newer head position
+ * just before drawing.
+ */
+class FrustumSetup
+{
+public:
+    EQFABRIC_API FrustumSetup();
+
+    /**
+     * Compute the frusta and head transformations of a render context.
+     *
+     * The near and far planes of the context frusta are retained. The pixel
+     * and viewport decomposition is taken from the context.
+     *
+     * @param context the render context to update.
+     * @param eyeWorld the position of the context's eye, in world coordinates
+     *                 for fixed walls or relative to the head for HMDs.
+     * @param cyclopWorld the position of the cyclop eye.
+     * @param inverseHead the inverse head matrix, used for HMDs.
+     */
+    EQFABRIC_API void compute(RenderContext& context, const Vector3f& eyeWorld,
+                              const Vector3f& cyclopWorld,
+                              const Matrix4f& inverseHead) const;
+
+    /**
+     * Compute the frustum corners for an eye position in wall coordinates.
+     *
+     * @param frustum the frustum to update, with valid near and far planes.
+     * @param eye the eye position relative to the wall.
+     * @param ortho compute an orthographic instead of a perspective frustum.
+     * @param pixel the pixel decomposition wrt the destination.
+     * @param vp the fractional viewport wrt the destination.
+     */
+    EQFABRIC_API void computeCorners(Frustumf& frustum, const Vector3f& eye,
+                                     bool ortho, const Pixel& pixel,
+                                     const Viewport& vp) const;
+
+    /** @return true if the wall moves with the observer. */
+    bool isHMD() const { return type != 0; }
+
+    /**
+     * @return the eye position for an observer-relative eye and head matrix,
+     *         as passed to compute().
+     */
+    EQFABRIC_API Vector3f getEyePosition(const Matrix4f& head,
+                                         const Vector3f& eye) const;
+
+    Matrix4f transform;   //!< world to wall transformation
+    Vector2i destination; //!< size of the destination channel in pixels
+    float width;          //!< wall width
+    float height;         //!< wall height
+    float modelUnit;      //!< the model unit of the destination view
+    uint32_t type;        //!< the Wall::Type
+    /** The frusta may be recomputed for a new head position. */
+    uint32_t latchable;
+    uint32_t alignDummy; //!< @internal padding
+};
+}
+}
+
+#endif // EQFABRIC_FRUSTUMSETUP_H
@@ -22,6 +22,7 @@
 #include <eq/fabric/api.h>
 #include <eq/fabric/colorMask.h>     // member
 #include <eq/fabric/eye.h>           // member
+#include <eq/fabric/frustumSetup.h>  // member
 #include <eq/fabric/pixel.h>         // member
 #include <eq/fabric/pixelViewport.h> // member
 #include <eq/fabric/range.h>         // member
@@ -46,6 +47,8 @@ public:
     Matrix4f headTransform;  //!< frustum transform for modelview
     Matrix4f orthoTransform; //!< orthographic frustum transform
 
+    FrustumSetup frustumSetup; //!< @internal wall data to recompute frusta
+
     co::ObjectVersion view; //!< destination view id and version
     uint128_t frameID;      //!< identifier from Config::beginFrame
     PixelViewport pvp;      //!< pixel viewport of channel wrt window
@@ -51,6 +51,7 @@ class Error;
 class ErrorRegistry;
 class FrameData;
 class Frustum;
+class FrustumSetup;
 class Pixel;
 class PixelViewport;
 class Projection;
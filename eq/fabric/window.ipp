@@ -50,6 +50,7 @@ std::string _iAttributeStrings[] = {
     MAKE_WINDOW_ATTR_STRING(IATTR_HINT_STATISTICS),
     MAKE_WINDOW_ATTR_STRING(IATTR_HINT_SCREENSAVER),
     MAKE_WINDOW_ATTR_STRING(IATTR_HINT_GRAB_POINTER),
+    MAKE_WINDOW_ATTR_STRING(IATTR_HINT_COALESCE_EVENTS),
     MAKE_WINDOW_ATTR_STRING(IATTR_HINT_WIDTH),
     MAKE_WINDOW_ATTR_STRING(IATTR_HINT_HEIGHT),
     MAKE_WINDOW_ATTR_STRING(IATTR_PLANES_COLOR),
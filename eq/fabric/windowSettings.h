@@ -70,6 +70,8 @@ public:
         IATTR_HINT_STATISTICS,    //!< Statistics gathering hint
         IATTR_HINT_SCREENSAVER,   //!< Screensaver (de)activation (WGL)
         IATTR_HINT_GRAB_POINTER,  //!< Capture mouse outside window
+        /** Merge consecutive motion, resize and axis events */
+        IATTR_HINT_COALESCE_EVENTS,
         IATTR_HINT_WIDTH,         //!< Default horizontal resolution
         IATTR_HINT_HEIGHT,        //!< Default vertical resolution
         IATTR_PLANES_COLOR,       //!< No of per-component color planes
@@ -37,11 +37,16 @@
 #include <eq/util/objectManager.h>
 #include <lunchbox/monitor.h>
 #include <lunchbox/scopedMutex.h>
+#include <lunchbox/spinLock.h>
 #include <pression/plugins/compressor.h>
 
 #include <boost/foreach.hpp>
 
 #include <algorithm>
+#include <atomic>
+#include <map>
+
+#define N_IMAGE_CACHES 8 // shards of released images, see _getCacheIndex()
 
 namespace eq
 {
@@ -50,6 +55,13 @@ typedef std::vector<FrameData::Listener*> Listeners;
 
 namespace detail
 {
+/** Released images of one shard, reused by newly received images. */
+struct ImageCache
+{
+    lunchbox::SpinLock lock;
+    Images images;
+};
+
 class FrameData
 {
 public:
@@ -64,12 +76,30 @@ public:
     }
 
     Images images;
-    Images imageCache;
-    std::mutex imageCacheLock;
+
+    /** The concurrent decode threads allocate from different shards. */
+    ImageCache imageCaches[N_IMAGE_CACHES];
 
     ROIFinder roiFinder;
 
-    Images pendingImages;
+    /** The received, not yet applied state of one version. */
+    struct Pending
+    {
+        Pending()
+            : nDecoding(0)
+            , ready(false)
+        {
+        }
+
+        Images images;
+        uint32_t nDecoding; //!< Received images still being decompressed
+        bool ready;         //!< Ready received, applied once all are decoded
+        fabric::FrameData data;
+    };
+
+    /** Received versions, applied in order. Protected by pendingLock. */
+    std::map<uint64_t, Pending> pending;
+    std::mutex pendingLock;
 
     uint64_t version; //!< The current version
 
@@ -90,6 +120,17 @@ public:
 
 typedef co::CommandFunc<FrameData> CmdFunc;
 
+namespace
+{
+/** @return the image cache shard of the calling thread. */
+size_t _getCacheIndex()
+{
+    static std::atomic<size_t> next(0);
+    thread_local const size_t index = next++ % N_IMAGE_CACHES;
+    return index;
+}
+}
+
 FrameData::FrameData()
     : _impl(new detail::FrameData)
 {
@@ -99,13 +140,20 @@ FrameData::~FrameData()
 {
     clear();
 
-    for (Image* image : _impl->imageCache)
+    for (const auto& pending : _impl->pending)
+        for (Image* image : pending.second.images)
+            delete image;
+
+    for (detail::ImageCache& cache : _impl->imageCaches)
     {
-        LBLOG(LOG_BUG) << "Unflushed image in FrameData destructor"
-                       << std::endl;
-        delete image;
+        for (Image* image : cache.images)
+        {
+            LBLOG(LOG_BUG) << "Unflushed image in FrameData destructor"
+                           << std::endl;
+            delete image;
+        }
+        cache.images.clear();
     }
-    _impl->imageCache.clear();
 
     delete _impl;
 }
@@ -164,10 +212,16 @@ void FrameData::applyInstanceData(co::DataIStream& is)
 
 void FrameData::clear()
 {
-    _impl->imageCacheLock.lock();
-    _impl->imageCache.insert(_impl->imageCache.end(), _impl->images.begin(),
-                             _impl->images.end());
-    _impl->imageCacheLock.unlock();
+    // Spread the images over all shards, the decode threads refilling this
+    // frame data then mostly allocate from their own shard.
+    size_t index = _getCacheIndex();
+    for (Image* image : _impl->images)
+    {
+        detail::ImageCache& cache = _impl->imageCaches[index];
+        lunchbox::ScopedFastWrite mutex(cache.lock);
+        cache.images.push_back(image);
+        index = (index + 1) % N_IMAGE_CACHES;
+    }
     _impl->images.clear();
 }
 
@@ -175,31 +229,33 @@ void FrameData::flush()
 {
     clear();
 
-    for (ImagesCIter i = _impl->imageCache.begin();
-         i != _impl->imageCache.end(); ++i)
+    for (detail::ImageCache& cache : _impl->imageCaches)
     {
-        Image* image = *i;
-        image->flush();
-        delete image;
+        for (Image* image : cache.images)
+        {
+            image->flush();
+            delete image;
+        }
+        cache.images.clear();
     }
-
-    _impl->imageCache.clear();
 }
 
 void FrameData::deleteGLObjects(util::ObjectManager& om)
 {
     for (Image* image : _impl->images)
         image->deleteGLObjects(om);
-    for (Image* image : _impl->imageCache)
-        image->deleteGLObjects(om);
+    for (detail::ImageCache& cache : _impl->imageCaches)
+        for (Image* image : cache.images)
+            image->deleteGLObjects(om);
 }
 
 void FrameData::resetPlugins()
 {
     BOOST_FOREACH (Image* image, _impl->images)
         image->resetPlugins();
-    BOOST_FOREACH (Image* image, _impl->imageCache)
-        image->resetPlugins();
+    for (detail::ImageCache& cache : _impl->imageCaches)
+        BOOST_FOREACH (Image* image, cache.images)
+            image->resetPlugins();
 }
 
 Image* FrameData::newImage(const eq::Frame::Type type,
@@ -214,22 +270,26 @@ Image* FrameData::_allocImage(const eq::Frame::Type type,
                               const DrawableConfig& config,
                               const bool setQuality_)
 {
-    Image* image;
-    _impl->imageCacheLock.lock();
+    Image* image = 0;
 
-    if (_impl->imageCache.empty())
+    // own shard first, steal from the others when it runs empty
+    const size_t index = _getCacheIndex();
+    for (size_t i = 0; i < N_IMAGE_CACHES && !image; ++i)
     {
-        _impl->imageCacheLock.unlock();
-        image = new Image;
+        detail::ImageCache& cache =
+            _impl->imageCaches[(index + i) % N_IMAGE_CACHES];
+        lunchbox::ScopedFastWrite mutex(cache.lock);
+        if (cache.images.empty())
+            continue;
+
+        image = cache.images.back();
+        cache.images.pop_back();
     }
-    else
-    {
-        image = _impl->imageCache.back();
-        _impl->imageCache.pop_back();
-        _impl->imageCacheLock.unlock();
 
+    if (image)
         image->reset();
-    }
+    else
+        image = new Image;
 
     image->setAlphaUsage(_impl->useAlpha);
     image->setStorageType(type);
@@ -357,19 +417,56 @@ void FrameData::setReady()
 void FrameData::setReady(const co::ObjectVersion& frameData,
                          const fabric::FrameData& data)
 {
-    clear();
     LBASSERT(frameData.version.high() == 0);
     LBASSERT(_impl->readyVersion < frameData.version.low());
-    LBASSERT(_impl->readyVersion == 0 ||
-             _impl->readyVersion + 1 == frameData.version.low());
     LBASSERT(_impl->version == frameData.version.low());
 
-    _impl->images.swap(_impl->pendingImages);
-    fabric::FrameData::operator=(data);
-    _setReady(frameData.version.low());
+    std::lock_guard<std::mutex> mutex(_impl->pendingLock);
+    detail::FrameData::Pending& pending =
+        _impl->pending[frameData.version.low()];
+    LBASSERT(!pending.ready);
+    pending.ready = true;
+    pending.data = data;
+    _applyReady();
+}
 
-    LBLOG(LOG_ASSEMBLY) << this << " applied v" << frameData.version.low()
-                        << std::endl;
+void FrameData::_applyReady()
+{
+    // Apply in version order, a version still decoding holds back newer ones
+    while (!_impl->pending.empty())
+    {
+        std::map<uint64_t, detail::FrameData::Pending>::iterator i =
+            _impl->pending.begin();
+        detail::FrameData::Pending& pending = i->second;
+        if (!pending.ready || pending.nDecoding > 0)
+            return;
+
+        clear();
+        _impl->images.swap(pending.images);
+        fabric::FrameData::operator=(pending.data);
+        _setReady(i->first);
+
+        LBLOG(LOG_ASSEMBLY) << this << " applied v" << i->first << std::endl;
+        _impl->pending.erase(i);
+    }
+}
+
+void FrameData::startDecode(const uint64_t version)
+{
+    std::lock_guard<std::mutex> mutex(_impl->pendingLock);
+    detail::FrameData::Pending& pending = _impl->pending[version];
+    LBASSERT(!pending.ready);
+    ++pending.nDecoding;
+}
+
+void FrameData::finishDecode(const uint64_t version)
+{
+    std::lock_guard<std::mutex> mutex(_impl->pendingLock);
+    LBASSERT(_impl->pending.count(version));
+    detail::FrameData::Pending& pending = _impl->pending[version];
+    LBASSERT(pending.nDecoding > 0);
+    if (--pending.nDecoding == 0)
+        _applyReady();
 }
 
 void FrameData::_setReady(const uint64_t version)
@@ -477,7 +574,8 @@ bool FrameData::addImage(const co::ObjectVersion& frameDataVersion,
         }
     }
 
-    _impl->pendingImages.push_back(image);
+    std::lock_guard<std::mutex> mutex(_impl->pendingLock);
+    _impl->pending[frameDataVersion.version.low()].images.push_back(image);
     return true;
 }
 
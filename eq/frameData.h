@@ -205,6 +205,18 @@ public:
     void setReady(const co::ObjectVersion& frameData,
                   const fabric::FrameData& data); //!< @internal
 
+    /**
+     * @internal
+     * Account for a received image of the given version queued for
+     * asynchronous decompression.
+     *
+     * A ready received via setReady() is deferred until finishDecode() has
+     * been called for all started images of its version. Versions are applied
+     * in order, so images of overlapping versions never mix.
+     */
+    void startDecode(uint64_t version);
+    void finishDecode(uint64_t version); //!< @internal
+
 protected:
     virtual ChangeType getChangeType() const { return INSTANCE; }
     virtual void getInstanceData(co::DataOStream& os);
@@ -220,6 +232,9 @@ private:
     /** Apply all received images of the given version. */
     void _applyVersion(const uint128_t& version);
 
+    /** Apply all fully received and decoded versions, in order. */
+    void _applyReady();
+
     /** Set a specific version ready. */
     void _setReady(const uint64_t version);
 
@@ -40,6 +40,8 @@
 #include <X11/XKBlib.h>
 #include <X11/keysym.h>
 
+#include <algorithm>
+
 #ifdef EQUALIZER_USE_MAGELLAN_GLX
 #include <spnav.h>
 #endif
@@ -236,6 +238,9 @@ KeyModifier _getKeyModifiers(const unsigned int state)
 EventHandler::EventHandler(WindowIF* window)
     : _window(window)
     , _magellanUsed(false)
+    , _coalesce(window->getIAttribute(
+                    WindowSettings::IATTR_HINT_COALESCE_EVENTS) == ON)
+    , _nCoalesced(0)
 {
     LBASSERT(window);
 
@@ -276,6 +281,10 @@ EventHandler::EventHandler(WindowIF* window)
 
 EventHandler::~EventHandler()
 {
+    if (_nCoalesced > 0)
+        LBINFO << "Coalesced " << _nCoalesced << " events of window "
+               << _window->getXDrawable() << std::endl;
+
     if (_magellanUsed)
     {
 #ifdef EQUALIZER_USE_MAGELLAN_GLX
@@ -319,14 +328,132 @@ void EventHandler::_dispatch()
     if (!display)
         return;
 
+    bool coalescing = false;
+    for (const EventHandler* handler : *_eventHandlers)
+        coalescing = coalescing || handler->_coalesce;
+
+    if (!coalescing)
+    {
+        while (XPending(display))
+        {
+            XEvent event;
+            XNextEvent(display, &event);
+
+            for (EventHandler* handler : *_eventHandlers)
+                handler->_processEvent(event);
+        }
+        return;
+    }
+
+    // Drain the queue first to merge the events superseded by later events
+    std::vector<XEvent> events;
     while (XPending(display))
     {
-        XEvent event;
-        XNextEvent(display, &event);
+        events.resize(events.size() + 1);
+        XNextEvent(display, &events.back());
+    }
 
+    for (EventHandler* handler : *_eventHandlers)
+        if (handler->_coalesce)
+            handler->_nCoalesced +=
+                coalesce(events, handler->_window->getXDrawable());
+
+    for (const XEvent& event : events)
         for (EventHandler* handler : *_eventHandlers)
             handler->_processEvent(event);
+}
+
+namespace
+{
+enum EventKind
+{
+    KIND_OTHER,
+    KIND_MOTION,
+    KIND_CONFIGURE,
+    KIND_EXPOSE,
+    KIND_AXIS,
+    KIND_ALL
+};
+
+EventKind _getKind(const XEvent& event)
+{
+    switch (event.type)
+    {
+    case MotionNotify:
+        return KIND_MOTION;
+    case ConfigureNotify:
+        return KIND_CONFIGURE;
+    case Expose:
+        return KIND_EXPOSE;
+#ifdef EQUALIZER_USE_MAGELLAN_GLX
+    case ClientMessage:
+    {
+        spnav_event spev;
+        if (spnav_x11_event(&event, &spev) == SPNAV_EVENT_MOTION)
+            return KIND_AXIS;
+        return KIND_OTHER;
+    }
+#endif
+    default:
+        return KIND_OTHER;
+    }
+}
+
+#ifdef EQUALIZER_USE_MAGELLAN_GLX
+/** Add the space mouse motion of 'from' to 'to' (magellan X11 protocol). */
+void _addAxis(const XEvent& from, XEvent& to)
+{
+    for (size_t i = 2; i < 8; ++i)
+    {
+        const int sum = int(from.xclient.data.s[i]) + to.xclient.data.s[i];
+        to.xclient.data.s[i] = short(std::max(-32768, std::min(32767, sum)));
+    }
+}
+#endif
+}
+
+size_t EventHandler::coalesce(std::vector<XEvent>& events, const XID drawable)
+{
+    const size_t none = events.size();
+    size_t previous[KIND_ALL]; // last event of each kind in the current run
+    std::fill(previous, previous + KIND_ALL, none);
+
+    std::vector<bool> removed(events.size(), false);
+    size_t nRemoved = 0;
+    for (size_t i = 0; i < events.size(); ++i)
+    {
+        XEvent& event = events[i];
+        if (event.xany.window != drawable)
+            continue;
+
+        const EventKind kind = _getKind(event);
+        if (kind == KIND_OTHER) // keep order with button, key, ... events
+        {
+            std::fill(previous, previous + KIND_ALL, none);
+            continue;
+        }
+
+        if (previous[kind] != none)
+        {
+#ifdef EQUALIZER_USE_MAGELLAN_GLX
+            if (kind == KIND_AXIS)
+                _addAxis(events[previous[kind]], event);
+#endif
+            removed[previous[kind]] = true;
+            ++nRemoved;
+        }
+        previous[kind] = i;
     }
+
+    if (nRemoved == 0)
+        return 0;
+
+    size_t j = 0;
+    for (size_t i = 0; i < events.size(); ++i)
+        if (!removed[i])
+            events[j++] = events[i];
+    events.resize(j);
+    return nRemoved;
 }
 
 namespace
@@ -25,6 +25,8 @@
 
 #include <lunchbox/thread.h> // thread-safety macro
 
+#include <vector>
+
 namespace eq
 {
 namespace glx
@@ -48,10 +50,34 @@ public:
      */
     static void dispatch();
 
+    /**
+     * @internal
+     * Remove the events of a drawable superseded by a later event.
+     *
+     * Consecutive pointer motion, configure, expose and space mouse motion
+     * events of the drawable are merged into the last event of each run. Any
+     * other event of the drawable ends a run, which preserves the order of
+     * button and key events with respect to the pointer position. Space mouse
+     * motions are summed up. Events of other drawables are not modified.
+     *
+     * @param events the events to coalesce, in the order of their arrival.
+     * @param drawable the drawable whose events are coalesced.
+     * @return the number of removed events.
+     */
+    static EQ_API size_t coalesce(std::vector<XEvent>& events, XID drawable);
+
+    /**
+     * @return the number of events removed by coalescing for this window.
+     * @version 2.1
+     * @sa WindowSettings::IATTR_HINT_COALESCE_EVENTS
+     */
+    size_t getNumCoalesced() const { return _nCoalesced; }
 private:
     WindowIF* const _window;
 
     bool _magellanUsed; //!< Window registered with spnav
+    bool _coalesce;     //!< IATTR_HINT_COALESCE_EVENTS is on
+    size_t _nCoalesced; //!< Events removed by coalescing
 
     void _dispatch();
     bool _processEvent(const XEvent& event);
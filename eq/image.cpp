@@ -28,10 +28,10 @@
 
 #include <eq/fabric/renderContext.h>
 #include <eq/gl.h>
+#include <eq/util/bufferPool.h>
 #include <eq/util/frameBufferObject.h>
 #include <eq/util/objectManager.h>
 
-#include <lunchbox/buffer.h>
 #include <lunchbox/memoryMap.h>
 #include <pression/compressor.h>
 #include <pression/decompressor.h>
@@ -59,6 +59,69 @@ namespace eq
 {
 namespace
 {
+/**
+ * @internal Pixel memory from the util::BufferPool.
+ *
+ * Resizing does not preserve the content and keeps the memory while the size
+ * stays within its size class.
+ */
+class PixelBuffer
+{
+public:
+    PixelBuffer()
+        : _data(nullptr)
+        , _size(0)
+    {
+    }
+
+    PixelBuffer(const PixelBuffer& from)
+        : _data(nullptr)
+        , _size(0)
+    {
+        *this = from;
+    }
+
+    ~PixelBuffer() { clear(); }
+    PixelBuffer& operator=(const PixelBuffer& from)
+    {
+        if (this == &from)
+            return *this;
+        resize(from._size);
+        if (_size > 0)
+            memcpy(_data, from._data, _size);
+        return *this;
+    }
+
+    void* getData() { return _data; }
+    bool isEmpty() const { return _size == 0; }
+    void resize(const size_t size)
+    {
+        if (size == 0)
+        {
+            clear();
+            return;
+        }
+        if (!_data || util::BufferPool::getCapacity(size) !=
+                          util::BufferPool::getCapacity(_size))
+        {
+            clear();
+            _data = util::BufferPool::alloc(size);
+        }
+        _size = size;
+    }
+
+    void clear()
+    {
+        util::BufferPool::free(_data);
+        _data = nullptr;
+        _size = 0;
+    }
+
+private:
+    void* _data;
+    size_t _size;
+};
+
 /** @internal Raw image data. */
 struct Memory : public PixelData
 {
@@ -115,7 +178,7 @@ public:
     /** During the call of setPixelData or writeImage, we have to
      * manage an internal buffer to copy the data. Otherwise the downloader
      * allocates the memory. */
-    lunchbox::Bufferb localBuffer;
+    PixelBuffer localBuffer;
 
     bool hasAlpha; //!< The uncompressed pixels contain alpha
 };
@@ -1149,6 +1212,11 @@ const PixelData& Image::compressPixelData(const Frame::Buffer buffer)
     return memory;
 }
 
+void Image::invalidateCompressedData(const Frame::Buffer buffer)
+{
+    _impl->getMemory(buffer).compressedData = pression::CompressorResult();
+}
+
 //---------------------------------------------------------------------------
 // File IO
 //---------------------------------------------------------------------------
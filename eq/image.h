@@ -202,6 +202,14 @@ public:
     /** @return the pixel data, compressing it if needed. @version 1.0 */
     EQ_API const PixelData& compressPixelData(const Frame::Buffer);
 
+    /**
+     * Discard the compressed pixel data of the given buffer.
+     *
+     * The next compressPixelData() recompresses the current pixel data.
+     * @version 2.1
+     */
+    EQ_API void invalidateCompressedData(const Frame::Buffer buffer);
+
     /**
      * @return true if the image has valid pixel data for the buffer.
      * @version 1.0
@@ -39,6 +39,9 @@
 #ifdef WGL
 #include "wgl/windowSystem.h"
 #endif
+#ifdef EQ_EGL_USED
+#include "egl/windowSystem.h"
+#endif
 
 #include <co/global.h>
 #include <eq/fabric/configParams.h>
@@ -126,6 +129,9 @@ bool _init(const int argc, char** argv, NodeFactory* nodeFactory)
 #ifdef WGL
     WindowSystem::add(WindowSystemImpl(new wgl::WindowSystem));
 #endif
+#ifdef EQ_EGL_USED
+    WindowSystem::add(WindowSystemImpl(new egl::WindowSystem));
+#endif
 #ifdef EQUALIZER_USE_QT5WIDGETS
     if (QApplication::instance())
         WindowSystem::add(WindowSystemImpl(new qt::WindowSystem));
@@ -28,21 +28,33 @@
 #include "log.h"
 #include "nodeFactory.h"
 #include "nodeStatistics.h"
+#include "observer.h"
 #include "pipe.h"
 #include "server.h"
 
+#include "detail/numa.h"
+#include "detail/statisticBatch.h"
+
 #include <eq/fabric/axisEvent.h>
 #include <eq/fabric/buttonEvent.h>
 #include <eq/fabric/commands.h>
 #include <eq/fabric/elementVisitor.h>
 #include <eq/fabric/frameData.h>
 #include <eq/fabric/task.h>
+#include <eq/util/bufferPool.h>
 
 #include <co/barrier.h>
 #include <co/connection.h>
 #include <co/global.h>
 #include <co/objectICommand.h>
+#include <lunchbox/mtQueue.h>
 #include <lunchbox/scopedMutex.h>
+#include <lunchbox/spinLock.h>
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <thread>
 
 namespace eq
 {
@@ -50,6 +62,7 @@ namespace
 {
 typedef std::unordered_map<uint128_t, co::Barrier*> BarrierHash;
 typedef std::unordered_map<uint128_t, FrameDataPtr> FrameDataHash;
+typedef std::unordered_map<uint128_t, Matrix4f> HeadMatrixHash;
 typedef FrameDataHash::const_iterator FrameDataHashCIter;
 typedef FrameDataHash::iterator FrameDataHashIter;
 
@@ -86,6 +99,83 @@ private:
     co::CommandQueue _queue;
 };
 
+typedef std::function<void()> DecompressTask;
+typedef lunchbox::MTQueue<DecompressTask> DecompressQueue;
+
+/** Decodes received frame data images off the command thread. */
+class DecompressThread : public lunchbox::Thread
+{
+public:
+    DecompressThread(DecompressQueue& queue,
+                     const std::atomic<int32_t>& affinity)
+        : _queue(queue)
+        , _affinity(affinity)
+        , _applied(lunchbox::Thread::NONE)
+    {
+    }
+    virtual ~DecompressThread() {}
+protected:
+    bool init() override
+    {
+        setName("Decomp");
+        return true;
+    }
+
+    void run() override
+    {
+        while (true)
+        {
+            const DecompressTask task = _queue.pop();
+            if (!task)
+                return; // exit thread
+
+            // decoded images are allocated by this thread, place its memory
+            // once per affinity change instead of per image
+            const int32_t affinity = _affinity;
+            if (affinity != _applied)
+            {
+                lunchbox::Thread::setAffinity(affinity);
+                detail::numa::bindMemory(affinity);
+                _applied = affinity;
+            }
+            task();
+        }
+    }
+
+private:
+    DecompressQueue& _queue;
+    const std::atomic<int32_t>& _affinity;
+    int32_t _applied;
+};
+
+/** Finds the affinity shared by all pipe threads of a node. */
+class ThreadAffinityVisitor : public NodeVisitor
+{
+public:
+    ThreadAffinityVisitor()
+        : affinity(lunchbox::Thread::NONE)
+    {
+    }
+
+    VisitorResult visitPre(eq::Pipe* pipe) override
+    {
+        const int32_t pipeAffinity = pipe->_getAffinity();
+        if (pipeAffinity == lunchbox::Thread::NONE)
+            return TRAVERSE_PRUNE;
+
+        if (affinity == lunchbox::Thread::NONE)
+            affinity = pipeAffinity;
+        else if (affinity != pipeAffinity)
+        {
+            affinity = lunchbox::Thread::NONE;
+            return TRAVERSE_TERMINATE;
+        }
+        return TRAVERSE_PRUNE;
+    }
+
+    int32_t affinity;
+};
+
 class Node
 {
 public:
@@ -93,6 +183,8 @@ public:
         : state(STATE_STOPPED)
         , finishedFrame(0)
         , unlockedFrame(0)
+        , affinity(lunchbox::Thread::NONE)
+        , autoAffinity(false)
     {
     }
 
@@ -114,7 +206,50 @@ public:
     /** All frame datas used by the node during rendering. */
     lunchbox::Lockable<FrameDataHash> frameDatas;
 
+    /** The latest head matrices for late latching, by observer identifier. */
+    lunchbox::Lockable<HeadMatrixHash, lunchbox::SpinLock> latchedHeads;
+
     TransmitThread transmitter;
+
+    /** Pending image decompressions, consumed by the decompressors. */
+    DecompressQueue decompressQueue;
+
+    /** The worker pool decoding received images in parallel. */
+    std::vector<DecompressThread*> decompressors;
+
+    /** The affinity of the node threads, applied lazily by decompressors. */
+    std::atomic<int32_t> affinity;
+
+    /** Place the node threads with the pipe threads on the next frame. */
+    bool autoAffinity;
+
+    /** Statistics queued for the next batch sent to the application. */
+    lunchbox::Lockable<Statistics, lunchbox::SpinLock> statistics;
+
+    void startDecompressors()
+    {
+        LBASSERT(decompressors.empty());
+        const size_t nThreads =
+            std::max(1u, std::min(4u, std::thread::hardware_concurrency()));
+        for (size_t i = 0; i < nThreads; ++i)
+        {
+            decompressors.push_back(
+                new DecompressThread(decompressQueue, affinity));
+            decompressors.back()->start();
+        }
+    }
+
+    void stopDecompressors()
+    {
+        for (size_t i = 0; i < decompressors.size(); ++i)
+            decompressQueue.push(DecompressTask()); // wake up to exit
+        for (DecompressThread* thread : decompressors)
+        {
+            thread->join();
+            delete thread;
+        }
+        decompressors.clear();
+    }
 };
 }
 
@@ -302,20 +437,26 @@ void Node::_setAffinity()
         break;
 
     case AUTO:
-        // TODO
-        LBVERB << "No automatic thread placement for node threads "
-               << std::endl;
+        // the pipe threads are placed during their initialization
+        LBVERB << "Deferring thread placement for node threads" << std::endl;
+        _impl->autoAffinity = true;
         break;
 
     default:
-        co::LocalNodePtr node = getLocalNode();
-        send(node, fabric::CMD_NODE_SET_AFFINITY) << affinity;
-
-        node->setAffinity(affinity);
+        _applyAffinity(affinity);
         break;
     }
 }
 
+void Node::_applyAffinity(const int32_t affinity)
+{
+    co::LocalNodePtr node = getLocalNode();
+    send(node, fabric::CMD_NODE_SET_AFFINITY) << affinity;
+
+    node->setAffinity(affinity);
+    _impl->affinity = affinity;
+}
+
 void Node::waitFrameStarted(const uint32_t frameNumber) const
 {
     _impl->currentFrame.waitGE(frameNumber);
@@ -491,7 +632,47 @@ bool Node::processEvent(Statistic& event)
 {
     Config* config = getConfig();
     updateEvent(event, config->getTime());
-    config->sendEvent(EVENT_STATISTIC) << event;
+    queueStatistic(event);
+    return true;
+}
+
+void Node::queueStatistic(const Statistic& statistic)
+{
+    lunchbox::ScopedFastWrite mutex(_impl->statistics);
+    _impl->statistics->push_back(statistic);
+}
+
+void Node::_sendStatistics()
+{
+    Statistics statistics;
+    {
+        lunchbox::ScopedFastWrite mutex(_impl->statistics);
+        if (_impl->statistics->empty())
+            return;
+        statistics.swap(_impl->statistics.data);
+    }
+
+    std::vector<uint8_t> data;
+    detail::statisticBatch::encode(statistics, data);
+    getConfig()->sendEvent(EVENT_STATISTICS) << data;
+}
+
+void Node::setLatchedHeadMatrix(const Observer& observer,
+                                const Matrix4f& head)
+{
+    lunchbox::ScopedFastWrite mutex(_impl->latchedHeads);
+    _impl->latchedHeads.data[observer.getID()] = head;
+}
+
+bool Node::getLatchedHeadMatrix(const Observer& observer, Matrix4f& head) const
+{
+    lunchbox::ScopedFastRead mutex(_impl->latchedHeads);
+    HeadMatrixHash::const_iterator i =
+        _impl->latchedHeads->find(observer.getID());
+    if (i == _impl->latchedHeads->end())
+        return false;
+
+    head = i->second;
     return true;
 }
 
@@ -541,6 +722,7 @@ void Node::dirtyClientExit()
     }
     getTransmitterQueue()->push(co::ICommand()); // wake up to exit
     _impl->transmitter.join();
+    _impl->stopDecompressors();
 }
 
 //---------------------------------------------------------------------------
@@ -608,6 +790,7 @@ bool Node::_cmdConfigInit(co::ICommand& cmd)
     _setAffinity();
 
     _impl->transmitter.start();
+    _impl->startDecompressors();
     const uint64_t result = configInit(initID);
 
     if (getIAttribute(IATTR_THREAD_MODEL) == eq::UNDEFINED)
@@ -637,6 +820,8 @@ bool Node::_cmdConfigExit(co::ICommand& cmd)
     _impl->state = configExit() ? STATE_STOPPED : STATE_FAILED;
     getTransmitterQueue()->push(co::ICommand()); // wake up to exit
     _impl->transmitter.join();
+    _impl->stopDecompressors();
+    _sendStatistics();
     _flushObjects();
 
     getConfig()->send(getLocalNode(), fabric::CMD_CONFIG_DESTROY_NODE)
@@ -661,6 +846,22 @@ bool Node::_cmdFrameStart(co::ICommand& cmd)
 
     LBLOG(LOG_TASKS) << "----- Begin Frame ----- " << frameNumber << std::endl;
 
+    if (_impl->autoAffinity)
+    {
+        // Co-locate the transmit, receive and decompression threads with the
+        // pipe threads, if all of them run on the same socket.
+        _impl->autoAffinity = false;
+        detail::ThreadAffinityVisitor visitor;
+        accept(visitor);
+        if (visitor.affinity != lunchbox::Thread::NONE)
+        {
+            LBINFO << "Placing threads of node " << getName()
+                   << " with its pipes on affinity " << visitor.affinity
+                   << std::endl;
+            _applyAffinity(visitor.affinity);
+        }
+    }
+
     Config* config = getConfig();
 
     if (configVersion != co::VERSION_INVALID)
@@ -689,6 +890,8 @@ bool Node::_cmdFrameFinish(co::ICommand& cmd)
 
     _finishFrame(frameNumber);
     _frameFinish(frameID, frameNumber);
+    _sendStatistics();
+    util::BufferPool::trim(frameNumber);
 
     const uint128_t version = commit();
     if (version != co::VERSION_NONE)
@@ -747,13 +950,27 @@ bool Node::_cmdFrameDataTransmit(co::ICommand& cmd)
     FrameDataPtr frameData = getFrameData(frameDataVersion);
     LBASSERT(!frameData->isReady());
 
-    NodeStatistics event(Statistic::NODE_FRAME_DECOMPRESS, this, frameNumber);
-
-    // Note on the const_cast: since the PixelData structure stores non-const
-    // pointers, we have to go non-const at some point, even though we do not
-    // modify the data.
-    LBCHECK(frameData->addImage(frameDataVersion, pvp, zoom, context, buffers,
-                                useAlpha, const_cast<uint8_t*>(data)));
+    // Decode on the worker pool, so that images arriving from multiple sources
+    // decompress in parallel. The task holds a reference to the command, which
+    // keeps the received buffer alive until the image has been decoded.
+    const uint64_t version = frameDataVersion.version.low();
+    frameData->startDecode(version);
+    _impl->decompressQueue.push([this, cmd, frameData, frameDataVersion, pvp,
+                                 version, zoom, context, buffers, frameNumber,
+                                 useAlpha, data]() {
+        {
+            NodeStatistics event(Statistic::NODE_FRAME_DECOMPRESS, this,
+                                 frameNumber);
+
+            // Note on the const_cast: since the PixelData structure stores
+            // non-const pointers, we have to go non-const at some point, even
+            // though we do not modify the data.
+            LBCHECK(frameData->addImage(frameDataVersion, pvp, zoom, context,
+                                        buffers, useAlpha,
+                                        const_cast<uint8_t*>(data)));
+        }
+        frameData->finishDecode(version);
+    });
     return true;
 }
 
@@ -771,8 +988,8 @@ bool Node::_cmdFrameDataReady(co::ICommand& cmd)
     FrameDataPtr frameData = getFrameData(frameDataVersion);
     LBASSERT(frameData);
     LBASSERT(!frameData->isReady());
+    // becomes ready once all images of this version have been decoded
     frameData->setReady(frameDataVersion, data);
-    LBASSERT(frameData->isReady());
     return true;
 }
 
@@ -92,6 +92,15 @@ public:
     /** @internal Release the frame data instance. */
     void releaseFrameData(FrameDataPtr data);
 
+    /**
+     * @internal
+     * Queue a statistic for the application node.
+     *
+     * Thread-safe. The queued statistics are sent in one batch at the end of
+     * each frame.
+     */
+    void queueStatistic(const Statistic& statistic);
+
     /** @internal Wait for the node to be initialized. */
     EQ_API void waitInitialized() const;
 
@@ -142,8 +151,52 @@ public:
      */
     EQ_API virtual bool processEvent(AxisEvent& event);
     EQ_API virtual bool processEvent(ButtonEvent& event);
+
+    /**
+     * Process a statistic event.
+     *
+     * The default implementation queues the statistic, which is sent to the
+     * application with all statistics of this node at the end of the frame.
+     *
+     * @param event the statistic event.
+     * @return true if the event was handled, false if not.
+     * @version 1.5.2
+     */
     EQ_API virtual bool processEvent(Statistic& event);
 
+    /**
+     * Provide the latest tracked head matrix of an observer for late latching.
+     *
+     * Thread-safe, to be called by a node-local tracker source whenever a new
+     * sample is available. Once a head matrix is set for an observer, the
+     * channels of this node recompute their frusta for the latest head matrix
+     * just before each frameDraw, instead of using the frusta computed by the
+     * server at the start of the frame. This requires the observer to use the
+     * fixed focus mode.
+     *
+     * @param observer the tracked observer.
+     * @param head the latest head matrix.
+     * @version 2.1
+     */
+    EQ_API void setLatchedHeadMatrix(const Observer& observer,
+                                     const Matrix4f& head);
+
+    /**
+     * Get the head matrix of an observer for late latching.
+     *
+     * Called from the pipe threads before each frameDraw. The default
+     * implementation returns the latest matrix set using
+     * setLatchedHeadMatrix(). Implementations have to be thread-safe.
+     *
+     * @param observer the observer of the destination view.
+     * @param head the returned head matrix.
+     * @return true if a head matrix is available, false to use the frusta
+     *         computed by the server.
+     * @version 2.1
+     */
+    EQ_API virtual bool getLatchedHeadMatrix(const Observer& observer,
+                                             Matrix4f& head) const;
+
     /** @internal @sa Serializable::setDirty() */
     EQ_API void setDirty(const uint64_t bits) override;
 
@@ -270,11 +323,13 @@ private:
     detail::Node* const _impl;
 
     void _setAffinity();
+    void _applyAffinity(int32_t affinity);
 
     void _finishFrame(const uint32_t frameNumber) const;
     void _frameFinish(const uint128_t& frameID, const uint32_t frameNumber);
 
     void _flushObjects();
+    void _sendStatistics();
 
     /** The command functions. */
     bool _cmdCreatePipe(co::ICommand& command);
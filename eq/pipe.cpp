@@ -40,6 +40,7 @@
 #include "view.h"
 #include "window.h"
 
+#include "detail/numa.h"
 #include "messagePump.h"
 #include "systemPipe.h"
 
@@ -127,6 +128,7 @@ class TransferThread : public co::Worker
 public:
     explicit TransferThread(const uint32_t index)
         : co::Worker(co::Global::getCommandQueueLimit())
+        , affinity(lunchbox::Thread::NONE)
         , _index(index)
         , _qThread(nullptr)
         , _stop(false)
@@ -138,6 +140,10 @@ public:
         if (!co::Worker::init())
             return false;
         setName(std::string("Tfer") + boost::lexical_cast<std::string>(_index));
+
+        // co-locate with the pipe thread, the readback images are shared
+        lunchbox::Thread::setAffinity(affinity);
+        numa::bindMemory(affinity);
 #ifdef EQ_QT_USED
         _qThread = QThread::currentThread();
 #endif
@@ -147,6 +153,8 @@ public:
     bool stopRunning() override { return _stop; }
     void postStop() { _stop = true; }
     QThread* getQThread() { return _qThread; }
+    int32_t affinity; //!< The affinity of the pipe thread
+
 private:
     uint32_t _index;
     QThread* _qThread;
@@ -170,6 +178,7 @@ public:
         , state(STATE_STOPPED)
         , currentFrame(0)
         , frameTime(0)
+        , affinity(lunchbox::Thread::NONE)
         , thread(0)
         , transferThread(index)
     {
@@ -221,6 +230,9 @@ public:
     /** All queues used by the pipe's channels during rendering. */
     QueueHash queues;
 
+    /** The affinity applied to the pipe thread. */
+    int32_t affinity;
+
     /** The pipe thread. */
     RenderThread* thread;
 
@@ -333,6 +345,9 @@ bool Pipe::isWindowSystemAvailable(const std::string& name) const
         available = name == "GLX";
 #elif WGL
         available = name == "WGL";
+#endif
+#ifdef EQ_EGL_USED
+        available = available || name == "EGL";
 #endif
     }
 
@@ -391,6 +406,17 @@ bool Pipe::isWindowSystemAvailable(const std::string& name) const
 
 WindowSystem Pipe::selectWindowSystem() const
 {
+    // Explicit choice, e.g., EGL for headless render nodes. Never selected
+    // implicitly, a missing DISPLAY is reported by the default window system.
+    const char* name = getenv("EQ_WINDOW_SYSTEM");
+    if (name)
+    {
+        if (WindowSystem::supports(name) && isWindowSystemAvailable(name))
+            return WindowSystem(name);
+        LBWARN << "Ignoring unavailable window system " << name
+               << " from EQ_WINDOW_SYSTEM" << std::endl;
+    }
+
 #ifdef AGL
     return WindowSystem("AGL");
 #elif GLX
@@ -529,14 +555,25 @@ void Pipe::_setupAffinity()
     switch (affinity)
     {
     case AUTO:
-        lunchbox::Thread::setAffinity(_getAutoAffinity());
+        _impl->affinity = _getAutoAffinity();
         break;
 
     case OFF:
     default:
-        lunchbox::Thread::setAffinity(affinity);
+        _impl->affinity = affinity;
         break;
     }
+
+    // place the images read back by this pipe on the memory next to its GPU
+    lunchbox::Thread::setAffinity(_impl->affinity);
+    if (detail::numa::bindMemory(_impl->affinity))
+        LBINFO << "Pipe " << getName() << " memory bound to the NUMA nodes of "
+               << "affinity " << _impl->affinity << std::endl;
+}
+
+int32_t Pipe::_getAffinity() const
+{
+    return _impl->affinity;
 }
 
 void Pipe::_exitCommandQueue()
@@ -547,6 +584,13 @@ void Pipe::_exitCommandQueue()
 
     CommandQueue* queue = _impl->thread->getWorkerQueue();
     LBASSERT(queue);
+    if (queue->hasStatistics())
+    {
+        std::ostringstream os;
+        queue->dumpStatistics(os);
+        LBINFO << "Command statistics of pipe " << getName() << std::endl
+               << os.str();
+    }
 
     MessagePump* pump = queue->getMessagePump();
     queue->setMessagePump(0);
@@ -904,7 +948,7 @@ bool Pipe::processEvent(Statistic& event)
 {
     Config* config = getConfig();
     updateEvent(event, config->getTime());
-    config->sendEvent(EVENT_STATISTIC) << event;
+    getNode()->queueStatistic(event);
     return true;
 }
 
@@ -1043,6 +1087,7 @@ bool Pipe::startTransferThread()
     if (_impl->transferThread.isRunning())
         return true;
 
+    _impl->transferThread.affinity = _impl->affinity;
     return _impl->transferThread.start();
 }
 
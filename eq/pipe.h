@@ -370,6 +370,9 @@ private:
 
     /** @internal @return lunchbox::Thread::Affinity mask for this GPU.  */
     EQ_API int32_t _getAutoAffinity() const;
+
+    /** @internal @return the affinity applied to the pipe threads. */
+    int32_t _getAffinity() const;
     friend class detail::ThreadAffinityVisitor;
 
     // friend class Window;
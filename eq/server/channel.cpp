@@ -439,9 +439,9 @@ void Channel::removeListener(ChannelListener* listener)
         _listeners.erase(i);
 }
 
-void Channel::_fireLoadData(const uint32_t frameNumber,
-                            const fabric::Statistics& statistics,
-                            const Viewport& region)
+void Channel::fireLoadData(const uint32_t frameNumber,
+                           const fabric::Statistics& statistics,
+                           const Viewport& region)
 {
     LB_TS_SCOPED(_serverThread);
     for (ChannelListener* listener : _listeners)
@@ -480,7 +480,7 @@ bool Channel::_cmdFrameFinishReply(co::ICommand& cmd)
     const uint32_t frameNumber = command.read<uint32_t>();
     const Statistics& statistics = command.read<Statistics>();
 
-    _fireLoadData(frameNumber, statistics, region);
+    fireLoadData(frameNumber, statistics, region);
     return true;
 }
 
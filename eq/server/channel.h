@@ -170,6 +170,10 @@ public:
     void removeListener(ChannelListener* listener);
     /** @return true if the channel has listeners */
     bool hasListeners() const { return !_listeners.empty(); }
+    /** Notify all channel listeners of the statistics of a finished frame. */
+    EQSERVER_API void fireLoadData(const uint32_t frameNumber,
+                                   const Statistics& statistics,
+                                   const Viewport& region);
     //@}
 
     bool omitOutput() const;          //!< @internal
@@ -211,9 +215,6 @@ private:
 
     void _setupRenderContext(const uint128_t& frameID, RenderContext& context);
 
-    void _fireLoadData(const uint32_t frameNumber, const Statistics& statistics,
-                       const Viewport& region);
-
     /* command handler functions. */
     bool _cmdConfigInitReply(co::ICommand& command);
     bool _cmdConfigExitReply(co::ICommand& command);
@@ -0,0 +1,131 @@
+
+/* Copyright (c) 2026, The Equalizer authors, see AUTHORS
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "compositingSchedule.h"
+
+#include <lunchbox/debug.h>
+
+#include <algorithm>
+
+namespace eq
+{
+namespace server
+{
+namespace
+{
+CompositingSchedule::Radices _factorize(size_t n)
+{
+    CompositingSchedule::Radices factors;
+    for (size_t factor = 2; factor * factor <= n; ++factor)
+    {
+        while (n % factor == 0)
+        {
+            factors.push_back(factor);
+            n /= factor;
+        }
+    }
+    if (n > 1)
+        factors.push_back(n);
+    return factors;
+}
+}
+
+CompositingSchedule::CompositingSchedule(const size_t nSources,
+                                         const Radices& radices)
+    : _nSources(nSources)
+    , _radices(radices)
+{
+#ifndef NDEBUG
+    size_t product = 1;
+    for (const size_t radix : radices)
+        product *= radix;
+    LBASSERTINFO(product == nSources, product << " != " << nSources);
+#endif
+
+    // The source index is a mixed-radix number, the members of a group in
+    // round r differ only in digit r.
+    std::vector<Region> regions(nSources);
+    size_t stride = 1;
+    for (const size_t radix : _radices)
+    {
+        const std::vector<Region> previous = regions;
+        Transfers transfers;
+
+        for (size_t i = 0; i < nSources; ++i)
+        {
+            const size_t digit = (i / stride) % radix;
+            const size_t base = i - digit * stride;
+            const Region& current = previous[i];
+            const uint32_t size = current.end - current.start;
+
+            const Region own(current.start + uint32_t(size * digit / radix),
+                             current.start +
+                                 uint32_t(size * (digit + 1) / radix));
+            regions[i] = own;
+
+            for (size_t j = 0; j < radix; ++j)
+            {
+                if (j == digit)
+                    continue;
+
+                Transfer transfer;
+                transfer.from = base + j * stride;
+                transfer.to = i;
+                transfer.region = own;
+                transfers.push_back(transfer);
+            }
+        }
+
+        _transfers.push_back(transfers);
+        _regions.push_back(regions);
+        stride *= radix;
+    }
+
+    if (_regions.empty()) // single source
+        _regions.push_back(regions);
+}
+
+CompositingSchedule::Radices CompositingSchedule::getBinarySwapRadices(
+    const size_t n)
+{
+    return _factorize(n);
+}
+
+CompositingSchedule::Radices CompositingSchedule::getRadixKRadices(
+    const size_t n, const size_t k)
+{
+    // Greedily combine the prime factors, largest first, into radices <= k
+    Radices factors = _factorize(n);
+    std::sort(factors.rbegin(), factors.rend());
+
+    Radices radices;
+    for (const size_t factor : factors)
+    {
+        Radices::iterator i = radices.begin();
+        for (; i != radices.end(); ++i)
+            if (*i * factor <= k)
+                break;
+
+        if (i == radices.end())
+            radices.push_back(factor);
+        else
+            *i *= factor;
+    }
+    return radices;
+}
+}
+}
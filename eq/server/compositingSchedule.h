@@ -0,0 +1,138 @@
+
+/* Copyright (c) 2026, The Equalizer authors, see AUTHORS
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQSERVER_COMPOSITINGSCHEDULE_H
+#define EQSERVER_COMPOSITINGSCHEDULE_H
+
+#include <eq/server/api.h>
+
+#include <cstddef>
+#include <iostream>
+#include <stdint.h>
+#include <vector>
+
+namespace eq
+{
+namespace server
+{
+/**
+ * A parallel sort-last compositing schedule for N sources.
+ *
+ * The schedule is a radix-k exchange: in each round, the sources are grouped
+ * by the given radix, each group member takes ownership of one horizontal
+ * stripe of the group's current image region and receives this stripe from
+ * all other group members. After the last round, each source owns and has
+ * composited 1/N of the final image. Binary-swap is radix-k with all radices
+ * being two, direct send is a single round with a radix of N.
+ */
+class CompositingSchedule
+{
+public:
+    /** The resolution of the stripe boundaries. */
+    static const uint32_t UNIT = 100000;
+
+    /** A horizontal image stripe [start, end[, in UNITs of the height. */
+    struct Region
+    {
+        Region()
+            : start(0)
+            , end(UNIT)
+        {
+        }
+        Region(const uint32_t s, const uint32_t e)
+            : start(s)
+            , end(e)
+        {
+        }
+        bool operator==(const Region& rhs) const
+        {
+            return start == rhs.start && end == rhs.end;
+        }
+
+        uint32_t start;
+        uint32_t end;
+    };
+
+    /** One image transfer from one source to another within a round. */
+    struct Transfer
+    {
+        size_t from;   //!< index of the sending source
+        size_t to;     //!< index of the receiving source
+        Region region; //!< the stripe sent, owned by 'to' after the round
+    };
+    typedef std::vector<Transfer> Transfers;
+    typedef std::vector<size_t> Radices;
+
+    /**
+     * Create a new schedule.
+     *
+     * The product of all radices has to be equal to the number of sources.
+     */
+    EQSERVER_API CompositingSchedule(size_t nSources, const Radices& radices);
+
+    /**
+     * @return binary-swap radices for n sources. Non-power-of-two source
+     *         counts use the remaining odd prime factors as additional radices.
+     */
+    EQSERVER_API static Radices getBinarySwapRadices(size_t n);
+
+    /**
+     * @return radix-k radices for n sources, using factors of n which are as
+     *         large as possible but not larger than k, unless n has a larger
+     *         prime factor.
+     */
+    EQSERVER_API static Radices getRadixKRadices(size_t n, size_t k);
+
+    /** @return the number of sources. */
+    size_t getNumSources() const { return _nSources; }
+
+    /** @return the number of rounds. */
+    size_t getNumRounds() const { return _radices.size(); }
+
+    /** @return the transfers of the given round. */
+    const Transfers& getTransfers(const size_t round) const
+    {
+        return _transfers[round];
+    }
+
+    /** @return the region owned by a source after the given round. */
+    const Region& getRegion(const size_t round, const size_t source) const
+    {
+        return _regions[round][source];
+    }
+
+    /** @return the final region composited by a source. */
+    const Region& getRegion(const size_t source) const
+    {
+        return _regions.back()[source];
+    }
+
+private:
+    size_t _nSources;
+    Radices _radices;
+    std::vector<Transfers> _transfers;
+    std::vector<std::vector<Region>> _regions;
+};
+
+inline std::ostream& operator<<(std::ostream& os,
+                                const CompositingSchedule::Region& region)
+{
+    return os << "[ " << region.start << ' ' << region.end << " ]";
+}
+}
+}
+#endif // EQSERVER_COMPOSITINGSCHEDULE_H
@@ -539,180 +539,221 @@ RenderContext Compound::setupRenderContext(const Eye eye) const
 //---------------------------------------------------------------------------
 void Compound::setWall(const Wall& wall)
 {
+    _frustumInput = FrustumInput();
     _frustum.setWall(wall);
     LBVERB << "Wall: " << _data.frustumData << std::endl;
 }
 
 void Compound::setProjection(const Projection& projection)
 {
+    _frustumInput = FrustumInput();
     _frustum.setProjection(projection);
     LBVERB << "Projection: " << _data.frustumData << std::endl;
 }
 
+Compound::FrustumInput::FrustumInput()
+    : fromView(false)
+    , type(Frustum::TYPE_NONE)
+    , modelUnit(1.f)
+    , ratio(1.f)
+{
+}
+
+bool Compound::FrustumInput::operator==(const FrustumInput& rhs) const
+{
+    // exact comparison, the Wall and Projection operators use a tolerance
+    return fromView == rhs.fromView && type == rhs.type &&
+           wall.bottomLeft == rhs.wall.bottomLeft &&
+           wall.bottomRight == rhs.wall.bottomRight &&
+           wall.topLeft == rhs.wall.topLeft && wall.type == rhs.wall.type &&
+           projection.origin == rhs.projection.origin &&
+           projection.distance == rhs.projection.distance &&
+           projection.fov == rhs.projection.fov &&
+           projection.hpr == rhs.projection.hpr && coverage == rhs.coverage &&
+           viewVP == rhs.viewVP && segmentVP == rhs.segmentVP &&
+           overdraw == rhs.overdraw && pvp == rhs.pvp &&
+           modelUnit == rhs.modelUnit && eye == rhs.eye && ratio == rhs.ratio;
+}
+
 void Compound::updateFrustum(const Vector3f& eye, const float ratio)
+{
+    updateFrusta(Compounds(1, this), eye, ratio);
+}
+
+void Compound::updateFrusta(const Compounds& compounds, const Vector3f& eye,
+                            const float ratio)
+{
+    // Gather serially, segments inherit their frustum from the canvas
+    Compounds changed;
+    std::vector<FrustumInput> inputs;
+    for (Compound* compound : compounds)
+    {
+        FrustumInput input;
+        if (compound->_getFrustumInput(eye, ratio, input) &&
+            input != compound->_frustumInput)
+        {
+            changed.push_back(compound);
+            inputs.push_back(input);
+        }
+    }
+
+    const int nChanged = int(changed.size());
+    std::vector<Wall> walls(nChanged);
+    std::vector<Vector4i> overdraws(nChanged);
+#pragma omp parallel for if (nChanged > 16)
+    for (int i = 0; i < nChanged; ++i)
+        overdraws[i] = _computeWall(inputs[i], walls[i]);
+
+    for (int i = 0; i < nChanged; ++i)
+        changed[i]->_applyFrustum(inputs[i], walls[i], overdraws[i]);
+}
+
+bool Compound::_getFrustumInput(const Vector3f& eye, const float ratio,
+                                FrustumInput& input)
 {
     if (!isDestination()) // only set view/segment frusta on destination
-        return;
+        return false;
 
     Channel* channel = getChannel();
     Segment* segment = channel->getSegment();
     const View* view = channel->getView();
     if (!segment || !view)
-        return;
+        return false;
+
+    input.viewVP = view->getViewport();
+    input.segmentVP = segment->getViewport();
+    input.overdraw = view->getOverdraw();
+    input.pvp = channel->getPixelViewport();
+    input.modelUnit = view->getModelUnit();
+    input.eye = eye;
+    input.ratio = ratio;
 
     if (view->getCurrentType() != Frustum::TYPE_NONE) // frustum from view:
     {
-        // set compound frustum =
-        //         segment frustum X channel/view coverage
-        const Viewport& segmentVP = segment->getViewport();
-        const Viewport& viewVP = view->getViewport();
-        const Viewport coverage = viewVP.getCoverage(segmentVP);
-
-        Wall wall(view->getWall());
-
-        wall.apply(coverage);
-        wall.moveFocus(eye, ratio);
-        _updateOverdraw(wall);
-        wall.scale(view->getModelUnit());
-
-        switch (view->getCurrentType())
-        {
-        case Frustum::TYPE_WALL:
-            setWall(wall);
-            LBLOG(LOG_VIEW) << "View wall for " << channel->getName() << ": "
-                            << wall << std::endl;
-            return;
-
-        case Frustum::TYPE_PROJECTION:
-        {
-            Projection projection(view->getProjection()); // keep distance
-            projection = wall;
-            setProjection(projection);
-            LBLOG(LOG_VIEW) << "View projection for " << channel->getName()
-                            << ": " << projection << std::endl;
-            return;
-        }
-
-        default:
-            LBUNIMPLEMENTED;
-        }
+        // compound frustum = segment frustum X channel/view coverage
+        input.fromView = true;
+        input.type = view->getCurrentType();
+        input.wall = view->getWall();
+        input.projection = view->getProjection();
+        input.coverage = input.viewVP.getCoverage(input.segmentVP);
+        return true;
     }
     // else frustum from segment
 
     segment->inheritFrustum();
 
-    // set compound frustum =
-    //         segment frustum X channel/segment coverage
+    // compound frustum = segment frustum X channel/segment coverage
     const Channel* outputChannel = segment->getChannel();
     LBASSERT(outputChannel);
 
     const Viewport& outputVP = outputChannel->getViewport();
     const Viewport& channelVP = channel->getViewport();
-    const Viewport coverage = outputVP.getCoverage(channelVP);
 
-    Wall wall(segment->getWall());
-    wall.moveFocus(eye, ratio);
-    wall.apply(coverage);
-    _updateOverdraw(wall);
-    wall.scale(view->getModelUnit());
+    input.fromView = false;
+    input.type = segment->getCurrentType();
+    input.wall = segment->getWall();
+    input.projection = segment->getProjection();
+    input.coverage = outputVP.getCoverage(channelVP);
+    return true;
+}
 
-    switch (segment->getCurrentType())
+Vector4i Compound::_computeWall(const FrustumInput& input, Wall& wall)
+{
+    wall = input.wall;
+    if (input.fromView)
     {
-    case Frustum::TYPE_WALL:
+        wall.apply(input.coverage);
+        wall.moveFocus(input.eye, input.ratio);
+    }
+    else
     {
-        setWall(wall);
-        LBLOG(LOG_VIEW) << "Segment wall for " << channel->getName() << ": "
-                        << wall << std::endl;
-        return;
+        wall.moveFocus(input.eye, input.ratio);
+        wall.apply(input.coverage);
     }
 
+    const Vector4i& overdraw = _computeOverdraw(input, wall);
+    wall.scale(input.modelUnit);
+    return overdraw;
+}
+
+void Compound::_applyFrustum(const FrustumInput& input, const Wall& wall,
+                             const Vector4i& overdraw)
+{
+    Channel* channel = getChannel();
+    channel->setOverdraw(overdraw);
+
+    const char* const source = input.fromView ? "View" : "Segment";
+    switch (input.type)
+    {
+    case Frustum::TYPE_WALL:
+        setWall(wall);
+        LBLOG(LOG_VIEW) << source << " wall for " << channel->getName()
+                        << ": " << wall << std::endl;
+        break;
+
     case Frustum::TYPE_PROJECTION:
     {
-        Projection projection(segment->getProjection());
+        Projection projection(input.projection); // keep distance
         projection = wall;
         setProjection(projection);
-        LBLOG(LOG_VIEW) << "Segment projection for " << channel->getName()
+        LBLOG(LOG_VIEW) << source << " projection for " << channel->getName()
                         << ": " << projection << std::endl;
-        return;
+        break;
     }
+
     default:
         LBUNIMPLEMENTED;
+        return;
     }
+    _frustumInput = input;
 }
 
 void Compound::_computeFrustum(RenderContext& context) const
 {
-    // compute eye position in screen space
-    const Vector3f& eyeWorld = _getEyePosition(context.eye);
-    const FrustumData& frustumData = _inherit.frustumData;
-    const Matrix4f& xfm = frustumData.getTransform();
-    const Vector3f eyeWall = xfm * eyeWorld;
+    FrustumSetup& setup = context.frustumSetup;
+    _setupFrustum(setup);
 
-    LBVERB << "Eye position world: " << eyeWorld << " wall " << eyeWall
-           << std::endl;
-    _computePerspective(context, eyeWall);
-    _computeOrtho(context, eyeWall);
+    const Channel* destination = getInheritChannel();
+    context.frustum = destination->getFrustum();
+    context.ortho = destination->getFrustum();
+
+    const Vector3f& eyeWorld = _getEyePosition(context.eye);
+    LBVERB << "Eye position world: " << eyeWorld << " wall "
+           << setup.transform * eyeWorld << std::endl;
+    setup.compute(context, eyeWorld, _getEyePosition(EYE_CYCLOP),
+                  _getInverseHeadMatrix());
 }
 
 void Compound::computeTileFrustum(Frustumf& frustum, const Eye eye, Viewport vp,
                                   bool ortho) const
 {
-    const Vector3f& eyeWorld = _getEyePosition(eye);
-    const FrustumData& frustumData = _inherit.frustumData;
-    const Matrix4f& xfm = frustumData.getTransform();
-    const Vector3f eyeWall = xfm * eyeWorld;
-
-    _computeFrustumCorners(frustum, frustumData, eyeWall, ortho, &vp);
-}
-
-namespace
-{
-static void _computeHeadTransform(Matrix4f& result, const Matrix4f& xfm,
-                                  const Vector3f& eye)
-{
-    // headTransform = -trans(eye) * view matrix (frustum position)
-    for (int i = 0; i < 16; i += 4)
-    {
-        result.array[i] = xfm.array[i] - eye[0] * xfm.array[i + 3];
-        result.array[i + 1] = xfm.array[i + 1] - eye[1] * xfm.array[i + 3];
-        result.array[i + 2] = xfm.array[i + 2] - eye[2] * xfm.array[i + 3];
-        result.array[i + 3] = xfm.array[i + 3];
-    }
-}
-}
-
-void Compound::_computePerspective(RenderContext& context,
-                                   const Vector3f& eye) const
-{
-    const FrustumData& frustumData = _inherit.frustumData;
-
-    _computeFrustumCorners(context.frustum, frustumData, eye, false);
-    _computeHeadTransform(context.headTransform, frustumData.getTransform(),
-                          eye);
+    FrustumSetup setup;
+    _setupFrustum(setup);
 
-    const bool isHMD = (frustumData.getType() != Wall::TYPE_FIXED);
-    if (isHMD)
-        context.headTransform *= _getInverseHeadMatrix();
+    const Vector3f eyeWall = setup.transform * _getEyePosition(eye);
+    frustum = getInheritChannel()->getFrustum();
+    setup.computeCorners(frustum, eyeWall, ortho, getInheritPixel(), vp);
 }
 
-void Compound::_computeOrtho(RenderContext& context, const Vector3f& eye) const
+void Compound::_setupFrustum(FrustumSetup& setup) const
 {
-    // Compute corners for cyclop eye without perspective correction:
-    const Vector3f& cyclopWorld = _getEyePosition(EYE_CYCLOP);
     const FrustumData& frustumData = _inherit.frustumData;
-    const Matrix4f& xfm = frustumData.getTransform();
-    const Vector3f cyclopWall = xfm * cyclopWorld;
-
-    _computeFrustumCorners(context.ortho, frustumData, cyclopWall, true);
-    _computeHeadTransform(context.orthoTransform, xfm, eye);
+    const Channel* destination = getInheritChannel();
+    const PixelViewport& destPVP = destination->getPixelViewport();
+    const View* view = destination->getView();
+    const Observer* observer = view ? view->getObserver() : 0;
 
-    // Apply stereo shearing
-    context.orthoTransform.array[8] += (cyclopWall[0] - eye[0]) / eye[2];
-    context.orthoTransform.array[9] += (cyclopWall[1] - eye[1]) / eye[2];
+    setup.transform = frustumData.getTransform();
+    setup.destination = Vector2i(destPVP.w, destPVP.h);
+    setup.width = frustumData.getWidth();
+    setup.height = frustumData.getHeight();
+    setup.modelUnit = view ? view->getModelUnit() : 1.f;
+    setup.type = frustumData.getType();
 
-    const bool isHMD = (frustumData.getType() != Wall::TYPE_FIXED);
-    if (isHMD)
-        context.orthoTransform *= _getInverseHeadMatrix();
+    // Render clients may only recompute the frusta if the wall does not
+    // depend on the head position.
+    setup.latchable =
+        observer && observer->getFocusMode() == fabric::FOCUSMODE_FIXED;
 }
 
 Vector3f Compound::_getEyePosition(const Eye eye) const
@@ -758,92 +799,11 @@ const Matrix4f& Compound::_getInverseHeadMatrix() const
     return identity;
 }
 
-void Compound::_computeFrustumCorners(Frustumf& frustum,
-                                      const FrustumData& frustumData,
-                                      const Vector3f& eye, const bool ortho,
-                                      const Viewport* const invp) const
-{
-    const Channel* destination = getInheritChannel();
-    frustum = destination->getFrustum();
-
-    const float ratio = ortho ? 1.0f : frustum.nearPlane() / eye.z();
-    const float width_2 = frustumData.getWidth() * .5f;
-    const float height_2 = frustumData.getHeight() * .5f;
-
-    if (eye.z() > 0 || ortho)
-    {
-        frustum.left() = (-width_2 - eye.x()) * ratio;
-        frustum.right() = (width_2 - eye.x()) * ratio;
-        frustum.bottom() = (-height_2 - eye.y()) * ratio;
-        frustum.top() = (height_2 - eye.y()) * ratio;
-    }
-    else // eye behind near plane - 'mirror' x
-    {
-        frustum.left() = (width_2 - eye.x()) * ratio;
-        frustum.right() = (-width_2 - eye.x()) * ratio;
-        frustum.bottom() = (height_2 + eye.y()) * ratio;
-        frustum.top() = (-height_2 + eye.y()) * ratio;
-    }
-
-    // move frustum according to pixel decomposition
-    const Pixel& pixel = getInheritPixel();
-    if (pixel != Pixel::ALL && pixel.isValid())
-    {
-        const Channel* inheritChannel = getInheritChannel();
-        const PixelViewport& destPVP = inheritChannel->getPixelViewport();
-
-        if (pixel.w > 1)
-        {
-            const float frustumWidth = frustum.right() - frustum.left();
-            const float pixelWidth =
-                frustumWidth / static_cast<float>(destPVP.w);
-            const float jitter = pixelWidth * pixel.x - pixelWidth * .5f;
-
-            frustum.left() += jitter;
-            frustum.right() += jitter;
-        }
-        if (pixel.h > 1)
-        {
-            const float frustumHeight = frustum.bottom() - frustum.top();
-            const float pixelHeight = frustumHeight / float(destPVP.h);
-            const float jitter = pixelHeight * pixel.y + pixelHeight * .5f;
-
-            frustum.top() -= jitter;
-            frustum.bottom() -= jitter;
-        }
-    }
-
-    // adjust to viewport (screen-space decomposition)
-    // Note: vp is computed pixel-correct by Compound::updateInheritData()
-    const Viewport& vp = invp ? *invp : _inherit.vp;
-    if (vp != Viewport::FULL && vp.isValid())
-    {
-        const float frustumWidth = frustum.right() - frustum.left();
-        frustum.left() += frustumWidth * vp.x;
-        frustum.right() = frustum.left() + frustumWidth * vp.w;
-
-        const float frustumHeight = frustum.top() - frustum.bottom();
-        frustum.bottom() += frustumHeight * vp.y;
-        frustum.top() = frustum.bottom() + frustumHeight * vp.h;
-    }
-}
-
-void Compound::_updateOverdraw(Wall& wall)
+Vector4i Compound::_computeOverdraw(const FrustumInput& input, Wall& wall)
 {
-    Channel* channel = getChannel();
-    LBASSERT(channel);
-    if (!channel)
-        return;
-
-    const Segment* segment = channel->getSegment();
-    const View* view = channel->getView();
-    LBASSERT(segment && view);
-    if (!segment || !view)
-        return;
-
-    const Viewport& segmentVP = segment->getViewport();
-    const Viewport& viewVP = view->getViewport();
-    const Vector2i& overdraw = view->getOverdraw();
+    const Viewport& segmentVP = input.segmentVP;
+    const Viewport& viewVP = input.viewVP;
+    const Vector2i& overdraw = input.overdraw;
     Vector4i channelOverdraw;
 
     // compute overdraw
@@ -860,9 +820,9 @@ void Compound::_updateOverdraw(Wall& wall)
         channelOverdraw.w() = overdraw.y();
 
     // apply to frustum
+    const PixelViewport& pvp = input.pvp;
     if (channelOverdraw.x() > 0)
     {
-        const PixelViewport& pvp = channel->getPixelViewport();
         const float ratio = static_cast<float>(pvp.w + channelOverdraw.x()) /
                             static_cast<float>(pvp.w);
         wall.resizeLeft(ratio);
@@ -870,7 +830,6 @@ void Compound::_updateOverdraw(Wall& wall)
 
     if (channelOverdraw.z() > 0)
     {
-        const PixelViewport& pvp = channel->getPixelViewport();
         const float ratio = static_cast<float>(pvp.w + channelOverdraw.x() +
                                                channelOverdraw.z()) /
                             static_cast<float>(pvp.w + channelOverdraw.x());
@@ -879,7 +838,6 @@ void Compound::_updateOverdraw(Wall& wall)
 
     if (channelOverdraw.y() > 0)
     {
-        const PixelViewport& pvp = channel->getPixelViewport();
         const float ratio = static_cast<float>(pvp.h + channelOverdraw.y()) /
                             static_cast<float>(pvp.h);
         wall.resizeBottom(ratio);
@@ -887,14 +845,13 @@ void Compound::_updateOverdraw(Wall& wall)
 
     if (channelOverdraw.w() > 0)
     {
-        const PixelViewport& pvp = channel->getPixelViewport();
         const float ratio = static_cast<float>(pvp.h + +channelOverdraw.y() +
                                                channelOverdraw.w()) /
                             static_cast<float>(pvp.h + channelOverdraw.y());
         wall.resizeTop(ratio);
     }
 
-    channel->setOverdraw(channelOverdraw);
+    return channelOverdraw;
 }
 
 //---------------------------------------------------------------------------
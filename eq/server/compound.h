@@ -309,6 +309,7 @@ public:
     {
         return _inherit.pvp;
     }
+    const Viewport& getInheritViewport() const { return _inherit.vp; }
     const Range& getInheritRange() const { return _inherit.range; }
     const Pixel& getInheritPixel() const { return _inherit.pixel; }
     const SubPixel& getInheritSubPixel() const { return _inherit.subPixel; }
@@ -365,6 +366,16 @@ public:
     /** Update the frustum from the view or segment. */
     void updateFrustum(const Vector3f& eye, const float ratio);
 
+    /**
+     * Update the frusta of the given destination compounds.
+     *
+     * Compounds whose view, segment, channel and focus parameters did not
+     * change since their last update are skipped. The others are computed in
+     * parallel.
+     */
+    static void updateFrusta(const Compounds& compounds, const Vector3f& eye,
+                             const float ratio);
+
     /** compute the frustum for a given viewport */
     void computeTileFrustum(Frustumf& frustum, const fabric::Eye eye,
                             Viewport vp, bool ortho) const;
@@ -547,6 +558,33 @@ private:
     /** The frustum description of this compound. */
     Frustum _frustum;
 
+    /** All parameters of a view or segment frustum update. */
+    struct FrustumInput
+    {
+        FrustumInput();
+        bool operator==(const FrustumInput& rhs) const;
+        bool operator!=(const FrustumInput& rhs) const
+        {
+            return !(*this == rhs);
+        }
+
+        bool fromView;         //!< frustum from view or from segment
+        Frustum::Type type;    //!< of the view or segment, TYPE_NONE if unset
+        Wall wall;             //!< of the view or segment
+        Projection projection; //!< of the view or segment
+        Viewport coverage;     //!< of the channel in the view or segment
+        Viewport viewVP;
+        Viewport segmentVP;
+        Vector2i overdraw;     //!< of the view
+        PixelViewport pvp;     //!< of the channel
+        float modelUnit;
+        Vector3f eye;
+        float ratio;
+    };
+
+    /** The input of the frustum set by the last updateFrustum(). */
+    FrustumInput _frustumInput;
+
     typedef std::vector<CompoundListener*> CompoundListeners;
     CompoundListeners _listeners;
 
@@ -569,7 +607,12 @@ private:
     void _addChild(Compound* child);
     bool _removeChild(Compound* child);
 
-    void _updateOverdraw(Wall& wall);
+    bool _getFrustumInput(const Vector3f& eye, const float ratio,
+                          FrustumInput& input);
+    static Vector4i _computeWall(const FrustumInput& input, Wall& wall);
+    static Vector4i _computeOverdraw(const FrustumInput& input, Wall& wall);
+    void _applyFrustum(const FrustumInput& input, const Wall& wall,
+                       const Vector4i& overdraw);
     void _updateInheritRoot();
     void _updateInheritNode();
     void _updateInheritPVP();
@@ -584,14 +627,9 @@ private:
     void _fireChildRemove(Compound* child);
 
     void _computeFrustum(RenderContext& context) const;
-    void _computePerspective(RenderContext& context, const Vector3f& eye) const;
-    void _computeOrtho(RenderContext& context, const Vector3f& eye) const;
+    void _setupFrustum(fabric::FrustumSetup& setup) const;
     Vector3f _getEyePosition(const fabric::Eye eye) const;
     const Matrix4f& _getInverseHeadMatrix() const;
-    void _computeFrustumCorners(Frustumf& frustum,
-                                const FrustumData& frustumData,
-                                const Vector3f& eye, const bool ortho,
-                                const Viewport* const vp = 0) const;
 };
 
 std::ostream& operator<<(std::ostream& os, const Compound& compound);
@@ -45,6 +45,11 @@
 #include <boost/foreach.hpp>
 #include <lunchbox/sleep.h>
 
+#include <atomic>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
 #include "channelStopFrameVisitor.h"
 #include "configDeregistrator.h"
 #include "configRegistrator.h"
@@ -60,6 +65,12 @@ typedef co::CommandFunc<Config> ConfigFunc;
 using fabric::ON;
 using fabric::OFF;
 
+namespace
+{
+/** The maximum number of nodes connected and launched concurrently. */
+const size_t _maxConnectThreads = 32;
+}
+
 Config::Config(ServerPtr parent)
     : Super(parent)
     , _currentFrame(0)
@@ -581,27 +592,59 @@ bool Config::_updateRunning(const bool canFail)
 
 bool Config::_connectNodes()
 {
-    bool success = true;
-    lunchbox::Clock clock;
-    const Nodes& nodes = getNodes();
-    for (Nodes::const_iterator i = nodes.begin(); i != nodes.end(); ++i)
-    {
-        Node* node = *i;
-        if (!node->isActive())
-            continue;
+    Nodes nodes;
+    for (Node* node : getNodes())
+        if (node->isActive())
+            nodes.push_back(node);
+
+    // Connect, launch and wait for the nodes concurrently, so that slow or
+    // unreachable hosts do not delay the bring-up of the other nodes.
+    std::atomic<size_t> next(0);
+    std::atomic<bool> success(true);
+    const auto connect = [&] {
+        for (size_t i = next++; i < nodes.size(); i = next++)
+        {
+            Node* node = nodes[i];
+            if (!node->connect() || !node->syncLaunch())
+                success = false;
+        }
+    };
 
-        if (!node->connect())
-            success = false;
-    }
+    const size_t nThreads = std::min(nodes.size(), _maxConnectThreads);
+    std::vector<std::thread> threads;
+    threads.reserve(nThreads);
+    for (size_t i = 0; i < nThreads; ++i)
+        threads.emplace_back(connect);
+    for (std::thread& thread : threads)
+        thread.join();
 
-    for (Nodes::const_iterator i = nodes.begin(); i != nodes.end(); ++i)
+    return success;
+}
+
+void Config::_logBringUpTimes() const
+{
+    std::ostringstream os;
+    for (const Node* node : getNodes())
     {
-        Node* node = *i;
-        if (node->isActive() && !node->syncLaunch(clock))
-            success = false;
+        if (!node->isActive() || node->isApplicationNode())
+            continue;
+
+        const Node::BringUpTimes& times = node->getBringUpTimes();
+        os << std::endl
+           << "  " << std::setw(24) << std::left
+           << (node->getName().empty() ? node->getHost() : node->getName())
+           << std::right << std::setw(10) << times.connect << std::setw(10)
+           << times.launch << std::setw(10) << times.handshake
+           << std::setw(10) << times.init;
     }
+    if (os.str().empty())
+        return;
 
-    return success;
+    LBINFO << "Node bring-up times in ms:" << std::endl
+           << "  " << std::setw(24) << std::left << "node" << std::right
+           << std::setw(10) << "connect" << std::setw(10) << "launch"
+           << std::setw(10) << "handshake" << std::setw(10) << "init"
+           << os.str() << std::endl;
 }
 
 void Config::_startNodes()
@@ -802,7 +845,9 @@ bool Config::_init(const uint128_t& initID)
     // any of the above entities might have been updated
     commit();
 
-    if (!_updateRunning(false))
+    const bool running = _updateRunning(false);
+    _logBringUpTimes();
+    if (!running)
         return false;
 
     // Needed to set up active state for first LB update
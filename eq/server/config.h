@@ -265,6 +265,7 @@ private:
     bool _connectNodes();
     bool _connectNode(Node* node);
     bool _syncConnectNode(Node* node, const lunchbox::Clock& clock);
+    void _logBringUpTimes() const; //!< of the active render client nodes
     void _startNodes();
     lunchbox::Request<void> _createConfig(Node* node);
     bool _updateNodes(const bool canFail);
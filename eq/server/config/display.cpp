@@ -138,6 +138,8 @@ void Display::discoverLocal(Config* config, const ConfigParams& params)
     if (scalability)
     {
         names.push_back(EQ_SERVER_CONFIG_LAYOUT_DB_DS);
+        names.push_back(EQ_SERVER_CONFIG_LAYOUT_DB_BS);
+        names.push_back(EQ_SERVER_CONFIG_LAYOUT_DB_RK);
         names.push_back(EQ_SERVER_CONFIG_LAYOUT_DB_STATIC);
         names.push_back(EQ_SERVER_CONFIG_LAYOUT_DB_DYNAMIC);
         names.push_back(EQ_SERVER_CONFIG_LAYOUT_2D_STATIC);
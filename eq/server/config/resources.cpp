@@ -64,6 +64,7 @@
 #include <cstdio>
 
 #define USE_IPv4
+#define RADIX_K 4 // maximum group size for DBRadixK
 
 namespace eq
 {
@@ -556,7 +557,9 @@ Compound* Resources::_addMonoCompound(Compound* root, const Channels& channels,
         compound = _add2DCompound(root, activeChannels, params);
     }
     else if (name == EQ_SERVER_CONFIG_LAYOUT_DB_DYNAMIC ||
-             name == EQ_SERVER_CONFIG_LAYOUT_DB_STATIC)
+             name == EQ_SERVER_CONFIG_LAYOUT_DB_STATIC ||
+             name == EQ_SERVER_CONFIG_LAYOUT_DB_BS ||
+             name == EQ_SERVER_CONFIG_LAYOUT_DB_RK)
     {
         compound = _addDBCompound(root, activeDBChannels, params);
     }
@@ -708,9 +711,100 @@ Compound* Resources::_addDBCompound(Compound* root, const Channels& channels,
         start += step;
     }
 
+    if (name == EQ_SERVER_CONFIG_LAYOUT_DB_BS)
+    {
+        const size_t nSources = children.size();
+        _addCompositingSchedule(
+            compound,
+            CompositingSchedule(
+                nSources, CompositingSchedule::getBinarySwapRadices(nSources)));
+    }
+    else if (name == EQ_SERVER_CONFIG_LAYOUT_DB_RK)
+    {
+        const size_t nSources = children.size();
+        _addCompositingSchedule(
+            compound, CompositingSchedule(
+                          nSources, CompositingSchedule::getRadixKRadices(
+                                        nSources, RADIX_K)));
+    }
     return compound;
 }
 
+static Viewport _getViewport(const CompositingSchedule::Region& region)
+{
+    const float unit = float(CompositingSchedule::UNIT);
+    return Viewport(0.f, float(region.start) / unit, 1.f,
+                    float(region.end - region.start) / unit);
+}
+
+void Resources::_addCompositingSchedule(Compound* compound,
+                                        const CompositingSchedule& schedule)
+{
+    // Each source child gets a draw child, which reads back the first round
+    // stripes for its peers, and one assemble/readback child per subsequent
+    // round. The source child composites the last round and outputs the final
+    // color stripe to the destination, where only 1/N of the image converges.
+    const Compounds children = compound->getChildren();
+    const size_t nSources = children.size();
+    const size_t nRounds = schedule.getNumRounds();
+    LBASSERT(schedule.getNumSources() == nSources);
+    if (nRounds == 0)
+        return;
+
+    std::ostringstream prefix;
+    prefix << "Frame." << compound->getName() << '.' << ++_frameCounter;
+
+    std::vector<Compounds> stages(nSources);
+    for (size_t i = 0; i < nSources; ++i)
+    {
+        Compound* child = children[i];
+        stages[i].push_back(new Compound(child)); // draw child
+
+        for (size_t round = 1; round < nRounds; ++round)
+        {
+            Compound* stage = new Compound(child);
+            stage->setTasks(fabric::TASK_ASSEMBLE | fabric::TASK_READBACK);
+            stages[i].push_back(stage);
+        }
+        stages[i].push_back(child); // last round composited by the child
+    }
+
+    for (size_t round = 0; round < nRounds; ++round)
+    {
+        const CompositingSchedule::Transfers& transfers =
+            schedule.getTransfers(round);
+        for (const CompositingSchedule::Transfer& transfer : transfers)
+        {
+            std::ostringstream frameName;
+            frameName << prefix.str() << ".r" << round << '.' << transfer.from
+                      << '.' << transfer.to;
+
+            Frame* outputFrame = new Frame;
+            outputFrame->setName(frameName.str());
+            outputFrame->setViewport(_getViewport(transfer.region));
+            outputFrame->setBuffers(Frame::Buffer::color |
+                                    Frame::Buffer::depth);
+            stages[transfer.from][round]->addOutputFrame(outputFrame);
+
+            Frame* inputFrame = new Frame;
+            inputFrame->setName(frameName.str());
+            stages[transfer.to][round + 1]->addInputFrame(inputFrame);
+        }
+    }
+
+    // final color stripe output, if not already in place
+    for (size_t i = 0; i < nSources; ++i)
+    {
+        Compound* child = children[i];
+        if (child->getChannel() == compound->getChannel())
+            continue;
+
+        Frame* output = child->getOutputFrames().front();
+        output->setViewport(_getViewport(schedule.getRegion(i)));
+        output->setBuffers(Frame::Buffer::color);
+    }
+}
+
 Compound* Resources::_addDSCompound(Compound* root, const Channels& channels)
 {
     const Channel* channel = root->getChannel();
@@ -21,12 +21,16 @@
 
 #include "../types.h"
 
+#include "../compositingSchedule.h" // used inline
+
 #define EQ_SERVER_CONFIG_LAYOUT_SIMPLE "Simple"
 #define EQ_SERVER_CONFIG_LAYOUT_2D_STATIC "Static2D"
 #define EQ_SERVER_CONFIG_LAYOUT_2D_DYNAMIC "Dynamic2D"
 #define EQ_SERVER_CONFIG_LAYOUT_DB_STATIC "StaticDB"
 #define EQ_SERVER_CONFIG_LAYOUT_DB_DYNAMIC "DynamicDB"
 #define EQ_SERVER_CONFIG_LAYOUT_DB_DS "DBDirectSend"
+#define EQ_SERVER_CONFIG_LAYOUT_DB_BS "DBBinarySwap"
+#define EQ_SERVER_CONFIG_LAYOUT_DB_RK "DBRadixK"
 #define EQ_SERVER_CONFIG_LAYOUT_DB_2D "DB_2D"
 #define EQ_SERVER_CONFIG_LAYOUT_SUBPIXEL "Subpixel"
 
@@ -57,6 +61,8 @@ private:
     static Compound* _addDBCompound(Compound* root, const Channels& channels,
                                     fabric::ConfigParams params);
     static Compound* _addDSCompound(Compound* root, const Channels& channels);
+    static void _addCompositingSchedule(Compound* compound,
+                                        const CompositingSchedule& schedule);
     static Compound* _addDB2DCompound(Compound* root, const Channels& channels,
                                       fabric::ConfigParams params);
     static Compound* _addSubpixelCompound(Compound* root, const Channels&);
@@ -17,24 +17,73 @@
 
 #include "dfrEqualizer.h"
 
+#include "../channel.h"
 #include "../compound.h"
 #include "../compoundVisitor.h"
 #include "../config.h"
 #include "../log.h"
+#include "../observer.h"
+#include "../view.h"
 
 #include <eq/fabric/statistic.h>
+#include <eq/fabric/wall.h>
 #include <eq/fabric/zoom.h>
 #include <lunchbox/debug.h>
 
+#include <algorithm>
+#include <limits>
+
 namespace eq
 {
 namespace server
 {
 static const float MINSIZE = 128.f; // pixels
 
+namespace
+{
+/** @return the start of an interval of the given size around the center. */
+float _getStart(const float center, const float size)
+{
+    return std::min(std::max(center - size * .5f, 0.f), 1.f - size);
+}
+
+/**
+ * @return the render time of the regions at the given zoom scale, which is the
+ *         time of the slowest pipe.
+ */
+float _getTime(const DFREqualizer::Regions& regions,
+               const std::vector<float>& costs, const float falloff,
+               const float scale, std::vector<float>& zooms)
+{
+    std::vector<float> times(1, 0.f); // per pipe
+    float relative = 1.f;
+    for (size_t i = 0; i < regions.size(); ++i, relative *= falloff)
+    {
+        const DFREqualizer::Region& region = regions[i];
+        const float zoom = std::min(std::max(scale * relative, region.minZoom),
+                                    region.maxZoom);
+        zooms[i] = zoom;
+
+        const float cost = costs[i] * zoom * zoom;
+        if (region.pipePixels.empty())
+        {
+            times[0] += cost * region.pixels;
+            continue;
+        }
+        if (times.size() < region.pipePixels.size())
+            times.resize(region.pipePixels.size(), 0.f);
+        for (size_t j = 0; j < region.pipePixels.size(); ++j)
+            times[j] += cost * region.pipePixels[j];
+    }
+    return *std::max_element(times.begin(), times.end());
+}
+}
+
 DFREqualizer::DFREqualizer()
     : _current(getFrameRate())
     , _lastTime(0)
+    , _falloff(.5f)
+    , _regions(false)
 {
     LBINFO << "New DFREqualizer @" << (void*)this << std::endl;
 }
@@ -57,6 +106,7 @@ void DFREqualizer::attach(Compound* compound)
         channel->removeListener(this);
     }
 
+    _exitRegions();
     Equalizer::attach(compound);
 
     if (compound)
@@ -73,16 +123,23 @@ void DFREqualizer::attach(Compound* compound)
 void DFREqualizer::notifyUpdatePre(Compound* compound, const uint32_t /*frame*/)
 {
     LBASSERT(compound == getCompound());
+    LBASSERT(getDamping() >= 0.f);
+    LBASSERT(getDamping() <= 1.f);
 
+    if (_regions && !compound->isLeaf())
+        _updateRegions(compound);
+    else
+        _updateZoom(compound);
+}
+
+void DFREqualizer::_updateZoom(Compound* compound)
+{
     if (isFrozen() || !compound->isActive() || !isActive())
     {
         compound->setZoom(Zoom::NONE);
         return;
     }
 
-    LBASSERT(getDamping() >= 0.f);
-    LBASSERT(getDamping() <= 1.f);
-
     const float factor =
         (sqrtf(_current / getFrameRate()) - 1.f) * getDamping() + 1.f;
 
@@ -111,6 +168,309 @@ void DFREqualizer::notifyUpdatePre(Compound* compound, const uint32_t /*frame*/)
     compound->setZoom(newZoom);
 }
 
+void DFREqualizer::_initRegions()
+{
+    const Compound* compound = getCompound();
+    if (!_listeners.empty() || !compound)
+        return;
+
+    // Subscribe to child channel load events
+    const Compounds& children = compound->getChildren();
+    _listeners.resize(children.size());
+    _regions.resize(1 + (children.size() - 1) / 4);
+
+    for (size_t i = 0; i < children.size(); ++i)
+    {
+        Channel* channel = children[i]->getChannel();
+        LBASSERT(channel);
+        channel->addListener(&_listeners[i]);
+    }
+    if (children.size() != 1 + (_regions.size() - 1) * 4)
+        LBWARN << "Region-varying DFR compound needs 4n+1 children, ignoring "
+               << children.size() - 1 - (_regions.size() - 1) * 4
+               << " child compounds" << std::endl;
+}
+
+void DFREqualizer::_exitRegions()
+{
+    const Compound* compound = getCompound();
+    if (!compound || _listeners.empty())
+        return;
+
+    const Compounds& children = compound->getChildren();
+    LBASSERT(_listeners.size() == children.size());
+    for (size_t i = 0; i < children.size(); ++i)
+        children[i]->getChannel()->removeListener(&_listeners[i]);
+
+    _listeners.clear();
+    _regions.clear();
+}
+
+void DFREqualizer::_updateRegions(Compound* compound)
+{
+    _initRegions();
+
+    const Compounds& children = compound->getChildren();
+    if (isFrozen() || !compound->isActive() || !isActive())
+    {
+        for (Compound* child : children)
+            child->setZoom(Zoom::NONE);
+        return;
+    }
+
+    const Viewports viewports =
+        computeViewports(_getFocus(compound), _regions.size());
+    const PixelViewport& pvp = compound->getInheritPixelViewport();
+    const float minZoom = MINSIZE / float(std::min(pvp.w, pvp.h));
+
+    // children on the same pipe render one after another, different pipes
+    // render in parallel
+    std::vector<const Pipe*> pipes;
+    std::vector<size_t> pipeIndices(viewports.size());
+    for (size_t i = 0; i < viewports.size(); ++i)
+    {
+        const Pipe* pipe = children[i]->getChannel()->getPipe();
+        const auto j = std::find(pipes.begin(), pipes.end(), pipe);
+        pipeIndices[i] = j - pipes.begin();
+        if (j == pipes.end())
+            pipes.push_back(pipe);
+    }
+
+    for (size_t i = 0; i < _regions.size(); ++i)
+    {
+        Region& region = _regions[i];
+        region.pixels = 0.f;
+        region.time = 0.f;
+        region.minZoom = minZoom;
+        region.maxZoom = std::numeric_limits<float>::max();
+        region.pipePixels.assign(pipes.size(), 0.f);
+
+        const size_t begin = i == 0 ? 0 : 1 + (i - 1) * 4;
+        const size_t end = 1 + i * 4;
+        for (size_t j = begin; j < end; ++j)
+        {
+            const Viewport& vp = viewports[j];
+            const float width = vp.w * float(pvp.w);
+            const float height = vp.h * float(pvp.h);
+            children[j]->setViewport(vp);
+            region.pixels += width * height;
+            region.pipePixels[pipeIndices[j]] += width * height;
+            region.time += _listeners[j].time;
+
+            if (width < 1.f || height < 1.f)
+                continue;
+            const PixelViewport& channelPVP =
+                children[j]->getChannel()->getPixelViewport();
+            region.maxZoom = std::min(region.maxZoom,
+                                      std::min(float(channelPVP.w) / width,
+                                               float(channelPVP.h) / height));
+        }
+        if (region.maxZoom == std::numeric_limits<float>::max())
+            region.maxZoom = 1.f;
+        region.minZoom = std::min(region.minZoom, region.maxZoom);
+    }
+
+    adapt(_regions, 1000.f / getFrameRate(), getDamping(), _falloff);
+
+    for (size_t i = 0; i < children.size(); ++i)
+    {
+        Compound* child = children[i];
+        const size_t index = i == 0 ? 0 : 1 + (i - 1) / 4;
+        if (index < _regions.size())
+        {
+            const float zoom = _regions[index].zoom;
+            child->setZoom(Zoom(zoom, zoom));
+        }
+        else
+            child->setViewport(Viewport(0.f, 0.f, 0.f, 0.f));
+    }
+}
+
+Vector2f DFREqualizer::_getFocus(const Compound* compound) const
+{
+    const Vector2f center(.5f, .5f);
+    const Compound* destination = compound;
+    while (!destination->isDestination() && destination->getParent())
+        destination = destination->getParent();
+
+    const Channel* channel = destination->getChannel();
+    const View* view = channel ? channel->getView() : 0;
+    const Observer* observer = view ? view->getObserver() : 0;
+    if (!observer)
+        return center;
+
+    Wall wall;
+    switch (destination->getFrustumType())
+    {
+    case Frustum::TYPE_WALL:
+        wall = destination->getWall();
+        break;
+    case Frustum::TYPE_PROJECTION:
+        wall = destination->getProjection();
+        break;
+    default:
+        return center;
+    }
+
+    // HMD walls move with the head, the observer looks at the center
+    if (wall.type == Wall::TYPE_HMD)
+        return center;
+
+    // the destination wall is in model units
+    Matrix4f head = observer->getHeadMatrix();
+    head.setTranslation(head.getTranslation() * view->getModelUnit());
+    return computeFocus(wall, head);
+}
+
+Viewports DFREqualizer::computeViewports(const Vector2f& focus,
+                                         const size_t nRegions)
+{
+    Viewports viewports;
+    if (nRegions == 0)
+        return viewports;
+
+    // nested rectangles around the focus, each twice the size of its inner
+    // one, shifted to fit into the compound
+    Viewports rects(nRegions);
+    float size = 1.f;
+    for (size_t i = nRegions; i > 0; --i, size *= .5f)
+        rects[i - 1] = Viewport(_getStart(focus.x(), size),
+                                _getStart(focus.y(), size), size, size);
+
+    viewports.reserve(1 + (nRegions - 1) * 4);
+    viewports.push_back(rects[0]);
+    for (size_t i = 1; i < nRegions; ++i)
+    {
+        const Viewport& in = rects[i - 1];
+        const Viewport& out = rects[i];
+        const float inRight = in.x + in.w;
+        const float inTop = in.y + in.h;
+        viewports.push_back(Viewport(out.x, out.y, in.x - out.x, out.h));
+        viewports.push_back(
+            Viewport(inRight, out.y, out.x + out.w - inRight, out.h));
+        viewports.push_back(Viewport(in.x, out.y, in.w, in.y - out.y));
+        viewports.push_back(
+            Viewport(in.x, inTop, in.w, out.y + out.h - inTop));
+    }
+    return viewports;
+}
+
+Vector2f DFREqualizer::computeFocus(const Wall& wall, const Matrix4f& head)
+{
+    // http://en.wikipedia.org/wiki/Line-plane_intersection
+    const Vector2f center(.5f, .5f);
+    const Vector3f eye = head.getTranslation();
+    const Vector3f view = head * Vector4f(0.f, 0.f, -1.f, 0.f);
+    const Vector3f w = wall.getW();
+    const float denom = view.dot(w);
+    if (denom == 0.f) // view parallel to wall
+        return center;
+
+    const float d = (wall.bottomLeft - eye).dot(w) / denom;
+    if (d <= 0.f) // wall behind observer
+        return center;
+
+    const Vector3f point = eye + view * d - wall.bottomLeft;
+    const Vector3f u = wall.getU();
+    const Vector3f v = wall.getV();
+    const float x = point.dot(u) / u.dot(u);
+    const float y = point.dot(v) / v.dot(v);
+    return Vector2f(std::min(std::max(x, 0.f), 1.f),
+                    std::min(std::max(y, 0.f), 1.f));
+}
+
+std::vector<float> DFREqualizer::computeZooms(const Regions& regions,
+                                              const float budget,
+                                              const float falloff)
+{
+    std::vector<float> zooms(regions.size());
+    for (size_t i = 0; i < regions.size(); ++i)
+        zooms[i] = regions[i].zoom;
+
+    // cost per pixel of each region, regions without measurement get the
+    // average cost of the measured ones
+    std::vector<float> costs(regions.size(), 0.f);
+    float sum = 0.f;
+    size_t nKnown = 0;
+    for (size_t i = 0; i < regions.size(); ++i)
+    {
+        const Region& region = regions[i];
+        if (region.time <= 0.f || region.pixels <= 0.f || region.zoom <= 0.f)
+            continue;
+        costs[i] = region.time / (region.pixels * region.zoom * region.zoom);
+        sum += costs[i];
+        ++nKnown;
+    }
+    if (nKnown == 0 || budget <= 0.f)
+        return zooms;
+
+    for (float& cost : costs)
+        if (cost == 0.f)
+            cost = sum / float(nKnown);
+
+    // the time is monotonic in the scale of the first region: bisect
+    float relative = 1.f;
+    float high = 0.f;
+    for (const Region& region : regions)
+    {
+        high = std::max(high, region.maxZoom / relative);
+        relative *= falloff;
+    }
+    if (_getTime(regions, costs, falloff, high, zooms) <= budget)
+        return zooms;
+
+    float low = 0.f;
+    for (size_t i = 0; i < 32; ++i)
+    {
+        const float scale = (low + high) * .5f;
+        if (_getTime(regions, costs, falloff, scale, zooms) > budget)
+            high = scale;
+        else
+            low = scale;
+    }
+    _getTime(regions, costs, falloff, low, zooms);
+    return zooms;
+}
+
+void DFREqualizer::adapt(Regions& regions, const float budget,
+                         const float damping, const float falloff)
+{
+    const std::vector<float> zooms = computeZooms(regions, budget, falloff);
+    for (size_t i = 0; i < regions.size(); ++i)
+    {
+        Region& region = regions[i];
+        region.zoom += (zooms[i] - region.zoom) * damping;
+        region.zoom =
+            std::min(std::max(region.zoom, region.minZoom), region.maxZoom);
+    }
+}
+
+void DFREqualizer::RegionListener::notifyLoadData(
+    Channel* /*channel*/, const uint32_t /*frameNumber*/,
+    const Statistics& statistics, const Viewport& /*region*/)
+{
+    int64_t startTime = std::numeric_limits<int64_t>::max();
+    int64_t endTime = 0;
+    for (const Statistic& data : statistics)
+    {
+        switch (data.type)
+        {
+        case Statistic::CHANNEL_CLEAR:
+        case Statistic::CHANNEL_DRAW:
+        case Statistic::CHANNEL_READBACK:
+            startTime = std::min(startTime, data.startTime);
+            endTime = std::max(endTime, data.endTime);
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    if (endTime > startTime)
+        time = float(endTime - startTime);
+}
+
 void DFREqualizer::notifyLoadData(Channel* channel, const uint32_t frameNumber,
                                   const Statistics& statistics,
                                   const Viewport& /*region*/)
@@ -159,6 +519,10 @@ std::ostream& operator<<(std::ostream& os, const DFREqualizer* lb)
 
     if (lb->getDamping() != 0.5f)
         os << "    damping " << lb->getDamping() << std::endl;
+    if (lb->getRegions())
+        os << "    regions ON" << std::endl;
+    if (lb->getFalloff() != 0.5f)
+        os << "    falloff " << lb->getFalloff() << std::endl;
 
     os << '}' << std::endl << lunchbox::enableFlush;
     return os;
@@ -23,6 +23,7 @@
 
 #include <deque>
 #include <map>
+#include <vector>
 
 namespace eq
 {
@@ -30,10 +31,48 @@ namespace server
 {
 std::ostream& operator<<(std::ostream& os, const DFREqualizer*);
 
-/** Tries to maintain a constant frame rate by adapting the compound zoom.*/
+/**
+ * Tries to maintain a constant frame rate by adapting the compound zoom.
+ *
+ * By default, the compound is zoomed isotropically based on the measured frame
+ * rate.
+ *
+ * In region mode ('regions ON'), the children of a non-leaf compound render
+ * nested regions around a focus point, which is the point the observer looks
+ * at on a fixed wall, or the center of the view otherwise. The first child
+ * renders the innermost region, each following group of four children renders
+ * the left, right, bottom and top part of the next ring, each using its own
+ * channel. Each region is twice the size of the region it contains, and the
+ * outermost region covers the whole compound. The frame time budget given by
+ * the frame rate is distributed across the regions using their measured render
+ * times, with the zoom falling off from the innermost region to the periphery.
+ */
 class DFREqualizer : public Equalizer, protected ChannelListener
 {
 public:
+    /** The state of one region of a region-varying compound. */
+    struct Region
+    {
+        Region()
+            : pixels(0.f)
+            , time(0.f)
+            , zoom(1.f)
+            , minZoom(0.f)
+            , maxZoom(1.f)
+        {
+        }
+
+        float pixels;  //!< The number of pixels of the region at zoom 1
+        float time;    //!< The last render time at zoom in ms, 0 if unknown
+        float zoom;    //!< The current linear zoom factor
+        float minZoom; //!< The smallest allowed zoom factor
+        float maxZoom; //!< The largest allowed zoom factor
+
+        /** The pixels at zoom 1 on each pipe, all on one pipe if empty. */
+        std::vector<float> pipePixels;
+    };
+    typedef std::vector<Region> Regions;
+
     DFREqualizer();
     virtual ~DFREqualizer();
     void toStream(std::ostream& os) const final { os << this; }
@@ -49,12 +88,86 @@ public:
                         const Viewport& region) final;
 
     uint32_t getType() const final { return fabric::DFR_EQUALIZER; }
+    /** Set the region-varying mode, used only on non-leaf compounds. */
+    void setRegions(const bool regions) { _regions = regions; }
+    /** @return true if the region-varying mode is used. */
+    bool getRegions() const { return _regions; }
+    /** Set the zoom ratio between two neighbouring regions. */
+    void setFalloff(const float falloff) { _falloff = falloff; }
+    /** @return the zoom ratio between two neighbouring regions. */
+    float getFalloff() const { return _falloff; }
+    /**
+     * Compute the viewports of the children of a region-varying compound.
+     *
+     * @param focus the focus point, normalized to the compound viewport.
+     * @param nRegions the number of nested regions.
+     * @return the innermost viewport, followed by the left, right, bottom and
+     *         top viewport of each ring, from the inside out.
+     */
+    static EQSERVER_API Viewports computeViewports(const Vector2f& focus,
+                                                   size_t nRegions);
+
+    /**
+     * @return the point the observer with the given head matrix looks at,
+     *         normalized to the wall and clamped to it, or the wall center if
+     *         the wall is not in front of the observer.
+     */
+    static EQSERVER_API Vector2f computeFocus(const Wall& wall,
+                                              const Matrix4f& head);
+
+    /**
+     * Compute the zoom factors which render the regions in the given time.
+     *
+     * The render time of each region is assumed to be proportional to its
+     * pixel count at the current zoom. The pipes render in parallel, the
+     * regions on one pipe one after another, and the slowest pipe has to
+     * finish within the budget. The zoom of region i is falloff^i times the
+     * zoom of the first region, clamped to the allowed range of the region.
+     *
+     * @return the zoom factors, the current zooms if no time is known.
+     */
+    static EQSERVER_API std::vector<float> computeZooms(const Regions& regions,
+                                                        float budget,
+                                                        float falloff);
+
+    /** Move the zoom factors towards computeZooms() by the damping factor. */
+    static EQSERVER_API void adapt(Regions& regions, float budget,
+                                   float damping, float falloff);
+
 protected:
     void notifyChildAdded(Compound*, Compound*) override {}
     void notifyChildRemove(Compound*, Compound*) override {}
 private:
+    /** Helper class gathering the render time of one child. */
+    class RegionListener : public ChannelListener
+    {
+    public:
+        RegionListener()
+            : time(0.f)
+        {
+        }
+
+        /** @sa ChannelListener::notifyLoadData */
+        void notifyLoadData(Channel* channel, uint32_t frameNumber,
+                            const Statistics& statistics,
+                            const Viewport& region) final;
+
+        float time; //!< The last render time in ms
+    };
+
     float _current;    //!< Framerate of the last finished frame
     int64_t _lastTime; //!< Last frames' timestamp
+    float _falloff;    //!< Zoom ratio between neighbouring regions
+    bool _regions;     //!< Region-varying mode on non-leaf compounds
+
+    std::vector<RegionListener> _listeners; //!< One for each child
+    Regions _regions;
+
+    void _updateZoom(Compound* compound);
+    void _initRegions();
+    void _exitRegions();
+    void _updateRegions(Compound* compound);
+    Vector2f _getFocus(const Compound* compound) const;
 };
 }
 }
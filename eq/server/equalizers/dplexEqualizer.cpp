@@ -0,0 +1,460 @@
+
+/* Copyright (c) 2026, The Equalizer authors, see AUTHORS
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "dplexEqualizer.h"
+
+#include "../compound.h"
+#include "../compoundVisitor.h"
+#include "../config.h"
+#include "../log.h"
+
+#include <eq/fabric/statistic.h>
+#include <lunchbox/debug.h>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+#define MAX_PERIOD 16
+#define SLOWDOWN 1.05f   // pace slightly below the sustainable rate
+#define HYSTERESIS .95f  // minimum improvement to apply a new schedule
+
+namespace eq
+{
+namespace server
+{
+namespace
+{
+class LoadSubscriber : public CompoundVisitor
+{
+public:
+    explicit LoadSubscriber(ChannelListener* listener)
+        : nChannels(0)
+        , _listener(listener)
+    {
+    }
+
+    virtual VisitorResult visit(Compound* compound)
+    {
+        Channel* channel = compound->getChannel();
+        LBASSERT(channel);
+        channel->addListener(_listener);
+        ++nChannels;
+
+        return TRAVERSE_CONTINUE;
+    }
+
+    size_t nChannels;
+
+private:
+    ChannelListener* const _listener;
+};
+
+class LoadUnsubscriber : public CompoundVisitor
+{
+public:
+    explicit LoadUnsubscriber(ChannelListener* listener)
+        : _listener(listener)
+    {
+    }
+
+    virtual VisitorResult visit(Compound* compound)
+    {
+        Channel* channel = compound->getChannel();
+        LBASSERT(channel);
+        channel->removeListener(_listener);
+
+        return TRAVERSE_CONTINUE;
+    }
+
+private:
+    ChannelListener* const _listener;
+};
+
+typedef DPlexEqualizer::Schedule Schedule;
+typedef DPlexEqualizer::Times Times;
+
+/** Assign non-overlapping phases within the cycle, densest sources first. */
+bool _assignPhases(Schedule& schedule, const uint32_t cycle)
+{
+    std::vector<size_t> order(schedule.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [&schedule](const size_t a, const size_t b) {
+                         return schedule[a].period < schedule[b].period;
+                     });
+
+    std::vector<bool> used(cycle, false);
+    for (const size_t i : order)
+    {
+        const uint32_t period = schedule[i].period;
+        bool found = false;
+        for (uint32_t phase = 0; phase < period && !found; ++phase)
+        {
+            found = true;
+            for (uint32_t j = phase; j < cycle && found; j += period)
+                found = !used[j];
+            if (!found)
+                continue;
+
+            for (uint32_t j = phase; j < cycle; j += period)
+                used[j] = true;
+            schedule[i].phase = phase;
+        }
+        if (!found)
+            return false;
+    }
+    return true;
+}
+
+/** Exhaustive search over monotonic period assignments for one cycle. */
+class Search
+{
+public:
+    Search(const Times& times, const std::vector<size_t>& order,
+           const uint32_t cycle)
+        : best(std::numeric_limits<float>::max())
+        , _times(times)
+        , _order(order)
+        , _cycle(cycle)
+        , _periods(times.size(), 1)
+    {
+        for (uint32_t i = 1; i <= cycle; ++i)
+            if (cycle % i == 0)
+                _divisors.push_back(i);
+    }
+
+    void run(const float bound)
+    {
+        best = bound;
+        _recurse(0, 0, _cycle, 0.f);
+    }
+
+    float best;
+    Schedule schedule;
+
+private:
+    const Times& _times;
+    const std::vector<size_t>& _order;
+    const uint32_t _cycle;
+    std::vector<uint32_t> _divisors;
+    std::vector<uint32_t> _periods;
+
+    void _recurse(const size_t index, const size_t minDivisor,
+                  const uint32_t remaining, const float interval)
+    {
+        const size_t nSources = _order.size();
+        if (index == nSources)
+        {
+            if (remaining == 0)
+                _evaluate(interval);
+            return;
+        }
+
+        const uint32_t nLeft = uint32_t(nSources - index - 1);
+        for (size_t i = minDivisor; i < _divisors.size(); ++i)
+        {
+            const uint32_t period = _divisors[i];
+            const uint32_t slots = _cycle / period;
+            if (slots + nLeft > remaining)
+                continue; // each remaining source needs at least one slot
+
+            const float time = _times[_order[index]] / float(period);
+            const float newInterval = std::max(interval, time);
+            if (newInterval >= best)
+                continue;
+
+            _periods[_order[index]] = period;
+            _recurse(index + 1, i, remaining - slots, newInterval);
+        }
+    }
+
+    void _evaluate(const float interval)
+    {
+        Schedule candidate(_periods.size());
+        for (size_t i = 0; i < _periods.size(); ++i)
+            candidate[i].period = _periods[i];
+
+        if (!_assignPhases(candidate, _cycle))
+            return;
+
+        best = interval;
+        schedule.swap(candidate);
+    }
+};
+}
+
+// The DPlex equalizer assigns the period and phase of the children of a
+// time-multiplex compound from their predicted frame times. The frame rate is
+// paced to the slowest child relative to its period.
+
+DPlexEqualizer::DPlexEqualizer()
+{
+    LBINFO << "New DPlexEqualizer @" << (void*)this << std::endl;
+}
+
+DPlexEqualizer::DPlexEqualizer(const DPlexEqualizer& from)
+    : Equalizer(from)
+{
+}
+
+DPlexEqualizer::~DPlexEqualizer()
+{
+    attach(0);
+}
+
+void DPlexEqualizer::attach(Compound* compound)
+{
+    _exit();
+    Equalizer::attach(compound);
+}
+
+DPlexEqualizer::Schedule DPlexEqualizer::computeSchedule(
+    const Times& times, const uint32_t maxPeriod)
+{
+    const size_t nSources = times.size();
+    if (nSources == 0)
+        return Schedule();
+
+    // fastest sources first, which get the shortest periods
+    std::vector<size_t> order(nSources);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [&times](const size_t a, const size_t b) {
+                         return times[a] < times[b];
+                     });
+
+    // default: plain round-robin
+    Schedule schedule(nSources);
+    for (size_t i = 0; i < nSources; ++i)
+        schedule[order[i]] = Slot(uint32_t(nSources), uint32_t(i));
+    float best = getInterval(times, schedule);
+
+    const uint32_t lastCycle = std::max(uint32_t(nSources), maxPeriod);
+    for (uint32_t cycle = uint32_t(nSources) + 1; cycle <= lastCycle; ++cycle)
+    {
+        Search search(times, order, cycle);
+        search.run(best);
+        if (search.schedule.empty())
+            continue;
+
+        best = search.best;
+        schedule.swap(search.schedule);
+    }
+    return schedule;
+}
+
+float DPlexEqualizer::getInterval(const Times& times, const Schedule& schedule)
+{
+    LBASSERT(times.size() == schedule.size());
+    float interval = 0.f;
+    for (size_t i = 0; i < times.size() && i < schedule.size(); ++i)
+        interval = std::max(interval, times[i] / float(schedule[i].period));
+    return interval;
+}
+
+void DPlexEqualizer::_init()
+{
+    const Compound* compound = getCompound();
+    if (!_loadListeners.empty() || !compound)
+        return;
+
+    // Subscribe to child channel load events
+    const Compounds& children = compound->getChildren();
+    _loadListeners.resize(children.size());
+    _schedule.resize(children.size());
+
+    for (size_t i = 0; i < children.size(); ++i)
+    {
+        Compound* child = children[i];
+        LoadListener& loadListener = _loadListeners[i];
+        loadListener.parent = this;
+
+        LoadSubscriber subscriber(&loadListener);
+        child->accept(subscriber);
+        loadListener.nChannels = subscriber.nChannels;
+
+        _schedule[i] =
+            Slot(child->getInheritPeriod(), child->getInheritPhase());
+    }
+}
+
+void DPlexEqualizer::_exit()
+{
+    const Compound* compound = getCompound();
+    if (!compound || _loadListeners.empty())
+        return;
+
+    const Compounds& children = compound->getChildren();
+
+    LBASSERT(_loadListeners.size() == children.size());
+    for (size_t i = 0; i < children.size(); ++i)
+    {
+        Compound* child = children[i];
+        LoadListener& loadListener = _loadListeners[i];
+
+        LoadUnsubscriber unsubscriber(&loadListener);
+        child->accept(unsubscriber);
+    }
+
+    _loadListeners.clear();
+    _schedule.clear();
+}
+
+void DPlexEqualizer::notifyUpdatePre(Compound* compound,
+                                     const uint32_t /*frameNumber*/)
+{
+    _init();
+
+    if (isFrozen() || !compound->isActive() || !isActive())
+    {
+        compound->setMaxFPS(std::numeric_limits<float>::max());
+        return;
+    }
+
+    Times times;
+    times.reserve(_loadListeners.size());
+    for (const LoadListener& listener : _loadListeners)
+    {
+        const float time = listener.getTime();
+        if (time <= 0.f) // wait until all children have reported
+            return;
+        times.push_back(time);
+    }
+    if (times.empty())
+        return;
+
+    const Schedule schedule = computeSchedule(times, MAX_PERIOD);
+    const float current = getInterval(times, _schedule);
+    const float interval = getInterval(times, schedule);
+    if (interval < current * HYSTERESIS)
+    {
+        const Compounds& children = compound->getChildren();
+        LBASSERT(children.size() == schedule.size());
+        for (size_t i = 0; i < children.size(); ++i)
+        {
+            children[i]->setPeriod(schedule[i].period);
+            children[i]->setPhase(schedule[i].phase);
+            LBLOG(LOG_LB1) << children[i]->getChannel()->getName()
+                           << " time " << times[i] << "ms period "
+                           << schedule[i].period << " phase "
+                           << schedule[i].phase << std::endl;
+        }
+        _schedule = schedule;
+    }
+
+    const float time = getInterval(times, _schedule) * SLOWDOWN;
+    compound->setMaxFPS(1000.f / time);
+    LBLOG(LOG_LB2) << 1000.f / time << " Hz, " << time << "ms" << std::endl;
+}
+
+DPlexEqualizer::LoadListener::LoadListener()
+    : parent(0)
+    , nChannels(0)
+    , _frameNumber(0)
+    , _nReports(0)
+    , _startTime(std::numeric_limits<int64_t>::max())
+    , _endTime(0)
+    , _level(0.f)
+    , _trend(0.f)
+{
+}
+
+void DPlexEqualizer::LoadListener::notifyLoadData(
+    Channel* channel, const uint32_t frameNumber, const Statistics& statistics,
+    const Viewport& /*region*/)
+{
+    if (frameNumber != _frameNumber)
+    {
+        _commit(); // reports of the previous frame are incomplete
+        _frameNumber = frameNumber;
+    }
+
+    // gather required load data
+    for (size_t i = 0; i < statistics.size(); ++i)
+    {
+        const Statistic& data = statistics[i];
+        switch (data.type)
+        {
+        case Statistic::CHANNEL_CLEAR:
+        case Statistic::CHANNEL_DRAW:
+        case Statistic::CHANNEL_ASSEMBLE:
+        case Statistic::CHANNEL_READBACK:
+            _startTime = LB_MIN(_startTime, data.startTime);
+            _endTime = LB_MAX(_endTime, data.endTime);
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    LBLOG(LOG_LB2) << "Frame " << frameNumber << " channel "
+                   << channel->getName() << " time " << _endTime - _startTime
+                   << std::endl;
+    if (++_nReports >= nChannels)
+        _commit();
+}
+
+void DPlexEqualizer::LoadListener::_commit()
+{
+    const bool valid = _startTime != std::numeric_limits<int64_t>::max();
+    const float time = valid ? float(LB_MAX(_endTime - _startTime, 1)) : 0.f;
+
+    _nReports = 0;
+    _startTime = std::numeric_limits<int64_t>::max();
+    _endTime = 0;
+    if (!valid)
+        return;
+
+    if (_level <= 0.f)
+    {
+        _level = time;
+        return;
+    }
+
+    // double exponential smoothing to follow changing workloads
+    const float damping = parent->getDamping();
+    const float predicted = _level + _trend;
+    const float level = predicted + (time - predicted) * damping;
+    _trend += ((level - _level) - _trend) * damping;
+    _level = level;
+}
+
+float DPlexEqualizer::LoadListener::getTime() const
+{
+    if (_level <= 0.f)
+        return 0.f;
+    return LB_MAX(_level + _trend, _level * .5f);
+}
+
+std::ostream& operator<<(std::ostream& os, const DPlexEqualizer* lb)
+{
+    if (!lb)
+        return os;
+
+    os << lunchbox::disableFlush << "dplex_equalizer" << std::endl
+       << '{' << std::endl;
+
+    if (lb->getDamping() != 0.5f)
+        os << "    damping " << lb->getDamping() << std::endl;
+
+    os << '}' << std::endl << lunchbox::enableFlush;
+    return os;
+}
+}
+}
@@ -0,0 +1,143 @@
+
+/* Copyright (c) 2026, The Equalizer authors, see AUTHORS
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQS_DPLEXEQUALIZER_H
+#define EQS_DPLEXEQUALIZER_H
+
+#include "../channelListener.h" // base class
+#include "equalizer.h"          // base class
+
+#include <vector>
+
+namespace eq
+{
+namespace server
+{
+std::ostream& operator<<(std::ostream& os, const DPlexEqualizer*);
+
+/**
+ * Assigns the period and phase of the children of a DPlex compound.
+ *
+ * The frame time of each child is predicted from its recent draw times. Faster
+ * children are given a shorter period, so that each frame of the destination
+ * is rendered by exactly one child and all children keep up with a common
+ * output frame rate. The frame rate of the compound is limited to this rate,
+ * which delivers the output frames at evenly spaced intervals.
+ */
+class DPlexEqualizer : public Equalizer
+{
+public:
+    EQSERVER_API DPlexEqualizer();
+    DPlexEqualizer(const DPlexEqualizer& from);
+    virtual ~DPlexEqualizer();
+    void toStream(std::ostream& os) const final { os << this; }
+    /** @sa Equalizer::attach */
+    void attach(Compound* compound) final;
+
+    /** @sa CompoundListener::notifyUpdatePre */
+    void notifyUpdatePre(Compound* compound, const uint32_t frameNumber) final;
+
+    uint32_t getType() const final { return fabric::DPLEX_EQUALIZER; }
+    /** The period and phase assigned to one source. */
+    struct Slot
+    {
+        Slot()
+            : period(1)
+            , phase(0)
+        {
+        }
+        Slot(const uint32_t period_, const uint32_t phase_)
+            : period(period_)
+            , phase(phase_)
+        {
+        }
+
+        uint32_t period;
+        uint32_t phase;
+    };
+    typedef std::vector<Slot> Schedule;
+    typedef std::vector<float> Times;
+
+    /**
+     * Compute the period and phase for sources with the given frame times.
+     *
+     * The returned schedule assigns each frame of a cycle to exactly one
+     * source and minimizes the resulting output frame interval. Cycles up to
+     * maxPeriod frames are considered.
+     *
+     * @return the schedule, empty if no source is given.
+     */
+    static EQSERVER_API Schedule computeSchedule(const Times& times,
+                                                 uint32_t maxPeriod);
+
+    /** @return the output frame interval sustained by a schedule. */
+    static EQSERVER_API float getInterval(const Times& times,
+                                          const Schedule& schedule);
+
+protected:
+    void notifyChildAdded(Compound*, Compound*) override
+    {
+        LBASSERT(_loadListeners.empty());
+    }
+    void notifyChildRemove(Compound*, Compound*) override
+    {
+        LBASSERT(_loadListeners.empty());
+    }
+
+private:
+    /** Helper class connecting on child tree for load gathering. */
+    class LoadListener : public ChannelListener
+    {
+    public:
+        LoadListener();
+
+        /** @sa ChannelListener::notifyLoadData */
+        void notifyLoadData(Channel* channel, uint32_t frameNumber,
+                            const Statistics& statistics,
+                            const Viewport& region) final;
+
+        /** @return the predicted frame time, 0 if unknown. */
+        float getTime() const;
+
+        DPlexEqualizer* parent;
+        size_t nChannels; //!< The number of channels reporting
+
+    private:
+        uint32_t _frameNumber; //!< The frame currently gathered
+        size_t _nReports;      //!< Reports received for _frameNumber
+        int64_t _startTime;
+        int64_t _endTime;
+
+        float _level; //!< smoothed frame time
+        float _trend; //!< smoothed frame time change
+
+        void _commit();
+    };
+
+    /** One listener for each compound child. */
+    std::vector<LoadListener> _loadListeners;
+    friend class LoadListener;
+
+    Schedule _schedule; //!< The currently applied schedule
+
+    void _init();
+    void _exit();
+};
+}
+}
+
+#endif // EQS_DPLEXEQUALIZER_H
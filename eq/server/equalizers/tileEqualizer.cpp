@@ -22,10 +22,19 @@
 #include "../compound.h"
 #include "../compoundVisitor.h"
 #include "../config.h"
+#include "../log.h"
 #include "../server.h"
 #include "../tileQueue.h"
 #include "../view.h"
 
+#include <eq/fabric/statistic.h>
+
+#include <algorithm>
+#include <cmath>
+
+// Number of completed frames used to fit the tile cost model
+#define HISTORY_SIZE 8
+
 namespace eq
 {
 namespace server
@@ -106,22 +115,83 @@ public:
 private:
     const std::string& _name;
 };
+
+class SourceCollector : public CompoundVisitor
+{
+public:
+    explicit SourceCollector(const std::string& name)
+        : _name(name)
+    {
+    }
+
+    /** Visit a leaf compound. */
+    virtual VisitorResult visitLeaf(Compound* compound)
+    {
+        if (_findQueue(_name, compound->getInputTileQueues()))
+            compounds.push_back(compound);
+        return TRAVERSE_CONTINUE;
+    }
+
+    Compounds compounds;
+
+private:
+    const std::string& _name;
+};
+
+uint32_t _getNumTiles(const PixelViewport& pvp, const Vector2i& size)
+{
+    return (pvp.w / size.x() + ((pvp.w % size.x()) ? 1 : 0)) *
+           (pvp.h / size.y() + ((pvp.h % size.y()) ? 1 : 0));
+}
 }
 
 TileEqualizer::TileEqualizer()
     : Equalizer()
     , _created(false)
+    , _autoSize(false)
     , _name("TileEqualizer")
+    , _minSize(16, 16)
+    , _maxSize(512, 512)
+    , _adaptedFrame(0)
 {
 }
 
 TileEqualizer::TileEqualizer(const TileEqualizer& from)
     : Equalizer(from)
     , _created(from._created)
+    , _autoSize(from._autoSize)
     , _name(from._name)
+    , _minSize(from._minSize)
+    , _maxSize(from._maxSize)
+    , _adaptedFrame(0)
 {
 }
 
+TileEqualizer::~TileEqualizer()
+{
+    attach(0);
+}
+
+void TileEqualizer::attach(Compound* compound)
+{
+    _unsubscribe();
+    Equalizer::attach(compound);
+}
+
+void TileEqualizer::setSizeBounds(const Vector2i& minSize,
+                                  const Vector2i& maxSize)
+{
+    _minSize.x() = LB_MAX(minSize.x(), 1);
+    _minSize.y() = LB_MAX(minSize.y(), 1);
+    _maxSize.x() = LB_MAX(maxSize.x(), _minSize.x());
+    _maxSize.y() = LB_MAX(maxSize.y(), _minSize.y());
+
+    if (_minSize != minSize || _maxSize != maxSize)
+        LBWARN << "Invalid tile size bounds [ " << minSize << " " << maxSize
+               << " ], using [ " << _minSize << " " << _maxSize << " ]"
+               << std::endl;
+}
+
 std::string TileEqualizer::_getQueueName() const
 {
     std::ostringstream name;
@@ -147,6 +217,9 @@ void TileEqualizer::_createQueues(Compound* compound)
 
     InputQueueCreator creator(getTileSize(), name);
     compound->accept(creator);
+
+    if (_autoSize)
+        _subscribe(compound);
 }
 
 void TileEqualizer::_destroyQueues(Compound* compound)
@@ -162,19 +235,231 @@ void TileEqualizer::_destroyQueues(Compound* compound)
         delete q;
     }
 
+    _unsubscribe();
+
     InputQueueDestroyer destroyer(name);
     compound->accept(destroyer);
     _created = false;
 }
 
+void TileEqualizer::_subscribe(Compound* compound)
+{
+    LBASSERT(_sources.empty());
+    SourceCollector collector(_getQueueName());
+    compound->accept(collector);
+
+    for (Compound* source : collector.compounds)
+    {
+        Channel* channel = source->getChannel();
+        LBASSERT(channel);
+        if (!channel)
+            continue;
+
+        channel->addListener(this);
+        _sources.push_back(Source(channel, source->getTaskID()));
+    }
+}
+
+void TileEqualizer::_unsubscribe()
+{
+    for (const Source& source : _sources)
+        source.channel->removeListener(this);
+    _sources.clear();
+    _history.clear();
+    _adaptedFrame = 0;
+}
+
 void TileEqualizer::notifyUpdatePre(Compound* compound,
-                                    const uint32_t /*frame*/)
+                                    const uint32_t frameNumber)
 {
     if (isActive() && !_created)
         _createQueues(compound);
 
     if (!isActive() && _created)
         _destroyQueues(compound);
+
+    if (!_created)
+        return;
+
+    if (_autoSize && _sources.empty())
+        _subscribe(compound);
+    else if (!_autoSize && !_sources.empty())
+        _unsubscribe();
+
+    if (_autoSize && !isFrozen() && compound->isActive())
+        _adaptSize(compound, frameNumber);
+}
+
+void TileEqualizer::notifyLoadData(Channel* channel, const uint32_t frameNumber,
+                                   const Statistics& statistics,
+                                   const Viewport& /*region*/)
+{
+    for (FrameLoad& load : _history)
+    {
+        if (load.frameNumber != frameNumber)
+            continue;
+
+        for (const Source& source : _sources)
+        {
+            if (source.channel != channel)
+                continue;
+
+            // Channel::_frameTiles reports the summed times of all tiles
+            // processed by this source back-to-back from the start time
+            int64_t startTime = std::numeric_limits<int64_t>::max();
+            int64_t endTime = 0;
+            for (const Statistic& stat : statistics)
+            {
+                if (stat.task != source.taskID)
+                    continue;
+
+                switch (stat.type)
+                {
+                case Statistic::CHANNEL_CLEAR:
+                case Statistic::CHANNEL_DRAW:
+                case Statistic::CHANNEL_READBACK:
+                    startTime = LB_MIN(startTime, stat.startTime);
+                    endTime = LB_MAX(endTime, stat.endTime);
+                    break;
+
+                default:
+                    break;
+                }
+            }
+
+            ++load.nReports;
+            if (startTime == std::numeric_limits<int64_t>::max())
+                return; // source did not get any tile
+
+            load.busyTime += endTime - startTime;
+            load.endTimes.push_back(endTime);
+            LBLOG(LOG_LB2) << "Tile time " << endTime - startTime << " for "
+                           << channel->getName() << " @ " << frameNumber
+                           << std::endl;
+            return;
+        }
+        return;
+    }
+}
+
+void TileEqualizer::_adaptSize(Compound* compound, const uint32_t frameNumber)
+{
+    // Gather completed frames, newest first
+    const size_t nSources = _sources.size();
+    FrameLoads loads;
+    for (std::deque<FrameLoad>::const_reverse_iterator i = _history.rbegin();
+         i != _history.rend(); ++i)
+    {
+        if (i->nReports == nSources && !i->endTimes.empty())
+            loads.push_back(*i);
+    }
+
+    const Vector2i& size = getTileSize();
+    Vector2i newSize = size;
+    if (!loads.empty() && nSources > 0 &&
+        loads.front().frameNumber != _adaptedFrame)
+    {
+        _adaptedFrame = loads.front().frameNumber;
+        newSize = computeTileSize(loads, nSources, size, getDamping(),
+                                  _minSize, _maxSize);
+    }
+
+    if (newSize != size)
+    {
+        setTileSize(newSize);
+        TileQueue* output =
+            _findQueue(_getQueueName(), compound->getOutputTileQueues());
+        if (output)
+            output->setTileSize(newSize);
+    }
+
+    // Start gathering data for this frame
+    const PixelViewport& pvp = compound->getInheritPixelViewport();
+    if (!pvp.hasArea())
+        return;
+
+    _history.push_back(FrameLoad());
+    FrameLoad& load = _history.back();
+    load.frameNumber = frameNumber;
+    load.nTiles = _getNumTiles(pvp, newSize);
+    load.area = int64_t(pvp.w) * int64_t(pvp.h);
+
+    while (_history.size() > HISTORY_SIZE)
+        _history.pop_front();
+}
+
+Vector2i TileEqualizer::computeTileSize(const FrameLoads& loads,
+                                        const size_t nSources,
+                                        const Vector2i& size,
+                                        const float damping,
+                                        const Vector2i& minSize,
+                                        const Vector2i& maxSize)
+{
+    if (loads.empty() || nSources == 0)
+        return size;
+
+    // Fit busyTime = overhead * nTiles + pixelTime with least squares. The
+    // idle time of each source waiting on the slowest source is measured as a
+    // multiple of the average tile cost.
+    double sumN = 0., sumB = 0., sumNN = 0., sumNB = 0., sumIdle = 0.;
+    for (const FrameLoad& load : loads)
+    {
+        const double nTiles = LB_MAX(load.nTiles, 1u);
+        const double busy = double(load.busyTime);
+        double idle = 0.;
+        if (!load.endTimes.empty())
+        {
+            const int64_t lastEnd =
+                *std::max_element(load.endTimes.begin(), load.endTimes.end());
+            for (const int64_t endTime : load.endTimes)
+                idle += double(lastEnd - endTime);
+        }
+
+        const double tileCost = LB_MAX(busy / nTiles, 1.);
+        sumIdle += idle / double(nSources) / tileCost;
+        sumN += nTiles;
+        sumB += busy;
+        sumNN += nTiles * nTiles;
+        sumNB += nTiles * busy;
+    }
+
+    const double n = double(loads.size());
+    const double variance = n * sumNN - sumN * sumN;
+    const double relIdle = sumIdle / n;
+    const double tailFactor = LB_MIN(LB_MAX(relIdle, .1), 1.);
+    double overhead = 0.;
+    double pixelTime = 0.;
+    if (variance > 0.)
+    {
+        overhead = (n * sumNB - sumN * sumB) / variance;
+        pixelTime = (sumB - overhead * sumN) / n;
+    }
+
+    float target = float(size.x() * size.y());
+    if (overhead > 0. && pixelTime > 0.)
+    {
+        // Minimizes (overhead * area / tile + pixelTime) / nSources +
+        //           tailFactor * (overhead + pixelTime * tile / area)
+        const double area = double(loads.front().area);
+        target = float(area * std::sqrt(overhead / (double(nSources) *
+                                                    tailFactor * pixelTime)));
+    }
+    else // not enough variation to fit the model, probe towards balance
+        target *= relIdle > .5 ? .8f : 1.25f;
+
+    const float current = float(size.x() * size.y());
+    const float area = current + (target - current) * damping;
+    const float aspect = float(size.x()) / float(size.y());
+    Vector2i newSize(int32_t(std::sqrt(area * aspect) + .5f),
+                     int32_t(std::sqrt(area / aspect) + .5f));
+    newSize.x() = LB_MIN(LB_MAX(newSize.x(), minSize.x()), maxSize.x());
+    newSize.y() = LB_MIN(LB_MAX(newSize.y(), minSize.y()), maxSize.y());
+
+    LBLOG(LOG_LB1) << "Tile size " << size << " -> " << newSize
+                   << ", overhead " << overhead << " pixel time " << pixelTime
+                   << " tail " << relIdle << " from " << loads.size()
+                   << " frames" << std::endl;
+    return newSize;
 }
 
 std::ostream& operator<<(std::ostream& os, const TileEqualizer* lb)
@@ -183,10 +468,14 @@ std::ostream& operator<<(std::ostream& os, const TileEqualizer* lb)
     {
         os << lunchbox::disableFlush << "tile_equalizer" << std::endl
            << "{" << std::endl
-           << "    name \"" << lb->getName() << "\"" << std::endl
-           << "    size " << lb->getTileSize() << std::endl
-           << "}" << std::endl
-           << lunchbox::enableFlush;
+           << "    name \"" << lb->getName() << "\"" << std::endl;
+        if (lb->isAutoSize())
+            os << "    size AUTO [ " << lb->getMinSize().x() << ' '
+               << lb->getMinSize().y() << ' ' << lb->getMaxSize().x() << ' '
+               << lb->getMaxSize().y() << " ]" << std::endl;
+        else
+            os << "    size " << lb->getTileSize() << std::endl;
+        os << "}" << std::endl << lunchbox::enableFlush;
     }
     return os;
 }
@@ -19,7 +19,11 @@
 #ifndef EQS_TILEEQUALIZER_H
 #define EQS_TILEEQUALIZER_H
 
-#include "equalizer.h"
+#include "../channelListener.h" // base class
+#include "equalizer.h"          // base class
+
+#include <deque>
+#include <vector>
 
 namespace eq
 {
@@ -27,19 +31,95 @@ namespace server
 {
 std::ostream& operator<<(std::ostream& os, const TileEqualizer*);
 
-class TileEqualizer : public Equalizer
+/**
+ * Distributes the work of a compound as a queue of tiles to its children.
+ *
+ * In auto size mode, the tile size is adapted each frame from the clear, draw
+ * and readback times reported by the sources. The per-tile overhead and the
+ * per-pixel cost are estimated from the recent frames, and the tile size is
+ * chosen to minimize the sum of the queue overhead and the idle time of the
+ * sources waiting on the last tiles of a frame.
+ */
+class TileEqualizer : public Equalizer, protected ChannelListener
 {
 public:
     EQSERVER_API TileEqualizer();
     TileEqualizer(const TileEqualizer& from);
-    ~TileEqualizer() {}
+    ~TileEqualizer();
     /** @sa CompoundListener::notifyUpdatePre */
     void notifyUpdatePre(Compound* compound, const uint32_t frameNumber) final;
 
+    /** @sa ChannelListener::notifyLoadData */
+    void notifyLoadData(Channel* channel, uint32_t frameNumber,
+                        const Statistics& statistics,
+                        const Viewport& region) final;
+
+    /** @sa Equalizer::attach */
+    void attach(Compound* compound) final;
+
     void toStream(std::ostream& os) const final { os << this; }
     void setName(const std::string& name) { _name = name; }
     const std::string& getName() const { return _name; }
     uint32_t getType() const final { return fabric::TILE_EQUALIZER; }
+    /** Enable or disable the automatic adaptation of the tile size. */
+    void setAutoSize(const bool onOff) { _autoSize = onOff; }
+
+    /** @return true if the tile size is adapted automatically. */
+    bool isAutoSize() const { return _autoSize; }
+
+    /**
+     * Set the minimum and maximum tile size used in auto size mode.
+     *
+     * Invalid bounds are clamped to a minimum of one pixel and a maximum not
+     * below the minimum.
+     */
+    EQSERVER_API void setSizeBounds(const Vector2i& minSize,
+                                    const Vector2i& maxSize);
+
+    /** @return the minimum tile size used in auto size mode. */
+    const Vector2i& getMinSize() const { return _minSize; }
+
+    /** @return the maximum tile size used in auto size mode. */
+    const Vector2i& getMaxSize() const { return _maxSize; }
+
+    /** The load reported by all sources for one frame. */
+    struct FrameLoad
+    {
+        FrameLoad()
+            : frameNumber(0)
+            , nTiles(0)
+            , nReports(0)
+            , area(0)
+            , busyTime(0)
+        {
+        }
+        uint32_t frameNumber;
+        uint32_t nTiles;   //!< number of tiles generated
+        uint32_t nReports; //!< number of sources which reported their load
+        int64_t area;    //!< pixel area of the tiled viewport
+        int64_t busyTime; //!< summed clear, draw and readback of all sources
+        std::vector<int64_t> endTimes; //!< per source end of the last tile
+    };
+    typedef std::vector<FrameLoad> FrameLoads;
+
+    /**
+     * Compute the tile size for the next frame in auto size mode.
+     *
+     * @param loads the completed frames, newest first.
+     * @param nSources the number of tile sources.
+     * @param size the current tile size.
+     * @param damping the fraction of the change towards the optimum applied.
+     * @param minSize the minimum tile size.
+     * @param maxSize the maximum tile size.
+     * @return the new tile size, within the given bounds.
+     */
+    static EQSERVER_API Vector2i computeTileSize(const FrameLoads& loads,
+                                                 size_t nSources,
+                                                 const Vector2i& size,
+                                                 float damping,
+                                                 const Vector2i& minSize,
+                                                 const Vector2i& maxSize);
+
 protected:
     void notifyChildAdded(Compound*, Compound*) override {}
     void notifyChildRemove(Compound*, Compound*) override {}
@@ -48,8 +128,31 @@ private:
     void _destroyQueues(Compound* compound);
     void _createQueues(Compound* compound);
 
+    void _subscribe(Compound* compound);
+    void _unsubscribe();
+    void _adaptSize(Compound* compound, uint32_t frameNumber);
+
     bool _created;
+    bool _autoSize;
     std::string _name;
+    Vector2i _minSize;
+    Vector2i _maxSize;
+    uint32_t _adaptedFrame; //!< newest frame used for the last adaptation
+
+    /** A tile source, identified by its channel and compound task. */
+    struct Source
+    {
+        Source(Channel* c, const uint32_t t)
+            : channel(c)
+            , taskID(t)
+        {
+        }
+        Channel* channel;
+        uint32_t taskID;
+    };
+    std::vector<Source> _sources;
+
+    std::deque<FrameLoad> _history;
 };
 
 } // server
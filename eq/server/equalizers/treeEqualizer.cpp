@@ -19,11 +19,18 @@
 #include "treeEqualizer.h"
 
 #include "../compound.h"
+#include "../frame.h"
 #include "../log.h"
 
 #include <eq/fabric/statistic.h>
 #include <lunchbox/debug.h>
 
+#include <algorithm>
+#include <limits>
+
+#define HISTORY 8      // frames used to predict the cost of a leaf
+#define MAX_PENDING 32 // assignments kept while waiting for their load data
+
 namespace eq
 {
 namespace server
@@ -32,7 +39,8 @@ std::ostream& operator<<(std::ostream& os, const TreeEqualizer::Node*);
 
 // The tree load balancer organizes the children in a binary tree. At each
 // level, a relative split position is determined by balancing the left subtree
-// against the right subtree.
+// against the right subtree. The time of each subtree is predicted as a linear
+// function of its work, fitted from the per-stage statistics of its leafs.
 
 TreeEqualizer::TreeEqualizer()
     : _tree(0)
@@ -55,7 +63,7 @@ TreeEqualizer::~TreeEqualizer()
 }
 
 void TreeEqualizer::notifyUpdatePre(Compound* compound,
-                                    const uint32_t /*frame*/)
+                                    const uint32_t frameNumber)
 {
     if (isFrozen() || !compound->isActive() || !isActive())
         return;
@@ -82,7 +90,7 @@ void TreeEqualizer::notifyUpdatePre(Compound* compound,
     // compute new data
     _update(_tree);
     _split(_tree);
-    _assign(_tree, Viewport(), Range());
+    _assign(_tree, Viewport(), Range(), frameNumber);
     LBLOG(LOG_LB2) << "LB tree: " << _tree;
 }
 
@@ -136,54 +144,77 @@ void TreeEqualizer::_clearTree(Node* node)
     }
 }
 
-void TreeEqualizer::notifyLoadData(Channel* channel, const uint32_t /*frame*/,
+void TreeEqualizer::notifyLoadData(Channel* channel,
+                                   const uint32_t frameNumber,
                                    const Statistics& statistics,
                                    const Viewport& /*region*/)
 {
-    _notifyLoadData(_tree, channel, statistics);
+    _notifyLoadData(_tree, channel, frameNumber, statistics);
 }
 
 void TreeEqualizer::_notifyLoadData(Node* node, Channel* channel,
+                                    const uint32_t frameNumber,
                                     const Statistics& statistics)
 {
     if (!node)
         return;
 
-    _notifyLoadData(node->left, channel, statistics);
-    _notifyLoadData(node->right, channel, statistics);
+    _notifyLoadData(node->left, channel, frameNumber, statistics);
+    _notifyLoadData(node->right, channel, frameNumber, statistics);
 
     if (!node->compound || node->compound->getChannel() != channel)
         return;
 
-    // gather relevant load data
+    std::map<uint32_t, float>::iterator i = node->works.find(frameNumber);
+    if (i == node->works.end())
+        return;
+
+    const float work = i->second;
+    node->works.erase(node->works.begin(), ++i);
+    if (work <= 0.f)
+        return;
+
+    // gather relevant load data, stage by stage
     const uint32_t taskID = node->compound->getTaskID();
-    int64_t startTime = std::numeric_limits<int64_t>::max();
-    int64_t endTime = 0;
+    Stages stages;
     bool loadSet = false;
-    int64_t timeTransmit = 0;
-    for (size_t i = 0; i < statistics.size() && !loadSet; ++i)
+    for (const Statistic& stat : statistics)
     {
-        const Statistic& stat = statistics[i];
         if (stat.task != taskID) // from different compound
             continue;
 
+        const float time = float(stat.endTime - stat.startTime);
+
         switch (stat.type)
         {
         case Statistic::CHANNEL_CLEAR:
         case Statistic::CHANNEL_DRAW:
-        case Statistic::CHANNEL_READBACK:
-            startTime = LB_MIN(startTime, stat.startTime);
-            endTime = LB_MAX(endTime, stat.endTime);
+            stages.draw += time;
+            loadSet = true;
             break;
 
+        case Statistic::CHANNEL_READBACK:
         case Statistic::CHANNEL_ASYNC_READBACK:
+            stages.readback += time;
+            break;
+
+        case Statistic::CHANNEL_FRAME_COMPRESS:
+            stages.compress += time;
+            break;
+
         case Statistic::CHANNEL_FRAME_TRANSMIT:
-            timeTransmit += stat.endTime - stat.startTime;
+            stages.transmit += time;
             break;
 
-        // assemble blocks on input frames, stop using subsequent data
+        // The leaf composites the inputs it receives from other leafs, which is
+        // the compositing of an inner node. The final assembly of the
+        // destination is not part of any leaf's task.
         case Statistic::CHANNEL_ASSEMBLE:
-            loadSet = true;
+            stages.composite += time;
+            break;
+
+        case Statistic::CHANNEL_FRAME_WAIT_READY:
+            stages.composite -= time;
             break;
 
         default:
@@ -191,12 +222,99 @@ void TreeEqualizer::_notifyLoadData(Node* node, Channel* channel,
         }
     }
 
-    if (startTime == std::numeric_limits<int64_t>::max())
+    if (!loadSet)
         return;
 
-    node->time = endTime - startTime;
-    node->time = LB_MAX(node->time, 1);
-    node->time = LB_MAX(node->time, timeTransmit);
+    // compression is sampled within the transmission
+    stages.transmit = LB_MAX(stages.transmit - stages.compress, 0.f);
+    stages.composite = LB_MAX(stages.composite, 0.f);
+    node->history.push_back(stages);
+    node->historyWork.push_back(work);
+    if (node->history.size() > HISTORY)
+    {
+        node->history.pop_front();
+        node->historyWork.pop_front();
+    }
+}
+
+TreeEqualizer::Cost TreeEqualizer::predict(const Stages& stages,
+                                           const float work, const Mode mode)
+{
+    LBASSERT(work > 0.f);
+
+    // The images of a DB decomposition always cover the full viewport, only
+    // the draw time depends on the range. The compositing is accounted for by
+    // the inner nodes.
+    const float pixels = stages.readback + stages.compress + stages.transmit;
+    if (mode == MODE_DB)
+        return Cost(pixels, stages.draw / work);
+    return Cost(0.f, (stages.draw + pixels) / work);
+}
+
+float TreeEqualizer::computeSplit(const Cost& left, const Cost& right,
+                                  const float work)
+{
+    const float rates = left.rate + right.rate;
+    if (rates <= 0.f)
+        return .5f;
+
+    // left.fixed + left.rate * x = right.fixed + right.rate * ( work - x )
+    const float split =
+        work > 0.f
+            ? (right.fixed - left.fixed + right.rate * work) / rates / work
+            : right.rate / rates;
+    return LB_MIN(LB_MAX(split, 0.f), 1.f);
+}
+
+TreeEqualizer::Cost TreeEqualizer::combine(const Cost& left, const Cost& right,
+                                           const float work,
+                                           const float composite)
+{
+    const float rates = left.rate + right.rate;
+    const float split = computeSplit(left, right, work);
+    Cost cost;
+
+    if (rates <= 0.f)
+        cost.fixed = LB_MAX(left.fixed, right.fixed);
+    else if (split <= 0.f)
+        cost = right;
+    else if (split >= 1.f)
+        cost = left;
+    else
+    {
+        cost.rate = left.rate * right.rate / rates;
+        cost.fixed = (right.rate * left.fixed + left.rate * right.fixed) / rates;
+    }
+
+    cost.fixed += composite;
+    return cost;
+}
+
+float TreeEqualizer::_getComposite(const Node* to, const Node* from) const
+{
+    if (!to->compound)
+        return _getComposite(to->left, from) + _getComposite(to->right, from);
+
+    float composite = 0.f;
+    for (const Frame* input : to->compound->getInputFrames())
+    {
+        std::vector<const Node*> nodes(1, from);
+        while (!nodes.empty())
+        {
+            const Node* node = nodes.back();
+            nodes.pop_back();
+            if (!node->compound)
+            {
+                nodes.push_back(node->left);
+                nodes.push_back(node->right);
+                continue;
+            }
+            for (const Frame* output : node->compound->getOutputFrames())
+                if (output->getName() == input->getName())
+                    composite += to->composite;
+        }
+    }
+    return composite;
 }
 
 void TreeEqualizer::_update(Node* node)
@@ -219,6 +337,31 @@ void TreeEqualizer::_update(Node* node)
         node->boundary2i = getBoundary2i();
         node->resistancef = getResistancef();
         node->resistance2i = getResistance2i();
+
+        if (node->history.empty())
+        {
+            // no data yet, distribute work by usage
+            const float resources = LB_MAX(node->resources, 0.0001f);
+            node->cost = Cost(0.f, 1.f / resources);
+            node->composite = 0.f;
+            return;
+        }
+
+        node->cost = Cost();
+        node->composite = 0.f;
+        for (size_t i = 0; i < node->history.size(); ++i)
+        {
+            const Cost cost =
+                predict(node->history[i], node->historyWork[i], node->mode);
+            node->cost.fixed += cost.fixed;
+            node->cost.rate += cost.rate;
+            node->composite += node->history[i].composite;
+        }
+        const float nSamples = float(node->history.size());
+        const size_t nInputs = compound->getInputFrames().size();
+        node->cost.fixed /= nSamples;
+        node->cost.rate /= nSamples;
+        node->composite /= nSamples * float(LB_MAX(nInputs, size_t(1)));
         return;
     }
     // else
@@ -252,7 +395,7 @@ void TreeEqualizer::_update(Node* node)
         node->boundaryf = node->right->boundaryf;
         node->resistance2i = node->right->resistance2i;
         node->resistancef = node->right->resistancef;
-        node->time = node->right->time;
+        node->cost = node->right->cost;
     }
     else if (node->right->resources == 0.f)
     {
@@ -261,7 +404,7 @@ void TreeEqualizer::_update(Node* node)
         node->boundaryf = node->left->boundaryf;
         node->resistance2i = node->left->resistance2i;
         node->resistancef = node->left->resistancef;
-        node->time = node->left->time;
+        node->cost = node->left->cost;
     }
     else
     {
@@ -320,7 +463,10 @@ void TreeEqualizer::_update(Node* node)
             LBUNIMPLEMENTED;
         }
 
-        node->time = node->left->time + node->right->time;
+        node->composite = _getComposite(node->left, node->right) +
+                          _getComposite(node->right, node->left);
+        node->cost = combine(node->left->cost, node->right->cost, node->work,
+                             node->composite);
     }
 }
 
@@ -345,22 +491,12 @@ void TreeEqualizer::_split(Node* node)
     }
 
     // new split
-    const float target = node->time * left->resources / node->resources;
-    const float leftTime = float(left->time);
-    float split = 0.f;
-    const float rightTime = float(right->time);
+    const float split = computeSplit(left->cost, right->cost, node->work);
 
-    if (leftTime >= target)
-        split = target / leftTime * node->split;
-    else
-    {
-        const float timeLeft = target - leftTime;
-        split = node->split + timeLeft / rightTime * (1.f - node->split);
-    }
-
-    LBLOG(LOG_LB2) << "Should split at " << split << " (" << target << ": "
-                   << leftTime << " by " << left->resources << "/" << rightTime
-                   << " by " << right->resources << ")" << std::endl;
+    LBLOG(LOG_LB2) << "Should split at " << split << " (" << left->cost.fixed
+                   << " + " << left->cost.rate << " / " << right->cost.fixed
+                   << " + " << right->cost.rate << " for " << node->work
+                   << ")" << std::endl;
     node->split = (1.f - getDamping()) * split + getDamping() * node->split;
     LBLOG(LOG_LB2) << "Dampened split at " << node->split << std::endl;
 
@@ -368,15 +504,19 @@ void TreeEqualizer::_split(Node* node)
     _split(right);
 }
 
-void TreeEqualizer::_assign(Node* node, const Viewport& vp, const Range& range)
+void TreeEqualizer::_assign(Node* node, const Viewport& vp, const Range& range,
+                            const uint32_t frameNumber)
 {
-    LBLOG(LOG_LB2) << "assign " << vp << ", " << range << " time " << node->time
-                   << " split " << node->split << std::endl;
+    LBLOG(LOG_LB2) << "assign " << vp << ", " << range << " cost "
+                   << node->cost.fixed << " + " << node->cost.rate << " split "
+                   << node->split << std::endl;
     LBASSERTINFO(vp.isValid(), vp);
     LBASSERTINFO(range.isValid(), range);
     LBASSERTINFO(node->resources > 0.f || !vp.hasArea() || !range.hasData(),
                  "Assigning work to unused compound: " << vp << ", " << range);
 
+    node->work = vp.getArea() * (range.end - range.start);
+
     Compound* compound = node->compound;
     if (compound)
     {
@@ -385,6 +525,10 @@ void TreeEqualizer::_assign(Node* node, const Viewport& vp, const Range& range)
 
         compound->setViewport(vp);
         compound->setRange(range);
+
+        node->works[frameNumber] = node->work;
+        if (node->works.size() > MAX_PENDING)
+            node->works.erase(node->works.begin());
         LBLOG(LOG_LB2) << compound->getChannel()->getName() << " set " << vp
                        << ", " << range << std::endl;
         return;
@@ -448,7 +592,7 @@ void TreeEqualizer::_assign(Node* node, const Viewport& vp, const Range& range)
         // traverse children
         Viewport childVP = vp;
         childVP.w = (absoluteSplit - vp.x);
-        _assign(node->left, childVP, range);
+        _assign(node->left, childVP, range, frameNumber);
 
         childVP.x = childVP.getXEnd();
         childVP.w = end - childVP.x;
@@ -459,7 +603,7 @@ void TreeEqualizer::_assign(Node* node, const Viewport& vp, const Range& range)
         while (childVP.getXEnd() < end)
             childVP.w += std::numeric_limits<float>::epsilon();
 
-        _assign(node->right, childVP, range);
+        _assign(node->right, childVP, range, frameNumber);
         break;
     }
 
@@ -519,7 +663,7 @@ void TreeEqualizer::_assign(Node* node, const Viewport& vp, const Range& range)
         // traverse children
         Viewport childVP = vp;
         childVP.h = (absoluteSplit - vp.y);
-        _assign(node->left, childVP, range);
+        _assign(node->left, childVP, range, frameNumber);
 
         childVP.y = childVP.getYEnd();
         childVP.h = end - childVP.y;
@@ -530,7 +674,7 @@ void TreeEqualizer::_assign(Node* node, const Viewport& vp, const Range& range)
         while (childVP.getYEnd() < end)
             childVP.h += std::numeric_limits<float>::epsilon();
 
-        _assign(node->right, childVP, range);
+        _assign(node->right, childVP, range, frameNumber);
         break;
     }
 
@@ -573,11 +717,11 @@ void TreeEqualizer::_assign(Node* node, const Viewport& vp, const Range& range)
 
         Range childRange = range;
         childRange.end = absoluteSplit;
-        _assign(node->left, vp, childRange);
+        _assign(node->left, vp, childRange, frameNumber);
 
         childRange.start = childRange.end;
         childRange.end = range.end;
-        _assign(node->right, vp, childRange);
+        _assign(node->right, vp, childRange, frameNumber);
         break;
     }
 
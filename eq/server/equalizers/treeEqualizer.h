@@ -26,6 +26,7 @@
 #include <eq/fabric/viewport.h> // member
 
 #include <deque>
+#include <map>
 #include <vector>
 
 namespace eq
@@ -34,7 +35,17 @@ namespace server
 {
 std::ostream& operator<<(std::ostream& os, const TreeEqualizer*);
 
-/** Adapts the 2D tiling or DB range of the attached compound's children. */
+/**
+ * Adapts the 2D tiling or DB range of the attached compound's children.
+ *
+ * The draw, readback, compression and transmission times of each leaf are
+ * smoothed over a history window and modelled separately, since only the draw
+ * time scales with the range of a DB decomposition. Each inner node splits its
+ * work to equalize the predicted critical path of its children, including the
+ * compositing of the inputs one subtree receives from the other. This
+ * compositing is measured on the leaf channels assembling these inputs, the
+ * final assembly of the destination does not depend on the split.
+ */
 class TreeEqualizer : public Equalizer, protected ChannelListener
 {
 public:
@@ -51,6 +62,70 @@ public:
                         const Viewport& region) final;
 
     uint32_t getType() const final { return fabric::TREE_EQUALIZER; }
+    /** The per-stage times of one source for one frame, in milliseconds. */
+    struct Stages
+    {
+        Stages()
+            : draw(0.f)
+            , readback(0.f)
+            , compress(0.f)
+            , transmit(0.f)
+            , composite(0.f)
+        {
+        }
+
+        float draw;      //!< clear and draw
+        float readback;  //!< synchronous and asynchronous readback
+        float compress;  //!< compression of the output images
+        float transmit;  //!< transmission of the output images
+        float composite; //!< assembly of the leaf's inputs, no waiting
+    };
+
+    /**
+     * The predicted time of a subtree as a linear function of its work.
+     *
+     * The work is the fraction of the destination viewport or database range
+     * assigned to the subtree.
+     */
+    struct Cost
+    {
+        Cost()
+            : fixed(0.f)
+            , rate(0.f)
+        {
+        }
+        Cost(const float fixed_, const float rate_)
+            : fixed(fixed_)
+            , rate(rate_)
+        {
+        }
+
+        float operator()(const float work) const { return fixed + rate * work; }
+        float fixed; //!< time independent of the work
+        float rate;  //!< time for the full work
+    };
+
+    /**
+     * @return the cost of a source which needed the given stage times for
+     *         the given work.
+     */
+    static EQSERVER_API Cost predict(const Stages& stages, float work,
+                                     Mode mode);
+
+    /**
+     * @return the part of the work assigned to the left child which
+     *         equalizes the predicted times of both children, in [0, 1].
+     */
+    static EQSERVER_API float computeSplit(const Cost& left, const Cost& right,
+                                           float work);
+
+    /**
+     * @return the cost of an inner node splitting its work optimally between
+     *         its children and compositing their results.
+     */
+    static EQSERVER_API Cost combine(const Cost& left, const Cost& right,
+                                     float work, float composite);
+
 protected:
     void notifyChildAdded(Compound*, Compound*) override { LBASSERT(!_tree); }
     void notifyChildRemove(Compound*, Compound*) override { LBASSERT(!_tree); }
@@ -67,7 +142,8 @@ private:
             , oldsplit(0.0f)
             , boundaryf(0.0f)
             , resistancef(0.0f)
-            , time(1)
+            , work(0.0f)
+            , composite(0.0f)
         {
         }
         ~Node()
@@ -88,7 +164,14 @@ private:
         float resistancef;
         Vector2i resistance2i;
         Vector2i maxSize;
-        int64_t time;
+        float work;      //!< The last assigned fraction of the total work
+        Cost cost;       //!< The predicted cost of the subtree
+        float composite; //!< Compositing time, per input frame on leafs
+
+        // leaf nodes only:
+        std::map<uint32_t, float> works; //!< Work assigned per frame
+        std::deque<Stages> history;      //!< Recent stage times
+        std::deque<float> historyWork;   //!< The work for each history entry
     };
     friend std::ostream& operator<<(std::ostream& os, const Node* node);
     typedef std::vector<Node*> LBNodes;
@@ -102,15 +185,19 @@ private:
     /** Clear the tree, does not delete the nodes. */
     void _clearTree(Node* node);
 
-    void _notifyLoadData(Node* node, Channel* channel,
+    void _notifyLoadData(Node* node, Channel* channel, uint32_t frameNumber,
                          const Statistics& statistics);
 
+    /** @return the compositing time of the inputs 'to' receives from 'from'. */
+    float _getComposite(const Node* to, const Node* from) const;
+
     /** Update all node fields influencing the split */
     void _update(Node* node);
 
-    /** Adjust the split of each node based on the front-most _history. */
+    /** Adjust the split of each node based on the cost of its children. */
     void _split(Node* node);
-    void _assign(Node* node, const Viewport& vp, const Range& range);
+    void _assign(Node* node, const Viewport& vp, const Range& range,
+                 uint32_t frameNumber);
 };
 }
 }
@@ -25,23 +25,26 @@
 
 #include <eq/fabric/statistic.h>
 
-#include <set>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
 
-#define MIN_USAGE .1f // 10%
+#define MIN_USAGE .1f   // 10%
+#define MIN_SHARE .01f  // smallest share used to measure costs
+#define HYSTERESIS .95f // minimum improvement to apply new shares
+#define SMOOTHING .5f   // weight of a new cost measurement
 
 namespace eq
 {
 namespace server
 {
 ViewEqualizer::ViewEqualizer()
-    : _nPipes(0)
 {
     LBINFO << "New view equalizer @" << (void*)this << std::endl;
 }
 
 ViewEqualizer::ViewEqualizer(const ViewEqualizer& from)
     : Equalizer(from)
-    , _nPipes(0)
 {
 }
 
@@ -65,6 +68,9 @@ void ViewEqualizer::attach(Compound* compound)
         (*i).clear();
 
     _listeners.clear();
+    _costs.clear();
+    _shares.clear();
+    _times.clear();
     Equalizer::attach(compound);
 }
 
@@ -80,91 +86,129 @@ void ViewEqualizer::notifyUpdatePre(Compound* compound LB_UNUSED,
 
 namespace
 {
-class SelfAssigner : public CompoundVisitor
+typedef ViewEqualizer::Cost Cost;
+typedef ViewEqualizer::Costs Costs;
+typedef ViewEqualizer::Shares Shares;
+
+float _getCost(const Cost& cost)
 {
-public:
-    SelfAssigner(const Pipe* self, float& nResources,
-                 lunchbox::PtrHash<Pipe*, float>& pipeUsage)
-        : _self(self)
-        , _nResources(nResources)
-        , _pipeUsage(pipeUsage)
-        , _numChannels(0)
+    return std::max(cost.draw + cost.transfer,
+                    std::numeric_limits<float>::epsilon());
+}
+
+/**
+ * Assign the children to the pipes within the given frame time, the most
+ * expensive children first, each to its cheapest pipes first.
+ */
+bool _assign(const Costs& costs, const std::vector<size_t>& order,
+             const float time, Shares& shares)
+{
+    const size_t nPipes = costs.front().size();
+    std::vector<float> loads(nPipes, 0.f);
+    std::vector<size_t> pipes;
+
+    for (const size_t i : order)
     {
+        const std::vector<Cost>& childCosts = costs[i];
+        pipes.clear();
+        for (size_t j = 0; j < nPipes; ++j)
+            if (childCosts[j].available)
+                pipes.push_back(j);
+        std::stable_sort(pipes.begin(), pipes.end(),
+                         [&childCosts](const size_t a, const size_t b) {
+                             return _getCost(childCosts[a]) <
+                                    _getCost(childCosts[b]);
+                         });
+
+        std::vector<float>& share = shares[i];
+        share.assign(nPipes, 0.f);
+        float left = 1.f;
+        for (const size_t j : pipes)
+        {
+            const float cost = _getCost(childCosts[j]);
+            const float use = std::min(left, (time - loads[j]) / cost);
+            if (use <= 0.f)
+                continue;
+            if (use < left && use * cost < MIN_USAGE * time)
+                continue; // not worth the overhead of another source
+
+            share[j] = use;
+            loads[j] += use * cost;
+            left -= use;
+            if (left <= 0.f)
+                break;
+        }
+        if (left > 0.0001f)
+            return false;
     }
+    return true;
+}
 
-    virtual VisitorResult visitLeaf(Compound* compound)
+/** @return the largest time, 0 for an invalid set of shares. */
+float _getMaxTime(const Costs& costs, const Shares& shares)
+{
+    if (shares.size() != costs.size())
+        return 0.f;
+
+    for (size_t i = 0; i < costs.size(); ++i)
     {
-        if (!compound->isActive())
-            return TRAVERSE_CONTINUE;
+        if (shares[i].size() != costs[i].size())
+            return 0.f;
 
-        Pipe* pipe = compound->getPipe();
-        LBASSERT(pipe);
+        float sum = 0.f;
+        bool available = false;
+        for (size_t j = 0; j < costs[i].size(); ++j)
+        {
+            available = available || costs[i][j].available;
+            if (shares[i][j] > 0.f && !costs[i][j].available)
+                return 0.f;
+            sum += shares[i][j];
+        }
+        if (available && std::abs(sum - 1.f) > .001f)
+            return 0.f;
+    }
 
-        if (pipe != _self)
-            return TRAVERSE_CONTINUE;
+    const std::vector<float> times =
+        ViewEqualizer::predictTimes(costs, shares);
+    return times.empty() ? 0.f : *std::max_element(times.begin(), times.end());
+}
 
-        if (_pipeUsage.find(pipe) == _pipeUsage.end())
-            _pipeUsage[pipe] = 0.0f;
+class SourceCollector : public CompoundVisitor
+{
+public:
+    explicit SourceCollector(std::vector<const Pipe*>& pipes)
+        : _pipes(pipes)
+    {
+    }
 
-        float& pipeUsage = _pipeUsage[pipe];
-        if (pipeUsage >= 1.0f)
-        {
-            compound->setUsage(0.f);
-            return TRAVERSE_TERMINATE;
-        }
+    virtual VisitorResult visitPre(const Compound* compound)
+    {
+        return compound->isActive() ? TRAVERSE_CONTINUE : TRAVERSE_PRUNE;
+    }
 
-        if (pipeUsage > 0.0f) // pipe already partly used
-        {
-            LBASSERT(pipeUsage < 1.0f);
-
-            float use = 1.0f - pipeUsage;
-            use = LB_MAX(use, MIN_USAGE);
-
-            compound->setUsage(use);
-            _nResources -= use;
-            pipeUsage = 1.0f; // Don't use more than twice
-            LBLOG(LOG_LB1) << "  Use "
-                           << static_cast<unsigned>(use * 100.f + .5f)
-                           << "% of " << pipe->getName() << " task "
-                           << compound->getTaskID() << ", "
-                           << _nResources * 100.f << "% left" << std::endl;
-        }
-        else
-        {
-            LBASSERT(pipeUsage == 0.0f);
-
-            float use = LB_MIN(1.0f, _nResources);
-
-            compound->setUsage(use);
-            _nResources -= use;
-            pipeUsage = use;
-            LBLOG(LOG_LB1) << "  Use "
-                           << static_cast<unsigned>(use * 100.f + .5f)
-                           << "% of " << pipe->getName() << " task "
-                           << compound->getTaskID() << ", "
-                           << _nResources * 100.f << "% left" << std::endl;
-        }
-        ++_numChannels;
+    virtual VisitorResult visitLeaf(const Compound* compound)
+    {
+        if (!compound->isActive())
+            return TRAVERSE_PRUNE;
 
-        return TRAVERSE_TERMINATE;
+        const Pipe* pipe = compound->getPipe();
+        LBASSERT(pipe);
+        if (std::find(_pipes.begin(), _pipes.end(), pipe) == _pipes.end())
+            _pipes.push_back(pipe);
+        return TRAVERSE_CONTINUE;
     }
 
-    uint32_t getNumChannels() const { return _numChannels; }
 private:
-    const Pipe* const _self;
-    float& _nResources;
-    lunchbox::PtrHash<Pipe*, float>& _pipeUsage;
-    uint32_t _numChannels;
+    std::vector<const Pipe*>& _pipes;
 };
 
-class PreviousAssigner : public CompoundVisitor
+class UsageAssigner : public CompoundVisitor
 {
 public:
-    PreviousAssigner(const Pipe* self, float& nResources,
-                     lunchbox::PtrHash<Pipe*, float>& pipeUsage)
-        : _self(self)
-        , _nResources(nResources)
-        , _pipeUsage(pipeUsage)
+    UsageAssigner(const std::map<const Pipe*, float>& usage,
+                  const std::map<const Pipe*, size_t>& nSources)
+        : _usage(usage)
+        , _nSources(nSources)
         , _numChannels(0)
     {
     }
@@ -174,250 +218,345 @@ public:
         if (!compound->isActive())
             return TRAVERSE_CONTINUE;
 
-        Pipe* pipe = compound->getPipe();
-        LBASSERT(pipe);
-
-        if (compound->getUsage() == 0.0f || // not previously used
-            pipe == _self)                  // already assigned above
+        const Pipe* pipe = compound->getPipe();
+        const std::map<const Pipe*, float>::const_iterator i =
+            _usage.find(pipe);
+        if (i == _usage.end() || i->second <= 0.f)
         {
+            compound->setUsage(0.f);
             return TRAVERSE_CONTINUE;
         }
 
-        compound->setUsage(0.0f);     // reset to unused
-        if (_nResources <= MIN_USAGE) // done
-            return TRAVERSE_CONTINUE;
-
-        if (_pipeUsage.find(pipe) == _pipeUsage.end())
-            _pipeUsage[pipe] = 0.0f;
-
-        float& pipeUsage = _pipeUsage[pipe];
-        if (pipeUsage > 0.0f) // pipe already partly used
-            return TRAVERSE_CONTINUE;
-
-        float use = LB_MIN(1.0f, _nResources);
-        if (use + MIN_USAGE > 1.0f)
-            use = 1.0f;
-
-        pipeUsage = use;
+        // sources of one child on the same pipe share its usage
+        const float use = i->second / float(_nSources.find(pipe)->second);
         compound->setUsage(use);
-        _nResources -= use;
         ++_numChannels;
-
         LBLOG(LOG_LB1) << "  Use " << static_cast<unsigned>(use * 100.f + .5f)
                        << "% of " << pipe->getName() << " task "
-                       << compound->getTaskID() << ", " << _nResources * 100.f
-                       << "% left" << std::endl;
+                       << compound->getTaskID() << std::endl;
         return TRAVERSE_CONTINUE;
     }
 
     uint32_t getNumChannels() const { return _numChannels; }
 private:
-    const Pipe* const _self;
-    float& _nResources;
-    lunchbox::PtrHash<Pipe*, float>& _pipeUsage;
+    const std::map<const Pipe*, float>& _usage;
+    const std::map<const Pipe*, size_t>& _nSources;
     uint32_t _numChannels;
 };
+}
 
-class NewAssigner : public CompoundVisitor
+void ViewEqualizer::estimateCosts(Costs& costs)
 {
-public:
-    NewAssigner(float& nResources, lunchbox::PtrHash<Pipe*, float>& pipeUsage)
-        : _nResources(nResources)
-        , _pipeUsage(pipeUsage)
-        , _numChannels(0)
-        , _fallback(0)
+    const size_t nChildren = costs.size();
+    const size_t nPipes = nChildren == 0 ? 0 : costs.front().size();
+
+    // fit draw = work[child] * speed[pipe] to the known draw costs
+    std::vector<float> work(nChildren, 0.f);
+    std::vector<float> speed(nPipes, 1.f);
+    for (size_t iteration = 0; iteration < 8; ++iteration)
     {
+        for (size_t i = 0; i < nChildren; ++i)
+        {
+            float sum = 0.f;
+            size_t n = 0;
+            for (size_t j = 0; j < nPipes; ++j)
+            {
+                if (costs[i][j].draw <= 0.f)
+                    continue;
+                sum += costs[i][j].draw / speed[j];
+                ++n;
+            }
+            work[i] = n > 0 ? sum / float(n) : 0.f;
+        }
+
+        float speedSum = 0.f;
+        size_t nSpeeds = 0;
+        std::vector<bool> known(nPipes, false);
+        for (size_t j = 0; j < nPipes; ++j)
+        {
+            float sum = 0.f;
+            size_t n = 0;
+            for (size_t i = 0; i < nChildren; ++i)
+            {
+                if (costs[i][j].draw <= 0.f || work[i] <= 0.f)
+                    continue;
+                sum += costs[i][j].draw / work[i];
+                ++n;
+            }
+            if (n == 0)
+                continue;
+            speed[j] = sum / float(n);
+            known[j] = true;
+            speedSum += speed[j];
+            ++nSpeeds;
+        }
+
+        // normalize to a mean speed of one, unknown pipes have the mean
+        const float mean = nSpeeds > 0 ? speedSum / float(nSpeeds) : 1.f;
+        for (size_t j = 0; j < nPipes; ++j)
+            speed[j] = known[j] ? speed[j] / mean : 1.f;
     }
 
-    virtual VisitorResult visitLeaf(Compound* compound)
+    float workSum = 0.f;
+    size_t nWorks = 0;
+    for (const float w : work)
     {
-        if (!compound->isActive())
-            return TRAVERSE_CONTINUE;
-
-        if (!_fallback)
-            _fallback = compound;
+        if (w <= 0.f)
+            continue;
+        workSum += w;
+        ++nWorks;
+    }
+    const float meanWork = nWorks > 0 ? workSum / float(nWorks) : 1.f;
 
-        if (compound->getUsage() != 0.0f) // already used
-            return TRAVERSE_CONTINUE;
+    for (size_t i = 0; i < nChildren; ++i)
+    {
+        float transferSum = 0.f;
+        size_t nTransfers = 0;
+        for (const Cost& cost : costs[i])
+        {
+            if (cost.draw <= 0.f || cost.transfer <= 0.f)
+                continue;
+            transferSum += cost.transfer;
+            ++nTransfers;
+        }
+        const float transfer =
+            nTransfers > 0 ? transferSum / float(nTransfers) : 0.f;
 
-        Pipe* pipe = compound->getPipe();
-        LBASSERT(pipe);
+        for (size_t j = 0; j < nPipes; ++j)
+        {
+            Cost& cost = costs[i][j];
+            if (!cost.available || cost.draw > 0.f)
+                continue;
+            cost.draw = (work[i] > 0.f ? work[i] : meanWork) * speed[j];
+            cost.transfer = transfer;
+        }
+    }
+}
 
-        if (_pipeUsage.find(pipe) == _pipeUsage.end())
-            _pipeUsage[pipe] = 0.0f;
+Shares ViewEqualizer::computeShares(const Costs& costs, const Shares& current)
+{
+    const size_t nChildren = costs.size();
+    Shares shares(nChildren);
+    if (nChildren == 0 || costs.front().empty())
+        return shares;
 
-        float& pipeUsage = _pipeUsage[pipe];
-        if (pipeUsage >= 1.0f)
-            return TRAVERSE_CONTINUE;
+    // most expensive children first, an upper bound is all children on their
+    // cheapest pipe
+    std::vector<float> minCosts(nChildren, 0.f);
+    for (size_t i = 0; i < nChildren; ++i)
+    {
+        float minCost = std::numeric_limits<float>::max();
+        for (const Cost& cost : costs[i])
+            if (cost.available)
+                minCost = std::min(minCost, _getCost(cost));
+        if (minCost < std::numeric_limits<float>::max())
+            minCosts[i] = minCost;
+    }
+    std::vector<size_t> order(nChildren);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [&minCosts](const size_t a, const size_t b) {
+                         return minCosts[a] > minCosts[b];
+                     });
+
+    float high = std::accumulate(minCosts.begin(), minCosts.end(), 0.f);
+    if (high <= 0.f)
+    {
+        for (std::vector<float>& share : shares)
+            share.assign(costs.front().size(), 0.f);
+        return shares;
+    }
+    for (size_t i = 0; i < 8 && !_assign(costs, order, high, shares); ++i)
+        high *= 2.f;
 
-        if (pipeUsage > 0.0f) // pipe already partly used
+    float low = 0.f;
+    Shares candidate(nChildren);
+    for (size_t i = 0; i < 32; ++i)
+    {
+        const float time = (low + high) * .5f;
+        if (_assign(costs, order, time, candidate))
         {
-            LBASSERT(pipeUsage < 1.0f);
-
-            float use = 1.0f - pipeUsage;
-            use = LB_MAX(use, MIN_USAGE);
-
-            compound->setUsage(use);
-            _nResources -= use;
-            pipeUsage = 1.0f; // Don't use more than twice
-            LBLOG(LOG_LB1) << "  Use "
-                           << static_cast<unsigned>(use * 100.f + .5f)
-                           << "% of " << pipe->getName() << " task "
-                           << compound->getTaskID() << ", "
-                           << _nResources * 100.f << "% left" << std::endl;
+            high = time;
+            shares.swap(candidate);
         }
         else
-        {
-            LBASSERT(pipeUsage == 0.0f);
-
-            float use = LB_MIN(1.0f, _nResources);
-
-            compound->setUsage(use);
-            _nResources -= use;
-            pipeUsage = use;
-            LBLOG(LOG_LB1) << "  Use "
-                           << static_cast<unsigned>(use * 100.f + .5f)
-                           << "% of " << pipe->getName() << " task "
-                           << compound->getTaskID() << ", "
-                           << _nResources * 100.f << "% left" << std::endl;
-        }
-        ++_numChannels;
+            low = time;
+    }
 
-        if (_nResources <= MIN_USAGE)
-            return TRAVERSE_TERMINATE; // done
-        return TRAVERSE_CONTINUE;
+    const float currentTime = _getMaxTime(costs, current);
+    if (currentTime > 0.f &&
+        _getMaxTime(costs, shares) > currentTime * HYSTERESIS)
+    {
+        return current;
     }
+    return shares;
+}
 
-    uint32_t getNumChannels() const { return _numChannels; }
-    Compound* getFallback() { return _fallback; }
-private:
-    float& _nResources;
-    lunchbox::PtrHash<Pipe*, float>& _pipeUsage;
-    uint32_t _numChannels;
-    Compound* _fallback;
-};
+std::vector<float> ViewEqualizer::predictTimes(const Costs& costs,
+                                               const Shares& shares)
+{
+    const size_t nChildren = std::min(costs.size(), shares.size());
+    const size_t nPipes = nChildren == 0 ? 0 : costs.front().size();
+
+    std::vector<float> loads(nPipes, 0.f);
+    for (size_t i = 0; i < nChildren; ++i)
+        for (size_t j = 0; j < nPipes && j < shares[i].size(); ++j)
+            loads[j] += shares[i][j] * _getCost(costs[i][j]);
+
+    std::vector<float> times(nChildren, 0.f);
+    for (size_t i = 0; i < nChildren; ++i)
+        for (size_t j = 0; j < nPipes && j < shares[i].size(); ++j)
+            if (shares[i][j] > 0.f)
+                times[i] = std::max(times[i], loads[j]);
+    return times;
+}
+
+void ViewEqualizer::_updateCosts(const size_t child,
+                                 const Listener::Load& load)
+{
+    // sum up the sources of the child on each pipe
+    PipeCosts samples;
+    std::map<const Pipe*, float> shares;
+    for (const auto& i : load.samples)
+    {
+        const Listener::Sample& sample = i.second;
+        if (!sample.pipe || sample.draw <= 0.f)
+            continue;
+        Cost& cost = samples[sample.pipe];
+        cost.draw += sample.draw;
+        cost.transfer += sample.transfer;
+        shares[sample.pipe] += sample.share;
+    }
+
+    PipeCosts& costs = _costs[child];
+    for (const auto& i : samples)
+    {
+        const float share = shares[i.first];
+        if (share < MIN_SHARE)
+            continue;
+
+        const Cost sample(i.second.draw / share, i.second.transfer / share);
+        Cost& cost = costs[i.first];
+        if (cost.draw <= 0.f)
+            cost = sample;
+        else
+        {
+            cost.draw += (sample.draw - cost.draw) * SMOOTHING;
+            cost.transfer += (sample.transfer - cost.transfer) * SMOOTHING;
+        }
+    }
 }
 
 void ViewEqualizer::_update(const uint32_t frameNumber)
 {
+    for (Listener& listener : _listeners)
+        listener.recordShares(frameNumber - 1);
+
     const uint32_t frame = _findInputFrameNumber();
     LBLOG(LOG_LB1) << "Using data from frame " << frame << std::endl;
 
     //----- Gather data for frame
-    Loads loads;
-    int64_t totalTime(0);
-
-    for (Listeners::iterator i = _listeners.begin(); i != _listeners.end(); ++i)
-    {
-        Listener& listener = *i;
-        const Listener::Load& load = listener.useLoad(frame);
-
-        totalTime += load.time;
-        loads.push_back(load);
-    }
+    const size_t size(_listeners.size());
+    _costs.resize(size);
+    for (size_t i = 0; i < size; ++i)
+        _updateCosts(i, _listeners[i].useLoad(frame));
 
     const Compound* compound = getCompound();
 
-    if (isFrozen() || !compound->isActive() || _nPipes == 0)
+    if (isFrozen() || !compound->isActive() || _pipes.empty())
         // always execute code above to not leak memory
         return;
 
-    if (totalTime == 0) // no data
-        totalTime = 1;
-
-    const float resourceTime(static_cast<float>(totalTime) /
-                             static_cast<float>(_nPipes));
-    LBLOG(LOG_LB1) << resourceTime << "ms/resource" << std::endl;
-
-    //----- Assign new resource usage
+    //----- Model costs of all children on all pipes
     const Compounds& children = compound->getChildren();
-    const size_t size(_listeners.size());
     LBASSERT(children.size() == size);
-    lunchbox::PtrHash<Pipe*, float> pipeUsage;
-    float* leftOvers = static_cast<float*>(alloca(size * sizeof(float)));
+    Costs costs(size, std::vector<Cost>(_pipes.size()));
+    Shares current(size, std::vector<float>(_pipes.size(), 0.f));
+    _shares.resize(size);
 
-    // use self
     for (size_t i = 0; i < size; ++i)
     {
-        Listener::Load& load = loads[i];
-        LBASSERT(load.missing == 0);
-
-        Compound* child = children[i];
+        const Compound* child = children[i];
         if (!child->isActive())
             continue;
 
-        float segmentResources(load.time / resourceTime);
-
-        LBLOG(LOG_LB1) << "----- balance step 1 for view " << i << " ("
-                       << child->getChannel()->getName() << " "
-                       << child->getChannel()->getSerial() << ") using "
-                       << segmentResources << " resources" << std::endl;
-        SelfAssigner assigner(child->getPipe(), segmentResources, pipeUsage);
+        std::vector<const Pipe*> pipes;
+        SourceCollector collector(pipes);
+        child->accept(collector);
 
-        child->accept(assigner);
-        load.missing = assigner.getNumChannels();
-        leftOvers[i] = segmentResources;
+        for (size_t j = 0; j < _pipes.size(); ++j)
+        {
+            const Pipe* pipe = _pipes[j];
+            Cost& cost = costs[i][j];
+            PipeCosts::const_iterator k = _costs[i].find(pipe);
+            if (k != _costs[i].end())
+                cost = k->second;
+            cost.available =
+                std::find(pipes.begin(), pipes.end(), pipe) != pipes.end();
+
+            PipeShares::const_iterator l = _shares[i].find(pipe);
+            if (l != _shares[i].end())
+                current[i][j] = l->second;
+        }
     }
+    estimateCosts(costs);
 
-    // use previous' frames resources
-    for (size_t i = 0; i < size; ++i)
-    {
-        Listener::Load& load = loads[i];
-        Compound* child = children[i];
-        if (!child->isActive())
-            continue;
-
-        float& leftOver = leftOvers[i];
-        LBLOG(LOG_LB1) << "----- balance step 2 for view " << i << " ("
-                       << child->getChannel()->getName() << " "
-                       << child->getChannel()->getSerial() << ") using "
-                       << leftOver << " resources" << std::endl;
-        PreviousAssigner assigner(child->getPipe(), leftOver, pipeUsage);
-
-        child->accept(assigner);
-        load.missing += assigner.getNumChannels();
-    }
+    //----- Assign new resource usage
+    const Shares shares = computeShares(costs, current);
+    _times = predictTimes(costs, shares);
+    const float time =
+        _times.empty() ? 0.f : *std::max_element(_times.begin(), _times.end());
+    LBLOG(LOG_LB1) << "Predicted frame time " << time << "ms" << std::endl;
 
-    // satisfy left-overs
     for (size_t i = 0; i < size; ++i)
     {
         Listener& listener = _listeners[i];
         LBASSERTINFO(listener.getNLoads() <= getConfig()->getLatency() + 3,
                      listener);
 
-        float& leftOver = leftOvers[i];
-        Listener::Load& load = loads[i];
         Compound* child = children[i];
-
         if (!child->isActive())
             continue;
 
-        if (leftOver > MIN_USAGE || load.missing == 0)
+        // usage is the fraction of the pipe's frame time used for the child
+        PipeShares& childShares = _shares[i];
+        std::map<const Pipe*, float> usage;
+        childShares.clear();
+        for (size_t j = 0; j < _pipes.size(); ++j)
         {
-            LBLOG(LOG_LB1) << "----- balance step 3 for view " << i << " ("
-                           << child->getChannel()->getName() << ") using "
-                           << leftOver << " resources" << std::endl;
+            if (shares[i][j] <= 0.f)
+                continue;
+            childShares[_pipes[j]] = shares[i][j];
+            usage[_pipes[j]] =
+                time > 0.f ? shares[i][j] * _getCost(costs[i][j]) / time : 1.f;
+        }
+
+        std::map<const Pipe*, size_t> nSources;
+        for (const Compound* source : listener.getSources())
+            if (source->isActive())
+                ++nSources[source->getPipe()];
 
-            NewAssigner assigner(leftOver, pipeUsage);
-            child->accept(assigner);
-            load.missing += assigner.getNumChannels();
+        LBLOG(LOG_LB1) << "----- balance view " << i << " ("
+                       << child->getChannel()->getName() << " "
+                       << child->getChannel()->getSerial() << ") predicted "
+                       << _times[i] << "ms" << std::endl;
+        UsageAssigner assigner(usage, nSources);
+        child->accept(assigner);
 
-            if (load.missing == 0) // assign at least one resource
+        uint32_t missing = assigner.getNumChannels();
+        if (missing == 0) // assign at least one resource
+        {
+            for (Compound* source : listener.getSources())
             {
-                Compound* fallback = assigner.getFallback();
-                LBASSERT(fallback);
-                LBASSERT(leftOver > 0);
-
-                fallback->setUsage(leftOver);
-                load.missing = 1;
-                LBLOG(LOG_LB1)
-                    << "  Use " << static_cast<unsigned>(leftOver * 100.f + .5f)
-                    << "% of " << fallback->getPipe()->getName() << " task "
-                    << fallback->getTaskID() << std::endl;
+                if (!source->isActive())
+                    continue;
+                source->setUsage(1.f);
+                missing = 1;
+                break;
             }
         }
-
-        listener.newLoad(frameNumber, load.missing);
+        LBASSERT(missing > 0);
+        listener.newLoad(frameNumber, missing);
     }
 }
 
@@ -477,39 +616,12 @@ void ViewEqualizer::_updateListeners()
     }
 }
 
-namespace
-{
-class PipeCounter : public CompoundVisitor
-{
-public:
-    virtual VisitorResult visitPre(const Compound* compound)
-    {
-        return compound->isActive() ? TRAVERSE_CONTINUE : TRAVERSE_PRUNE;
-    }
-
-    virtual VisitorResult visitLeaf(const Compound* compound)
-    {
-        if (!compound->isActive())
-            return TRAVERSE_PRUNE;
-
-        const Pipe* pipe = compound->getPipe();
-        LBASSERT(pipe);
-        _pipes.insert(pipe);
-        return TRAVERSE_CONTINUE;
-    }
-
-    size_t getNPipes() const { return _pipes.size(); }
-private:
-    std::set<const Pipe*> _pipes;
-};
-}
-
 void ViewEqualizer::_updateResources()
 {
-    PipeCounter counter;
+    _pipes.clear();
+    SourceCollector collector(_pipes);
     const Compound* compound = getCompound();
-    compound->accept(counter);
-    _nPipes = counter.getNPipes();
+    compound->accept(collector);
 }
 
 //---------------------------------------------------------------------------
@@ -521,9 +633,11 @@ class LoadSubscriber : public CompoundVisitor
 {
 public:
     LoadSubscriber(ChannelListener* listener,
-                   lunchbox::PtrHash<Channel*, uint32_t>& taskIDs)
+                   lunchbox::PtrHash<Channel*, uint32_t>& taskIDs,
+                   Compounds& sources)
         : _listener(listener)
         , _taskIDs(taskIDs)
+        , _sources(sources)
     {
     }
 
@@ -536,6 +650,7 @@ public:
         {
             channel->addListener(_listener);
             _taskIDs[channel] = compound->getTaskID();
+            _sources.push_back(compound);
             LBLOG(LOG_LB1) << _taskIDs[channel] << ' ';
         }
         else
@@ -550,13 +665,14 @@ public:
 private:
     ChannelListener* const _listener;
     lunchbox::PtrHash<Channel*, uint32_t>& _taskIDs;
+    Compounds& _sources;
 };
 }
 
 void ViewEqualizer::Listener::update(Compound* compound)
 {
     LBASSERT(_taskIDs.empty());
-    LoadSubscriber subscriber(this, _taskIDs);
+    LoadSubscriber subscriber(this, _taskIDs, _sources);
     compound->accept(subscriber);
 }
 
@@ -568,6 +684,7 @@ void ViewEqualizer::Listener::clear()
         i->first->removeListener(this);
     }
     _taskIDs.clear();
+    _sources.clear();
 }
 
 ViewEqualizer::Listener::Load ViewEqualizer::Listener::Load::NONE(0, 0, 1);
@@ -620,7 +737,7 @@ void ViewEqualizer::Listener::notifyLoadData(Channel* channel,
 
         case Statistic::CHANNEL_ASYNC_READBACK:
         case Statistic::CHANNEL_FRAME_TRANSMIT:
-            transmitTime += data.startTime - data.endTime;
+            transmitTime += data.endTime - data.startTime;
             break;
         case Statistic::CHANNEL_FRAME_WAIT_SENDTOKEN:
             transmitTime -= data.endTime - data.startTime;
@@ -646,6 +763,11 @@ void ViewEqualizer::Listener::notifyLoadData(Channel* channel,
     load.time += time;
     --load.missing;
 
+    Sample& sample = load.samples[taskID];
+    sample.pipe = channel->getPipe();
+    sample.draw = float(endTime - startTime);
+    sample.transfer = float(LB_MAX(transmitTime, 0));
+
     if (load.missing == 0)
     {
         const float rTime = float(load.time) / float(load.nResources);
@@ -709,6 +831,27 @@ void ViewEqualizer::Listener::newLoad(const uint32_t frameNumber,
     _loads.push_front(Load(frameNumber, nChannels, 0));
 }
 
+void ViewEqualizer::Listener::recordShares(const uint32_t frameNumber)
+{
+    // called before the child's equalizers update the sources for the next
+    // frame, i.e., the sources still have the decomposition of frameNumber
+    Load& load = _getLoad(frameNumber);
+    if (load == Load::NONE)
+        return;
+
+    for (const Compound* source : _sources)
+    {
+        if (!source->isActive() || source->getUsage() == 0.f)
+            continue;
+
+        const Range& range = source->getInheritRange();
+        Sample& sample = load.samples[source->getTaskID()];
+        sample.pipe = source->getPipe();
+        sample.share =
+            source->getInheritViewport().getArea() * (range.end - range.start);
+    }
+}
+
 std::ostream& operator<<(std::ostream& os, const ViewEqualizer* equalizer)
 {
     if (equalizer)
@@ -34,10 +34,71 @@ std::ostream& operator<<(std::ostream& os, const ViewEqualizer*);
 /**
  * An Equalizer allocating resources to multiple destination channels of a
  * single view.
+ *
+ * The cost of rendering the whole work of each child on each pipe is modeled
+ * from the statistics of the used source channels: the draw time and the time
+ * to transmit the pixels to the destination, each divided by the share of the
+ * work rendered. The costs of unused pipes are estimated from the fitted
+ * per-pipe throughput and per-child work. The pipes are then assigned to
+ * minimize the largest predicted frame time of all children.
  */
 class ViewEqualizer : public Equalizer
 {
 public:
+    /** The predicted cost of rendering the whole work of a child on a pipe. */
+    struct Cost
+    {
+        Cost()
+            : draw(0.f)
+            , transfer(0.f)
+            , available(false)
+        {
+        }
+        Cost(const float draw_, const float transfer_)
+            : draw(draw_)
+            , transfer(transfer_)
+            , available(true)
+        {
+        }
+
+        float draw;     //!< The draw time in ms, 0 if unknown
+        float transfer; //!< The time to transmit the pixels in ms
+        bool available; //!< The child has a source channel on the pipe
+    };
+    typedef std::vector<std::vector<Cost>> Costs;   //!< [child][pipe]
+    typedef std::vector<std::vector<float>> Shares; //!< [child][pipe]
+
+    /**
+     * Estimate the unknown costs of the available pipes.
+     *
+     * Unknown draw costs are the product of the per-child work and the
+     * per-pipe throughput fitted to the known draw costs. Unknown transfer
+     * costs are the mean known remote transfer cost of the child.
+     */
+    static EQSERVER_API void estimateCosts(Costs& costs);
+
+    /**
+     * Compute the share of the work of each child rendered by each pipe.
+     *
+     * The shares minimize the largest predicted frame time of all children.
+     * The current shares are kept if the new ones do not improve the
+     * prediction by at least five percent.
+     *
+     * @param costs the complete costs, see estimateCosts().
+     * @param current the current shares, may be empty.
+     * @return the new shares.
+     */
+    static EQSERVER_API Shares computeShares(const Costs& costs,
+                                             const Shares& current);
+
+    /**
+     * @return the predicted frame time of each child: the time of the
+     *         busiest pipe used by the child, which renders and transmits the
+     *         shares of all children assigned to it.
+     */
+    static EQSERVER_API std::vector<float> predictTimes(const Costs& costs,
+                                                        const Shares& shares);
+
     EQSERVER_API ViewEqualizer();
     ViewEqualizer(const ViewEqualizer& from);
     virtual ~ViewEqualizer();
@@ -49,6 +110,8 @@ public:
     void notifyUpdatePre(Compound* compound, const uint32_t frameNumber) final;
 
     uint32_t getType() const final { return fabric::VIEW_EQUALIZER; }
+    /** @return the frame time of each child predicted by the last update. */
+    const std::vector<float>& getPredictedTimes() const { return _times; }
 protected:
     void notifyChildAdded(Compound*, Compound*) override
     {
@@ -72,6 +135,24 @@ private:
         virtual void notifyLoadData(Channel* channel, uint32_t frameNumber,
                                     const Statistics& statistics,
                                     const Viewport& region);
+        /** The load of one source channel. */
+        struct Sample
+        {
+            Sample()
+                : pipe(0)
+                , draw(0.f)
+                , transfer(0.f)
+                , share(0.f)
+            {
+            }
+
+            const Pipe* pipe;
+            float draw;     //!< draw time in ms
+            float transfer; //!< transmit time in ms
+            float share;    //!< share of the work rendered
+        };
+        typedef std::map<uint32_t, Sample> Samples; //!< by task ID
+
         struct Load
         {
             static Load NONE;
@@ -84,6 +165,7 @@ private:
             uint32_t missing;
             uint32_t nResources;
             int64_t time;
+            Samples samples;
         };
 
         /** @return the frame number of the youngest complete load. */
@@ -92,11 +174,16 @@ private:
         const Load& useLoad(const uint32_t frameNumber);
         /** Insert a new, empty load for the given frame. */
         void newLoad(const uint32_t frameNumber, const uint32_t nChannels);
+        /** Record the current work share of the sources for a frame. */
+        void recordShares(const uint32_t frameNumber);
         /** @return the size of the history stash. */
         size_t getNLoads() const { return _loads.size(); }
+        /** @return the source compounds of the child. */
+        const Compounds& getSources() const { return _sources; }
     private:
         typedef lunchbox::PtrHash<Channel*, uint32_t> TaskIDHash;
         TaskIDHash _taskIDs;
+        Compounds _sources;
 
         typedef std::deque<Load> LoadDeque;
         LoadDeque _loads;
@@ -110,18 +197,25 @@ private:
     friend std::ostream& operator<<(std::ostream& os,
                                     const ViewEqualizer::Listener::Load&);
 
-    typedef std::vector<Listener::Load> Loads;
     typedef std::vector<Listener> Listeners;
     /** Per-child listener gathering load data. */
     Listeners _listeners;
 
-    /** The total number of available resources. */
-    size_t _nPipes;
+    /** The available pipes. */
+    std::vector<const Pipe*> _pipes;
+
+    typedef std::map<const Pipe*, Cost> PipeCosts;
+    typedef std::map<const Pipe*, float> PipeShares;
+    std::vector<PipeCosts> _costs;   //!< Measured costs for each child
+    std::vector<PipeShares> _shares; //!< Current shares for each child
+    std::vector<float> _times;       //!< Predicted time of each child
 
     /** Update channel load subscription. */
     void _updateListeners();
-    /** Update resource count. */
+    /** Update the available pipes. */
     void _updateResources();
+    /** Update the measured costs from the load of a child. */
+    void _updateCosts(const size_t child, const Listener::Load& load);
     /** Assign resources to children. */
     void _update(const uint32_t frameNumber);
     /** Find the frame number to use for update. */
@@ -104,6 +104,8 @@ void Global::_setupDefaults()
     _windowIAttributes[WindowSettings::IATTR_HINT_DRAWABLE] = fabric::WINDOW;
     _windowIAttributes[WindowSettings::IATTR_HINT_SCREENSAVER] = fabric::AUTO;
     _windowIAttributes[WindowSettings::IATTR_HINT_GRAB_POINTER] = fabric::ON;
+    _windowIAttributes[WindowSettings::IATTR_HINT_COALESCE_EVENTS] =
+        fabric::OFF;
     _windowIAttributes[WindowSettings::IATTR_PLANES_COLOR] = fabric::AUTO;
     _windowIAttributes[WindowSettings::IATTR_PLANES_DEPTH] = fabric::AUTO;
     _windowIAttributes[WindowSettings::IATTR_PLANES_STENCIL] = fabric::AUTO;
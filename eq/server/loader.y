@@ -24,6 +24,7 @@
 #include "channel.h"
 #include "compound.h"
 #include "equalizers/dfrEqualizer.h"
+#include "equalizers/dplexEqualizer.h"
 #include "equalizers/framerateEqualizer.h"
 #include "equalizers/loadEqualizer.h"
 #include "equalizers/treeEqualizer.h"
@@ -71,6 +72,7 @@
         static eq::server::Observer*    observer = 0;
         static eq::server::Compound*    eqCompound = 0; // avoid name clash
         static eq::server::DFREqualizer* dfrEqualizer = 0;
+        static eq::server::DPlexEqualizer* dplexEqualizer = 0;
         static eq::server::LoadEqualizer* loadEqualizer = 0;
         static eq::server::TreeEqualizer* treeEqualizer = 0;
         static eq::server::TileEqualizer* tileEqualizer = 0;
@@ -135,6 +137,7 @@
 %token EQTOKEN_WINDOW_IATTR_HINT_STATISTICS
 %token EQTOKEN_WINDOW_IATTR_HINT_SCREENSAVER
 %token EQTOKEN_WINDOW_IATTR_HINT_GRAB_POINTER
+%token EQTOKEN_WINDOW_IATTR_HINT_COALESCE_EVENTS
 %token EQTOKEN_WINDOW_IATTR_HINT_HEIGHT
 %token EQTOKEN_WINDOW_IATTR_HINT_WIDTH
 %token EQTOKEN_WINDOW_IATTR_PLANES_ACCUM
@@ -166,6 +169,7 @@
 %token EQTOKEN_HINT_AFFINITY
 %token EQTOKEN_HINT_SCREENSAVER
 %token EQTOKEN_HINT_GRAB_POINTER
+%token EQTOKEN_HINT_COALESCE_EVENTS
 %token EQTOKEN_PLANES_COLOR
 %token EQTOKEN_PLANES_ALPHA
 %token EQTOKEN_PLANES_DEPTH
@@ -196,12 +200,15 @@
 %token EQTOKEN_COMPOUND
 %token EQTOKEN_DFREQUALIZER
 %token EQTOKEN_FRAMERATEEQUALIZER
+%token EQTOKEN_DPLEXEQUALIZER
 %token EQTOKEN_LOADEQUALIZER
 %token EQTOKEN_TREEEQUALIZER
 %token EQTOKEN_MONITOREQUALIZER
 %token EQTOKEN_VIEWEQUALIZER
 %token EQTOKEN_TILEEQUALIZER
 %token EQTOKEN_DAMPING
+%token EQTOKEN_REGIONS
+%token EQTOKEN_FALLOFF
 %token EQTOKEN_CONNECTION
 %token EQTOKEN_NAME
 %token EQTOKEN_TYPE
@@ -475,6 +482,11 @@ global:
          eq::server::Global::instance()->setWindowIAttribute(
              eq::server::WindowSettings::IATTR_HINT_GRAB_POINTER, $2 );
      }
+     | EQTOKEN_WINDOW_IATTR_HINT_COALESCE_EVENTS IATTR
+     {
+         eq::server::Global::instance()->setWindowIAttribute(
+             eq::server::WindowSettings::IATTR_HINT_COALESCE_EVENTS, $2 );
+     }
      | EQTOKEN_WINDOW_IATTR_HINT_HEIGHT IATTR
      {
          eq::server::Global::instance()->setWindowIAttribute(
@@ -741,6 +753,8 @@ windowAttribute:
         { window->setIAttribute( eq::server::WindowSettings::IATTR_HINT_SCREENSAVER, $2 ); }
     | EQTOKEN_HINT_GRAB_POINTER IATTR
         { window->setIAttribute( eq::server::WindowSettings::IATTR_HINT_GRAB_POINTER, $2 ); }
+    | EQTOKEN_HINT_COALESCE_EVENTS IATTR
+        { window->setIAttribute( eq::server::WindowSettings::IATTR_HINT_COALESCE_EVENTS, $2 ); }
     | EQTOKEN_PLANES_COLOR IATTR
         { window->setIAttribute( eq::server::WindowSettings::IATTR_PLANES_COLOR, $2 ); }
     | EQTOKEN_PLANES_ALPHA IATTR
@@ -1153,8 +1167,8 @@ projectionField:
     | EQTOKEN_HPR  '[' FLOAT FLOAT FLOAT ']'
         { projection.hpr = eq::fabric::Vector3f( $3, $4, $5 ); }
 
-equalizer: dfrEqualizer | framerateEqualizer | loadEqualizer | treeEqualizer |
-           monitorEqualizer | viewEqualizer | tileEqualizer
+equalizer: dfrEqualizer | framerateEqualizer | dplexEqualizer | loadEqualizer |
+           treeEqualizer | monitorEqualizer | viewEqualizer | tileEqualizer
 
 dfrEqualizer: EQTOKEN_DFREQUALIZER '{'
     { dfrEqualizer = new eq::server::DFREqualizer; }
@@ -1167,6 +1181,13 @@ framerateEqualizer: EQTOKEN_FRAMERATEEQUALIZER '{' '}'
     {
         eqCompound->addEqualizer( new eq::server::FramerateEqualizer );
     }
+dplexEqualizer: EQTOKEN_DPLEXEQUALIZER '{'
+    { dplexEqualizer = new eq::server::DPlexEqualizer; }
+    dplexEqualizerFields '}'
+    {
+        eqCompound->addEqualizer( dplexEqualizer );
+        dplexEqualizer = 0;
+    }
 loadEqualizer: EQTOKEN_LOADEQUALIZER '{'
     { loadEqualizer = new eq::server::LoadEqualizer; }
     loadEqualizerFields '}'
@@ -1201,6 +1222,13 @@ dfrEqualizerFields: /* null */ | dfrEqualizerFields dfrEqualizerField
 dfrEqualizerField:
     EQTOKEN_DAMPING FLOAT      { dfrEqualizer->setDamping( $2 ); }
     | EQTOKEN_FRAMERATE FLOAT  { dfrEqualizer->setFrameRate( $2 ); }
+    | EQTOKEN_REGIONS IATTR
+        { dfrEqualizer->setRegions( $2 == eq::fabric::ON ); }
+    | EQTOKEN_FALLOFF FLOAT    { dfrEqualizer->setFalloff( $2 ); }
+
+dplexEqualizerFields: /* null */ | dplexEqualizerFields dplexEqualizerField
+dplexEqualizerField:
+    EQTOKEN_DAMPING FLOAT      { dplexEqualizer->setDamping( $2 ); }
 
 loadEqualizerFields: /* null */ | loadEqualizerFields loadEqualizerField
 loadEqualizerField:
@@ -1243,6 +1271,13 @@ tileEqualizerField:
     EQTOKEN_NAME STRING                   { tileEqualizer->setName( $2 ); }
     | EQTOKEN_SIZE '[' UNSIGNED UNSIGNED ']'
                    { tileEqualizer->setTileSize( eq::fabric::Vector2i( $3, $4 )); }
+    | EQTOKEN_SIZE EQTOKEN_AUTO { tileEqualizer->setAutoSize( true ); }
+    | EQTOKEN_SIZE EQTOKEN_AUTO '[' UNSIGNED UNSIGNED UNSIGNED UNSIGNED ']'
+        {
+            tileEqualizer->setAutoSize( true );
+            tileEqualizer->setSizeBounds( eq::fabric::Vector2i( $4, $5 ),
+                                          eq::fabric::Vector2i( $6, $7 ));
+        }
 
 swapBarrier:
     EQTOKEN_SWAPBARRIER '{' { swapBarrier = new eq::server::SwapBarrier; }
@@ -276,13 +276,19 @@ bool Node::connect()
     LBASSERT(localNode);
 
     _node = _createNetNode(this);
+    _bringUpTimes = BringUpTimes();
+    _bringUpClock.reset();
 
     LBLOG(LOG_INIT) << "Connecting node" << std::endl;
-    if (localNode->connect(_node) ||
-        localNode->launch(_node, _createLaunchCommand()))
-    {
+    const bool connected = localNode->connect(_node);
+    _bringUpTimes.connect = _bringUpClock.resetTimef();
+    if (connected)
+        return true;
+
+    const bool launched = localNode->launch(_node, _createLaunchCommand());
+    _bringUpTimes.launch = _bringUpClock.resetTimef();
+    if (launched)
         return true;
-    }
 
     LBWARN << "Connection to " << _node->getNodeID() << " failed" << std::endl;
     sendError(fabric::ERROR_NODE_LAUNCH) << _host;
@@ -291,7 +297,7 @@ bool Node::connect()
     return false;
 }
 
-bool Node::syncLaunch(const lunchbox::Clock& clock)
+bool Node::syncLaunch()
 {
     LBASSERT(isActive());
 
@@ -307,7 +313,9 @@ bool Node::syncLaunch(const lunchbox::Clock& clock)
     const int64_t timeOut = getIAttribute(IATTR_LAUNCH_TIMEOUT);
     _node = localNode->syncLaunch(_node->getNodeID(),
                                   std::max(int64_t(0),
-                                           timeOut - clock.getTime64()));
+                                           timeOut -
+                                               _bringUpClock.getTime64()));
+    _bringUpTimes.handshake = _bringUpClock.getTimef();
     if (_node)
         return true;
 
@@ -393,6 +401,7 @@ void Node::configInit(const uint128_t& initID, const uint32_t frameNumber)
     _flushedFrame = config->getFinishedFrame();
     _finishedFrame = config->getFinishedFrame();
     _frameIDs.clear();
+    _bringUpClock.reset();
 
     LBLOG(LOG_INIT) << "Create node" << std::endl;
     getConfig()->send(_node, fabric::CMD_CONFIG_CREATE_NODE) << getID();
@@ -653,6 +662,7 @@ bool Node::_cmdConfigInitReply(co::ICommand& cmd)
     co::ObjectICommand command(cmd);
     LBVERB << "handle configInit reply " << command << std::endl;
     LBASSERT(_state == STATE_INITIALIZING);
+    _bringUpTimes.init = _bringUpClock.getTimef();
     _state = command.read<uint64_t>() ? STATE_INIT_SUCCESS : STATE_INIT_FAILED;
 
     return true;
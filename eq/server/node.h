@@ -31,6 +31,8 @@
 #include <co/connectionDescription.h>
 #include <co/node.h>
 
+#include <lunchbox/clock.h>
+
 #include <vector>
 
 namespace eq
@@ -87,6 +89,25 @@ public:
     const Pipe* getLastDrawPipe() const { return _lastDrawPipe; }
     /** @return the number of the last finished frame. @internal */
     uint32_t getFinishedFrame() const { return _finishedFrame; }
+    /** The time spent in each step of the last start of the node, in ms. */
+    struct BringUpTimes
+    {
+        BringUpTimes()
+            : connect(0.f)
+            , launch(0.f)
+            , handshake(0.f)
+            , init(0.f)
+        {
+        }
+
+        float connect;   //!< connection attempt to a running process
+        float launch;    //!< execution of the launch command
+        float handshake; //!< launch until the process connected back
+        float init;      //!< configInit until the reply of the process
+    };
+
+    /** @return the bring-up times of the last start of this node. */
+    const BringUpTimes& getBringUpTimes() const { return _bringUpTimes; }
     //@}
 
     /**
@@ -99,8 +120,12 @@ public:
     /** Launch the render slave node process. */
     bool launch();
 
-    /** Synchronize the connection of a render slave launch. */
-    bool syncLaunch(const lunchbox::Clock& time);
+    /**
+     * Synchronize the connection of a render slave launch.
+     *
+     * Waits at most IATTR_LAUNCH_TIMEOUT after the launch of this node.
+     */
+    bool syncLaunch();
 
     /** Start initializing this entity. */
     void configInit(const uint128_t& initID, const uint32_t frameNumber);
@@ -272,6 +297,10 @@ private:
     /** The last draw pipe for this entity */
     const Pipe* _lastDrawPipe;
 
+    /** Bring-up times and the clock measuring the current step. */
+    BringUpTimes _bringUpTimes;
+    lunchbox::Clock _bringUpClock;
+
     struct Private;
     Private* _private; // placeholder for binary-compatible changes
 
@@ -38,6 +38,7 @@ class CompoundVisitor;
 class Config;
 class ConfigVisitor;
 class DFREqualizer;
+class DPlexEqualizer;
 class Equalizer;
 class Frame;
 class FrameData;
@@ -117,6 +118,7 @@ using fabric::Error;
 using fabric::Event;
 using fabric::EventOCommand;
 using fabric::Frustumf;
+using fabric::FrustumSetup;
 using fabric::Matrix4f;
 using fabric::Pixel;
 using fabric::PixelViewport;
@@ -79,11 +79,8 @@ namespace
 class FrustumUpdater : public ConfigVisitor
 {
 public:
-    FrustumUpdater(const Channels& channels, const Vector3f& eye,
-                   const float ratio)
+    explicit FrustumUpdater(const Channels& channels)
         : _channels(channels)
-        , _eye(eye)
-        , _ratio(ratio)
     {
     }
     virtual ~FrustumUpdater() {}
@@ -99,16 +96,16 @@ public:
         if (std::find(_channels.begin(), _channels.end(), channel) !=
             _channels.end()) // our destination channel
         {
-            compound->updateFrustum(_eye, _ratio);
+            _compounds.push_back(compound);
         }
 
         return TRAVERSE_PRUNE;
     }
 
+    const Compounds& getCompounds() const { return _compounds; }
 private:
     const Channels& _channels;
-    const Vector3f& _eye;
-    const float _ratio;
+    Compounds _compounds;
 };
 
 class CapabilitiesUpdater : public ConfigVisitor
@@ -402,9 +399,10 @@ void View::updateFrusta()
     const float ratio = _computeFocusRatio(eye);
 
     Config* config = getConfig();
-    FrustumUpdater updater(channels, eye, ratio);
+    FrustumUpdater updater(channels);
 
     config->accept(updater);
+    Compound::updateFrusta(updater.getCompounds(), eye, ratio);
 }
 
 float View::_computeFocusRatio(Vector3f& eye)
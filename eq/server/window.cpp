@@ -570,6 +570,9 @@ void Window::output(std::ostream& os) const
                                                                                : i == WindowSettings::
                                                                                              IATTR_HINT_GRAB_POINTER
                                                                                      ? "hint_grab_pointer  "
+                                                                                     : i == WindowSettings::
+                                                                                                   IATTR_HINT_COALESCE_EVENTS
+                                                                                           ? "hint_coalesce_events "
                                                                                      : i == WindowSettings::
                                                                                                    IATTR_PLANES_COLOR
                                                                                            ? "planes_color       "
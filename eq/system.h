@@ -37,5 +37,10 @@
 #include <eq/wgl/types.h>
 #include <eq/wgl/window.h>
 #endif
+#ifdef EQ_EGL_USED
+#include <eq/egl/pipe.h>
+#include <eq/egl/types.h>
+#include <eq/egl/window.h>
+#endif
 
 #endif // EQ_SYSTEM_H
@@ -91,6 +91,7 @@ using fabric::Errors;
 using fabric::Event;
 using fabric::Frustum;
 using fabric::Frustumf;
+using fabric::FrustumSetup;
 using fabric::GPUInfo;
 using fabric::IAttribute;
 using fabric::KeyEvent;
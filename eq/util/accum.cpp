@@ -35,6 +35,7 @@ public:
         , abo(0)
         , numSteps(0)
         , totalSteps(0)
+        , weight(1)
     {
         LBASSERT(glewContext);
     }
@@ -45,6 +46,7 @@ public:
     AccumBufferObject* abo;
     uint32_t numSteps;
     uint32_t totalSteps;
+    uint32_t weight;
 };
 }
 
@@ -113,14 +115,15 @@ bool Accum::resize(const PixelViewport& pvp)
 
 void Accum::accum()
 {
-    LBASSERT(_impl->numSteps < _impl->totalSteps);
+    LBASSERT(_impl->numSteps + _impl->weight <= _impl->totalSteps);
+    const float weight = float(_impl->weight);
 
     if (_impl->abo)
     {
         if (_impl->numSteps == 0)
-            _impl->abo->load(1.0f);
+            _impl->abo->load(weight);
         else
-            _impl->abo->accum(1.0f);
+            _impl->abo->accum(weight);
     }
     else
     {
@@ -128,19 +131,30 @@ void Accum::accum()
         // glAccum function seems to be implemented differently.
         if (_impl->numSteps == 0)
 #ifdef Darwin
-            glAccum(GL_LOAD, 1.0f / _impl->totalSteps);
+            glAccum(GL_LOAD, weight / _impl->totalSteps);
 #else
-            glAccum(GL_LOAD, 1.0f);
+            glAccum(GL_LOAD, weight);
 #endif
         else
 #ifdef Darwin
-            glAccum(GL_ACCUM, 1.0f / _impl->totalSteps);
+            glAccum(GL_ACCUM, weight / _impl->totalSteps);
 #else
-            glAccum(GL_ACCUM, 1.0f);
+            glAccum(GL_ACCUM, weight);
 #endif
     }
 
-    ++_impl->numSteps;
+    _impl->numSteps += _impl->weight;
+}
+
+void Accum::setWeight(const uint32_t weight)
+{
+    LBASSERT(weight > 0);
+    _impl->weight = weight;
+}
+
+uint32_t Accum::getWeight() const
+{
+    return _impl->weight;
 }
 
 void Accum::display()
@@ -77,10 +77,28 @@ public:
 
     /**
      * Accumulate a frame from the read buffer into the accumulation buffer.
+     *
+     * The frame counts as the number of steps set by setWeight().
      * @version 1.0
      */
     EQ_API void accum();
 
+    /**
+     * Set the number of accumulation steps represented by each subsequent
+     * accumulated frame.
+     *
+     * Used to accumulate frames which already average several samples, e.g.,
+     * several idle anti-aliasing steps rendered in one frame. The default
+     * weight is one.
+     *
+     * @param weight the number of steps of each accumulated frame.
+     * @version 2.1
+     */
+    EQ_API void setWeight(uint32_t weight);
+
+    /** @return the steps of each accumulated frame. @version 2.1 */
+    EQ_API uint32_t getWeight() const;
+
     /**
      * Copy the result of the accumulation to the current draw buffer.
      * @version 1.0
@@ -19,6 +19,8 @@
 
 #include <eq/gl.h>
 
+#include <cmath>
+
 namespace eq
 {
 namespace util
@@ -72,8 +74,17 @@ void AccumBufferObject::load(const GLfloat value)
     _texture->copyFromFrameBuffer(_texture->getInternalFormat(), _pvp);
 
     const PixelViewport pvp(0, 0, getWidth(), getHeight());
+    const uint32_t nDraws = _getNumDraws(value);
     _setup(pvp);
-    _drawQuadWithTexture(_texture, pvp, value);
+    _drawQuads(_texture, pvp, value, 1);
+    if (nDraws > 1)
+    {
+        EQ_GL_CALL(glEnable(GL_BLEND));
+        EQ_GL_CALL(glBlendFunc(GL_ONE, GL_ONE));
+        _drawQuads(_texture, pvp, value, nDraws - 1);
+        EQ_GL_CALL(glBlendFunc(GL_ONE, GL_ZERO));
+        EQ_GL_CALL(glDisable(GL_BLEND));
+    }
     _reset();
 
     EQ_GL_ERROR("after AccumBufferObject::load");
@@ -98,7 +109,7 @@ void AccumBufferObject::accum(const GLfloat value)
     EQ_GL_CALL(glEnable(GL_BLEND));
     EQ_GL_CALL(glBlendFunc(GL_ONE, GL_ONE));
 
-    _drawQuadWithTexture(_texture, pvp, value);
+    _drawQuads(_texture, pvp, value, _getNumDraws(value));
 
     EQ_GL_CALL(glBlendFunc(GL_ONE, GL_ZERO));
     EQ_GL_CALL(glDisable(GL_BLEND));
@@ -141,6 +152,21 @@ void AccumBufferObject::_reset()
     EQ_GL_CALL(glBindFramebufferEXT(GL_FRAMEBUFFER_EXT, _previousFBO));
 }
 
+uint32_t AccumBufferObject::_getNumDraws(const GLfloat value)
+{
+    // the texture is modulated by the clamped vertex color, values above one
+    // are applied in several additive draws of at most one each
+    return value > 1.f ? uint32_t(std::ceil(value)) : 1;
+}
+
+void AccumBufferObject::_drawQuads(Texture* texture, const PixelViewport& pvp,
+                                   const GLfloat value, const uint32_t nDraws)
+{
+    const GLfloat step = value / _getNumDraws(value);
+    for (uint32_t i = 0; i < nDraws; ++i)
+        _drawQuadWithTexture(texture, pvp, step);
+}
+
 void AccumBufferObject::_drawQuadWithTexture(Texture* texture,
                                              const PixelViewport& pvp,
                                              const GLfloat value)
@@ -109,6 +109,13 @@ private:
     void _setup(const PixelViewport& pvp);
     void _reset();
 
+    /** @return the number of draws to apply value with a clamped color. */
+    static uint32_t _getNumDraws(const float value);
+
+    /** Draw nDraws textured quads, each with a share of value. */
+    void _drawQuads(Texture* texture, const PixelViewport& pvp,
+                    const float value, uint32_t nDraws);
+
     /**
      * Draw a textured quad.
      *
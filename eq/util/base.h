@@ -30,8 +30,10 @@
 #include <eq/util/accum.h>
 #include <eq/util/accumBufferObject.h>
 #include <eq/util/bitmapFont.h>
+#include <eq/util/bufferPool.h>
 #include <eq/util/frameBufferObject.h>
 #include <eq/util/objectManager.h>
 #include <eq/util/shader.h>
+#include <eq/util/sharedFrameData.h>
 
 #endif // EQUTIL_H
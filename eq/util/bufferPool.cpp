@@ -0,0 +1,400 @@
+
+/* Copyright (c) 2026, The Equalizer authors, see AUTHORS
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "bufferPool.h"
+
+#include <lunchbox/debug.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <deque>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+#define MIN_BITS 12                     // smallest size class: 4 KB
+#define N_CLASSES ((64 - MIN_BITS) * 4) // four size classes per power of two
+#define HEADER_SIZE 64                  // keeps the buffers cache-line aligned
+#define HUGE_SIZE (2u << 20)            // mapped, using huge pages
+#define THREAD_BLOCKS 2                 // cached blocks per class and thread
+#define THREAD_SIZE (8u << 20)          // cached bytes per thread, below HUGE
+#define HISTORY 16                      // trims tracked for the high-water mark
+
+namespace eq
+{
+namespace util
+{
+namespace
+{
+/** Stored in the first HEADER_SIZE bytes of each block. */
+struct Header
+{
+    size_t index;  //!< the size class
+    uint64_t trim; //!< the trim() count when the block was cached
+};
+
+Header& _getHeader(void* block)
+{
+    return *static_cast<Header*>(block);
+}
+
+size_t _getClass(const size_t size)
+{
+    if (size <= (size_t(1) << MIN_BITS))
+        return 3;
+
+    size_t bits = MIN_BITS + 1;
+    while ((size_t(1) << bits) < size)
+        ++bits;
+
+    // four classes of 5/8, 6/8, 7/8 and 8/8 of the next power of two
+    const size_t step = size_t(1) << (bits - 3);
+    const size_t steps = (size + step - 1) / step;
+    return (bits - MIN_BITS) * 4 + steps - 5;
+}
+
+size_t _getCapacity(const size_t index)
+{
+    const size_t bits = index / 4 + MIN_BITS;
+    return (index % 4 + 5) << (bits - 3);
+}
+
+void* _allocBlock(const size_t index)
+{
+    const size_t capacity = _getCapacity(index);
+    const size_t size = capacity + HEADER_SIZE;
+    void* block = nullptr;
+#ifdef __linux__
+    if (capacity >= HUGE_SIZE)
+    {
+        block = ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (block == MAP_FAILED)
+            throw std::bad_alloc();
+#ifdef MADV_HUGEPAGE
+        ::madvise(block, size, MADV_HUGEPAGE);
+#endif
+    }
+    else
+#endif
+    {
+        // malloc only guarantees 16 bytes, the buffers are cache-line aligned
+#ifdef _WIN32
+        block = ::_aligned_malloc(size, HEADER_SIZE);
+#else
+        if (::posix_memalign(&block, HEADER_SIZE, size) != 0)
+            block = nullptr;
+#endif
+    }
+
+    if (!block)
+        throw std::bad_alloc();
+    _getHeader(block).index = index;
+    return block;
+}
+
+void _freeBlock(void* block)
+{
+    const size_t capacity = _getCapacity(_getHeader(block).index);
+#ifdef __linux__
+    if (capacity >= HUGE_SIZE)
+    {
+        ::munmap(block, capacity + HEADER_SIZE);
+        return;
+    }
+#endif
+#ifdef _WIN32
+    ::_aligned_free(block);
+#else
+    ::free(block);
+#endif
+}
+
+#ifdef __linux__
+/** Resize a mapped block, keeping its pages. @return 0 on failure. */
+void* _resizeBlock(void* block, const size_t index)
+{
+    const size_t size = _getCapacity(_getHeader(block).index) + HEADER_SIZE;
+    void* grown = ::mremap(block, size, _getCapacity(index) + HEADER_SIZE,
+                           MREMAP_MAYMOVE);
+    if (grown == MAP_FAILED)
+    {
+        _freeBlock(block);
+        return nullptr;
+    }
+    _getHeader(grown).index = index;
+    return grown;
+}
+#endif
+
+/** The shared free lists and memory accounting. */
+class Pool
+{
+public:
+    Pool()
+        : freeBlocks(N_CLASSES)
+        , cachedSize(0)
+        , nTrims(0)
+        , usedSize(0)
+        , threadSize(0)
+        , highWater(0)
+    {
+    }
+
+    /** @return the smallest cached block of up to four times the size. */
+    void* pop(const size_t index)
+    {
+        const size_t end = std::min(index + 9, size_t(N_CLASSES));
+        std::lock_guard<std::mutex> mutex(lock);
+        for (size_t i = index; i < end; ++i)
+            if (!freeBlocks[i].empty())
+                return _pop(i);
+        return nullptr;
+    }
+
+    /**
+     * @return the largest cached mapped block smaller than the class, or the
+     *         smallest larger one.
+     */
+    void* popMapped(const size_t index)
+    {
+        const size_t begin = _getClass(HUGE_SIZE);
+        std::lock_guard<std::mutex> mutex(lock);
+        for (size_t i = index; i > begin; --i)
+            if (!freeBlocks[i - 1].empty())
+                return _pop(i - 1);
+        for (size_t i = index + 1; i < N_CLASSES; ++i)
+            if (!freeBlocks[i].empty())
+                return _pop(i);
+        return nullptr;
+    }
+
+    void push(void* block)
+    {
+        const size_t index = _getHeader(block).index;
+        std::lock_guard<std::mutex> mutex(lock);
+        _getHeader(block).trim = nTrims;
+        freeBlocks[index].push_back(block);
+        cachedSize += _getCapacity(index);
+    }
+
+    void use(const size_t capacity)
+    {
+        const size_t used = (usedSize += capacity);
+        size_t mark = highWater;
+        while (used > mark && !highWater.compare_exchange_weak(mark, used))
+            ;
+    }
+
+    void trim()
+    {
+        std::lock_guard<std::mutex> mutex(lock);
+        const size_t used = usedSize;
+        highWaters.push_back(std::max(highWater.exchange(used), used));
+        if (highWaters.size() > HISTORY)
+            highWaters.pop_front();
+
+        const size_t mark =
+            *std::max_element(highWaters.begin(), highWaters.end());
+        // keep the recently needed memory, plus half of it for size changes
+        const size_t keep = mark > used ? (mark - used) * 3 / 2 : 0;
+
+        // release the least recently used blocks, the oldest of each class
+        // is at the front of its free list
+        while (cachedSize > keep)
+        {
+            std::vector<void*>* oldest = nullptr;
+            for (std::vector<void*>& blocks : freeBlocks)
+                if (!blocks.empty() &&
+                    (!oldest || _getHeader(blocks.front()).trim <
+                                    _getHeader(oldest->front()).trim))
+                {
+                    oldest = &blocks;
+                }
+
+            void* block = oldest->front();
+            oldest->erase(oldest->begin());
+            cachedSize -= _getCapacity(_getHeader(block).index);
+            _freeBlock(block);
+        }
+        ++nTrims;
+    }
+
+    std::mutex lock;
+    std::vector<std::vector<void*>> freeBlocks;
+    size_t cachedSize;
+    uint64_t nTrims;
+
+    std::atomic<size_t> usedSize;
+    std::atomic<size_t> threadSize; //!< cached in all thread caches
+    std::atomic<size_t> highWater;  //!< since the last trim
+    std::deque<size_t> highWaters;
+
+private:
+    void* _pop(const size_t index)
+    {
+        void* block = freeBlocks[index].back();
+        freeBlocks[index].pop_back();
+        cachedSize -= _getCapacity(index);
+        return block;
+    }
+};
+
+Pool& _getPool()
+{
+    // intentionally leaked, buffers may be released during static destruction
+    static Pool* pool = new Pool;
+    return *pool;
+}
+
+/** Small blocks recently released by one thread, avoids the shared lock. */
+class ThreadCache
+{
+public:
+    ThreadCache()
+        : _size(0)
+    {
+    }
+
+    ~ThreadCache()
+    {
+        Pool& pool = _getPool();
+        for (std::vector<void*>& blocks : _blocks)
+            for (void* block : blocks)
+                pool.push(block);
+        pool.threadSize -= _size;
+    }
+
+    void* pop(const size_t index)
+    {
+        if (_blocks.empty() || _blocks[index].empty())
+            return nullptr;
+
+        void* block = _blocks[index].back();
+        _blocks[index].pop_back();
+        _size -= _getCapacity(index);
+        _getPool().threadSize -= _getCapacity(index);
+        return block;
+    }
+
+    bool push(void* block)
+    {
+        const size_t index = _getHeader(block).index;
+        const size_t capacity = _getCapacity(index);
+        if (capacity >= HUGE_SIZE || _size + capacity > THREAD_SIZE)
+            return false;
+
+        if (_blocks.empty())
+            _blocks.resize(N_CLASSES);
+        if (_blocks[index].size() >= THREAD_BLOCKS)
+            return false;
+
+        _blocks[index].push_back(block);
+        _size += capacity;
+        _getPool().threadSize += capacity;
+        return true;
+    }
+
+private:
+    std::vector<std::vector<void*>> _blocks;
+    size_t _size;
+};
+
+thread_local ThreadCache _threadCache;
+}
+
+void* BufferPool::alloc(const size_t size)
+{
+    const size_t index = _getClass(size);
+    LBASSERT(index < N_CLASSES);
+
+    Pool& pool = _getPool();
+    void* block = _threadCache.pop(index);
+    if (!block)
+        block = pool.pop(index);
+#ifdef __linux__
+    // resizing a cached mapping only faults the added pages
+    if (!block && _getCapacity(index) >= HUGE_SIZE)
+    {
+        block = pool.popMapped(index);
+        if (block)
+            block = _resizeBlock(block, index);
+    }
+#endif
+    if (!block)
+        block = _allocBlock(index);
+
+    pool.use(_getCapacity(_getHeader(block).index));
+    return static_cast<uint8_t*>(block) + HEADER_SIZE;
+}
+
+void BufferPool::free(void* buffer)
+{
+    if (!buffer)
+        return;
+
+    void* block = static_cast<uint8_t*>(buffer) - HEADER_SIZE;
+    Pool& pool = _getPool();
+    pool.usedSize -= _getCapacity(_getHeader(block).index);
+    if (!_threadCache.push(block))
+        pool.push(block);
+}
+
+size_t BufferPool::getCapacity(const size_t size)
+{
+    return _getCapacity(_getClass(size));
+}
+
+void BufferPool::trim()
+{
+    _getPool().trim();
+}
+
+void BufferPool::trim(const uint32_t frameNumber)
+{
+    static std::atomic<uint32_t> lastFrame(0);
+    uint32_t last = lastFrame;
+    do
+    {
+        if (last == frameNumber)
+            return; // trimmed by another node of this process
+    } while (!lastFrame.compare_exchange_weak(last, frameNumber));
+
+    _getPool().trim();
+}
+
+size_t BufferPool::getUsedSize()
+{
+    return _getPool().usedSize;
+}
+
+size_t BufferPool::getCachedSize()
+{
+    Pool& pool = _getPool();
+    std::lock_guard<std::mutex> mutex(pool.lock);
+    return pool.cachedSize + pool.threadSize;
+}
+}
+}
@@ -0,0 +1,95 @@
+
+/* Copyright (c) 2026, The Equalizer authors, see AUTHORS
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQUTIL_BUFFERPOOL_H
+#define EQUTIL_BUFFERPOOL_H
+
+#include <eq/api.h>
+#include <eq/types.h>
+
+namespace eq
+{
+namespace util
+{
+/**
+ * A process-wide pool for large, frequently resized buffers, e.g., image pixel
+ * data.
+ *
+ * Requests are rounded up to one of four size classes per power of two, which
+ * bounds the internal fragmentation to 25%. Released buffers are kept per
+ * size class for reuse, in a small per-thread cache and a shared free list.
+ * Buffers of at least 2 MB are mapped directly and backed by transparent huge
+ * pages where available. On Linux, cached mappings of another size class are
+ * resized to serve a request, which keeps their pages resident.
+ *
+ * The memory cached by the pool is bounded by trim(), which releases the
+ * cached buffers exceeding the recent high-water mark of the used memory.
+ *
+ * All methods are thread-safe.
+ * @version 2.1
+ */
+class BufferPool
+{
+public:
+    /**
+     * Allocate a buffer of at least the given size.
+     *
+     * The returned memory is aligned to 64 bytes and not initialized.
+     *
+     * @param size the minimum size of the buffer in bytes.
+     * @return the buffer, never 0.
+     * @throw std::bad_alloc if the memory can't be allocated.
+     * @version 2.1
+     */
+    static EQ_API void* alloc(size_t size);
+
+    /** Release a buffer allocated by alloc(), ignores 0. @version 2.1 */
+    static EQ_API void free(void* buffer);
+
+    /** @return the usable size of a buffer of the given size. @version 2.1 */
+    static EQ_API size_t getCapacity(size_t size);
+
+    /**
+     * Release unneeded cached buffers.
+     *
+     * Cached buffers exceeding the largest memory use seen during the last 16
+     * calls are released to the system. Buffers in the per-thread caches are
+     * not released.
+     * @version 2.1
+     */
+    static EQ_API void trim();
+
+    /**
+     * Release unneeded cached buffers once per frame.
+     *
+     * Called at the end of each frame by every node. The pool is shared by all
+     * nodes of the process, only the first call for a given frame trims it.
+     *
+     * @param frameNumber the finished frame.
+     * @version 2.1
+     */
+    static EQ_API void trim(uint32_t frameNumber);
+
+    /** @return the size of the currently allocated buffers. @version 2.1 */
+    static EQ_API size_t getUsedSize();
+
+    /** @return the size of the cached, unused buffers. @version 2.1 */
+    static EQ_API size_t getCachedSize();
+};
+}
+}
+#endif // EQUTIL_BUFFERPOOL_H
@@ -0,0 +1,185 @@
+
+/* Copyright (c) 2026, The Equalizer authors, see AUTHORS
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQUTIL_SHAREDFRAMEDATA_H
+#define EQUTIL_SHAREDFRAMEDATA_H
+
+#include <eq/types.h>
+
+#include <co/objectHandler.h> // used inline
+#include <lunchbox/debug.h>   // used inline
+
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace eq
+{
+namespace util
+{
+/**
+ * A node-wide, versioned instance of a distributed frame data object.
+ *
+ * Maps one slave instance of a distributed object per process, instead of one
+ * per pipe thread. The first pipe thread requesting a new version applies it
+ * to the slave instance and stores a read-only snapshot for it, all other pipe
+ * threads share this snapshot without synchronizing or copying the object
+ * again. Each version received from the master is therefore applied once per
+ * node, regardless of the number of pipes.
+ *
+ * Versions are applied in order, so that pipe threads running behind the
+ * fastest pipe find the snapshot of their frame. The snapshots of the given
+ * number of versions older than the newest version are retained, which should
+ * be at least the latency of the config plus one.
+ *
+ * The template type has to be a co::Object with a public copy constructor
+ * creating a snapshot of the current data. All methods except map() and
+ * unmap() are thread-safe.
+ * @version 2.1
+ */
+template <class T>
+class SharedFrameData
+{
+public:
+    typedef std::shared_ptr<const T> ConstPtr;
+
+    /** Construct a new, unmapped instance. @version 2.1 */
+    SharedFrameData()
+        : _nRetained(1)
+        , _nSyncs(0)
+    {
+    }
+
+    ~SharedFrameData() { LBASSERT(!_object.isAttached()); }
+    SharedFrameData(const SharedFrameData&) = delete;
+    SharedFrameData& operator=(const SharedFrameData&) = delete;
+
+    /**
+     * Map the slave instance of the given distributed object.
+     *
+     * @param handler the object handler used for mapping, e.g., the config.
+     * @param id the identifier of the master instance.
+     * @param nRetained the number of older versions kept for slower pipes.
+     * @return true if the object was mapped, false otherwise.
+     * @version 2.1
+     */
+    bool map(co::ObjectHandler& handler, const uint128_t& id,
+             const uint32_t nRetained)
+    {
+        LBASSERT(!_object.isAttached());
+        if (!handler.mapObjectSync(handler.mapObjectNB(&_object, id,
+                                                       co::VERSION_OLDEST,
+                                                       co::NodePtr())))
+        {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> mutex(_lock);
+        _nRetained = nRetained;
+        _nSyncs = 0;
+        _snapshots.clear();
+        _snapshots[_object.getVersion()] = std::make_shared<const T>(_object);
+        return true;
+    }
+
+    /** Unmap the slave instance and release all snapshots. @version 2.1 */
+    void unmap(co::ObjectHandler& handler)
+    {
+        if (_object.isAttached())
+            handler.unmapObject(&_object);
+
+        std::lock_guard<std::mutex> mutex(_lock);
+        _snapshots.clear();
+    }
+
+    /**
+     * Get the snapshot of the given version of the frame data.
+     *
+     * Blocks until the version is available. Versions older than the newest
+     * retained version are not available anymore, the oldest retained
+     * snapshot is returned for them.
+     *
+     * @param version the version of the master instance, e.g., a frame ID.
+     * @return the snapshot of the given version.
+     * @version 2.1
+     */
+    ConstPtr sync(const uint128_t& version)
+    {
+        ConstPtr snapshot = _find(version);
+        if (snapshot)
+            return snapshot;
+
+        // Only one thread applies new versions, the others wait for it
+        std::lock_guard<std::mutex> syncMutex(_syncLock);
+        while (_object.getVersion() < version)
+        {
+            const uint128_t next = _object.sync(_object.getVersion() + 1);
+            snapshot = std::make_shared<const T>(_object);
+
+            std::lock_guard<std::mutex> mutex(_lock);
+            _snapshots[next] = snapshot;
+            ++_nSyncs;
+            while (_snapshots.begin()->first + _nRetained < next)
+                _snapshots.erase(_snapshots.begin());
+        }
+
+        snapshot = _find(version);
+        if (snapshot)
+            return snapshot;
+
+        LBWARN << "Version " << version << " of " << _object.getID()
+               << " not retained, increase the number of retained versions"
+               << std::endl;
+        std::lock_guard<std::mutex> mutex(_lock);
+        return _snapshots.begin()->second;
+    }
+
+    /** @return the snapshot of the newest applied version. @version 2.1 */
+    ConstPtr getNewest() const
+    {
+        std::lock_guard<std::mutex> mutex(_lock);
+        LBASSERT(!_snapshots.empty());
+        return _snapshots.rbegin()->second;
+    }
+
+    /** @return the number of versions applied since map(). @version 2.1 */
+    size_t getNumSyncs() const
+    {
+        std::lock_guard<std::mutex> mutex(_lock);
+        return _nSyncs;
+    }
+
+private:
+    typedef std::map<uint128_t, ConstPtr> Snapshots;
+
+    T _object;                //!< The mapped slave instance
+    Snapshots _snapshots;     //!< Retained snapshots by version
+    uint32_t _nRetained;      //!< Older versions kept for slower pipes
+    size_t _nSyncs;           //!< Versions applied to _object
+    mutable std::mutex _lock; //!< Protects the snapshots and counters
+    std::mutex _syncLock;     //!< Serializes the access to _object
+
+    ConstPtr _find(const uint128_t& version) const
+    {
+        std::lock_guard<std::mutex> mutex(_lock);
+        const typename Snapshots::const_iterator i = _snapshots.find(version);
+        return i == _snapshots.end() ? ConstPtr() : i->second;
+    }
+};
+}
+}
+#endif // EQUTIL_SHAREDFRAMEDATA_H
@@ -33,7 +33,10 @@ class FrameBufferObject;
 class PixelBufferObject;
 class Texture;
 class BitmapFont;
+class BufferPool;
 class ObjectManager;
+template <class T>
+class SharedFrameData;
 
 namespace shader
 {
@@ -822,7 +822,7 @@ bool Window::processEvent(Statistic& event)
 {
     Config* config = getConfig();
     updateEvent(event, config->getTime());
-    config->sendEvent(EVENT_STATISTIC) << event;
+    getNode()->queueStatistic(event);
     return true;
 }
 
@@ -0,0 +1,431 @@
+
+/* Copyright (c) 2026, The Equalizer authors, see AUTHORS
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Eyescale Software GmbH nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef EVOLVE_BRICKGRID_H
+#define EVOLVE_BRICKGRID_H
+
+#include <eq/eq.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace eVolve
+{
+/**
+ * The value ranges of the bricks of a volume, used to skip its empty space.
+ *
+ * The volume is divided into bricks of brickSize^3 voxels. The value range of
+ * each brick includes the voxels within 'overlap' of the brick, which covers
+ * the linear texture filtering and the distance between the front and back
+ * sample of a pre-integrated slice. A brick is empty if the transfer function
+ * is transparent over its whole value range, since the slice fragments within
+ * it do not change the framebuffer. Changing the transfer function only needs
+ * to classify the bricks again.
+ *
+ * Bricks and slices use the object coordinates of the volume, [-1,1]^3.
+ */
+class BrickGrid
+{
+public:
+    /** Convex slice polygons, in back-to-front order. */
+    struct Polygons
+    {
+        std::vector<eq::Vector3f> vertices;
+        std::vector<uint32_t> sizes; //!< number of vertices of each polygon
+
+        void clear()
+        {
+            vertices.clear();
+            sizes.clear();
+        }
+    };
+
+    /** Voxels around each brick included in its value range. */
+    static const uint32_t overlap = 4;
+
+    BrickGrid()
+        : _brickSize(1)
+        , _nOccupied(0)
+    {
+    }
+
+    /** Reset the value ranges for a volume of the given size. */
+    void resize(const uint32_t w, const uint32_t h, const uint32_t d,
+                const uint32_t brickSize)
+    {
+        LBASSERT(brickSize > 0);
+        _size = vmml::Vector3ui(w, h, d);
+        _brickSize = brickSize;
+        for (size_t i = 0; i < 3; ++i)
+            _nBricks[i] = (_size[i] + brickSize - 1) / brickSize;
+
+        const size_t nBricks = _nBricks[0] * _nBricks[1] * _nBricks[2];
+        _min.assign(nBricks, 255);
+        _max.assign(nBricks, 0);
+        _occupied.assign(nBricks, true);
+        _nOccupied = nBricks;
+    }
+
+    /**
+     * Add the values of one z slice of the volume.
+     *
+     * @param z the slice position.
+     * @param values the first value of the slice, w * h values stored row by
+     *               row.
+     * @param stride the distance of two values in bytes.
+     */
+    void addSlice(const uint32_t z, const uint8_t* values, const size_t stride)
+    {
+        const uint32_t zFirst = _getFirstBrick(z);
+        const uint32_t zLast = _getLastBrick(z, 2);
+
+        for (uint32_t y = 0; y < _size.y(); ++y)
+        {
+            const uint32_t yFirst = _getFirstBrick(y);
+            const uint32_t yLast = _getLastBrick(y, 1);
+
+            for (uint32_t x = 0; x < _size.x(); ++x, values += stride)
+            {
+                const uint8_t value = *values;
+                const uint32_t xLast = _getLastBrick(x, 0);
+
+                for (uint32_t k = zFirst; k <= zLast; ++k)
+                    for (uint32_t j = yFirst; j <= yLast; ++j)
+                        for (uint32_t i = _getFirstBrick(x); i <= xLast; ++i)
+                        {
+                            const size_t index = _getIndex(i, j, k);
+                            _min[index] = std::min(_min[index], value);
+                            _max[index] = std::max(_max[index], value);
+                        }
+            }
+        }
+    }
+
+    /**
+     * Classify the bricks for a transfer function.
+     *
+     * @param transferFunction 256 RGBA entries.
+     * @return the number of non-empty bricks.
+     */
+    size_t classify(const std::vector<uint8_t>& transferFunction)
+    {
+        // number of opaque entries up to each value
+        uint32_t nOpaque[257] = {0};
+        for (size_t i = 0; i < 256; ++i)
+        {
+            const size_t alpha = i * 4 + 3;
+            const bool opaque =
+                alpha < transferFunction.size() && transferFunction[alpha] > 0;
+            nOpaque[i + 1] = nOpaque[i] + (opaque ? 1 : 0);
+        }
+
+        _nOccupied = 0;
+        for (size_t i = 0; i < _occupied.size(); ++i)
+        {
+            _occupied[i] =
+                _min[i] <= _max[i] && nOpaque[_max[i] + 1] > nOpaque[_min[i]];
+            if (_occupied[i])
+                ++_nOccupied;
+        }
+        return _nOccupied;
+    }
+
+    size_t getNumBricks() const { return _occupied.size(); }
+    size_t getNumOccupied() const { return _nOccupied; }
+    const vmml::Vector3ui& getBrickCounts() const { return _nBricks; }
+    /** @return the value range of a brick. */
+    std::pair<uint8_t, uint8_t> getRange(const uint32_t i, const uint32_t j,
+                                         const uint32_t k) const
+    {
+        const size_t index = _getIndex(i, j, k);
+        return std::make_pair(_min[index], _max[index]);
+    }
+
+    bool isOccupied(const uint32_t i, const uint32_t j, const uint32_t k) const
+    {
+        return _occupied[_getIndex(i, j, k)];
+    }
+
+    /** @return the bounds of a brick clipped to the z range of a DB range. */
+    void getBounds(const uint32_t i, const uint32_t j, const uint32_t k,
+                   const eq::Range& range, eq::Vector3f& min,
+                   eq::Vector3f& max) const
+    {
+        const vmml::Vector3ui brick(i, j, k);
+        for (size_t c = 0; c < 3; ++c)
+        {
+            const uint32_t first = brick[c] * _brickSize;
+            const uint32_t last = std::min(first + _brickSize, _size[c]);
+            min[c] = 2.f * first / _size[c] - 1.f;
+            max[c] = 2.f * last / _size[c] - 1.f;
+        }
+        min.z() = std::max(min.z(), -1.f + 2.f * range.start);
+        max.z() = std::min(max.z(), -1.f + 2.f * range.end);
+    }
+
+    /**
+     * Compute the bounds of the non-empty bricks within a DB range.
+     *
+     * @return false if the range contains no non-empty brick.
+     */
+    bool getBounds(const eq::Range& range, eq::Vector3f& min,
+                   eq::Vector3f& max) const
+    {
+        min = eq::Vector3f(1.f, 1.f, 1.f);
+        max = eq::Vector3f(-1.f, -1.f, -1.f);
+        for (uint32_t k = 0; k < _nBricks.z(); ++k)
+            for (uint32_t j = 0; j < _nBricks.y(); ++j)
+                for (uint32_t i = 0; i < _nBricks.x(); ++i)
+                {
+                    if (!isOccupied(i, j, k))
+                        continue;
+
+                    eq::Vector3f brickMin, brickMax;
+                    getBounds(i, j, k, range, brickMin, brickMax);
+                    if (brickMin.z() >= brickMax.z())
+                        continue;
+
+                    for (size_t c = 0; c < 3; ++c)
+                    {
+                        min[c] = std::min(min[c], brickMin[c]);
+                        max[c] = std::max(max[c], brickMax[c]);
+                    }
+                }
+        return min.x() < max.x();
+    }
+
+    /** @return the number of non-empty bricks within a DB range. */
+    size_t getNumOccupied(const eq::Range& range) const
+    {
+        size_t nBricks = 0;
+        size_t nOccupied = 0;
+        _count(range, nBricks, nOccupied);
+        return nOccupied;
+    }
+
+    /** @return the fraction of non-empty bricks within a DB range. */
+    float getOccupancy(const eq::Range& range) const
+    {
+        size_t nBricks = 0;
+        size_t nOccupied = 0;
+        _count(range, nBricks, nOccupied);
+        return nBricks == 0 ? 0.f : float(nOccupied) / float(nBricks);
+    }
+
+    /**
+     * Compute the slices through the non-empty bricks of a DB range.
+     *
+     * The slices are the planes with viewVec.dot( p ) = n * sliceDistance, the
+     * same planes as the slices through the whole volume. The polygons are
+     * ordered by decreasing distance.
+     */
+    void computeSlices(const eq::Vector3f& viewVec, const double sliceDistance,
+                       const eq::Range& range, Polygons& polygons) const
+    {
+        polygons.clear();
+
+        struct Slice
+        {
+            int64_t plane;
+            eq::Vector3f min;
+            eq::Vector3f max;
+            bool operator<(const Slice& rhs) const { return plane > rhs.plane; }
+        };
+        std::vector<Slice> slices;
+
+        for (uint32_t k = 0; k < _nBricks.z(); ++k)
+            for (uint32_t j = 0; j < _nBricks.y(); ++j)
+                for (uint32_t i = 0; i < _nBricks.x(); ++i)
+                {
+                    if (!isOccupied(i, j, k))
+                        continue;
+
+                    Slice slice;
+                    getBounds(i, j, k, range, slice.min, slice.max);
+                    if (slice.min.z() >= slice.max.z())
+                        continue;
+
+                    double near = 0., far = 0.;
+                    for (size_t c = 0; c < 3; ++c)
+                    {
+                        near += viewVec[c] * (viewVec[c] > 0.f ? slice.min[c]
+                                                               : slice.max[c]);
+                        far += viewVec[c] * (viewVec[c] > 0.f ? slice.max[c]
+                                                              : slice.min[c]);
+                    }
+
+                    const int64_t first = int64_t(ceil(near / sliceDistance));
+                    const int64_t last = int64_t(floor(far / sliceDistance));
+                    for (slice.plane = first; slice.plane <= last;
+                         ++slice.plane)
+                    {
+                        slices.push_back(slice);
+                    }
+                }
+
+        std::stable_sort(slices.begin(), slices.end());
+
+        eq::Vector3f vertices[6];
+        for (const Slice& slice : slices)
+        {
+            const size_t nVertices =
+                clipBox(slice.min, slice.max, viewVec,
+                        float(slice.plane * sliceDistance), vertices);
+            if (nVertices < 3)
+                continue;
+
+            polygons.vertices.insert(polygons.vertices.end(), vertices,
+                                     vertices + nVertices);
+            polygons.sizes.push_back(uint32_t(nVertices));
+        }
+    }
+
+    /**
+     * Intersect a plane with an axis-aligned box.
+     *
+     * Intersections on an edge shared by two boxes are computed identically
+     * for both boxes, so that neighbouring polygons fit without cracks.
+     *
+     * @param min the lower corner of the box.
+     * @param max the upper corner of the box.
+     * @param normal the plane normal.
+     * @param distance the plane distance, normal.dot( p ) = distance.
+     * @param vertices the returned polygon, ordered around its center.
+     * @return the number of polygon vertices, at most six.
+     */
+    static size_t clipBox(const eq::Vector3f& min, const eq::Vector3f& max,
+                          const eq::Vector3f& normal, const float distance,
+                          eq::Vector3f vertices[6])
+    {
+        size_t nVertices = 0;
+        for (size_t axis = 0; axis < 3; ++axis)
+        {
+            const size_t u = (axis + 1) % 3;
+            const size_t v = (axis + 2) % 3;
+            for (size_t edge = 0; edge < 4; ++edge)
+            {
+                // edge along axis, from the lower to the upper corner
+                eq::Vector3f a;
+                a[axis] = min[axis];
+                a[u] = (edge & 1) ? max[u] : min[u];
+                a[v] = (edge & 2) ? max[v] : min[v];
+                eq::Vector3f b = a;
+                b[axis] = max[axis];
+
+                const float da = normal.dot(a) - distance;
+                const float db = normal.dot(b) - distance;
+                if ((da < 0.f) == (db < 0.f))
+                    continue;
+
+                const eq::Vector3f p = a + (b - a) * (da / (da - db));
+                if (std::find(vertices, vertices + nVertices, p) ==
+                        vertices + nVertices &&
+                    nVertices < 6)
+                {
+                    vertices[nVertices++] = p;
+                }
+            }
+        }
+        if (nVertices < 3)
+            return nVertices;
+
+        eq::Vector3f center(0.f, 0.f, 0.f);
+        for (size_t i = 0; i < nVertices; ++i)
+            center += vertices[i];
+        center /= float(nVertices);
+
+        eq::Vector3f s = vertices[0] - center;
+        s.normalize();
+        eq::Vector3f t = normal.cross(s);
+        t.normalize();
+        float angles[6];
+        for (size_t i = 0; i < nVertices; ++i)
+        {
+            const eq::Vector3f d = vertices[i] - center;
+            angles[i] = std::atan2(t.dot(d), s.dot(d));
+        }
+
+        // insertion sort by angle
+        for (size_t i = 1; i < nVertices; ++i)
+            for (size_t j = i; j > 0 && angles[j] < angles[j - 1]; --j)
+            {
+                std::swap(angles[j], angles[j - 1]);
+                std::swap(vertices[j], vertices[j - 1]);
+            }
+        return nVertices;
+    }
+
+private:
+    vmml::Vector3ui _size;
+    vmml::Vector3ui _nBricks;
+    uint32_t _brickSize;
+
+    std::vector<uint8_t> _min;
+    std::vector<uint8_t> _max;
+    std::vector<bool> _occupied;
+    size_t _nOccupied;
+
+    size_t _getIndex(const uint32_t i, const uint32_t j, const uint32_t k) const
+    {
+        return (size_t(k) * _nBricks.y() + j) * _nBricks.x() + i;
+    }
+
+    void _count(const eq::Range& range, size_t& nBricks,
+                size_t& nOccupied) const
+    {
+        for (uint32_t k = 0; k < _nBricks.z(); ++k)
+        {
+            eq::Vector3f min, max;
+            getBounds(0, 0, k, range, min, max);
+            if (min.z() >= max.z())
+                continue;
+
+            for (uint32_t j = 0; j < _nBricks.y(); ++j)
+                for (uint32_t i = 0; i < _nBricks.x(); ++i)
+                {
+                    ++nBricks;
+                    if (isOccupied(i, j, k))
+                        ++nOccupied;
+                }
+        }
+    }
+
+    uint32_t _getFirstBrick(const uint32_t position) const
+    {
+        return position > overlap ? (position - overlap) / _brickSize : 0;
+    }
+
+    uint32_t _getLastBrick(const uint32_t position, const size_t axis) const
+    {
+        return std::min((position + overlap) / _brickSize, _nBricks[axis] - 1);
+    }
+};
+}
+
+#endif // EVOLVE_BRICKGRID_H
@@ -33,6 +33,7 @@
 #include "eVolve.h"
 
 #include <eq/eq.h>
+#include <memory>
 
 namespace eVolve
 {
@@ -114,6 +115,9 @@ private:
     eq::uint128_t _currentViewID;
     std::string _message;
 };
+
+/** A read-only snapshot of one version of the frame data. */
+typedef std::shared_ptr<const FrameData> ConstFrameDataPtr;
 }
 
 #endif // EVOLVE_FRAMEDATA_H
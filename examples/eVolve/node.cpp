@@ -48,6 +48,20 @@ bool Node::configInit(const eq::uint128_t& initID)
         sendError(ERROR_EVOLVE_MAPOBJECT_FAILED);
         return false;
     }
+
+    const InitData& initData = config->getInitData();
+    if (!_frameData.map(*config, initData.getFrameDataID(),
+                        config->getLatency() + 1))
+    {
+        sendError(ERROR_EVOLVE_MAPOBJECT_FAILED);
+        return false;
+    }
     return true;
 }
+
+bool Node::configExit()
+{
+    _frameData.unmap(*getConfig());
+    return eq::Node::configExit();
+}
 }
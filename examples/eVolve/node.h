@@ -30,6 +30,7 @@
 #define EVOLVE_NODE_H
 
 #include "eVolve.h"
+#include "frameData.h"
 #include "initData.h"
 
 #include <eq/eq.h>
@@ -44,9 +45,26 @@ public:
     {
     }
 
+    /** @return the frame data of the given version, shared by all pipes. */
+    ConstFrameDataPtr syncFrameData(const eq::uint128_t& version)
+    {
+        return _frameData.sync(version);
+    }
+
+    /** @return the newest synchronized frame data. */
+    ConstFrameDataPtr getNewestFrameData() const
+    {
+        return _frameData.getNewest();
+    }
+
 protected:
     virtual ~Node() {}
     virtual bool configInit(const eq::uint128_t& initID);
+    virtual bool configExit();
+
+private:
+    /** Mapped once per node, synchronized by the first pipe of each frame. */
+    eq::util::SharedFrameData<FrameData> _frameData;
 };
 }
 
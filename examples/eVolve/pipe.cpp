@@ -30,8 +30,8 @@
  * The pipe object is responsible for maintaining GPU-specific and
  * frame-specific data. The identifier passed by the application contains the
  * version of the frame data corresponding to the rendered frame. The pipe's
- * start frame callback synchronizes the thread-local instance of the frame data
- * to this version.
+ * start frame callback obtains the snapshot of this version from the node,
+ * which synchronizes the frame data once for all its pipes.
  */
 
 #include "pipe.h"
@@ -57,10 +57,8 @@ bool Pipe::configInit(const eq::uint128_t& initID)
 
     Config* config = static_cast<Config*>(getConfig());
     const InitData& initData = config->getInitData();
-    const eq::uint128_t frameDataID = initData.getFrameDataID();
-
-    const bool mapped = config->mapObject(&_frameData, frameDataID);
-    LBASSERT(mapped);
+    const Node* node = static_cast<const Node*>(getNode());
+    _frameData = node->getNewestFrameData();
 
     const std::string& filename = initData.getFilename();
     const uint32_t precision = initData.getPrecision();
@@ -77,7 +75,7 @@ bool Pipe::configInit(const eq::uint128_t& initID)
         return false;
     }
 
-    return mapped;
+    return true;
 }
 
 bool Pipe::configExit()
@@ -85,17 +83,16 @@ bool Pipe::configExit()
     delete _renderer;
     _renderer = 0;
 
-    eq::Config* config = getConfig();
-    config->unmapObject(&_frameData);
-
+    _frameData.reset();
     return eq::Pipe::configExit();
 }
 
 void Pipe::frameStart(const eq::uint128_t& frameID, const uint32_t frameNumber)
 {
     eq::Pipe::frameStart(frameID, frameNumber);
-    _frameData.sync(frameID);
+    Node* node = static_cast<Node*>(getNode());
+    _frameData = node->syncFrameData(frameID);
 
-    _renderer->setOrtho(_frameData.useOrtho());
+    _renderer->setOrtho(_frameData->useOrtho());
 }
 }
@@ -44,7 +44,7 @@ public:
     {
     }
 
-    const FrameData& getFrameData() const { return _frameData; }
+    const FrameData& getFrameData() const { return *_frameData; }
     Renderer* getRenderer() { return _renderer; }
     const Renderer* getRenderer() const { return _renderer; }
 protected:
@@ -56,7 +56,7 @@ protected:
                             const uint32_t frameNumber);
 
 private:
-    FrameData _frameData;
+    ConstFrameDataPtr _frameData; //!< The node's snapshot of the current frame
 
     Renderer* _renderer; //!< The renderer, holding the volume
 };
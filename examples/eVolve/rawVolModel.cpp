@@ -125,6 +125,9 @@ bool RawVolumeModel::getVolumeInfo(VolumeInfo& info, const eq::Range& range)
         _preintName = createPreintegrationTable(&_TF[0]);
     }
 
+    if (_bricks.getNumBricks() == 0 && !_createBricks())
+        return false;
+
     VolumePart* volumePart = nullptr;
     const int32_t key = calcHashKey(range);
 
@@ -301,6 +304,41 @@ bool RawVolumeModel::_createVolumeTexture(GLuint& volume,
     return true;
 }
 
+bool RawVolumeModel::_createBricks()
+{
+    const uint32_t bytes = _hasDerivatives ? 4 : 1;
+    const uint32_t brickSize = std::max(8u, (_resolution + 15) / 16);
+
+    std::ifstream file(_filename.c_str(),
+                       std::ifstream::in | std::ifstream::binary);
+    if (!file.is_open())
+    {
+        LBERROR << "Can't open model data file" << std::endl;
+        return false;
+    }
+
+    BrickGrid bricks;
+    bricks.resize(_w, _h, _d, brickSize);
+    std::vector<uint8_t> data(_w * _h * bytes);
+    for (uint32_t z = 0; z < _d; ++z)
+    {
+        if (!file.read((char*)(&data[0]), data.size()))
+        {
+            LBERROR << "Can't read model data file" << std::endl;
+            return false;
+        }
+        // the value is the last byte of gx, gy, gz, val
+        bricks.addSlice(z, &data[bytes - 1], bytes);
+    }
+
+    _bricks = bricks;
+    _bricks.classify(_TF);
+    LBLOG(eq::LOG_CUSTOM) << _bricks.getNumOccupied() << " of "
+                          << _bricks.getNumBricks() << " bricks non-empty"
+                          << std::endl;
+    return true;
+}
+
 /** Volume always represented as cube [-1,-1,-1]..[1,1,1], so if the model
     is not cube it's proportions should be modified. This function makes
     maximum proportion equal to 1.0 to prevent unnecessary rescaling.
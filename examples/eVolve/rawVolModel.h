@@ -29,6 +29,8 @@
 #ifndef EVOLVE_RAW_VOL_MODEL_H
 #define EVOLVE_RAW_VOL_MODEL_H
 
+#include "brickGrid.h"
+
 #include <eq/eq.h>
 
 namespace eVolve
@@ -94,12 +96,17 @@ public:
     const std::string& getFileName() const { return _filename; }
     uint32_t getResolution() const { return _resolution; }
     const VolumeScaling& getVolumeScaling() const { return _volScaling; }
+    /** @return the value ranges of the bricks, valid after getVolumeInfo. */
+    const BrickGrid& getBricks() const { return _bricks; }
     void glewSetContext(const GLEWContext* context) { _glewContext = context; }
     const GLEWContext* glewGetContext() const { return _glewContext; }
 protected:
     bool _createVolumeTexture(GLuint& volume, DataInTextureDimensions& TD,
                               const eq::Range& range);
 
+    /** Compute the value ranges of the bricks and classify them. */
+    bool _createBricks();
+
 private:
     struct VolumePart
     {
@@ -128,6 +135,8 @@ private:
 
     bool _hasDerivatives; //!< true if raw+der used
 
+    BrickGrid _bricks; //!< value ranges for empty space skipping
+
     const GLEWContext* _glewContext; //!< OpenGL function table
 };
 }
@@ -44,7 +44,7 @@ RawVolumeModelRenderer::RawVolumeModelRenderer(const std::string& filename,
 
 static void renderSlices(const SliceClipper& sliceClipper)
 {
-    int numberOfSlices = static_cast<int>(3.6 / sliceClipper.sliceDistance);
+    const int numberOfSlices = sliceClipper.numberOfSlices;
 
     for (int s = 0; s < numberOfSlices; ++s)
     {
@@ -60,6 +60,18 @@ static void renderSlices(const SliceClipper& sliceClipper)
     }
 }
 
+static void renderSlices(const BrickGrid::Polygons& slices)
+{
+    const eq::Vector3f* vertex = slices.vertices.data();
+    for (const uint32_t nVertices : slices.sizes)
+    {
+        glBegin(GL_POLYGON);
+        for (uint32_t i = 0; i < nVertices; ++i, ++vertex)
+            glVertex4f(vertex->x(), vertex->y(), vertex->z(), 1.0);
+        glEnd();
+    }
+}
+
 void RawVolumeModelRenderer::_putVolumeDataToShader(
     const VolumeInfo& volumeInfo, const float sliceDistance,
     const eq::Matrix4f& invRotationM, const eq::Vector4f& taintColor,
@@ -161,13 +173,31 @@ bool RawVolumeModelRenderer::render(const eq::Range& range,
     _putVolumeDataToShader(volumeInfo, float(sliceDistance), invRotationM,
                            taintColor, normalsQuality);
 
-    _sliceClipper.updatePerFrameInfo(modelviewM, sliceDistance, range);
-
     // Render slices
     glEnable(GL_BLEND);
     glBlendFuncSeparateEXT(GL_ONE, GL_SRC_ALPHA, GL_ZERO, GL_SRC_ALPHA);
 
-    renderSlices(_sliceClipper);
+    // Skip empty space: slice the bounds of the non-empty bricks of the range,
+    // or only the non-empty bricks if a good part of the bricks is empty
+    const BrickGrid& bricks = _rawModel.getBricks();
+    eq::Vector3f min, max;
+    if (bricks.getBounds(range, min, max))
+    {
+        if (bricks.getOccupancy(range) < .75f)
+        {
+            const eq::Vector3f viewVec(-modelviewM.array[2],
+                                       -modelviewM.array[6],
+                                       -modelviewM.array[10]);
+            bricks.computeSlices(viewVec, sliceDistance, range, _slices);
+            renderSlices(_slices);
+        }
+        else
+        {
+            _sliceClipper.updatePerFrameInfo(modelviewM, sliceDistance, min,
+                                             max);
+            renderSlices(_sliceClipper);
+        }
+    }
 
     glDisable(GL_BLEND);
 
@@ -29,6 +29,7 @@
 #ifndef EVOLVE_RAW_VOL_MODEL_RENDERER_H
 #define EVOLVE_RAW_VOL_MODEL_RENDERER_H
 
+#include "brickGrid.h"
 #include "glslShaders.h"
 #include "rawVolModel.h"
 #include "sliceClipping.h"
@@ -73,10 +74,11 @@ private:
                                 const eq::Vector4f& taintColor,
                                 const int normalsQuality);
 
-    RawVolumeModel _rawModel;   //!< volume data
-    SliceClipper _sliceClipper; //!< frame clipping algorithm
-    uint32_t _precision;        //!< multiplyer for number of slices
-    GLSLShaders _shaders;       //!< GLSL shaders
+    RawVolumeModel _rawModel;    //!< volume data
+    SliceClipper _sliceClipper;  //!< frame clipping algorithm
+    BrickGrid::Polygons _slices; //!< slices of the non-empty bricks
+    uint32_t _precision;         //!< multiplyer for number of slices
+    GLSLShaders _shaders;        //!< GLSL shaders
 
     const GLEWContext* _glewContext; //!< OpenGL function table
 
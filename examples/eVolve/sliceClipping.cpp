@@ -54,6 +54,7 @@ SliceClipper::SliceClipper()
     , frontIndex(0)
     , sliceDistance(0)
     , planeStart(0)
+    , numberOfSlices(0)
 {
 }
 
@@ -61,20 +62,30 @@ void SliceClipper::updatePerFrameInfo(const eq::Matrix4f& modelviewM,
                                       const double newSliceDistance,
                                       const eq::Range& range)
 {
-    double zRs = -1 + 2. * range.start;
-    double zRe = -1 + 2. * range.end;
+    const float zRs = -1.f + 2.f * range.start;
+    const float zRe = -1.f + 2.f * range.end;
 
+    updatePerFrameInfo(modelviewM, newSliceDistance,
+                       eq::Vector3f(-1.f, -1.f, zRs),
+                       eq::Vector3f(1.f, 1.f, zRe));
+}
+
+void SliceClipper::updatePerFrameInfo(const eq::Matrix4f& modelviewM,
+                                      const double newSliceDistance,
+                                      const eq::Vector3f& min,
+                                      const eq::Vector3f& max)
+{
     // rendering parallelepipid's verteces
     eq::Vector4f vertices[8];
-    vertices[0] = eq::Vector4f(-1.0, -1.0, zRs, 1.0);
-    vertices[1] = eq::Vector4f(1.0, -1.0, zRs, 1.0);
-    vertices[2] = eq::Vector4f(-1.0, 1.0, zRs, 1.0);
-    vertices[3] = eq::Vector4f(1.0, 1.0, zRs, 1.0);
+    vertices[0] = eq::Vector4f(min.x(), min.y(), min.z(), 1.0);
+    vertices[1] = eq::Vector4f(max.x(), min.y(), min.z(), 1.0);
+    vertices[2] = eq::Vector4f(min.x(), max.y(), min.z(), 1.0);
+    vertices[3] = eq::Vector4f(max.x(), max.y(), min.z(), 1.0);
 
-    vertices[4] = eq::Vector4f(-1.0, -1.0, zRe, 1.0);
-    vertices[5] = eq::Vector4f(1.0, -1.0, zRe, 1.0);
-    vertices[6] = eq::Vector4f(-1.0, 1.0, zRe, 1.0);
-    vertices[7] = eq::Vector4f(1.0, 1.0, zRe, 1.0);
+    vertices[4] = eq::Vector4f(min.x(), min.y(), max.z(), 1.0);
+    vertices[5] = eq::Vector4f(max.x(), min.y(), max.z(), 1.0);
+    vertices[6] = eq::Vector4f(min.x(), max.y(), max.z(), 1.0);
+    vertices[7] = eq::Vector4f(max.x(), max.y(), max.z(), 1.0);
 
     for (int i = 0; i < 8; i++)
         for (int j = 0; j < 3; j++)
@@ -103,6 +114,8 @@ void SliceClipper::updatePerFrameInfo(const eq::Matrix4f& modelviewM,
     planeStart = viewVec.dot(vertices[nSequence[frontIndex][0]]);
     double dS = ceil(planeStart / sliceDistance);
     planeStart = dS * sliceDistance;
+    numberOfSlices =
+        std::max(0, int(floor((maxDist - planeStart) / sliceDistance)) + 1);
 }
 
 eq::Vector3f SliceClipper::getPosition(const int vertexNum,
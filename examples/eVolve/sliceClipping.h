@@ -47,6 +47,11 @@ struct SliceClipper
     void updatePerFrameInfo(const eq::Matrix4f& modelviewM,
                             const double sliceDistance, const eq::Range& range);
 
+    /** Slice the box [min, max] instead of the volume part of a range. */
+    void updatePerFrameInfo(const eq::Matrix4f& modelviewM,
+                            const double sliceDistance, const eq::Vector3f& min,
+                            const eq::Vector3f& max);
+
     eq::Vector3f getPosition(const int vertexNum, const int sliceNum) const;
 
     float shaderVertices[24];
@@ -55,6 +60,7 @@ struct SliceClipper
     int frontIndex;
     double sliceDistance;
     double planeStart;
+    int numberOfSlices; //!< slices intersecting the box
 };
 }
 
@@ -33,6 +33,7 @@
 
 #include "config.h"
 #include "initData.h"
+#include "jitter.h"
 #include "pipe.h"
 #include "vertexBufferState.h"
 #include "view.h"
@@ -132,6 +133,42 @@ void Channel::frameDraw(const eq::uint128_t& frameID)
     if (model)
         _updateNearFar(model->getBoundingBox());
 
+    Accum& accum = _accum[lunchbox::getIndexOfLastBit(getEye())];
+    const uint32_t nSamples = _getNumSamples();
+    uint32_t rendered = 1;
+    if (nSamples > 1 && _initSamples())
+    {
+        rendered = nSamples;
+        // render all idle samples of this frame, transmit their average
+        accum.samples->clear();
+        for (accum.sample = 0; accum.sample < nSamples; ++accum.sample)
+        {
+            if (accum.sample > 0)
+            {
+                applyBuffer();
+                applyViewport();
+                glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            }
+            _drawScene(frameID, model);
+            accum.samples->accum();
+        }
+        accum.sample = 0;
+
+        setupAssemblyState();
+        accum.samples->display();
+        resetAssemblyState();
+    }
+    else
+        _drawScene(frameID, model);
+
+    state.setFrustumCulling(true);
+    accum.stepsDone = LB_MAX(accum.stepsDone,
+                             getSubPixel().size * getPeriod() * rendered);
+    accum.transfer = true;
+}
+
+void Channel::_drawScene(const eq::uint128_t& frameID, const Model* model)
+{
     eq::Channel::frameDraw(frameID); // Setup OpenGL state
 
     glLightfv(GL_LIGHT0, GL_POSITION, lightPosition);
@@ -174,11 +211,6 @@ void Channel::frameDraw(const eq::uint128_t& frameID)
         glVertex3f(-.25f, 0.f, -.25f);
         glEnd();
     }
-
-    state.setFrustumCulling(true);
-    Accum& accum = _accum[lunchbox::getIndexOfLastBit(getEye())];
-    accum.stepsDone = LB_MAX(accum.stepsDone, getSubPixel().size * getPeriod());
-    accum.transfer = true;
 }
 
 void Channel::frameAssemble(const eq::uint128_t& frameID,
@@ -208,6 +240,7 @@ void Channel::frameAssemble(const eq::uint128_t& frameID,
     }
     // else
 
+    uint32_t samples = 1;
     accum.transfer = true;
     for (eq::Frame* frame : frames)
     {
@@ -217,11 +250,17 @@ void Channel::frameAssemble(const eq::uint128_t& frameID,
         if (subPixel != eq::SubPixel::ALL)
             accum.transfer = false;
 
+        samples = LB_MAX(samples, _getFrameSamples(subPixel.size));
         accum.stepsDone =
             LB_MAX(accum.stepsDone,
-                   subPixel.size * frame->getFrameData()->getContext().period);
+                   subPixel.size * frame->getFrameData()->getContext().period *
+                       samples);
     }
 
+    // each input frame is the average of the samples of its source channel
+    if (accum.buffer)
+        accum.buffer->setWeight(samples);
+
     applyBuffer();
     applyViewport();
     setupAssemblyState();
@@ -335,7 +374,10 @@ void Channel::frameViewFinish(const eq::uint128_t& frameID)
             setupAssemblyState();
 
             if (!_isDone() && accum.transfer)
+            {
+                accum.buffer->setWeight(_getFrameSamples(1));
                 accum.buffer->accum();
+            }
             accum.buffer->display();
 
             resetAssemblyState();
@@ -475,6 +517,63 @@ bool Channel::_initAccum()
     return true;
 }
 
+bool Channel::_initSamples()
+{
+    Accum& accum = _accum[lunchbox::getIndexOfLastBit(getEye())];
+    const eq::PixelViewport& pvp = getPixelViewport();
+    if (accum.samples)
+    {
+        accum.samples->resize(pvp);
+        return true;
+    }
+
+    // glAccum provides only one accumulation buffer, used by the destination
+    if (accum.samplesFailed || !eq::util::Accum::usesFBO(glewGetContext()))
+        return false;
+
+    accum.samples.reset(new eq::util::Accum(glewGetContext()));
+    if (!accum.samples->init(pvp, getWindow()->getColorFormat()))
+    {
+        LBWARN << "Sample accumulation buffer initialization failed, "
+               << "rendering one idle AA sample per frame." << std::endl;
+        accum.samples.reset();
+        accum.samplesFailed = true;
+        getConfig()->sendEvent(IDLE_AA_SINGLE_SAMPLE);
+        return false;
+    }
+    return true;
+}
+
+uint32_t Channel::_getNumSamples() const
+{
+    const FrameData& frameData = _getFrameData();
+    const Accum& accum = _accum[lunchbox::getIndexOfLastBit(getEye())];
+    if (!frameData.isIdle() || accum.step <= 0)
+        return 1;
+
+    const View* view = static_cast<const View*>(getView());
+    if (!view || view->getIdleSteps() != int32_t(jitter::nSamples))
+        return 1;
+
+    return jitter::getNumSamples(accum.step, getSubPixel(),
+                                 frameData.getIdleSamples());
+}
+
+uint32_t Channel::_getFrameSamples(const uint32_t size) const
+{
+    const FrameData& frameData = _getFrameData();
+    const Accum& accum = _accum[lunchbox::getIndexOfLastBit(getEye())];
+    if (!frameData.isIdle() || accum.step <= 0)
+        return 1;
+
+    const View* view = static_cast<const View*>(getView());
+    if (!view || view->getIdleSteps() != int32_t(jitter::nSamples))
+        return 1;
+
+    return jitter::getFrameSamples(accum.step, size,
+                                   frameData.getIdleSamples());
+}
+
 bool Channel::stopRendering() const
 {
     return getPipe()->getCurrentFrame() < _frameRestart;
@@ -489,12 +588,10 @@ eq::Vector2f Channel::getJitter() const
         return eq::Channel::getJitter();
 
     const View* view = static_cast<const View*>(getView());
-    if (!view || view->getIdleSteps() != 256)
+    if (!view || view->getIdleSteps() != int32_t(jitter::nSamples))
         return eq::Vector2f();
 
     const eq::Vector2i jitterStep = _getJitterStep();
-    if (jitterStep == eq::Vector2i())
-        return eq::Vector2f();
 
     const eq::PixelViewport& pvp = getPixelViewport();
     const float pvp_w = float(pvp.w);
@@ -505,9 +602,8 @@ eq::Vector2f Channel::getJitter() const
     const float pixel_w = frustum_w / pvp_w;
     const float pixel_h = frustum_h / pvp_h;
 
-    const float sampleSize = 16.f; // sqrt( 256 )
-    const float subpixel_w = pixel_w / sampleSize;
-    const float subpixel_h = pixel_h / sampleSize;
+    const float subpixel_w = pixel_w / float(jitter::gridSize);
+    const float subpixel_h = pixel_h / float(jitter::gridSize);
 
     // Sample value randomly computed within the subpixel
     lunchbox::RNG rng;
@@ -523,38 +619,11 @@ eq::Vector2f Channel::getJitter() const
     return eq::Vector2f(i, j);
 }
 
-static const uint32_t _primes[100] = {
-    739,  743,  751,  757,  761,  769,  773,  787,  797,  809,  811,  821,
-    823,  827,  829,  839,  853,  857,  859,  863,  877,  881,  883,  887,
-    907,  911,  919,  929,  937,  941,  947,  953,  967,  971,  977,  983,
-    991,  997,  1009, 1013, 1019, 1021, 1031, 1033, 1039, 1049, 1051, 1061,
-    1063, 1069, 1087, 1091, 1093, 1097, 1103, 1109, 1117, 1123, 1129, 1151,
-    1153, 1163, 1171, 1181, 1187, 1193, 1201, 1213, 1217, 1223, 1229, 1231,
-    1237, 1249, 1259, 1277, 1279, 1283, 1289, 1291, 1297, 1301, 1303, 1307,
-    1319, 1321, 1327, 1361, 1367, 1373, 1381, 1399, 1409, 1423, 1427, 1429,
-    1433, 1439, 1447, 1451};
-
 eq::Vector2i Channel::_getJitterStep() const
 {
-    const eq::SubPixel& subPixel = getSubPixel();
-    const uint32_t channelID = subPixel.index;
-    const View* view = static_cast<const View*>(getView());
-    if (!view)
-        return eq::Vector2i();
-
-    const uint32_t totalSteps = uint32_t(view->getIdleSteps());
-    if (totalSteps != 256)
-        return eq::Vector2i();
-
     const Accum& accum = _accum[lunchbox::getIndexOfLastBit(getEye())];
-    const uint32_t subset = totalSteps / getSubPixel().size;
-    const uint32_t index =
-        (accum.step * _primes[channelID % 100]) % subset + (channelID * subset);
-    const uint32_t sampleSize = 16;
-    const int dx = index % sampleSize;
-    const int dy = index / sampleSize;
-
-    return eq::Vector2i(dx, dy);
+    return jitter::getCell(
+        jitter::getSample(accum.step, accum.sample, getSubPixel()));
 }
 
 const Model* Channel::_getModel()
@@ -604,6 +673,11 @@ void Channel::_drawModel(const Model* scene)
     state.setProjectionModelViewMatrix(projection * view * model);
     state.setRange(triply::Range(&getRange().start));
 
+    const eq::PixelViewport& pvp = getPixelViewport();
+    state.setViewportSize(triply::Vector2f(pvp.w, pvp.h));
+    state.setLODTolerance(frameData.isIdle() ? 0.f
+                                             : frameData.getLODTolerance());
+
     const eq::Pipe* pipe = getPipe();
     const GLuint program = state.getProgram(pipe);
     if (program != VertexBufferState::INVALID)
@@ -70,6 +70,7 @@ protected:
     }
 
 private:
+    void _drawScene(const eq::uint128_t& frameID, const Model* model);
     void _drawModel(const Model* model);
     void _drawOverlay();
     void _drawHelp();
@@ -79,6 +80,16 @@ private:
 
     void _initJitter();
     bool _initAccum();
+    bool _initSamples();
+
+    /** @return the number of samples to render in this frame. */
+    uint32_t _getNumSamples() const;
+
+    /**
+     * @return the samples rendered per channel of a subpixel compound of the
+     *         given size in this frame.
+     */
+    uint32_t _getFrameSamples(uint32_t size) const;
 
     /** the subpixel for this step. */
     eq::Vector2i _getJitterStep() const;
@@ -95,14 +106,20 @@ private:
         Accum()
             : step(0)
             , stepsDone(0)
+            , sample(0)
             , transfer(false)
+            , samplesFailed(false)
         {
         }
 
         std::unique_ptr<eq::util::Accum> buffer;
+        /** Accumulates the samples rendered locally in one frame. */
+        std::unique_ptr<eq::util::Accum> samples;
         int32_t step;
         uint32_t stepsDone;
+        uint32_t sample; //!< the local sample currently rendered
         bool transfer;
+        bool samplesFailed;
     } _accum[eq::NUM_EYES];
 
     eq::PixelViewport _currentPVP;
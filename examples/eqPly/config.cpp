@@ -30,6 +30,7 @@
 
 #include "config.h"
 #include "eqPly.h"
+#include "jitter.h"
 #include "modelAssigner.h"
 #include "view.h"
 
@@ -50,6 +51,8 @@ Config::Config(eq::ServerPtr parent)
     , _redraw(true)
     , _useIdleAA(true)
     , _numFramesAA(0)
+    , _idleFrameTime(0)
+    , _maxIdleSamples(jitter::nSamples)
 {
 }
 
@@ -268,14 +271,41 @@ void Config::_updateData()
     if (isIdleAA())
     {
         LBASSERT(_numFramesAA > 0);
+        _updateIdleSamples();
         _frameData.setIdle(true);
     }
     else
+    {
         _frameData.setIdle(false);
+        _frameData.setIdleSamples(1);
+    }
 
     _numFramesAA = 0;
 }
 
+void Config::_updateIdleSamples()
+{
+    const int64_t time = getTime();
+    const int64_t frameTime = time - _idleFrameTime;
+    _idleFrameTime = time;
+
+    if (!_frameData.isIdle() || frameTime <= 0) // first idle frame
+    {
+        _frameData.setIdleSamples(1);
+        return;
+    }
+
+    // The frame time includes the readback, transmission and compositing of
+    // the frame, which makes the estimated time per sample conservative.
+    const uint32_t samples = _frameData.getIdleSamples();
+    const float sampleTime = float(frameTime) / float(samples);
+    const float budget = _initData.getIdleBudget();
+    const uint32_t maxSamples = std::min(samples * 2, _maxIdleSamples);
+
+    _frameData.setIdleSamples(std::max(
+        1u, std::min(maxSamples, uint32_t(budget / sampleTime))));
+}
+
 bool Config::isIdleAA()
 {
     return (!_needNewFrame() && _numFramesAA > 0);
@@ -424,6 +454,14 @@ bool Config::handleEvent(const eq::EventType type, const eq::KeyEvent& event)
         _frameData.adjustQuality(.1f);
         return true;
 
+    case 'b':
+        _frameData.adjustLODTolerance(-1.f);
+        return true;
+
+    case 'B':
+        _frameData.adjustLODTolerance(1.f);
+        return true;
+
     case 'c':
     case 'C':
         _switchCanvas();
@@ -739,6 +777,11 @@ bool Config::handleEvent(eq::EventICommand command)
             _numFramesAA = 0;
         return _numFramesAA > 0;
 
+    case IDLE_AA_SINGLE_SAMPLE:
+        // weighted accumulation needs the same samples on all channels
+        _maxIdleSamples = 1;
+        return false;
+
     default:
         break;
     }
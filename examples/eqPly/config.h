@@ -112,6 +112,8 @@ private:
     bool _useIdleAA;
 
     int32_t _numFramesAA;
+    int64_t _idleFrameTime;   //!< start time of the last idle frame
+    uint32_t _maxIdleSamples; //!< limit of idle samples per frame
 
     eq::admin::ServerPtr _admin;
 
@@ -121,6 +123,7 @@ private:
     void _deregisterData();
 
     bool _needNewFrame();
+    void _updateIdleSamples();
 
     void _switchCanvas();
     void _switchView();
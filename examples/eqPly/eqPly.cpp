@@ -59,6 +59,8 @@ static const std::string _help(
         "\t\ti:                         Toggle usage of idle anti-aliasing\n") +
     std::string(
         "\t\tq, Q:                      Adjust non-idle image quality\n") +
+    std::string("\t\tb, B:                      Adjust non-idle level of "
+                "detail tolerance\n") +
     std::string("\t\tn:                         Toggle navigation mode "
                 "(trackball, walk)\n") +
     std::string("\t\tr:                         Switch rendering mode (display "
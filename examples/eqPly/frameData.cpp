@@ -35,6 +35,7 @@ FrameData::FrameData()
     : _renderMode(triply::RENDER_MODE_DISPLAY_LIST)
     , _colorMode(COLOR_MODEL)
     , _quality(1.0f)
+    , _lodTolerance(0.f)
     , _ortho(false)
     , _statistics(false)
     , _help(false)
@@ -42,6 +43,7 @@ FrameData::FrameData()
     , _pilotMode(false)
     , _idle(false)
     , _compression(true)
+    , _idleSamples(1)
 {
     reset();
 }
@@ -51,9 +53,9 @@ void FrameData::serialize(co::DataOStream& os, const uint64_t dirtyBits)
     if (dirtyBits & DIRTY_CAMERA)
         os << _position << _rotation << _modelRotation;
     if (dirtyBits & DIRTY_FLAGS)
-        os << _modelID << _renderMode << _colorMode << _quality << _ortho
-           << _statistics << _help << _wireframe << _pilotMode << _idle
-           << _compression;
+        os << _modelID << _renderMode << _colorMode << _quality
+           << _lodTolerance << _ortho << _statistics << _help << _wireframe
+           << _pilotMode << _idle << _compression << _idleSamples;
     if (dirtyBits & DIRTY_VIEW)
         os << _currentViewID;
     if (dirtyBits & DIRTY_MESSAGE)
@@ -65,9 +67,9 @@ void FrameData::deserialize(co::DataIStream& is, const uint64_t dirtyBits)
     if (dirtyBits & DIRTY_CAMERA)
         is >> _position >> _rotation >> _modelRotation;
     if (dirtyBits & DIRTY_FLAGS)
-        is >> _modelID >> _renderMode >> _colorMode >> _quality >> _ortho >>
-            _statistics >> _help >> _wireframe >> _pilotMode >> _idle >>
-            _compression;
+        is >> _modelID >> _renderMode >> _colorMode >> _quality >>
+            _lodTolerance >> _ortho >> _statistics >> _help >> _wireframe >>
+            _pilotMode >> _idle >> _compression >> _idleSamples;
     if (dirtyBits & DIRTY_VIEW)
         is >> _currentViewID;
     if (dirtyBits & DIRTY_MESSAGE)
@@ -104,6 +106,15 @@ void FrameData::setIdle(const bool idle)
     setDirty(DIRTY_FLAGS);
 }
 
+void FrameData::setIdleSamples(const uint32_t samples)
+{
+    if (_idleSamples == samples)
+        return;
+
+    _idleSamples = samples;
+    setDirty(DIRTY_FLAGS);
+}
+
 void FrameData::toggleOrtho()
 {
     _ortho = !_ortho;
@@ -143,6 +154,16 @@ void FrameData::adjustQuality(const float delta)
     LBINFO << "Set non-idle image quality to " << _quality << std::endl;
 }
 
+void FrameData::adjustLODTolerance(const float delta)
+{
+    _lodTolerance += delta;
+    _lodTolerance = LB_MAX(_lodTolerance, 0.f);
+    _lodTolerance = LB_MIN(_lodTolerance, 16.f);
+    setDirty(DIRTY_FLAGS);
+    LBINFO << "Set non-idle level of detail tolerance to " << _lodTolerance
+           << " pixels" << std::endl;
+}
+
 void FrameData::togglePilotMode()
 {
     _pilotMode = !_pilotMode;
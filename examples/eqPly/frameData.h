@@ -32,15 +32,18 @@
 
 #include "eqPly.h"
 
+#include <memory>
+
 namespace eqPly
 {
 /**
  * Frame-specific data.
  *
  * The frame-specific data is used as a per-config distributed object and
- * contains mutable, rendering-relevant data. Each rendering thread (pipe) keeps
- * its own instance synchronized with the frame currently being rendered. The
- * data is managed by the Config, which modifies it directly.
+ * contains mutable, rendering-relevant data. Each node keeps one instance, and
+ * each rendering thread (pipe) holds a read-only snapshot of the version
+ * corresponding to the frame currently being rendered. The data is managed by
+ * the Config, which modifies it directly.
  */
 class FrameData : public co::Serializable
 {
@@ -57,6 +60,7 @@ public:
     void setColorMode(const ColorMode color);
     void setRenderMode(const triply::RenderMode mode);
     void setIdle(const bool idleMode);
+    void setIdleSamples(const uint32_t samples);
 
     void toggleOrtho();
     void toggleStatistics();
@@ -64,6 +68,7 @@ public:
     void toggleWireframe();
     void toggleColorMode();
     void adjustQuality(const float delta);
+    void adjustLODTolerance(const float delta);
     void togglePilotMode();
     triply::RenderMode toggleRenderMode();
     void toggleCompression();
@@ -71,12 +76,15 @@ public:
     eq::uint128_t getModelID() const { return _modelID; }
     ColorMode getColorMode() const { return _colorMode; }
     float getQuality() const { return _quality; }
+    float getLODTolerance() const { return _lodTolerance; }
     bool useOrtho() const { return _ortho; }
     bool useStatistics() const { return _statistics; }
     bool showHelp() const { return _help; }
     bool useWireframe() const { return _wireframe; }
     bool usePilotMode() const { return _pilotMode; }
     bool isIdle() const { return _idle; }
+    /** @return the samples each channel accumulates per idle frame. */
+    uint32_t getIdleSamples() const { return _idleSamples; }
     triply::RenderMode getRenderMode() const { return _renderMode; }
     bool useCompression() const { return _compression; }
     //*}
@@ -132,6 +140,7 @@ private:
     triply::RenderMode _renderMode;
     ColorMode _colorMode;
     float _quality;
+    float _lodTolerance;
     bool _ortho;
     bool _statistics;
     bool _help;
@@ -139,10 +148,14 @@ private:
     bool _pilotMode;
     bool _idle;
     bool _compression;
+    uint32_t _idleSamples;
 
     eq::uint128_t _currentViewID;
     std::string _message;
 };
+
+/** A read-only snapshot of one version of the frame data. */
+typedef std::shared_ptr<const FrameData> ConstFrameDataPtr;
 }
 
 #endif // EQ_PLY_FRAMEDATA_H
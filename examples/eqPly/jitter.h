@@ -0,0 +1,121 @@
+
+/* Copyright (c) 2026, The Equalizer authors, see AUTHORS
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Eyescale Software GmbH nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EQ_PLY_JITTER_H
+#define EQ_PLY_JITTER_H
+
+#include <eq/fabric/subPixel.h>
+#include <eq/types.h>
+
+#include <algorithm>
+
+namespace eqPly
+{
+/**
+ * The subpixel sample pattern of the idle anti-aliasing.
+ *
+ * A pixel is divided into a grid of 16x16 cells, one for each of the 256 idle
+ * steps. The samples of all channels of a subpixel compound are numbered
+ * globally: each frame, channel i of n renders the samples i, i + n, ...,
+ * following the samples of the previous frames. A channel rendering several
+ * samples per frame accumulates them locally before they are transmitted, and
+ * the destination accumulates the transmitted average weighted by its samples.
+ */
+namespace jitter
+{
+static const uint32_t gridSize = 16;                  //!< cells per pixel side
+static const uint32_t nSamples = gridSize * gridSize; //!< samples per pixel
+
+/**
+ * @return the grid cell of the nth sample. Each prefix of 4^k samples places
+ *         exactly one sample in each cell of a 2^k x 2^k grid over the pixel.
+ */
+inline eq::Vector2i getCell(const uint32_t n)
+{
+    // reverse the bits of n and de-interleave them into y and x
+    uint32_t reversed = 0;
+    for (uint32_t i = 0; i < 8; ++i)
+        reversed |= ((n >> i) & 1u) << (7 - i);
+
+    eq::Vector2i cell;
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        cell.x() |= ((reversed >> (2 * i)) & 1u) << i;
+        cell.y() |= ((reversed >> (2 * i + 1)) & 1u) << i;
+    }
+    return cell;
+}
+
+/**
+ * @param step the remaining idle steps before the current frame.
+ * @param sample the local sample of the channel in the current frame.
+ * @param subPixel the subpixel decomposition of the channel.
+ * @return the global number of the given sample.
+ */
+inline uint32_t getSample(const int32_t step, const uint32_t sample,
+                          const eq::SubPixel& subPixel)
+{
+    return nSamples - uint32_t(step) + sample * subPixel.size + subPixel.index;
+}
+
+/**
+ * All channels of a subpixel compound render the same number of samples in a
+ * frame, so that the destination can weight each transmitted average by it.
+ * Only the last frame, with fewer steps left than channels, renders one sample
+ * on the first channels.
+ *
+ * @param step the remaining idle steps before the current frame.
+ * @param size the number of channels of the subpixel compound.
+ * @param samplesPerFrame the requested samples per channel and frame.
+ * @return the number of samples rendered by each channel in the current frame.
+ */
+inline uint32_t getFrameSamples(const int32_t step, const uint32_t size,
+                                const uint32_t samplesPerFrame)
+{
+    if (step < int32_t(size))
+        return 1;
+    return std::max(1u, std::min(samplesPerFrame, uint32_t(step) / size));
+}
+
+/**
+ * @param step the remaining idle steps before the current frame.
+ * @param subPixel the subpixel decomposition of the channel.
+ * @param samplesPerFrame the requested samples per channel and frame.
+ * @return the number of samples rendered by the channel in the current frame.
+ */
+inline uint32_t getNumSamples(const int32_t step, const eq::SubPixel& subPixel,
+                              const uint32_t samplesPerFrame)
+{
+    if (step <= int32_t(subPixel.index))
+        return 0;
+    return getFrameSamples(step, subPixel.size, samplesPerFrame);
+}
+}
+}
+
+#endif // EQ_PLY_JITTER_H
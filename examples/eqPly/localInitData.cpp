@@ -46,6 +46,7 @@ namespace eqPly
 LocalInitData::LocalInitData()
     : _pathFilename("")
     , _maxFrames(0xffffffffu)
+    , _idleBudget(50.f)
     , _color(true)
     , _isResident(false)
     , _ignoreNoConfig(false)
@@ -56,6 +57,7 @@ LocalInitData::LocalInitData()
 LocalInitData& LocalInitData::operator=(const LocalInitData& from)
 {
     _maxFrames = from._maxFrames;
+    _idleBudget = from._idleBudget;
     _color = from._color;
     _isResident = from._isResident;
     _filenames = from._filenames;
@@ -136,7 +138,10 @@ void LocalInitData::parseArguments(const int argc, char** argv)
         "Disable overlay logo")(
         "disableROI,d",
         po::bool_switch(&userDefinedDisableROI)->default_value(false),
-        "Disable region of interest (ROI)");
+        "Disable region of interest (ROI)")(
+        "idleBudget", po::value<float>(&_idleBudget)->default_value(50.f),
+        "Target frame time in ms for idle anti-aliasing, rendering more "
+        "samples per frame on faster configurations");
     po::options_description all;
     all.add(options);
     all.add_options()("ignoreNoConfig",
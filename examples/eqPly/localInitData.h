@@ -51,6 +51,8 @@ public:
     bool useColor() const { return _color; }
     bool isResident() const { return _isResident; }
     bool ignoreNoConfig() const { return _ignoreNoConfig; }
+    /** @return the target time of an idle anti-aliasing frame in ms. */
+    float getIdleBudget() const { return _idleBudget; }
     const std::vector<std::string>& getFilenames() const { return _filenames; }
     LocalInitData& operator=(const LocalInitData& from);
 
@@ -58,6 +60,7 @@ private:
     eq::Strings _filenames;
     std::string _pathFilename;
     uint32_t _maxFrames;
+    float _idleBudget;
     bool _color;
     bool _isResident;
     bool _ignoreNoConfig;
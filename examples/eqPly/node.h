@@ -30,6 +30,7 @@
 #define EQ_PLY_NODE_H
 
 #include "eqPly.h"
+#include "frameData.h"
 #include "initData.h"
 
 #include <eq/eq.h>
@@ -40,7 +41,9 @@ namespace eqPly
  * Representation of a node in the cluster
  *
  * Manages node-specific data, namely requesting the mapping of the
- * initialization data by the local Config instance.
+ * initialization data by the local Config instance. The frame data is mapped
+ * once per node and synchronized by the first pipe rendering a new frame, all
+ * pipes of the node share the resulting read-only snapshot.
  */
 class Node : public eq::Node
 {
@@ -50,11 +53,25 @@ public:
     {
     }
 
+    /** @return the frame data of the given version, shared by all pipes. */
+    ConstFrameDataPtr syncFrameData(const eq::uint128_t& version)
+    {
+        return _frameData.sync(version);
+    }
+
+    /** @return the newest synchronized frame data. */
+    ConstFrameDataPtr getNewestFrameData() const
+    {
+        return _frameData.getNewest();
+    }
+
 protected:
     virtual ~Node() {}
     virtual bool configInit(const eq::uint128_t& initID);
+    virtual bool configExit();
 
 private:
+    eq::util::SharedFrameData<FrameData> _frameData;
 };
 }
 
@@ -32,6 +32,7 @@
 #include "pipe.h"
 
 #include "config.h"
+#include "node.h"
 #include <eq/eq.h>
 
 namespace eqPly
@@ -50,24 +51,21 @@ bool Pipe::configInit(const eq::uint128_t& initID)
     if (!eq::Pipe::configInit(initID))
         return false;
 
-    Config* config = static_cast<Config*>(getConfig());
-    const InitData& initData = config->getInitData();
-    const eq::uint128_t& frameDataID = initData.getFrameDataID();
-
-    return config->mapObject(&_frameData, frameDataID);
+    const Node* node = static_cast<const Node*>(getNode());
+    _frameData = node->getNewestFrameData();
+    return true;
 }
 
 bool Pipe::configExit()
 {
-    eq::Config* config = getConfig();
-    config->unmapObject(&_frameData);
-
+    _frameData.reset();
     return eq::Pipe::configExit();
 }
 
 void Pipe::frameStart(const eq::uint128_t& frameID, const uint32_t frameNumber)
 {
     eq::Pipe::frameStart(frameID, frameNumber);
-    _frameData.sync(frameID);
+    Node* node = static_cast<Node*>(getNode());
+    _frameData = node->syncFrameData(frameID);
 }
 }
@@ -41,8 +41,8 @@ namespace eqPly
  * The pipe object is responsible for maintaining GPU-specific and
  * frame-specific data. The identifier passed by the configuration contains
  * the version of the frame data corresponding to the rendered frame. The
- * pipe's start frame callback synchronizes the thread-local instance of the
- * frame data to this version.
+ * pipe's start frame callback obtains the snapshot of this version from the
+ * node, which synchronizes the frame data once for all its pipes.
  */
 class Pipe : public eq::Pipe
 {
@@ -52,7 +52,7 @@ public:
     {
     }
 
-    const FrameData& getFrameData() const { return _frameData; }
+    const FrameData& getFrameData() const { return *_frameData; }
 protected:
     virtual ~Pipe() {}
     virtual eq::WindowSystem selectWindowSystem() const;
@@ -62,7 +62,7 @@ protected:
                             const uint32_t frameNumber);
 
 private:
-    FrameData _frameData;
+    ConstFrameDataPtr _frameData;
 };
 }
 
@@ -69,7 +69,8 @@ enum LogTopics
 
 enum EventType
 {
-    IDLE_AA_LEFT = eq::EVENT_USER
+    IDLE_AA_LEFT = eq::EVENT_USER,
+    IDLE_AA_SINGLE_SAMPLE //!< a channel renders one idle AA sample per frame
 };
 }
 
@@ -92,6 +92,9 @@ bool Window::configInitGL(const eq::uint128_t& initID)
     if (initData.useGLSL())
         _loadShaders();
 
+    // glAccum provides no accumulation buffer to average several samples
+    if (!eq::util::Accum::usesFBO(glewGetContext()))
+        getConfig()->sendEvent(IDLE_AA_SINGLE_SAMPLE);
     return true;
 }
 
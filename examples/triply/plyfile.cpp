@@ -2044,8 +2044,8 @@ Exit:
 char **get_words(FILE *fp, int *nwords, char **orig_line)
 {
 #define BIG_STRING 4096
-    static char str[BIG_STRING];
-    static char str_copy[BIG_STRING];
+    static thread_local char str[BIG_STRING]; // models are read concurrently
+    static thread_local char str_copy[BIG_STRING];
     char **words;
     int max_words = 10;
     int num_words = 0;
@@ -76,6 +76,7 @@ class VertexBufferData;
 class VertexBufferNode;
 class VertexBufferRoot;
 class VertexBufferState;
+class VertexClustering;
 class VertexData;
 
 // basic type definitions
@@ -83,6 +84,7 @@ typedef vmml::Vector3f Vertex;
 typedef vmml::vector<3, uint8_t> Color;
 typedef vmml::Vector3f Normal;
 using vmml::Matrix4f;
+using vmml::Vector2f;
 using vmml::Vector4f;
 typedef size_t Index;
 typedef unsigned short ShortIndex;
@@ -133,7 +135,7 @@ typedef ArrayWrapper<float, 2> Range;
 const Index LEAF_SIZE(21845);
 
 // binary mesh file version, increment if changing the file format
-const unsigned short FILE_VERSION(0x011a);
+const unsigned short FILE_VERSION(0x011c);
 
 // enumeration for the sort axis
 enum Axis
@@ -52,6 +52,11 @@ public:
     virtual const VertexBufferBase* getRight() const { return nullptr; }
     virtual VertexBufferBase* getLeft() { return nullptr; }
     virtual VertexBufferBase* getRight() { return nullptr; }
+
+    /*  @return the simplified representation of the subtree, if any.  */
+    virtual const VertexBufferBase* getLOD() const { return nullptr; }
+    /*  @return the maximum deviation of getLOD() from the full model.  */
+    virtual float getLODError() const { return 0.f; }
     TRIPLY_API virtual void updateBounds() = 0;
 
 protected:
@@ -81,6 +86,7 @@ protected:
                            boost::progress_display&) = 0;
 
     virtual void updateRange() = 0;
+    virtual void updateLOD(VertexBufferData&) {}
 
     friend class VertexBufferDist;
     virtual Type getType() const = 0;
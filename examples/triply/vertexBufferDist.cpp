@@ -118,6 +118,18 @@ void VertexBufferDist::getInstanceData(co::DataOStream& os)
         os << uint64_t(leaf._vertexStart) << uint64_t(leaf._indexStart)
            << uint64_t(leaf._indexLength) << leaf._vertexLength;
     }
+    else
+    {
+        const VertexBufferNode& node =
+            dynamic_cast<const VertexBufferNode&>(_node);
+        const VertexBufferLeaf* lod = node._lod.get();
+
+        os << bool(lod);
+        if (lod)
+            os << node._lodError << uint64_t(lod->_vertexStart)
+               << uint64_t(lod->_indexStart) << uint64_t(lod->_indexLength)
+               << lod->_vertexLength;
+    }
 }
 
 void VertexBufferDist::applyInstanceData(co::DataIStream& is)
@@ -157,6 +169,21 @@ void VertexBufferDist::applyInstanceData(co::DataIStream& is)
     }
 
     VertexBufferNode& node = dynamic_cast<VertexBufferNode&>(_node);
+    if (is.read<bool>())
+    {
+        node._lod.reset(new VertexBufferLeaf(_root._data));
+        VertexBufferLeaf& lod = *node._lod;
+        uint64_t i1, i2, i3;
+        is >> node._lodError >> i1 >> i2 >> i3 >> lod._vertexLength;
+        lod._vertexStart = size_t(i1);
+        lod._indexStart = size_t(i2);
+        lod._indexLength = size_t(i3);
+        lod._boundingBox = node._boundingBox;
+        lod._range = node._range;
+    }
+    else
+        node._lod.reset();
+
     node._left = _createNode(leftType);
     if (node._left)
         _left.reset(new VertexBufferDist(_root, *node._left, getMasterNode(),
@@ -66,6 +66,7 @@ private:
     void renderBufferObject(VertexBufferState& state) const;
 
     friend class VertexBufferDist;
+    friend class VertexBufferNode;
     VertexBufferData& _globalData;
     Index _vertexStart;
     Index _indexStart;
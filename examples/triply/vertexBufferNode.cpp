@@ -28,8 +28,10 @@
  */
 
 #include "vertexBufferNode.h"
+#include "vertexBufferData.h"
 #include "vertexBufferLeaf.h"
 #include "vertexBufferState.h"
+#include "vertexClustering.h"
 #include "vertexData.h"
 #include <set>
 
@@ -40,6 +42,18 @@ inline static bool _subdivide(const Index length, const size_t depth)
     return (length > LEAF_SIZE) || (depth < 3 && length > 1);
 }
 
+/*  Add the finest representation of a child to the simplification input.  */
+void VertexBufferNode::_addMesh(VertexClustering& clustering,
+                                const VertexBufferData& data,
+                                const VertexBufferBase& child)
+{
+    const VertexBufferBase* lod = child.getLOD();
+    const VertexBufferLeaf& mesh =
+        static_cast<const VertexBufferLeaf&>(lod ? *lod : child);
+    clustering.add(data, mesh._vertexStart, mesh._vertexLength,
+                   mesh._indexStart, mesh._indexLength);
+}
+
 /*  Continue kd-tree setup, create intermediary or leaf nodes as required.  */
 void VertexBufferNode::setupTree(VertexData& data, const Index start,
                                  const Index length, const Axis axis,
@@ -102,6 +116,46 @@ void VertexBufferNode::updateRange()
     _range[1] = std::max(_left->getRange()[1], _right->getRange()[1]);
 }
 
+/*  Simplify the children's representations into the node's representation.
+    Each level keeps a quarter of the triangles of its children, which halves
+    the resolution of the surface for twice the area.  */
+void VertexBufferNode::updateLOD(VertexBufferData& globalData)
+{
+    _left->updateLOD(globalData);
+    _right->updateLOD(globalData);
+
+    VertexClustering clustering;
+    _addMesh(clustering, globalData, *_left);
+    _addMesh(clustering, globalData, *_right);
+
+    VertexBufferData simplified;
+    const float error = clustering.simplify(
+        _boundingBox, clustering.getNumTriangles() / 4, simplified);
+    _lodError =
+        error + std::max(_left->getLODError(), _right->getLODError());
+
+    _lod.reset(new VertexBufferLeaf(globalData));
+    _lod->_boundingBox = _boundingBox;
+    _lod->_range = _range;
+    _lod->_vertexStart = globalData.vertices.size();
+    _lod->_vertexLength = ShortIndex(simplified.vertices.size());
+    _lod->_indexStart = globalData.indices.size();
+    _lod->_indexLength = simplified.indices.size();
+
+    globalData.vertices.insert(globalData.vertices.end(),
+                               simplified.vertices.begin(),
+                               simplified.vertices.end());
+    globalData.colors.insert(globalData.colors.end(),
+                             simplified.colors.begin(),
+                             simplified.colors.end());
+    globalData.normals.insert(globalData.normals.end(),
+                              simplified.normals.begin(),
+                              simplified.normals.end());
+    globalData.indices.insert(globalData.indices.end(),
+                              simplified.indices.begin(),
+                              simplified.indices.end());
+}
+
 /*  Draw the node by rendering the children.  */
 void VertexBufferNode::draw(VertexBufferState& state) const
 {
@@ -123,6 +177,11 @@ void VertexBufferNode::fromMemory(char** addr, VertexBufferData& globalData)
                             std::to_string(unsigned(nodeType)));
     VertexBufferBase::fromMemory(addr, globalData);
 
+    // read simplified representation
+    memRead(reinterpret_cast<char*>(&_lodError), addr, sizeof(_lodError));
+    _lod.reset(new VertexBufferLeaf(globalData));
+    _lod->fromMemory(addr, globalData);
+
     // read left child (peek ahead)
     memRead(reinterpret_cast<char*>(&nodeType), addr, sizeof(nodeType));
     if (nodeType != Type::node && nodeType != Type::leaf)
@@ -156,6 +215,8 @@ void VertexBufferNode::toStream(std::ostream& os)
     const Type nodeType = Type::node;
     os.write(reinterpret_cast<const char*>(&nodeType), sizeof(nodeType));
     VertexBufferBase::toStream(os);
+    os.write(reinterpret_cast<const char*>(&_lodError), sizeof(_lodError));
+    _lod->toStream(os);
     _left->toStream(os);
     _right->toStream(os);
 }
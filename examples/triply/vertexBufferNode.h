@@ -31,15 +31,22 @@
 #define PLYLIB_VERTEXBUFFERNODE_H
 
 #include "vertexBufferBase.h"
+#include "vertexBufferLeaf.h"
 #include <triply/api.h>
 
 namespace triply
 {
-/* The class for regular (non-leaf) kd-tree nodes.  */
+/* The class for regular (non-leaf) kd-tree nodes.
+
+   Each node holds a simplified representation of its subtree, created by
+   clustering the vertices of the children's representations.  */
 class VertexBufferNode : public VertexBufferBase
 {
 public:
-    VertexBufferNode() {}
+    VertexBufferNode()
+        : _lodError(0.f)
+    {
+    }
     virtual ~VertexBufferNode() {}
     TRIPLY_API void draw(VertexBufferState& state) const override;
     Index getNumberOfVertices() const override
@@ -51,6 +58,8 @@ public:
     const VertexBufferBase* getRight() const override { return _right.get(); }
     VertexBufferBase* getLeft() override { return _left.get(); }
     VertexBufferBase* getRight() override { return _right.get(); }
+    const VertexBufferBase* getLOD() const override { return _lod.get(); }
+    float getLODError() const override { return _lodError; }
 protected:
     TRIPLY_API void toStream(std::ostream& os) override;
     TRIPLY_API void fromMemory(char** addr, VertexBufferData& globalData) final;
@@ -61,11 +70,18 @@ protected:
                               boost::progress_display&) override;
     TRIPLY_API void updateBounds() override;
     TRIPLY_API void updateRange() override;
+    TRIPLY_API void updateLOD(VertexBufferData& globalData) override;
     Type getType() const override { return Type::node; }
 private:
     friend class VertexBufferDist;
     std::unique_ptr<VertexBufferBase> _left;
     std::unique_ptr<VertexBufferBase> _right;
+    std::unique_ptr<VertexBufferLeaf> _lod;
+    float _lodError;
+
+    static void _addMesh(VertexClustering& clustering,
+                         const VertexBufferData& data,
+                         const VertexBufferBase& child);
 };
 }
 #endif // PLYLIB_VERTEXBUFFERNODE_H
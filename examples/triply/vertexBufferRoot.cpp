@@ -48,12 +48,11 @@ using vmml::FrustumCullerf;
 size_t getArchitectureBits();
 /*  Determine whether the current architecture is little endian or not.  */
 bool isArchitectureLittleEndian();
-/*  Construct architecture dependent file name.  */
-std::string getArchitectureFilename(const std::string& filename);
 
 VertexBufferRoot::VertexBufferRoot(const std::string& filename)
     : VertexBufferNode()
     , _invertFaces(false)
+    , _showProgress(true)
 {
     if (!readFromFile(filename))
         throw std::runtime_error("Can't read " + filename);
@@ -72,20 +71,42 @@ void VertexBufferRoot::setupTree(VertexData& data,
                                 progress);
     VertexBufferNode::updateBounds();
     VertexBufferNode::updateRange();
+    VertexBufferNode::updateLOD(_data);
 }
 
-// #define LOGCULL
-void VertexBufferRoot::cullDraw(VertexBufferState& state) const
+namespace
 {
-    _beginRendering(state);
+/*  @return true if a node may be rendered using its simplified
+    representation: all its leaves are drawn by this range and its projected
+    error is within the tolerance of the state. Uses the half-open range test
+    of cull(), except that the last range also owns the end of the model.  */
+bool _useLOD(const VertexBufferBase& node, const VertexBufferState& state)
+{
+    const float tolerance = state.getLODTolerance();
+    const Range& range = state.getRange();
+    if (tolerance <= 0.f || !node.getLOD() || node.getRange()[0] < range[0] ||
+        (node.getRange()[1] >= range[1] && range[1] < 1.f))
+    {
+        return false;
+    }
+    return state.getScreenError(node.getBoundingBox(), node.getLODError()) <=
+           tolerance;
+}
 
-#ifdef LOGCULL
-    size_t verticesRendered = 0;
-    size_t verticesOverlap = 0;
-#endif
+void _addLOD(const VertexBufferBase& node, VertexBufferRoot::Nodes& nodes)
+{
+    // a simplified node without triangles is too small to be visible
+    const VertexBufferBase* lod = node.getLOD();
+    if (lod->getNumberOfVertices() > 0)
+        nodes.push_back(lod);
+}
+}
 
+void VertexBufferRoot::cull(const VertexBufferState& state, Nodes& nodes) const
+{
     const Range& range = state.getRange();
     const FrustumCullerf culler(state.getProjectionModelViewMatrix());
+    const bool useLOD = state.getLODTolerance() > 0.f;
 
     // start with root node
     std::vector<const triply::VertexBufferBase*> candidates;
@@ -93,9 +114,6 @@ void VertexBufferRoot::cullDraw(VertexBufferState& state) const
 
     while (!candidates.empty())
     {
-        if (state.stopRendering())
-            return;
-
         const triply::VertexBufferBase* treeNode = candidates.back();
         candidates.pop_back();
 
@@ -114,17 +132,13 @@ void VertexBufferRoot::cullDraw(VertexBufferState& state) const
         {
         case vmml::VISIBILITY_FULL:
             // if fully visible and fully in range, render it
-            if (treeNode->getRange()[0] >= range[0] &&
+            if (!useLOD && treeNode->getRange()[0] >= range[0] &&
                 treeNode->getRange()[1] < range[1])
             {
-                treeNode->draw(state);
-                state.notifyVisible(treeNode->getBoundingBox());
-#ifdef LOGCULL
-                verticesRendered += treeNode->getNumberOfVertices();
-#endif
+                nodes.push_back(treeNode);
                 break;
             }
-        // partial range, fall through to partial visibility
+        // partial range or LOD selection, fall through to partial visibility
 
         case vmml::VISIBILITY_PARTIAL:
         {
@@ -134,17 +148,11 @@ void VertexBufferRoot::cullDraw(VertexBufferState& state) const
             if (!left && !right)
             {
                 if (treeNode->getRange()[0] >= range[0])
-                {
-                    treeNode->draw(state);
-                    state.notifyVisible(treeNode->getBoundingBox());
-#ifdef LOGCULL
-                    verticesRendered += treeNode->getNumberOfVertices();
-                    if (visibility == vmml::VISIBILITY_PARTIAL)
-                        verticesOverlap += treeNode->getNumberOfVertices();
-#endif
-                }
+                    nodes.push_back(treeNode);
                 // else drop, to be drawn by 'previous' channel
             }
+            else if (_useLOD(*treeNode, state))
+                _addLOD(*treeNode, nodes);
             else
             {
                 if (left)
@@ -159,15 +167,39 @@ void VertexBufferRoot::cullDraw(VertexBufferState& state) const
             break;
         }
     }
+}
+
+// #define LOGCULL
+void VertexBufferRoot::cullDraw(VertexBufferState& state) const
+{
+    Nodes nodes;
+    cull(state, nodes);
+
+    _beginRendering(state);
+
+#ifdef LOGCULL
+    size_t verticesRendered = 0;
+#endif
+
+    for (const VertexBufferBase* node : nodes)
+    {
+        if (state.stopRendering())
+            break;
+
+        node->draw(state);
+        state.notifyVisible(node->getBoundingBox());
+#ifdef LOGCULL
+        verticesRendered += node->getNumberOfVertices();
+#endif
+    }
 
     _endRendering(state);
 
 #ifdef LOGCULL
-    const size_t verticesTotal = model->getNumberOfVertices();
+    const size_t verticesTotal = getNumberOfVertices();
     PLYLIBINFO << getName() << " rendered "
-               << verticesRendered * 100 / verticesTotal
-               << "% of model, overlap <= "
-               << verticesOverlap * 100 / verticesTotal << "%" << std::endl;
+               << verticesRendered * 100 / verticesTotal << "% of model"
+               << std::endl;
 #endif
 }
 
@@ -245,7 +277,8 @@ std::string getArchitectureFilename(const std::string& filename)
 bool VertexBufferRoot::_constructFromPly(const std::string& filename)
 {
     PLYLIBINFO << "Reading PLY file." << std::endl;
-    boost::progress_display progress(12);
+    std::ostream quiet(nullptr);
+    boost::progress_display progress(12, _showProgress ? std::cout : quiet);
 
     VertexData data;
     if (_invertFaces)
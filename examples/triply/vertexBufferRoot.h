@@ -36,6 +36,9 @@
 
 namespace triply
 {
+/*  @return the name of the binary kd-tree cache of the given PLY file.  */
+TRIPLY_API std::string getArchitectureFilename(const std::string& filename);
+
 /*  The class for kd-tree root nodes.  */
 class VertexBufferRoot : public VertexBufferNode
 {
@@ -43,10 +46,16 @@ public:
     VertexBufferRoot()
         : VertexBufferNode()
         , _invertFaces(false)
+        , _showProgress(true)
     {
     }
     TRIPLY_API VertexBufferRoot(const std::string& filename);
 
+    typedef std::vector<const VertexBufferBase*> Nodes;
+
+    /*  Select the nodes to render for the given state without rendering.
+        Nodes are selected by range, view frustum and screen-space error.  */
+    TRIPLY_API void cull(const VertexBufferState& state, Nodes& nodes) const;
     TRIPLY_API virtual void cullDraw(VertexBufferState& state) const;
     TRIPLY_API virtual void draw(VertexBufferState& state) const;
 
@@ -55,6 +64,8 @@ public:
     TRIPLY_API bool readFromFile(const std::string& filename);
     bool hasColors() const { return !_data.colors.empty(); }
     void useInvertedFaces() { _invertFaces = true; }
+    /*  Do not print the progress of the construction from a PLY file.  */
+    void disableProgress() { _showProgress = false; }
     const std::string& getName() const { return _name; }
 protected:
     TRIPLY_API void toStream(std::ostream& os) final;
@@ -70,6 +81,7 @@ private:
     friend class VertexBufferDist;
     VertexBufferData _data;
     bool _invertFaces;
+    bool _showProgress;
     std::string _name;
 };
 }
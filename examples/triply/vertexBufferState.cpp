@@ -33,6 +33,8 @@ namespace triply
 VertexBufferState::VertexBufferState(const GLEWContext* glewContext)
     : _glewContext(glewContext)
     , _renderMode(RENDER_MODE_DISPLAY_LIST)
+    , _viewportSize(0.f, 0.f)
+    , _lodTolerance(0.f)
     , _useColors(false)
     , _useFrustumCulling(true)
 {
@@ -101,6 +103,36 @@ void VertexBufferState::updateRegion(const BoundingBox& box)
     _region[3] = std::max(_region[3], normalized[3]);
 }
 
+float VertexBufferState::getScreenError(const BoundingBox& box,
+                                        const float error) const
+{
+    // Project the error at the corner closest to the viewer, using the scale
+    // of the projection along the x and y axis. The perspective distortion
+    // towards the border of the viewport is neglected.
+    const auto& min = box.getMin();
+    const auto& max = box.getMax();
+    float w = std::numeric_limits<float>::max();
+    for (size_t i = 0; i < 8; ++i)
+    {
+        const Vertex corner(i & 1 ? max[0] : min[0], i & 2 ? max[1] : min[1],
+                            i & 4 ? max[2] : min[2]);
+        w = std::min(w, _pmvMatrix(3, 0) * corner[0] +
+                            _pmvMatrix(3, 1) * corner[1] +
+                            _pmvMatrix(3, 2) * corner[2] + _pmvMatrix(3, 3));
+    }
+    if (w <= 0.f) // box reaches behind the viewer
+        return std::numeric_limits<float>::max();
+
+    const vmml::Vector3f xAxis(_pmvMatrix(0, 0), _pmvMatrix(0, 1),
+                               _pmvMatrix(0, 2));
+    const vmml::Vector3f yAxis(_pmvMatrix(1, 0), _pmvMatrix(1, 1),
+                               _pmvMatrix(1, 2));
+
+    // normalized device coordinates span two units over the viewport
+    return error / w * .5f * std::max(xAxis.length() * _viewportSize[0],
+                                      yAxis.length() * _viewportSize[1]);
+}
+
 Vector4f VertexBufferState::getRegion() const
 {
     if (_region[0] > _region[2] || _region[1] > _region[3])
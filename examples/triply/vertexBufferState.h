@@ -73,6 +73,30 @@ public:
 
     TRIPLY_API void setRange(const Range& range) { _range = range; }
     TRIPLY_API const Range& getRange() const { return _range; }
+
+    /*  Set the maximum screen-space error in pixels of simplified nodes,
+        0 to always render at full resolution.  */
+    TRIPLY_API void setLODTolerance(const float pixels)
+    {
+        _lodTolerance = pixels;
+    }
+    TRIPLY_API float getLODTolerance() const { return _lodTolerance; }
+
+    /*  Set the size of the rendered viewport in pixels.  */
+    TRIPLY_API void setViewportSize(const Vector2f& size)
+    {
+        _viewportSize = size;
+    }
+    TRIPLY_API const Vector2f& getViewportSize() const
+    {
+        return _viewportSize;
+    }
+
+    /*  @return the projected size in pixels of an object-space error within
+        the given bounding box.  */
+    TRIPLY_API virtual float getScreenError(const BoundingBox& box,
+                                            float error) const;
+
     TRIPLY_API void resetRegion();
     TRIPLY_API virtual void updateRegion(const BoundingBox& box);
     virtual void declareRegion(const Vector4f&) {}
@@ -98,6 +122,8 @@ protected:
     const GLEWContext* const _glewContext;
     RenderMode _renderMode;
     Vector4f _region; //!< normalized x1 y1 x2 y2 region from cullDraw
+    Vector2f _viewportSize; //!< viewport size in pixels
+    float _lodTolerance;    //!< maximum screen-space error in pixels
     bool _useColors;
     bool _useFrustumCulling;
 
@@ -0,0 +1,223 @@
+
+/* Copyright (c) 2026, The Equalizer authors, see AUTHORS
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Eyescale Software GmbH nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "vertexClustering.h"
+#include "vertexBufferData.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <unordered_map>
+
+namespace triply
+{
+namespace
+{
+// maximum number of vertices addressable with a ShortIndex
+const size_t MAX_VERTICES = 65535;
+// grid resolution tried first along the longest axis of the bounding box
+const size_t MAX_RESOLUTION = 1024;
+const Index INVALID_INDEX = std::numeric_limits<Index>::max();
+
+/*  Rotate a triangle to start with its smallest index, keeping its winding. */
+Triangle _normalize(const Triangle& triangle)
+{
+    if (triangle[1] < triangle[0] && triangle[1] < triangle[2])
+        return Triangle(triangle[1], triangle[2], triangle[0]);
+    if (triangle[2] < triangle[0] && triangle[2] < triangle[1])
+        return Triangle(triangle[2], triangle[0], triangle[1]);
+    return triangle;
+}
+
+bool _less(const Triangle& a, const Triangle& b)
+{
+    if (a[0] != b[0])
+        return a[0] < b[0];
+    if (a[1] != b[1])
+        return a[1] < b[1];
+    return a[2] < b[2];
+}
+}
+
+void VertexClustering::add(const VertexBufferData& data,
+                           const Index vertexStart, const Index vertexLength,
+                           const Index indexStart, const Index indexLength)
+{
+    const Index offset = _vertices.size();
+    const auto vertex = data.vertices.begin() + vertexStart;
+    _vertices.insert(_vertices.end(), vertex, vertex + vertexLength);
+    const auto normal = data.normals.begin() + vertexStart;
+    _normals.insert(_normals.end(), normal, normal + vertexLength);
+    if (!data.colors.empty())
+    {
+        const auto color = data.colors.begin() + vertexStart;
+        _colors.insert(_colors.end(), color, color + vertexLength);
+    }
+
+    for (Index i = indexStart; i < indexStart + indexLength; ++i)
+        _indices.push_back(offset + data.indices[i]);
+}
+
+float VertexClustering::simplify(const BoundingBox& box,
+                                 const Index maxTriangles,
+                                 VertexBufferData& output) const
+{
+    output.clear();
+
+    // find the finest grid meeting the triangle budget
+    const Index budget = std::min(maxTriangles, Index(MAX_VERTICES / 3));
+    std::vector<Index> clusters;
+    std::vector<Triangle> triangles;
+    size_t resolution = MAX_RESOLUTION;
+    Index nClusters = 0;
+    while (true)
+    {
+        nClusters = _cluster(box, resolution, clusters);
+        _collect(clusters, triangles);
+        if (resolution == 1 || triangles.size() <= budget)
+            break;
+
+        // the triangle count of a surface grows with the resolution squared
+        const float scale =
+            std::sqrt(float(budget) / float(triangles.size())) * .95f;
+        resolution = std::min(resolution - 1, size_t(resolution * scale));
+        resolution = std::max(resolution, size_t(1));
+    }
+
+    if (triangles.empty() || triangles.size() > budget)
+        return box.getSize().length();
+
+    // represent each cluster by the mean of its vertices
+    const bool hasColors = !_colors.empty();
+    std::vector<Vertex> positions(nClusters, Vertex(0.f, 0.f, 0.f));
+    std::vector<Normal> normals(nClusters, Normal(0.f, 0.f, 0.f));
+    std::vector<vmml::Vector3f> colors(hasColors ? nClusters : 0,
+                                       vmml::Vector3f(0.f, 0.f, 0.f));
+    std::vector<size_t> counts(nClusters, 0);
+
+    for (size_t i = 0; i < _vertices.size(); ++i)
+    {
+        const Index cluster = clusters[i];
+        positions[cluster] += _vertices[i];
+        normals[cluster] += _normals[i];
+        if (hasColors)
+            colors[cluster] += vmml::Vector3f(_colors[i][0], _colors[i][1],
+                                              _colors[i][2]);
+        ++counts[cluster];
+    }
+    for (Index i = 0; i < nClusters; ++i)
+        positions[i] /= float(counts[i]);
+
+    float error = 0.f;
+    for (size_t i = 0; i < _vertices.size(); ++i)
+        error =
+            std::max(error, (_vertices[i] - positions[clusters[i]]).length());
+
+    // emit the clusters referenced by the remaining triangles
+    std::vector<Index> newIndex(nClusters, INVALID_INDEX);
+    for (const Triangle& triangle : triangles)
+    {
+        for (size_t i = 0; i < 3; ++i)
+        {
+            const Index cluster = triangle[i];
+            if (newIndex[cluster] == INVALID_INDEX)
+            {
+                newIndex[cluster] = output.vertices.size();
+                output.vertices.push_back(positions[cluster]);
+
+                Normal normal = normals[cluster];
+                if (normal.length() > 0.f)
+                    normal.normalize();
+                output.normals.push_back(normal);
+
+                if (hasColors)
+                {
+                    const vmml::Vector3f color =
+                        colors[cluster] / float(counts[cluster]);
+                    output.colors.push_back(Color(uint8_t(color[0] + .5f),
+                                                  uint8_t(color[1] + .5f),
+                                                  uint8_t(color[2] + .5f)));
+                }
+            }
+            output.indices.push_back(ShortIndex(newIndex[cluster]));
+        }
+    }
+    PLYLIBASSERT(output.vertices.size() <= MAX_VERTICES);
+    return error;
+}
+
+/*  Assign each vertex to a grid cell, return the number of occupied cells.  */
+Index VertexClustering::_cluster(const BoundingBox& box,
+                                 const size_t resolution,
+                                 std::vector<Index>& clusters) const
+{
+    const Vertex& origin = box.getMin();
+    const float cellSize = box.getSize().find_max() / float(resolution);
+    std::unordered_map<uint64_t, Index> cells;
+
+    clusters.resize(_vertices.size());
+    for (size_t i = 0; i < _vertices.size(); ++i)
+    {
+        uint64_t key = 0;
+        for (size_t j = 0; j < 3; ++j)
+        {
+            const float cell =
+                cellSize > 0.f ? (_vertices[i][j] - origin[j]) / cellSize : 0.f;
+            key = key * resolution +
+                  std::min(uint64_t(resolution - 1),
+                           uint64_t(std::max(cell, 0.f)));
+        }
+        const Index next = cells.size();
+        clusters[i] = cells.emplace(key, next).first->second;
+    }
+    return cells.size();
+}
+
+/*  Collect the triangles which do not collapse, without duplicates.  */
+void VertexClustering::_collect(const std::vector<Index>& clusters,
+                                std::vector<Triangle>& triangles) const
+{
+    triangles.clear();
+    for (size_t i = 0; i < _indices.size(); i += 3)
+    {
+        const Triangle triangle(clusters[_indices[i]],
+                                clusters[_indices[i + 1]],
+                                clusters[_indices[i + 2]]);
+        if (triangle[0] == triangle[1] || triangle[1] == triangle[2] ||
+            triangle[0] == triangle[2])
+        {
+            continue;
+        }
+        triangles.push_back(_normalize(triangle));
+    }
+
+    std::sort(triangles.begin(), triangles.end(), _less);
+    triangles.erase(std::unique(triangles.begin(), triangles.end()),
+                    triangles.end());
+}
+}
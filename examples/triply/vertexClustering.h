@@ -0,0 +1,76 @@
+
+/* Copyright (c) 2026, The Equalizer authors, see AUTHORS
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Eyescale Software GmbH nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PLYLIB_VERTEXCLUSTERING_H
+#define PLYLIB_VERTEXCLUSTERING_H
+
+#include "typedefs.h"
+#include <triply/api.h>
+#include <vector>
+
+namespace triply
+{
+/*  Simplifies indexed triangle meshes by clustering vertices on a grid.  */
+class VertexClustering
+{
+public:
+    /*  Add the triangles of a mesh range of the given kd-tree data.  */
+    TRIPLY_API void add(const VertexBufferData& data, Index vertexStart,
+                        Index vertexLength, Index indexStart,
+                        Index indexLength);
+
+    /*  @return the number of triangles added.  */
+    Index getNumTriangles() const { return _indices.size() / 3; }
+    /*
+     * Simplify the added triangles to at most maxTriangles triangles.
+     *
+     * The vertices are clustered on the finest regular grid over the given
+     * bounding box which meets the triangle budget. Each cluster is replaced
+     * by the mean of its vertices, collapsed and duplicate triangles are
+     * removed. The output indices are relative to the first output vertex.
+     *
+     * @return the maximum distance of an added vertex to its representative,
+     *         or the size of the bounding box if no triangle remains.
+     */
+    TRIPLY_API float simplify(const BoundingBox& box, Index maxTriangles,
+                              VertexBufferData& output) const;
+
+private:
+    std::vector<Vertex> _vertices;
+    std::vector<Normal> _normals;
+    std::vector<Color> _colors;
+    std::vector<Index> _indices;
+
+    Index _cluster(const BoundingBox& box, size_t resolution,
+                   std::vector<Index>& clusters) const;
+    void _collect(const std::vector<Index>& clusters,
+                  std::vector<Triangle>& triangles) const;
+};
+}
+
+#endif // PLYLIB_VERTEXCLUSTERING_H
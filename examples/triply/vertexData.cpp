@@ -216,43 +216,54 @@ bool VertexData::readPlyFile(const std::string& filename)
 /*  Calculate the face or vertex normals of the current vertex data.  */
 void VertexData::calculateNormals()
 {
-#ifndef NDEBUG
-    int wrongNormals = 0;
-#endif
-
-    normals.clear();
-    normals.reserve(vertices.size());
-
-    // initialize all normals to zero
-    for (size_t i = 0; i < vertices.size(); ++i)
-        normals.push_back(Normal(0, 0, 0));
-
-// iterate over all triangles and add their normals to adjacent vertices
-#pragma omp parallel for
-    for (ssize_t i = 0; i < ssize_t(triangles.size()); ++i)
+    // List the adjacent triangles of each vertex in triangle order. Each
+    // vertex normal is summed by one thread in this order, which yields the
+    // same normals for any number of threads.
+    std::vector<Index> offsets(vertices.size() + 1, 0);
+    for (const Triangle& triangle : triangles)
+        for (size_t j = 0; j < 3; ++j)
+            ++offsets[triangle[j] + 1];
+    for (size_t i = 1; i < offsets.size(); ++i)
+        offsets[i] += offsets[i - 1];
+
+    std::vector<Index> adjacent(offsets.back());
     {
-        const Index i0 = triangles[i][0];
-        const Index i1 = triangles[i][1];
-        const Index i2 = triangles[i][2];
-        const Normal normal =
-            vmml::compute_normal(vertices[i0], vertices[i1], vertices[i2]);
-#ifndef NDEBUG
-        // count emtpy normals in debug mode
-        if (normal.length() == 0.0f)
-            ++wrongNormals; // racy with OpenMP, but not critical
-#endif
-
-        normals[i0] += normal;
-        normals[i1] += normal;
-        normals[i2] += normal;
+        std::vector<Index> next(offsets.begin(), offsets.end() - 1);
+        for (size_t i = 0; i < triangles.size(); ++i)
+            for (size_t j = 0; j < 3; ++j)
+                adjacent[next[triangles[i][j]]++] = i;
     }
 
-// normalize all the normals
+    normals.resize(vertices.size());
 #pragma omp parallel for
     for (ssize_t i = 0; i < ssize_t(vertices.size()); ++i)
-        normals[i].normalize();
+    {
+        Normal normal(0, 0, 0);
+        for (Index j = offsets[i]; j < offsets[i + 1]; ++j)
+        {
+            const Triangle& triangle = triangles[adjacent[j]];
+            normal += vmml::compute_normal(vertices[triangle[0]],
+                                           vertices[triangle[1]],
+                                           vertices[triangle[2]]);
+        }
+        normal.normalize();
+        normals[i] = normal;
+    }
 
 #ifndef NDEBUG
+    // count emtpy normals in debug mode
+    int wrongNormals = 0;
+#pragma omp parallel for reduction(+ : wrongNormals)
+    for (ssize_t i = 0; i < ssize_t(triangles.size()); ++i)
+    {
+        const Triangle& triangle = triangles[i];
+        if (vmml::compute_normal(vertices[triangle[0]], vertices[triangle[1]],
+                                 vertices[triangle[2]])
+                .length() == 0.0f)
+        {
+            ++wrongNormals;
+        }
+    }
     if (wrongNormals > 0)
         PLYLIBINFO << wrongNormals << " faces have no valid normal."
                    << std::endl;
@@ -345,7 +356,12 @@ struct _TriangleSort
             axis = (axis + 1) % 3;
         } while (axis != _axis);
 
-        return false;
+        // finally by index, so that the parallel sort is deterministic
+        if (t1[0] != t2[0])
+            return t1[0] < t2[0];
+        if (t1[1] != t2[1])
+            return t1[1] < t2[1];
+        return t1[2] < t2[2];
     }
 
     const VertexData& _data;
@@ -52,6 +52,16 @@ protected:
                             const uint32_t frameNumber);
 
 private:
+    /**
+     * Map the object map of this pipe.
+     *
+     * Unlike eqPly and eVolve, Sequel does not share one instance of the frame
+     * data between the pipes of a node using eq::util::SharedFrameData: the
+     * frame data and all other mapped objects are of application types,
+     * created through the renderer of each pipe, and handed out as mutable
+     * co::Object to the renderer. A node-wide read-only snapshot would need a
+     * copyable object type and a const renderer API.
+     */
     bool _mapData(const uint128_t& initID);
     void _syncData(const uint128_t& version);
     void _unmapData();
@@ -0,0 +1,146 @@
+
+/* Copyright (c) 2026, The Equalizer authors, see AUTHORS
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Stress test for the eq::CommandQueue wakeup coalescing: producer threads
+// push bursts of commands into a queue drained by a consumer blocking in a
+// message pump. Uses a condition variable based pump, no window system.
+
+#include <eq/commandQueue.h>
+#include <eq/messagePump.h>
+#include <lunchbox/test.h>
+
+#include <co/global.h>
+#include <co/iCommand.h>
+#include <lunchbox/clock.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+namespace
+{
+const size_t nProducers = 4;
+const size_t nBursts = 1000;
+const size_t burstSize = 32;
+
+class MessagePump : public eq::MessagePump
+{
+public:
+    MessagePump()
+        : _pending(false)
+    {
+    }
+
+    void postWakeup() final
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _pending = true;
+        _condition.notify_one();
+    }
+
+    void dispatchAll() final
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _pending = false;
+    }
+
+    void dispatchOne(const uint32_t timeout) final
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _condition.wait_for(lock, std::chrono::milliseconds(timeout),
+                            [this] { return _pending; });
+        _pending = false;
+    }
+
+private:
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    bool _pending;
+};
+
+void _testStress()
+{
+    eq::CommandQueue queue(co::Global::getCommandQueueLimit());
+    queue.setMessagePump(new MessagePump);
+
+    const size_t nCommands = nProducers * nBursts * burstSize;
+    size_t nReceived = 0;
+    lunchbox::Clock clock;
+    std::thread consumer([&] {
+        while (nReceived < nCommands)
+        {
+            queue.pop();
+            ++nReceived;
+        }
+    });
+
+    std::vector<std::thread> producers;
+    for (size_t i = 0; i < nProducers; ++i)
+        producers.push_back(std::thread([&] {
+            for (size_t j = 0; j < nBursts; ++j)
+            {
+                for (size_t k = 0; k < burstSize; ++k)
+                    queue.push(co::ICommand());
+                std::this_thread::yield();
+            }
+        }));
+
+    for (std::thread& producer : producers)
+        producer.join();
+    consumer.join();
+    const float time = clock.getTimef();
+
+    TEST(nReceived == nCommands);
+    TEST(queue.isEmpty());
+    TESTINFO(queue.getWakeups() + queue.getCoalescedWakeups() == nCommands,
+             queue.getWakeups() << " + " << queue.getCoalescedWakeups());
+    TESTINFO(queue.getWakeups() < nCommands, queue.getWakeups());
+
+    std::cout << nCommands << " commands in " << time << " ms, "
+              << queue.getWakeups() << " wakeups, previously " << nCommands
+              << std::endl;
+
+    delete queue.getMessagePump();
+    queue.setMessagePump(0);
+}
+
+void _testStatistics()
+{
+    eq::CommandQueue queue(co::Global::getCommandQueueLimit());
+    queue.enableStatistics();
+    TEST(queue.hasStatistics());
+
+    for (size_t i = 0; i < 100; ++i)
+        queue.push(co::ICommand());
+    for (size_t i = 0; i < 100; ++i)
+        queue.pop();
+    TEST(queue.isEmpty());
+
+    std::ostringstream os;
+    queue.dumpStatistics(os);
+    std::cout << os.str();
+    TESTINFO(os.str().find("none      100") != std::string::npos, os.str());
+}
+}
+
+int main(int, char**)
+{
+    _testStress();
+    _testStatistics();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,219 @@
+
+/* Copyright (c) 2026, The Equalizer authors, see AUTHORS
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Streams frames through the sender of the Deflect proxy to an in-process
+// stream. Checks that unchanged frames are finished without sending any tile
+// to a host keeping the tiles of the last frame, and with all tiles to a host
+// replacing the whole frame on each finish. Checks that the JPEG quality
+// adapts only to the wait for the sends.
+
+#include <eq/deflect/streamSender.h>
+#include <lunchbox/test.h>
+
+#include <chrono>
+#include <future>
+#include <set>
+#include <thread>
+
+using eq::deflect::RateControl;
+
+namespace
+{
+const int32_t width = 1000;
+const int32_t height = 600;
+const size_t pixelSize = 4;
+typedef std::vector<uint8_t> Pixels;
+
+/**
+ * Stand-in for ::deflect::Stream, with sends taking a given time. The host
+ * either keeps the tiles of the previous frames, or replaces the whole frame
+ * with the tiles sent since the last finish.
+ */
+class Stream
+{
+public:
+    typedef std::future<bool> Future;
+    typedef std::set<std::pair<unsigned, unsigned>> Tiles; //!< by position
+
+    explicit Stream(const bool replaceFrame_ = false)
+        : nSends(0)
+        , nFinished(0)
+        , sendTime(0)
+        , fail(false)
+        , replaceFrame(replaceFrame_)
+    {
+    }
+
+    Future send(const ::deflect::ImageWrapper& image)
+    {
+        ++nSends;
+        _pending.insert(std::make_pair(image.x, image.y));
+        const int32_t time = sendTime;
+        const bool ok = !fail;
+        return std::async(std::launch::async, [time, ok] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(time));
+            return ok;
+        });
+    }
+
+    Future finishFrame()
+    {
+        ++nFinished;
+        if (replaceFrame)
+            shown.clear();
+        shown.insert(_pending.begin(), _pending.end());
+        _pending.clear();
+
+        std::promise<bool> promise;
+        promise.set_value(true);
+        return promise.get_future();
+    }
+
+    size_t nSends;
+    size_t nFinished;
+    int32_t sendTime; //!< ms per send
+    bool fail;
+    const bool replaceFrame;
+    Tiles shown; //!< The tiles shown by the host after the last finish
+
+private:
+    Tiles _pending; //!< The tiles sent since the last finish
+};
+
+typedef eq::deflect::StreamSender<Stream> Sender;
+
+bool _send(Sender& sender, Stream& stream, const Pixels& frame)
+{
+    return sender.send(stream, ::deflect::View::mono, eq::EYE_CYCLOP_BIT,
+                       frame.data(), eq::PixelViewport(0, 0, width, height),
+                       pixelSize, 0, 0);
+}
+
+void _testUnchangedFrames()
+{
+    Stream stream;
+    Sender sender(0.f, true);
+    Pixels frame(width * height * pixelSize, 0);
+
+    TEST(_send(sender, stream, frame));
+    TEST(sender.finishFrame(stream));
+    const size_t nTiles = stream.nSends;
+    TEST(nTiles > 0);
+    TEST(stream.nFinished == 1);
+
+    TEST(stream.shown.size() == nTiles);
+
+    // an unchanged frame sends nothing, but is still finished
+    for (size_t i = 0; i < 5; ++i)
+    {
+        TEST(_send(sender, stream, frame));
+        TEST(sender.finishFrame(stream));
+        TESTINFO(stream.nSends == nTiles, stream.nSends);
+        TESTINFO(stream.nFinished == i + 2, stream.nFinished);
+        TESTINFO(stream.shown.size() == nTiles, stream.shown.size());
+    }
+
+    // a frame without any image is not finished
+    TEST(sender.finishFrame(stream));
+    TEST(stream.nFinished == 6);
+
+    // a changed pixel sends its tile only
+    frame[0] = 255;
+    TEST(_send(sender, stream, frame));
+    TEST(sender.finishFrame(stream));
+    TESTINFO(stream.nSends == nTiles + 1, stream.nSends);
+    TEST(stream.nFinished == 7);
+
+    // a failed send is reported with the next image
+    stream.fail = true;
+    frame[0] = 0;
+    TEST(_send(sender, stream, frame));
+    TEST(sender.finishFrame(stream));
+    TEST(!_send(sender, stream, frame));
+}
+
+void _testFullFrames()
+{
+    Stream stream(true);
+    Sender sender(0.f, false);
+    Pixels frame(width * height * pixelSize, 0);
+
+    TEST(_send(sender, stream, frame));
+    TEST(sender.finishFrame(stream));
+    const size_t nTiles = stream.nSends;
+    TEST(nTiles > 0);
+    TEST(stream.shown.size() == nTiles);
+
+    // an unchanged frame sends all tiles again, the host shows a full frame
+    for (size_t i = 0; i < 5; ++i)
+    {
+        TEST(_send(sender, stream, frame));
+        TEST(sender.finishFrame(stream));
+        TESTINFO(stream.nSends == nTiles * (i + 2), stream.nSends);
+        TESTINFO(stream.nFinished == i + 2, stream.nFinished);
+        TESTINFO(stream.shown.size() == nTiles, stream.shown.size());
+    }
+
+    // so does a changed frame
+    frame[0] = 255;
+    TEST(_send(sender, stream, frame));
+    TEST(sender.finishFrame(stream));
+    TESTINFO(stream.nSends == nTiles * 7, stream.nSends);
+    TESTINFO(stream.shown.size() == nTiles, stream.shown.size());
+}
+
+void _testRateControl()
+{
+    Stream stream;
+    Sender sender(20.f, false);
+    Pixels frame(width * height * pixelSize, 0);
+
+    // sends completing between frames do not reduce the quality, no matter
+    // how long the frames take
+    stream.sendTime = 5;
+    for (size_t i = 0; i < 5; ++i)
+    {
+        frame[0] = uint8_t(i);
+        TEST(_send(sender, stream, frame));
+        TEST(sender.finishFrame(stream));
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+    TESTINFO(sender.getQuality() == RateControl::maxQuality,
+             sender.getQuality());
+
+    // waiting longer than the target for the sends reduces the quality
+    stream.sendTime = 60;
+    for (size_t i = 0; i < 3; ++i)
+    {
+        frame[0] = uint8_t(i + 10);
+        TEST(_send(sender, stream, frame));
+        TEST(sender.finishFrame(stream));
+    }
+    frame[0] = 0;
+    TEST(_send(sender, stream, frame));
+    TESTINFO(sender.getQuality() < RateControl::maxQuality,
+             sender.getQuality());
+}
+}
+
+int main(int, char**)
+{
+    _testUnchangedFrames();
+    _testFullFrames();
+    _testRateControl();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,211 @@
+
+/* Copyright (c) 2026, The Equalizer authors, see AUTHORS
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Streams recorded frame sequences through the tile cache of the Deflect proxy
+// to an in-process stand-in for the Deflect host, and checks the transmitted
+// tiles, the reconstructed image and the adaptation of the JPEG quality.
+
+#include <eq/deflect/rateControl.h>
+#include <eq/deflect/tileCache.h>
+#include <lunchbox/test.h>
+
+#include <cstring>
+#include <iostream>
+
+using eq::deflect::RateControl;
+using eq::deflect::TileCache;
+
+namespace
+{
+const int32_t width = 1000;
+const int32_t height = 600;
+const size_t pixelSize = 4;
+typedef std::vector<uint8_t> Pixels;
+
+/** Stand-in for the Deflect host, keeping the last received tiles. */
+class Host
+{
+public:
+    Host()
+        : canvas(width * height * pixelSize, 0)
+        , nBytes(0)
+        , nTiles(0)
+    {
+    }
+
+    void receive(const TileCache::Tile& tile)
+    {
+        const size_t rowSize = tile.w * pixelSize;
+        for (int32_t y = 0; y < tile.h; ++y)
+            ::memcpy(&canvas[((tile.y + y) * width + tile.x) * pixelSize],
+                     &tile.pixels[y * rowSize], rowSize);
+        nBytes += tile.pixels.size();
+        ++nTiles;
+    }
+
+    Pixels canvas; //!< rows top-down
+    size_t nBytes;
+    size_t nTiles;
+};
+
+/** Frame of a recorded sequence: a static background with a moving box. */
+void _render(Pixels& frame, const int32_t frameNumber, const bool fullUpdate)
+{
+    for (int32_t y = 0; y < height; ++y)
+    {
+        for (int32_t x = 0; x < width; ++x)
+        {
+            uint8_t* pixel = &frame[(y * width + x) * pixelSize];
+            pixel[0] = uint8_t(x);
+            pixel[1] = uint8_t(y);
+            pixel[2] = fullUpdate ? uint8_t(frameNumber) : 0;
+            pixel[3] = 255;
+        }
+    }
+
+    const int32_t boxX = (frameNumber * 7) % (width - 40);
+    const int32_t boxY = (frameNumber * 3) % (height - 40);
+    for (int32_t y = boxY; y < boxY + 40; ++y)
+        for (int32_t x = boxX; x < boxX + 40; ++x)
+            ::memset(&frame[(y * width + x) * pixelSize], 255, pixelSize);
+}
+
+/** @return true if the canvas is the frame with a swapped Y axis. */
+bool _equals(const Pixels& frame, const Pixels& canvas)
+{
+    const size_t rowSize = width * pixelSize;
+    for (int32_t y = 0; y < height; ++y)
+        if (::memcmp(&frame[(height - 1 - y) * rowSize], &canvas[y * rowSize],
+                     rowSize) != 0)
+        {
+            return false;
+        }
+    return true;
+}
+
+size_t _stream(const size_t nFrames, const bool fullUpdate)
+{
+    TileCache cache(128);
+    Host host;
+    Pixels frame(width * height * pixelSize);
+
+    for (size_t i = 0; i < nFrames; ++i)
+    {
+        _render(frame, int32_t(i), fullUpdate);
+        const size_t nDirty = cache.update(frame.data(), width, height,
+                                           pixelSize);
+        if (i == 0 || fullUpdate)
+        {
+            TESTINFO(nDirty == cache.getTiles().size(), i);
+        }
+        else
+        {
+            TESTINFO(nDirty > 0 && nDirty <= 8, i << ": " << nDirty);
+        }
+
+        for (const TileCache::Tile& tile : cache.getTiles())
+            if (tile.dirty)
+                host.receive(tile);
+        TESTINFO(_equals(frame, host.canvas), i);
+
+        // an unchanged frame does not produce any tile
+        TESTINFO(cache.update(frame.data(), width, height, pixelSize) == 0, i);
+    }
+    return host.nBytes;
+}
+
+void _testTiling()
+{
+    TileCache cache(256);
+    Pixels frame(width * height * pixelSize);
+    _render(frame, 0, false);
+    TEST(cache.update(frame.data(), width, height, pixelSize) == 12);
+
+    size_t area = 0;
+    for (const TileCache::Tile& tile : cache.getTiles())
+    {
+        TEST(tile.dirty);
+        TEST(tile.w > 0 && tile.w <= 256 && tile.h > 0 && tile.h <= 256);
+        TEST(tile.pixels.size() == size_t(tile.w * tile.h) * pixelSize);
+        area += tile.w * tile.h;
+    }
+    TEST(area == size_t(width * height));
+
+    cache.invalidate();
+    TEST(cache.update(frame.data(), width, height, pixelSize) == 12);
+
+    // a size change resets the tiles
+    TEST(cache.update(frame.data(), height, width, pixelSize) == 12);
+    TEST(cache.update(frame.data(), width / 2, height, pixelSize) == 6);
+}
+
+/** A link transmitting 'bandwidth' bytes per ms of JPEG of a given quality. */
+float _transmit(const size_t nBytes, const unsigned quality,
+                const float bandwidth)
+{
+    const float ratio = 4.f + (100.f - quality) * .5f;
+    return nBytes / ratio / bandwidth;
+}
+
+void _testRateControl()
+{
+    RateControl fixed;
+    fixed.update(1000.f);
+    TEST(fixed.getQuality() == RateControl::maxQuality);
+
+    const size_t frameSize = width * height * pixelSize;
+    const float bandwidth = 12500.f; // 100 MBit/s
+    const float target = 20.f;       // ms
+    TESTINFO(_transmit(frameSize, 100, bandwidth) > target,
+             _transmit(frameSize, 100, bandwidth));
+
+    RateControl control(target);
+    for (size_t i = 0; i < 50; ++i)
+        control.update(_transmit(frameSize, control.getQuality(), bandwidth));
+
+    const unsigned quality = control.getQuality();
+    TESTINFO(quality < RateControl::maxQuality, quality);
+    TESTINFO(quality >= RateControl::minQuality, quality);
+    TESTINFO(_transmit(frameSize, quality, bandwidth) < target * 1.5f,
+             _transmit(frameSize, quality, bandwidth));
+
+    // recovers the full quality once only small tiles are sent
+    for (size_t i = 0; i < 50; ++i)
+        control.update(
+            _transmit(frameSize / 20, control.getQuality(), bandwidth));
+    TEST(control.getQuality() == RateControl::maxQuality);
+}
+}
+
+int main(int, char**)
+{
+    _testTiling();
+
+    const size_t nFrames = 100;
+    const size_t frameSize = width * height * pixelSize;
+    const size_t delta = _stream(nFrames, false);
+    const size_t full = _stream(nFrames, true);
+
+    TEST(full == nFrames * frameSize);
+    TESTINFO(delta < full / 10, delta << " >= " << full / 10);
+    std::cout << "Streamed " << nFrames << " frames with " << delta
+              << " bytes of dirty tiles, " << full << " bytes of full frames"
+              << std::endl;
+
+    _testRateControl();
+    return EXIT_SUCCESS;
+}
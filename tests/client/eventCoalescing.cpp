@@ -0,0 +1,144 @@
+
+/* Copyright (c) 2026, The Equalizer authors, see AUTHORS
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Coalescing of synthetic X11 event streams by the glX event handler, without
+// an X server.
+
+#include <eq/glx/eventHandler.h>
+#include <lunchbox/test.h>
+
+#include <X11/Xlib.h>
+#include <cstring>
+
+using eq::glx::EventHandler;
+typedef std::vector<XEvent> XEvents;
+
+namespace
+{
+const XID windowA = 1;
+const XID windowB = 2;
+
+XEvent _createEvent(const int type, const XID window, const int x = 0)
+{
+    XEvent event;
+    ::memset(&event, 0, sizeof(event));
+    event.type = type;
+    event.xany.window = window;
+    switch (type)
+    {
+    case MotionNotify:
+        event.xmotion.x = x;
+        event.xmotion.y = -x;
+        break;
+    case ConfigureNotify:
+        event.xconfigure.width = x;
+        break;
+    case Expose:
+        event.xexpose.count = x;
+        break;
+    case ButtonPress:
+    case ButtonRelease:
+        event.xbutton.x = x;
+        event.xbutton.button = Button1;
+        break;
+    default:
+        break;
+    }
+    return event;
+}
+
+std::vector<int> _getTypes(const XEvents& events)
+{
+    std::vector<int> types;
+    for (const XEvent& event : events)
+        types.push_back(event.type);
+    return types;
+}
+}
+
+int main(int, char**)
+{
+    // a run of motion events is merged into the last one
+    XEvents events;
+    for (int i = 0; i < 100; ++i)
+        events.push_back(_createEvent(MotionNotify, windowA, i));
+    TEST(EventHandler::coalesce(events, windowA) == 99);
+    TEST(events.size() == 1);
+    TEST(events[0].xmotion.x == 99 && events[0].xmotion.y == -99);
+
+    // nothing to do for other windows and single events
+    TEST(EventHandler::coalesce(events, windowB) == 0);
+    TEST(EventHandler::coalesce(events, windowA) == 0);
+    TEST(events.size() == 1);
+
+    // button and key events end a run and keep their order
+    events.clear();
+    events.push_back(_createEvent(MotionNotify, windowA, 1));
+    events.push_back(_createEvent(MotionNotify, windowA, 2));
+    events.push_back(_createEvent(ButtonPress, windowA, 2));
+    events.push_back(_createEvent(MotionNotify, windowA, 3));
+    events.push_back(_createEvent(MotionNotify, windowA, 4));
+    events.push_back(_createEvent(MotionNotify, windowA, 5));
+    events.push_back(_createEvent(ButtonRelease, windowA, 5));
+    events.push_back(_createEvent(KeyPress, windowA));
+    events.push_back(_createEvent(MotionNotify, windowA, 6));
+    events.push_back(_createEvent(KeyRelease, windowA));
+    TEST(EventHandler::coalesce(events, windowA) == 3);
+    const std::vector<int> expected = {MotionNotify, ButtonPress,
+                                       MotionNotify, ButtonRelease,
+                                       KeyPress,     MotionNotify,
+                                       KeyRelease};
+    TEST(_getTypes(events) == expected);
+    TEST(events[0].xmotion.x == 2);
+    TEST(events[2].xmotion.x == 5);
+    TEST(events[5].xmotion.x == 6);
+
+    // resize and expose runs are merged independently of the motion
+    events.clear();
+    for (int i = 1; i <= 10; ++i)
+    {
+        events.push_back(_createEvent(ConfigureNotify, windowA, i * 10));
+        events.push_back(_createEvent(Expose, windowA, 0));
+        events.push_back(_createEvent(MotionNotify, windowA, i));
+    }
+    TEST(EventHandler::coalesce(events, windowA) == 27);
+    TEST(events.size() == 3);
+    TEST(events[0].type == ConfigureNotify);
+    TEST(events[0].xconfigure.width == 100);
+    TEST(events[1].type == Expose);
+    TEST(events[2].type == MotionNotify && events[2].xmotion.x == 10);
+
+    // interleaved windows are coalesced separately
+    events.clear();
+    for (int i = 0; i < 10; ++i)
+    {
+        events.push_back(_createEvent(MotionNotify, windowA, i));
+        events.push_back(_createEvent(MotionNotify, windowB, i + 100));
+        events.push_back(_createEvent(ButtonPress, windowB, i + 100));
+    }
+    TEST(EventHandler::coalesce(events, windowA) == 9);
+    TEST(events.size() == 21);
+    TEST(EventHandler::coalesce(events, windowB) == 0);
+    TEST(events[18].type == MotionNotify);
+    TEST(events[18].xany.window == windowA);
+    TEST(events[18].xmotion.x == 9);
+    TEST(events[0].type == MotionNotify && events[0].xmotion.x == 100);
+    TEST(events[19].type == MotionNotify && events[19].xmotion.x == 109);
+    TEST(events[19].xany.window == windowB);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,189 @@
+
+/* Copyright (c) 2026, The Equalizer authors, see AUTHORS
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Tests the ready handling of received frame data with asynchronous decoding:
+// images of overlapping versions are decoded out of order, and each version
+// becomes ready with exactly its own images, in version order.
+
+#include <eq/eq.h>
+#include <eq/frameData.h>
+#include <eq/image.h>
+#include <lunchbox/test.h>
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+using eq::FrameData;
+using eq::FrameDataPtr;
+using eq::PixelViewport;
+
+namespace
+{
+const eq::uint128_t frameDataID(42, 17);
+
+/** @return the transmitted form of an uncompressed color image. */
+std::vector<uint8_t> _encode(const PixelViewport& pvp)
+{
+    FrameData::ImageHeader header;
+    header.internalFormat = EQ_COMPRESSOR_DATATYPE_RGBA;
+    header.externalFormat = EQ_COMPRESSOR_DATATYPE_RGBA;
+    header.pixelSize = 4;
+    header.pvp = pvp;
+    header.compressorName = EQ_COMPRESSOR_NONE;
+    header.compressorFlags = 0;
+    header.nChunks = 0;
+    header.quality = 1.f;
+
+    const uint64_t size = pvp.getArea() * header.pixelSize;
+    std::vector<uint8_t> data(sizeof(header) + sizeof(size) + size, 0x80);
+    ::memcpy(data.data(), &header, sizeof(header));
+    ::memcpy(data.data() + sizeof(header), &size, sizeof(size));
+    return data;
+}
+
+/** Emulates the node: receives images and readies for one frame data. */
+class Receiver
+{
+public:
+    Receiver()
+        : frameData(new FrameData)
+    {
+        frameData->setID(frameDataID);
+        frameData->setVersion(1);
+        frameData->addListener(ready);
+    }
+
+    ~Receiver()
+    {
+        frameData->removeListener(ready);
+        frameData->flush();
+    }
+
+    /** Receive an image, the decode is started but not finished. */
+    void receiveImage(const uint64_t version, const int32_t id)
+    {
+        frameData->setVersion(version);
+        frameData->startDecode(version);
+        const PixelViewport pvp(id, 0, 8, 4);
+        std::vector<uint8_t> data = _encode(pvp);
+        TEST(frameData->addImage(_getVersion(version), pvp, eq::Zoom(),
+                                 eq::RenderContext(), eq::Frame::Buffer::color,
+                                 true, data.data()));
+    }
+
+    void finishDecode(const uint64_t version)
+    {
+        frameData->finishDecode(version);
+    }
+
+    void receiveReady(const uint64_t version)
+    {
+        frameData->setVersion(version);
+        frameData->setReady(_getVersion(version), eq::fabric::FrameData());
+    }
+
+    /** @return the identifiers of the current images, sorted. */
+    std::vector<int32_t> getImages() const
+    {
+        std::vector<int32_t> ids;
+        for (const eq::Image* image : frameData->getImages())
+            ids.push_back(image->getPixelViewport().x);
+        std::sort(ids.begin(), ids.end());
+        return ids;
+    }
+
+    FrameDataPtr frameData;
+    FrameData::Listener ready;
+
+private:
+    static co::ObjectVersion _getVersion(const uint64_t version)
+    {
+        return co::ObjectVersion(frameDataID, eq::uint128_t(0, version));
+    }
+};
+
+std::vector<int32_t> _ids(const std::initializer_list<int32_t>& ids)
+{
+    return std::vector<int32_t>(ids);
+}
+
+// v1 is still decoding when v2 has been fully received
+void _testReadyWhileDecoding()
+{
+    Receiver receiver;
+    receiver.receiveImage(1, 10);
+    receiver.receiveImage(1, 11);
+    receiver.receiveReady(1);
+    receiver.finishDecode(1);
+    TEST(receiver.ready == 0);
+
+    receiver.receiveImage(2, 20);
+    receiver.finishDecode(2);
+    receiver.receiveReady(2);
+    TESTINFO(receiver.ready == 0, receiver.ready); // held back by v1
+    TEST(!receiver.frameData->isReady());
+
+    receiver.finishDecode(1);
+    TESTINFO(receiver.ready == 2, receiver.ready);
+    TEST(receiver.frameData->isReady());
+    TEST(receiver.getImages() == _ids({20}));
+}
+
+// v2 images are decoding when v1 becomes ready
+void _testDecodingWhileReady()
+{
+    Receiver receiver;
+    receiver.receiveImage(1, 10);
+    receiver.receiveReady(1);
+    receiver.receiveImage(2, 20);
+    receiver.receiveImage(2, 21);
+    receiver.finishDecode(2);
+
+    receiver.finishDecode(1);
+    TESTINFO(receiver.ready == 1, receiver.ready);
+    TEST(receiver.getImages() == _ids({10}));
+    TEST(!receiver.frameData->isReady()); // v2 is current
+
+    receiver.receiveReady(2);
+    TESTINFO(receiver.ready == 1, receiver.ready);
+    receiver.receiveImage(3, 30);
+
+    receiver.finishDecode(2);
+    TESTINFO(receiver.ready == 2, receiver.ready);
+    TEST(receiver.getImages() == _ids({20, 21}));
+
+    receiver.receiveReady(3);
+    TESTINFO(receiver.ready == 2, receiver.ready);
+    receiver.finishDecode(3);
+    TESTINFO(receiver.ready == 3, receiver.ready);
+    TEST(receiver.frameData->isReady());
+    TEST(receiver.getImages() == _ids({30}));
+}
+}
+
+int main(int, char**)
+{
+    eq::NodeFactory nodeFactory;
+    TEST(eq::init(0, 0, &nodeFactory));
+
+    _testReadyWhileDecoding();
+    _testDecodingWhileReady();
+
+    TEST(eq::exit());
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,197 @@
+
+/* Copyright (c) 2026, The Equalizer authors, see AUTHORS
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Tests headless rendering with the EGL window system: the source channel of a
+// sort-last config runs on a second render client process, its FBO is read
+// back, transmitted and composited onto the destination without a display
+// server.
+
+#include <eq/eq.h>
+#include <lunchbox/test.h>
+
+#include <fstream>
+
+namespace
+{
+lunchbox::a_int32_t assembleCalls;
+lunchbox::a_int32_t inputImages;
+
+/** Write a DB config with the source channel on a launched render client. */
+std::string _writeConfig()
+{
+    const std::string filename =
+        std::string(EQ_TEST_BINARY_DIR) + "/headless.eqc";
+    std::ofstream os(filename.c_str());
+    os << "#Equalizer 1.2 ascii" << std::endl
+       << "global" << std::endl
+       << "{" << std::endl
+       << "    EQ_NODE_SATTR_LAUNCH_COMMAND \"%c\"" << std::endl
+       << "}" << std::endl
+       << "server" << std::endl
+       << "{" << std::endl
+       << "    connection { hostname \"127.0.0.1\" }" << std::endl
+       << "    config" << std::endl
+       << "    {" << std::endl
+       << "        appNode" << std::endl
+       << "        {" << std::endl
+       << "            connection { hostname \"127.0.0.1\" }" << std::endl
+       << "            pipe { window { channel { name \"channel\" }}}"
+       << std::endl
+       << "        }" << std::endl
+       << "        node" << std::endl
+       << "        {" << std::endl
+       << "            connection { hostname \"127.0.0.1\" }" << std::endl
+       << "            pipe" << std::endl
+       << "            {" << std::endl
+       << "                window" << std::endl
+       << "                {" << std::endl
+       << "                    attributes { hint_drawable FBO }" << std::endl
+       << "                    channel { name \"source\" }" << std::endl
+       << "                }" << std::endl
+       << "            }" << std::endl
+       << "        }" << std::endl
+       << "        compound" << std::endl
+       << "        {" << std::endl
+       << "            channel \"channel\"" << std::endl
+       << "            buffer [ COLOR DEPTH ]" << std::endl
+       << "            wall" << std::endl
+       << "            {" << std::endl
+       << "                bottom_left  [ -.32 -.20 -.75 ]" << std::endl
+       << "                bottom_right [  .32 -.20 -.75 ]" << std::endl
+       << "                top_left     [ -.32  .20 -.75 ]" << std::endl
+       << "            }" << std::endl
+       << "            compound { range [ 0 .5 ] }" << std::endl
+       << "            compound" << std::endl
+       << "            {" << std::endl
+       << "                channel \"source\"" << std::endl
+       << "                range [ .5 1 ]" << std::endl
+       << "                outputframe { name \"frame.source\" }" << std::endl
+       << "            }" << std::endl
+       << "            inputframe { name \"frame.source\" }" << std::endl
+       << "        }" << std::endl
+       << "    }" << std::endl
+       << "}" << std::endl;
+    return filename;
+}
+
+class Window : public eq::Window
+{
+public:
+    Window(eq::Pipe* parent)
+        : eq::Window(parent)
+    {
+    }
+
+protected:
+    bool configInitSystemWindow(const eq::uint128_t& initID) override
+    {
+        if (!eq::Window::configInitSystemWindow(initID))
+            return false;
+
+        // runs in both processes, a failure on the render client fails the
+        // config initialization of the application
+        const std::string name = getPipe()->getWindowSystem().getName();
+        TESTINFO(name == "EGL", name);
+        // on-screen windows are rendered to an FBO as well
+        TEST(getSystemWindow()->getFrameBufferObject());
+        return true;
+    }
+};
+
+class Channel : public eq::Channel
+{
+public:
+    Channel(eq::Window* parent)
+        : eq::Channel(parent)
+    {
+    }
+
+protected:
+    void frameAssemble(const eq::uint128_t& frameID,
+                       const eq::Frames& frames) override
+    {
+        // the input frame only has images once they have been read back and
+        // transmitted by the render client
+        for (const eq::Frame* frame : frames)
+        {
+            frame->waitReady();
+            inputImages += int32_t(frame->getImages().size());
+        }
+        eq::Channel::frameAssemble(frameID, frames);
+        ++assembleCalls;
+    }
+};
+
+class NodeFactory : public eq::NodeFactory
+{
+public:
+    eq::Window* createWindow(eq::Pipe* parent) override
+    {
+        return new Window(parent);
+    }
+    eq::Channel* createChannel(eq::Window* parent) override
+    {
+        return new Channel(parent);
+    }
+};
+}
+
+int main(const int argc, char** argv)
+{
+    // inherited by the render client launched by the server
+    ::setenv("EQ_WINDOW_SYSTEM", "EGL", 1 /*overwrite*/);
+
+    // the launched render client runs the client loop in initLocal and exits
+    NodeFactory nodeFactory;
+    TEST(eq::init(argc, argv, &nodeFactory));
+
+    eq::ClientPtr client = new eq::Client;
+    client->addConnectionDescription(new co::ConnectionDescription);
+    TEST(client->initLocal(argc, argv));
+
+    eq::Global::setConfig(_writeConfig());
+    eq::ServerPtr server = new eq::Server;
+    TEST(client->connectServer(server));
+
+    eq::fabric::ConfigParams configParams;
+    eq::Config* config = server->chooseConfig(configParams);
+    TEST(config);
+    TEST(config->getNodes().size() == 2);
+    TEST(config->init(eq::uint128_t()));
+
+    const int nFrames = 3;
+    for (int i = 0; i < nFrames; ++i)
+    {
+        config->startFrame(eq::uint128_t());
+        config->finishFrame();
+    }
+    config->finishAllFrames();
+
+    TESTINFO(assembleCalls == nFrames, assembleCalls);
+    TESTINFO(inputImages >= nFrames, inputImages);
+
+    TEST(config->exit());
+    server->releaseConfig(config);
+    client->disconnectServer(server);
+    client->exitLocal();
+
+    TESTINFO(client->getRefCount() == 1, client->getRefCount());
+    TESTINFO(server->getRefCount() == 1, server->getRefCount());
+
+    eq::exit();
+    return EXIT_SUCCESS;
+}
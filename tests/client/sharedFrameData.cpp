@@ -0,0 +1,229 @@
+
+/* Copyright (c) 2026, The Equalizer authors, see AUTHORS
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Multi-pipe test for eq::util::SharedFrameData: pipe threads of one node
+// render frames with latency and each obtain the frame data version of their
+// frame. Counts the versions received by the slave instances, once per frame
+// for the shared instance instead of once per frame and pipe.
+
+#include <eq/eq.h>
+#include <eq/util/sharedFrameData.h>
+#include <lunchbox/test.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+namespace
+{
+const size_t nPipes = 4;
+const size_t nFrames = 200;
+const size_t latency = 2;
+
+std::atomic<size_t> _nDeserialized(0);
+
+class FrameData : public co::Serializable
+{
+public:
+    FrameData()
+        : _frame(0)
+    {
+    }
+
+    void setFrame(const size_t frame)
+    {
+        _frame = frame;
+        setDirty(DIRTY_FRAME);
+    }
+
+    size_t getFrame() const { return _frame; }
+protected:
+    void serialize(co::DataOStream& os, const uint64_t dirtyBits) final
+    {
+        if (dirtyBits & DIRTY_FRAME)
+            os << uint64_t(_frame);
+    }
+
+    void deserialize(co::DataIStream& is, const uint64_t dirtyBits) final
+    {
+        if (dirtyBits & DIRTY_FRAME)
+            _frame = is.read<uint64_t>();
+        ++_nDeserialized;
+    }
+
+    ChangeType getChangeType() const final { return DELTA; }
+    enum DirtyBits
+    {
+        DIRTY_FRAME = co::Serializable::DIRTY_CUSTOM << 0
+    };
+
+private:
+    size_t _frame;
+};
+
+/** The config frame loop: starts frames at most 'latency' frames ahead. */
+class Frames
+{
+public:
+    Frames()
+        : _versions(nFrames + 1)
+        , _done(nPipes, 0)
+        , _started(0)
+    {
+    }
+
+    void start(FrameData& master)
+    {
+        for (size_t frame = 1; frame <= nFrames; ++frame)
+        {
+            std::unique_lock<std::mutex> lock(_lock);
+            _condition.wait(lock, [&] {
+                for (const size_t done : _done)
+                    if (done + latency + 1 < frame)
+                        return false;
+                return true;
+            });
+
+            master.setFrame(frame);
+            _versions[frame] = master.commit();
+            _started = frame;
+            _condition.notify_all();
+        }
+    }
+
+    /** Run one pipe thread, drawing each frame with its version. */
+    void run(const size_t pipe,
+             const std::function<void(size_t, const eq::uint128_t&)>& draw)
+    {
+        for (size_t frame = 1; frame <= nFrames; ++frame)
+        {
+            eq::uint128_t version;
+            {
+                std::unique_lock<std::mutex> lock(_lock);
+                _condition.wait(lock, [&] { return _started >= frame; });
+                version = _versions[frame];
+            }
+
+            draw(frame, version);
+            if ((frame + pipe) % 7 == 0) // vary the speed of the pipes
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+
+            std::lock_guard<std::mutex> lock(_lock);
+            _done[pipe] = frame;
+            _condition.notify_all();
+        }
+    }
+
+private:
+    std::mutex _lock;
+    std::condition_variable _condition;
+    std::vector<eq::uint128_t> _versions;
+    std::vector<size_t> _done;
+    size_t _started;
+};
+
+void _runPipes(FrameData& master,
+               const std::function<void(size_t, size_t,
+                                        const eq::uint128_t&)>& draw)
+{
+    Frames frames;
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < nPipes; ++i)
+        threads.emplace_back([&frames, &draw, i] {
+            frames.run(i, [&draw, i](const size_t frame,
+                                     const eq::uint128_t& version) {
+                draw(i, frame, version);
+            });
+        });
+
+    frames.start(master);
+    for (std::thread& thread : threads)
+        thread.join();
+}
+}
+
+int main(const int argc, char** argv)
+{
+    eq::NodeFactory nodeFactory;
+    TEST(eq::init(0, 0, &nodeFactory));
+
+    eq::ClientPtr client = new eq::Client;
+    TEST(client->initLocal(argc, argv));
+
+    FrameData master;
+    TEST(client->registerObject(&master));
+
+    // one slave instance per pipe
+    std::vector<FrameData> slaves(nPipes);
+    for (FrameData& slave : slaves)
+        TEST(client->mapObject(&slave, master.getID()));
+
+    _nDeserialized = 0;
+    _runPipes(master, [&slaves](const size_t pipe, const size_t frame,
+                                const eq::uint128_t& version) {
+        slaves[pipe].sync(version);
+        TESTINFO(slaves[pipe].getFrame() == frame, slaves[pipe].getFrame());
+    });
+    const size_t nPerPipe = _nDeserialized;
+    TESTINFO(nPerPipe == nPipes * nFrames, nPerPipe);
+
+    for (FrameData& slave : slaves)
+        client->unmapObject(&slave);
+
+    // one shared instance for all pipes
+    eq::util::SharedFrameData<FrameData> shared;
+    TEST(shared.map(*client, master.getID(), latency + 1));
+    TEST(shared.getNewest());
+    TEST(shared.getNumSyncs() == 0);
+
+    typedef eq::util::SharedFrameData<FrameData>::ConstPtr FrameDataPtr;
+    std::vector<std::vector<FrameDataPtr>> snapshots(
+        nPipes, std::vector<FrameDataPtr>(nFrames + 1));
+
+    _nDeserialized = 0;
+    _runPipes(master, [&shared, &snapshots](const size_t pipe,
+                                            const size_t frame,
+                                            const eq::uint128_t& version) {
+        const FrameDataPtr frameData = shared.sync(version);
+        TESTINFO(frameData->getFrame() == frame,
+                 frameData->getFrame() << " != " << frame);
+        snapshots[pipe][frame] = frameData;
+    });
+    const size_t nShared = _nDeserialized;
+    TESTINFO(nShared == nFrames, nShared);
+    TESTINFO(shared.getNumSyncs() == nFrames, shared.getNumSyncs());
+
+    // all pipes share the same snapshot of each frame
+    for (size_t frame = 1; frame <= nFrames; ++frame)
+        for (size_t pipe = 1; pipe < nPipes; ++pipe)
+            TEST(snapshots[pipe][frame] == snapshots[0][frame]);
+
+    std::cout << nPipes << " pipes, " << nFrames << " frames: " << nPerPipe
+              << " versions received by per-pipe instances, " << nShared
+              << " by the shared instance" << std::endl;
+
+    shared.unmap(*client);
+    client->deregisterObject(&master);
+    TEST(client->exitLocal());
+
+    TESTINFO(client->getRefCount() == 1, client->getRefCount());
+    eq::exit();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,139 @@
+
+/* Copyright (c) 2026, The Equalizer authors, see AUTHORS
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Round-trip and size test for the statistics batches sent by the render nodes
+// to the application node.
+
+#include <eq/detail/statisticBatch.h>
+#include <eq/fabric/statistic.h>
+#include <lunchbox/test.h>
+
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+using eq::Statistic;
+using eq::Statistics;
+namespace statisticBatch = eq::detail::statisticBatch;
+
+namespace
+{
+const size_t nFrames = 10;
+const size_t nChannels = 50;
+
+Statistic _createStatistic(const size_t frame, const size_t channel,
+                           const Statistic::Type type)
+{
+    Statistic statistic;
+    ::memset(statistic.resourceName, 0, sizeof(statistic.resourceName));
+    snprintf(statistic.resourceName, 32, "Channel %zu", channel);
+    statistic.originator = eq::uint128_t(channel + 1, 42);
+    statistic.serial = uint32_t(channel) + 7;
+    statistic.type = type;
+    statistic.frameNumber = uint32_t(frame);
+    statistic.task = 0;
+    statistic.plugins[0] = 0;
+    statistic.plugins[1] = 0;
+    statistic.startTime = int64_t(frame * 16 + channel % 5 + type);
+    statistic.endTime = statistic.startTime + 1 + int64_t(type % 3);
+    statistic.time = statistic.endTime;
+    statistic.idleTime = 0;
+    statistic.totalTime = 0;
+    statistic.ratio = 0.f;
+    statistic.currentFPS = 0.f;
+    statistic.averageFPS = 0.f;
+    statistic.pad = 0.f;
+
+    switch (type)
+    {
+    case Statistic::CHANNEL_FRAME_COMPRESS:
+        statistic.ratio = .25f;
+        statistic.plugins[0] = 0x1a;
+        statistic.plugins[1] = 0x12;
+        break;
+    case Statistic::WINDOW_FPS:
+        statistic.currentFPS = 59.9f;
+        statistic.averageFPS = 60.1f;
+        break;
+    case Statistic::PIPE_IDLE:
+        statistic.idleTime = 3;
+        statistic.totalTime = 16;
+        break;
+    case Statistic::CHANNEL_READBACK:
+        statistic.task = 4;
+        break;
+    default:
+        break;
+    }
+    return statistic;
+}
+
+bool _equals(const Statistic& a, const Statistic& b)
+{
+    return a.originator == b.originator && a.serial == b.serial &&
+           a.time == b.time && a.type == b.type &&
+           a.frameNumber == b.frameNumber && a.task == b.task &&
+           a.plugins[0] == b.plugins[0] && a.plugins[1] == b.plugins[1] &&
+           a.startTime == b.startTime && a.endTime == b.endTime &&
+           a.idleTime == b.idleTime && a.totalTime == b.totalTime &&
+           a.ratio == b.ratio && a.currentFPS == b.currentFPS &&
+           a.averageFPS == b.averageFPS &&
+           ::strcmp(a.resourceName, b.resourceName) == 0;
+}
+}
+
+int main(int, char**)
+{
+    std::vector<uint8_t> data;
+    Statistics statistics;
+    statisticBatch::encode(statistics, data);
+    TEST(statisticBatch::decode(data, statistics));
+    TEST(statistics.empty());
+
+    for (size_t frame = 1; frame <= nFrames; ++frame)
+        for (size_t channel = 0; channel < nChannels; ++channel)
+            for (int type = Statistic::CHANNEL_CLEAR;
+                 type <= Statistic::PIPE_IDLE; ++type)
+            {
+                statistics.push_back(
+                    _createStatistic(frame, channel, Statistic::Type(type)));
+            }
+
+    // non-monotonic times and frames of late statistics
+    statistics.push_back(_createStatistic(1, 3, Statistic::CHANNEL_DRAW));
+
+    data.clear();
+    statisticBatch::encode(statistics, data);
+
+    Statistics decoded;
+    TEST(statisticBatch::decode(data, decoded));
+    TESTINFO(decoded.size() == statistics.size(), decoded.size());
+    for (size_t i = 0; i < statistics.size(); ++i)
+        TESTINFO(_equals(statistics[i], decoded[i]), i);
+
+    const size_t eventSize = statistics.size() * sizeof(Statistic);
+    std::cout << statistics.size() << " statistics: " << data.size()
+              << " bytes batched, " << eventSize << " bytes as events"
+              << std::endl;
+    TESTINFO(data.size() * 8 < eventSize, data.size());
+
+    // truncated data is rejected
+    data.resize(data.size() / 2);
+    decoded.clear();
+    TEST(!statisticBatch::decode(data, decoded));
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,371 @@
+
+/* Copyright (c) 2026, The Equalizer authors, see AUTHORS
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Tests the CPU compositing of pixel, subpixel and zoomed images against
+// reference images computed from the undecomposed source image.
+
+#include <lunchbox/test.h>
+
+#include <eq/compositor.h>
+#include <eq/image.h>
+#include <eq/imageOp.h>
+#include <eq/init.h>
+#include <eq/nodeFactory.h>
+#include <eq/pixelData.h>
+
+#include <pression/plugins/compressor.h>
+
+#include <cstring>
+
+namespace
+{
+typedef std::vector<uint8_t> Pixels;
+
+/** Deterministic random generator, independent of the platform rand(). */
+class Random
+{
+public:
+    explicit Random(const uint32_t seed)
+        : _state(seed * 2654435761u + 1u)
+    {
+    }
+    uint8_t next()
+    {
+        _state = _state * 1664525u + 1013904223u;
+        return uint8_t(_state >> 24);
+    }
+
+private:
+    uint32_t _state;
+};
+
+Pixels _generate(const eq::PixelViewport& pvp, const uint32_t seed)
+{
+    Random random(seed);
+    Pixels pixels(size_t(pvp.getArea()) * 4);
+    for (uint8_t& pixel : pixels)
+        pixel = random.next();
+    return pixels;
+}
+
+void _setPixels(eq::Image& image, const eq::PixelViewport& pvp,
+                const Pixels& data)
+{
+    eq::PixelData pixels;
+    pixels.internalFormat = EQ_COMPRESSOR_DATATYPE_RGBA;
+    pixels.externalFormat = EQ_COMPRESSOR_DATATYPE_RGBA;
+    pixels.pixelSize = 4;
+    pixels.pvp = pvp;
+    pixels.pixels = const_cast<uint8_t*>(data.data());
+    image.setPixelViewport(pvp);
+    image.setPixelData(eq::Frame::Buffer::color, pixels);
+}
+
+void _setDepth(eq::Image& image, const eq::PixelViewport& pvp,
+               const Pixels& data)
+{
+    eq::PixelData pixels;
+    pixels.internalFormat = EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT;
+    pixels.externalFormat = EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT;
+    pixels.pixelSize = 4;
+    pixels.pvp = pvp;
+    pixels.pixels = const_cast<uint8_t*>(data.data());
+    image.setPixelData(eq::Frame::Buffer::depth, pixels);
+}
+
+eq::ImageOp _newOp(const eq::Image& image)
+{
+    eq::ImageOp op;
+    op.image = &image;
+    op.buffers = eq::Frame::Buffer::color;
+    return op;
+}
+
+/** Extract the pixels of one source of a pixel decomposition. */
+Pixels _extract(const Pixels& source, const eq::PixelViewport& pvp,
+                const eq::Pixel& pixel, eq::PixelViewport& result)
+{
+    result = eq::PixelViewport(0, 0, (pvp.w - pixel.x + pixel.w - 1) / pixel.w,
+                               (pvp.h - pixel.y + pixel.h - 1) / pixel.h);
+    Pixels pixels(size_t(result.getArea()) * 4);
+    for (int32_t y = 0; y < result.h; ++y)
+        for (int32_t x = 0; x < result.w; ++x)
+            ::memcpy(&pixels[(y * result.w + x) * 4],
+                     &source[((y * pixel.h + pixel.y) * pvp.w + x * pixel.w +
+                              pixel.x) *
+                             4],
+                     4);
+    return pixels;
+}
+
+bool _equals(const eq::Image* image, const eq::PixelViewport& pvp,
+             const Pixels& reference)
+{
+    return image && image->getPixelViewport() == pvp &&
+           image->hasPixelData(eq::Frame::Buffer::color) &&
+           !image->hasPixelData(eq::Frame::Buffer::depth) &&
+           ::memcmp(image->getPixelPointer(eq::Frame::Buffer::color),
+                    reference.data(), reference.size()) == 0;
+}
+
+void _testPixel(const uint32_t nColumns, const uint32_t nRows)
+{
+    const eq::PixelViewport pvp(0, 0, 67, 45);
+    const Pixels source = _generate(pvp, nColumns * nRows);
+
+    std::vector<eq::Image> images(nColumns * nRows);
+    std::vector<Pixels> data(images.size());
+    eq::ImageOps ops;
+    for (uint32_t i = 0; i < images.size(); ++i)
+    {
+        eq::RenderContext context;
+        context.pixel = eq::Pixel(i % nColumns, i / nColumns, nColumns, nRows);
+
+        eq::PixelViewport imagePVP;
+        data[i] = _extract(source, pvp, context.pixel, imagePVP);
+        _setPixels(images[i], imagePVP, data[i]);
+        images[i].setContext(context);
+        ops.push_back(_newOp(images[i]));
+    }
+
+    TEST(eq::Compositor::isCompletePixelDecomposition(ops));
+    const eq::Image* result = eq::Compositor::mergeImagesCPU(ops, false);
+    TESTINFO(_equals(result, pvp, source), nColumns << "x" << nRows);
+}
+
+/** Two depth-sorted sources, each split into a pixel decomposition. */
+void _testDBPixel()
+{
+    const eq::PixelViewport pvp(0, 0, 41, 27);
+    const eq::Pixel kernel(0, 0, 2, 2);
+    const size_t nSources = 2;
+    const size_t nPixels = kernel.w * kernel.h;
+
+    std::vector<Pixels> colors;
+    std::vector<Pixels> depths;
+    std::vector<eq::Image> images(nSources * nPixels);
+    std::vector<Pixels> data(images.size() * 2);
+    eq::ImageOps ops;
+    for (size_t i = 0; i < images.size(); ++i)
+    {
+        const size_t source = i / nPixels;
+        if (i % nPixels == 0)
+        {
+            colors.push_back(_generate(pvp, uint32_t(source)));
+            depths.push_back(_generate(pvp, uint32_t(source + 17)));
+        }
+
+        eq::RenderContext context;
+        context.pixel = eq::Pixel(i % kernel.w, (i % nPixels) / kernel.w,
+                                  kernel.w, kernel.h);
+
+        eq::PixelViewport imagePVP;
+        data[i * 2] = _extract(colors.back(), pvp, context.pixel, imagePVP);
+        data[i * 2 + 1] =
+            _extract(depths.back(), pvp, context.pixel, imagePVP);
+        _setPixels(images[i], imagePVP, data[i * 2]);
+        _setDepth(images[i], imagePVP, data[i * 2 + 1]);
+        images[i].setContext(context);
+        ops.push_back(_newOp(images[i]));
+        ops.back().buffers |= eq::Frame::Buffer::depth;
+    }
+
+    // nearest source wins, the first one on equal depth
+    Pixels color = colors[0];
+    Pixels depth = depths[0];
+    const uint32_t* depth1 = reinterpret_cast<const uint32_t*>(&depths[1][0]);
+    uint32_t* nearest = reinterpret_cast<uint32_t*>(&depth[0]);
+    for (int32_t i = 0; i < pvp.getArea(); ++i)
+    {
+        if (depth1[i] >= nearest[i])
+            continue;
+        nearest[i] = depth1[i];
+        ::memcpy(&color[i * 4], &colors[1][i * 4], 4);
+    }
+
+    TEST(eq::Compositor::isCompletePixelDecomposition(ops));
+    const eq::Image* result = eq::Compositor::mergeImagesCPU(ops, false);
+    TEST(result && result->getPixelViewport() == pvp);
+    TEST(result->hasPixelData(eq::Frame::Buffer::depth));
+    TEST(::memcmp(result->getPixelPointer(eq::Frame::Buffer::color),
+                  color.data(), color.size()) == 0);
+    TEST(::memcmp(result->getPixelPointer(eq::Frame::Buffer::depth),
+                  depth.data(), depth.size()) == 0);
+}
+
+/** Only complete pixel kernels are merged on the CPU. */
+void _testPartialPixel()
+{
+    const eq::PixelViewport pvp(0, 0, 16, 16);
+    const Pixels source = _generate(pvp, 3);
+
+    std::vector<eq::Image> images(4);
+    std::vector<Pixels> data(images.size());
+    const eq::Pixel pixels[] = {eq::Pixel(0, 0, 3, 1), eq::Pixel(1, 0, 3, 1),
+                                eq::Pixel(2, 0, 3, 1), eq::Pixel(1, 0, 2, 1)};
+    eq::ImageOps ops;
+    for (size_t i = 0; i < images.size(); ++i)
+    {
+        eq::RenderContext context;
+        context.pixel = pixels[i];
+
+        eq::PixelViewport imagePVP;
+        data[i] = _extract(source, pvp, context.pixel, imagePVP);
+        _setPixels(images[i], imagePVP, data[i]);
+        images[i].setContext(context);
+        ops.push_back(_newOp(images[i]));
+    }
+
+    const eq::ImageOp mixed = ops.back();
+    ops.pop_back();
+    TEST(eq::Compositor::isCompletePixelDecomposition(ops));
+
+    // missing kernel index
+    eq::ImageOps partial(ops.begin(), ops.begin() + 2);
+    TEST(!eq::Compositor::isCompletePixelDecomposition(partial));
+
+    // kernel index covered twice by color-only images
+    partial.push_back(ops[1]);
+    TEST(!eq::Compositor::isCompletePixelDecomposition(partial));
+
+    // different kernels
+    ops.push_back(mixed);
+    TEST(!eq::Compositor::isCompletePixelDecomposition(ops));
+
+    TEST(!eq::Compositor::isCompletePixelDecomposition(eq::ImageOps()));
+}
+
+void _testSubPixel(const bool withPixel)
+{
+    const size_t nSteps = 5;
+    const eq::PixelViewport pvp(0, 0, 64, 48);
+
+    std::vector<Pixels> sources;
+    std::vector<eq::Image> images(nSteps * 2);
+    std::vector<Pixels> data(images.size());
+    eq::ImageOps ops;
+    for (size_t i = 0; i < images.size(); ++i)
+    {
+        // two pixel or 2D sources per subpixel step
+        const size_t step = i / 2;
+        if (i % 2 == 0)
+            sources.push_back(_generate(pvp, uint32_t(step)));
+
+        eq::RenderContext context;
+        context.subPixel = eq::SubPixel(uint32_t(step), nSteps);
+
+        eq::PixelViewport imagePVP = pvp;
+        if (withPixel)
+        {
+            context.pixel = eq::Pixel(i % 2, 0, 2, 1);
+            data[i] = _extract(sources.back(), pvp, context.pixel, imagePVP);
+        }
+        else
+        {
+            imagePVP.w /= 2;
+            imagePVP.x = imagePVP.w * (i % 2);
+            data[i] = Pixels(size_t(imagePVP.getArea()) * 4);
+            for (int32_t y = 0; y < imagePVP.h; ++y)
+                ::memcpy(&data[i][y * imagePVP.w * 4],
+                         &sources.back()[(y * pvp.w + imagePVP.x) * 4],
+                         imagePVP.w * 4);
+        }
+        _setPixels(images[i], imagePVP, data[i]);
+        images[i].setContext(context);
+        ops.push_back(_newOp(images[i]));
+    }
+
+    // equally weighted average, rounded to nearest
+    Pixels reference(sources.front().size());
+    for (size_t i = 0; i < reference.size(); ++i)
+    {
+        uint32_t sum = 0;
+        for (const Pixels& source : sources)
+            sum += source[i];
+        reference[i] = uint8_t((sum + nSteps / 2) / nSteps);
+    }
+
+    TEST(eq::Compositor::isSubPixelDecomposition(ops));
+    const eq::Image* result = eq::Compositor::mergeImagesCPU(ops, false);
+    TESTINFO(_equals(result, pvp, reference), withPixel);
+}
+
+void _testZoom()
+{
+    const eq::PixelViewport pvp(0, 0, 32, 24);
+    const Pixels source = _generate(pvp, 42);
+    eq::Image image;
+    _setPixels(image, pvp, source);
+
+    // nearest magnification replicates each pixel
+    eq::ImageOp op = _newOp(image);
+    op.offset = eq::Vector2i(5, 3);
+    op.zoom = eq::Zoom(2.f, 2.f);
+    op.zoomFilter = eq::FILTER_NEAREST;
+
+    eq::PixelViewport zoomed(5, 3, 64, 48);
+    Pixels reference(size_t(zoomed.getArea()) * 4);
+    for (int32_t y = 0; y < zoomed.h; ++y)
+        for (int32_t x = 0; x < zoomed.w; ++x)
+            ::memcpy(&reference[(y * zoomed.w + x) * 4],
+                     &source[((y / 2) * pvp.w + x / 2) * 4], 4);
+
+    const eq::Image* result =
+        eq::Compositor::mergeImagesCPU(eq::ImageOps(1, op), false);
+    TEST(_equals(result, zoomed, reference));
+
+    // linear minification by two averages 2x2 pixels
+    op.offset = eq::Vector2i();
+    op.zoom = eq::Zoom(.5f, .5f);
+    op.zoomFilter = eq::FILTER_LINEAR;
+
+    zoomed = eq::PixelViewport(0, 0, 16, 12);
+    reference.resize(size_t(zoomed.getArea()) * 4);
+    for (int32_t y = 0; y < zoomed.h; ++y)
+        for (int32_t x = 0; x < zoomed.w; ++x)
+            for (int32_t c = 0; c < 4; ++c)
+            {
+                uint32_t sum = 2;
+                for (int32_t i = 0; i < 4; ++i)
+                    sum += source[((y * 2 + i / 2) * pvp.w + x * 2 + i % 2) *
+                                      4 +
+                                  c];
+                reference[(y * zoomed.w + x) * 4 + c] = uint8_t(sum / 4);
+            }
+
+    result = eq::Compositor::mergeImagesCPU(eq::ImageOps(1, op), false);
+    TEST(_equals(result, zoomed, reference));
+}
+}
+
+int main(int, char**)
+{
+    eq::NodeFactory nodeFactory;
+    TEST(eq::init(0, 0, &nodeFactory));
+
+    _testPixel(2, 1);
+    _testPixel(1, 3);
+    _testPixel(3, 2);
+    _testDBPixel();
+    _testPartialPixel();
+    _testSubPixel(false);
+    _testSubPixel(true);
+    _testZoom();
+
+    TEST(eq::exit());
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,323 @@
+
+/* Copyright (c) 2026, The Equalizer authors, see AUTHORS
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Tests the brick occupancy and the slice clipping of the empty space skipping
+// of eVolve on the CPU, using the bundled Bucky32x32x32_d.raw volume.
+
+#include <lunchbox/test.h>
+
+#include <eVolve/brickGrid.h>
+
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+using eVolve::BrickGrid;
+typedef std::vector<uint8_t> Values;
+
+namespace
+{
+const uint32_t size = 32;
+const std::string filename = "Bucky32x32x32_d.raw";
+
+/** @return the values of the volume, the last of the four bytes per voxel. */
+Values _loadValues()
+{
+    std::ifstream file(filename.c_str(), std::ios::binary);
+    Values data(size * size * size * 4);
+    file.read(reinterpret_cast<char*>(data.data()), data.size());
+    TESTINFO(file.good(), "Can't read " << filename);
+
+    Values values(size * size * size);
+    for (size_t i = 0; i < values.size(); ++i)
+        values[i] = data[i * 4 + 3];
+    return values;
+}
+
+/** @return the transfer function of the volume header. */
+Values _loadTransferFunction()
+{
+    std::ifstream file((filename + ".vhf").c_str());
+    Values transferFunction;
+    std::string line;
+    while (std::getline(file, line))
+    {
+        if (line.size() > 2 && line[1] == '=' &&
+            std::string("rgba").find(line[0]) != std::string::npos)
+        {
+            transferFunction.push_back(uint8_t(std::stoi(line.substr(2))));
+        }
+    }
+    TESTINFO(transferFunction.size() == 256 * 4, transferFunction.size());
+    return transferFunction;
+}
+
+/** A transfer function opaque for all values >= threshold. */
+Values _createTransferFunction(const uint32_t threshold)
+{
+    Values transferFunction(256 * 4, 255);
+    for (size_t i = 0; i < 256; ++i)
+        transferFunction[i * 4 + 3] = i >= threshold ? 255 : 0;
+    return transferFunction;
+}
+
+BrickGrid _createGrid(const Values& values, const uint32_t brickSize)
+{
+    BrickGrid grid;
+    grid.resize(size, size, size, brickSize);
+    for (uint32_t z = 0; z < size; ++z)
+        grid.addSlice(z, &values[z * size * size], 1);
+    return grid;
+}
+
+/** Brute-force reference of the classification of one brick. */
+bool _isOccupied(const Values& values, const Values& transferFunction,
+                 const uint32_t brickSize, const uint32_t i, const uint32_t j,
+                 const uint32_t k)
+{
+    const int32_t o = BrickGrid::overlap;
+    const int32_t b = brickSize;
+    uint8_t min = 255;
+    uint8_t max = 0;
+    for (int32_t z = k * b - o; z < int32_t(k + 1) * b + o; ++z)
+        for (int32_t y = j * b - o; y < int32_t(j + 1) * b + o; ++y)
+            for (int32_t x = i * b - o; x < int32_t(i + 1) * b + o; ++x)
+            {
+                if (x < 0 || y < 0 || z < 0 || x >= int32_t(size) ||
+                    y >= int32_t(size) || z >= int32_t(size))
+                {
+                    continue;
+                }
+                const uint8_t value = values[(z * size + y) * size + x];
+                min = std::min(min, value);
+                max = std::max(max, value);
+            }
+
+    for (size_t value = min; value <= max; ++value)
+        if (transferFunction[value * 4 + 3] > 0)
+            return true;
+    return false;
+}
+
+size_t _testClassification(BrickGrid& grid, const Values& values,
+                           const Values& transferFunction,
+                           const uint32_t brickSize)
+{
+    const size_t nOccupied = grid.classify(transferFunction);
+    size_t nExpected = 0;
+    const uint32_t nBricks = size / brickSize;
+    for (uint32_t k = 0; k < nBricks; ++k)
+        for (uint32_t j = 0; j < nBricks; ++j)
+            for (uint32_t i = 0; i < nBricks; ++i)
+            {
+                const bool expected =
+                    _isOccupied(values, transferFunction, brickSize, i, j, k);
+                TESTINFO(grid.isOccupied(i, j, k) == expected,
+                         i << ", " << j << ", " << k);
+                if (expected)
+                    ++nExpected;
+            }
+    TESTINFO(nOccupied == nExpected, nOccupied << " != " << nExpected);
+    TEST(grid.getNumOccupied() == nOccupied);
+    return nOccupied;
+}
+
+float _getArea(const eq::Vector3f* vertices, const size_t nVertices)
+{
+    eq::Vector3f sum(0.f, 0.f, 0.f);
+    for (size_t i = 1; i + 1 < nVertices; ++i)
+        sum += (vertices[i] - vertices[0]).cross(vertices[i + 1] - vertices[0]);
+    return sum.length() * .5f;
+}
+
+/** @return the total area of the brick slices. */
+float _testSlices(const BrickGrid& grid, const eq::Vector3f& viewVec,
+                  const double sliceDistance, const eq::Range& range)
+{
+    BrickGrid::Polygons polygons;
+    grid.computeSlices(viewVec, sliceDistance, range, polygons);
+
+    float area = 0.f;
+    float lastDistance = std::numeric_limits<float>::max();
+    const eq::Vector3f* vertices = polygons.vertices.data();
+    for (const uint32_t nVertices : polygons.sizes)
+    {
+        TEST(nVertices >= 3 && nVertices <= 6);
+
+        // planar, on a slice and back to front
+        const float distance = viewVec.dot(vertices[0]);
+        const float plane = float(std::round(distance / sliceDistance) *
+                                  sliceDistance);
+        TESTINFO(std::abs(distance - plane) < 1e-4f, distance);
+        TESTINFO(distance <= lastDistance + 1e-4f, distance);
+        lastDistance = distance;
+
+        eq::Vector3f center(0.f, 0.f, 0.f);
+        for (size_t i = 0; i < nVertices; ++i)
+        {
+            TESTINFO(std::abs(viewVec.dot(vertices[i]) - distance) < 1e-4f,
+                     vertices[i]);
+            TESTINFO(vertices[i].z() >= -1.f + 2.f * range.start - 1e-5f &&
+                         vertices[i].z() <= -1.f + 2.f * range.end + 1e-5f,
+                     vertices[i]);
+            center += vertices[i];
+        }
+        center /= float(nVertices);
+
+        // within a non-empty brick
+        const vmml::Vector3ui& counts = grid.getBrickCounts();
+        uint32_t brick[3];
+        for (size_t c = 0; c < 3; ++c)
+            brick[c] = std::min(uint32_t((center[c] + 1.f) * .5f * counts[c]),
+                                counts[c] - 1);
+        TESTINFO(grid.isOccupied(brick[0], brick[1], brick[2]), center);
+
+        area += _getArea(vertices, nVertices);
+        vertices += nVertices;
+    }
+    TEST(vertices == polygons.vertices.data() + polygons.vertices.size());
+    return area;
+}
+
+/** @return the total area of the slices through the whole range. */
+float _getFullArea(const eq::Vector3f& viewVec, const double sliceDistance,
+                   const eq::Range& range)
+{
+    const eq::Vector3f min(-1.f, -1.f, -1.f + 2.f * range.start);
+    const eq::Vector3f max(1.f, 1.f, -1.f + 2.f * range.end);
+
+    float area = 0.f;
+    for (int32_t plane = -100; plane <= 100; ++plane)
+    {
+        eq::Vector3f vertices[6];
+        const size_t nVertices =
+            BrickGrid::clipBox(min, max, viewVec,
+                               float(plane * sliceDistance), vertices);
+        if (nVertices >= 3)
+            area += _getArea(vertices, nVertices);
+    }
+    return area;
+}
+
+void _testClipBox()
+{
+    const eq::Vector3f min(-1.f, -1.f, -1.f);
+    const eq::Vector3f max(1.f, 1.f, 1.f);
+    eq::Vector3f vertices[6];
+
+    // axis-aligned plane: square
+    size_t n = BrickGrid::clipBox(min, max, eq::Vector3f(0.f, 0.f, 1.f), .5f,
+                                  vertices);
+    TEST(n == 4);
+    TESTINFO(std::abs(_getArea(vertices, n) - 4.f) < 1e-5f,
+             _getArea(vertices, n));
+
+    // diagonal plane through the center: regular hexagon
+    eq::Vector3f normal(1.f, 1.f, 1.f);
+    normal.normalize();
+    n = BrickGrid::clipBox(min, max, normal, 0.f, vertices);
+    TEST(n == 6);
+    const float hexagon = 3.f * std::sqrt(3.f); // side length sqrt(2)
+    TESTINFO(std::abs(_getArea(vertices, n) - hexagon) < 1e-4f,
+             _getArea(vertices, n));
+
+    // through a corner only, and outside of the box
+    TEST(BrickGrid::clipBox(min, max, normal, std::sqrt(3.f), vertices) < 3);
+    TEST(BrickGrid::clipBox(min, max, normal, 2.f, vertices) == 0);
+}
+}
+
+int main(int, char**)
+{
+    _testClipBox();
+
+    const Values values = _loadValues();
+    const Values transferFunction = _loadTransferFunction();
+    const Values transparent = _createTransferFunction(256);
+    const Values sparse = _createTransferFunction(200);
+
+    for (const uint32_t brickSize : {4u, 8u})
+    {
+        BrickGrid grid = _createGrid(values, brickSize);
+        const size_t nBricks = (size / brickSize) * (size / brickSize) *
+                               (size / brickSize);
+        TEST(grid.getNumBricks() == nBricks);
+
+        // classification against the brute-force reference, and repeated
+        // classification for changing transfer functions
+        const size_t nDefault =
+            _testClassification(grid, values, transferFunction, brickSize);
+        TEST(_testClassification(grid, values, transparent, brickSize) == 0);
+        const size_t nSparse =
+            _testClassification(grid, values, sparse, brickSize);
+        TESTINFO(nSparse <= nDefault, nSparse << " > " << nDefault);
+        TEST(_testClassification(grid, values, transferFunction, brickSize) ==
+             nDefault);
+
+        // tightened bounds of DB ranges
+        eq::Vector3f min, max;
+        TEST(grid.getBounds(eq::Range::ALL, min, max));
+        grid.classify(transparent);
+        TEST(!grid.getBounds(eq::Range::ALL, min, max));
+        TEST(grid.getNumOccupied(eq::Range::ALL) == 0);
+
+        grid.classify(sparse);
+        const eq::Range front(0.f, .5f);
+        if (grid.getBounds(front, min, max))
+        {
+            TESTINFO(min.z() >= -1.f && max.z() <= 0.f, min << max);
+        }
+        const size_t nFront = grid.getNumOccupied(front);
+        TEST(nFront + grid.getNumOccupied(eq::Range(.5f, 1.f)) == nSparse);
+        TEST(grid.getOccupancy(front) == float(nFront) / (nBricks / 2));
+
+        // slices of the non-empty bricks cover the same area as the slices
+        // of the whole volume if no brick is empty, and less otherwise
+        const double sliceDistance = 3.6 / (size * 2);
+        const eq::Vector3f viewVecs[] = {eq::Vector3f(0.f, 0.f, 1.f),
+                                         eq::Vector3f(.3f, -.5f, .81f),
+                                         eq::Vector3f(-.577f, .577f, -.577f)};
+        const eq::Range ranges[] = {eq::Range::ALL, eq::Range(.25f, .75f)};
+        for (const eq::Vector3f& viewVec : viewVecs)
+            for (const eq::Range& range : ranges)
+            {
+                const float full = _getFullArea(viewVec, sliceDistance, range);
+                grid.classify(_createTransferFunction(0));
+                TEST(grid.getNumOccupied() == nBricks);
+                const float area =
+                    _testSlices(grid, viewVec, sliceDistance, range);
+                TESTINFO(std::abs(area - full) < full * 1e-4f,
+                         area << " != " << full);
+
+                grid.classify(sparse);
+                const float sparseArea =
+                    _testSlices(grid, viewVec, sliceDistance, range);
+                TESTINFO(sparseArea <= area, sparseArea << " > " << area);
+                if (brickSize == 4 && range == eq::Range::ALL)
+                {
+                    std::cout << "Slice area for view " << viewVec << ": "
+                              << sparseArea / full * 100.f << "%, "
+                              << grid.getNumOccupied() << " of " << nBricks
+                              << " bricks" << std::endl;
+                }
+            }
+    }
+    return EXIT_SUCCESS;
+}
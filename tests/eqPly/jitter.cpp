@@ -0,0 +1,201 @@
+
+/* Copyright (c) 2026, The Equalizer authors, see AUTHORS
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Tests the subpixel sample pattern and its convergence order used by the
+// idle anti-aliasing of eqPly, for subpixel compounds rendering one or more
+// samples per channel and frame.
+
+#include <lunchbox/test.h>
+
+#include <eqPly/jitter.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace eqPly;
+
+namespace
+{
+typedef std::vector<uint32_t> Samples;
+typedef std::vector<float> Values;
+
+/**
+ * Run the idle steps of all channels of a subpixel compound as the channels
+ * do, with the given samples per frame for each frame. The destination
+ * accumulates the average of each channel weighted by the samples of the
+ * frame, or with weight one if not weighted.
+ *
+ * @return the samples in their rendering order.
+ */
+Samples _run(const uint32_t nChannels, const Samples& samplesPerFrame,
+             const Values& values, float& result, const bool weighted = true)
+{
+    Samples samples;
+    float sum = 0.f;
+    uint32_t steps = 0;
+    int32_t step = jitter::nSamples;
+    for (size_t frame = 0; step > 0; ++frame)
+    {
+        const uint32_t perFrame =
+            samplesPerFrame[std::min(frame, samplesPerFrame.size() - 1)];
+        const uint32_t nFrame =
+            jitter::getFrameSamples(step, nChannels, perFrame);
+        TEST(nFrame > 0 && nFrame <= perFrame);
+
+        for (uint32_t i = 0; i < nChannels; ++i)
+        {
+            const eq::SubPixel subPixel(i, nChannels);
+            const uint32_t nLocal =
+                jitter::getNumSamples(step, subPixel, perFrame);
+
+            // all rendering channels render the same samples
+            TESTINFO(nLocal == 0 || nLocal == nFrame,
+                     nChannels << " channels, frame " << frame << ": "
+                               << nLocal << " != " << nFrame);
+            if (nLocal == 0)
+                continue;
+
+            float average = 0.f;
+            for (uint32_t j = 0; j < nLocal; ++j)
+            {
+                samples.push_back(jitter::getSample(step, j, subPixel));
+                average += values[samples.back()];
+            }
+            average /= float(nLocal);
+
+            const uint32_t weight = weighted ? nFrame : 1;
+            sum += average * float(weight);
+            steps += weight;
+        }
+        step -= int32_t(nChannels * nFrame);
+
+        // all samples of the previous frames form a prefix of the sequence
+        Samples sorted(samples);
+        std::sort(sorted.begin(), sorted.end());
+        for (size_t i = 0; i < sorted.size(); ++i)
+            TESTINFO(sorted[i] == i, nChannels << " channels, frame " << frame
+                                               << ": " << sorted[i]);
+    }
+    TESTINFO(samples.size() == jitter::nSamples,
+             nChannels << " channels: " << samples.size());
+    if (weighted)
+        TESTINFO(steps == jitter::nSamples,
+                 nChannels << " channels: " << steps << " steps");
+
+    result = sum / float(steps);
+    return samples;
+}
+
+/** @return the fraction of the pixel below the line y = a * x + b. */
+float _getCoverage(const float a, const float b)
+{
+    const size_t n = 1024;
+    size_t covered = 0;
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < n; ++j)
+            if ((float(j) + .5f) / n < a * (float(i) + .5f) / n + b)
+                ++covered;
+    return float(covered) / float(n * n);
+}
+
+/** @return the estimated coverage of the first nSamples samples. */
+float _estimateCoverage(const float a, const float b, const uint32_t nSamples)
+{
+    uint32_t covered = 0;
+    for (uint32_t i = 0; i < nSamples; ++i)
+    {
+        const eq::Vector2i cell = jitter::getCell(i);
+        const float x = (float(cell.x()) + .5f) / jitter::gridSize;
+        const float y = (float(cell.y()) + .5f) / jitter::gridSize;
+        if (y < a * x + b)
+            ++covered;
+    }
+    return float(covered) / float(nSamples);
+}
+}
+
+int main(int, char**)
+{
+    // each prefix of 4^k samples has one sample in each cell of a 2^k grid
+    for (uint32_t k = 0; k <= 4; ++k)
+    {
+        const uint32_t size = 1u << k;
+        std::vector<bool> used(size * size, false);
+        for (uint32_t i = 0; i < size * size; ++i)
+        {
+            const eq::Vector2i cell = jitter::getCell(i);
+            TEST(cell.x() >= 0 && cell.x() < int32_t(jitter::gridSize));
+            TEST(cell.y() >= 0 && cell.y() < int32_t(jitter::gridSize));
+
+            const uint32_t index = (cell.y() * size / jitter::gridSize) * size +
+                                   cell.x() * size / jitter::gridSize;
+            TESTINFO(!used[index], "sample " << i << " in used cell " << index
+                                             << " of " << size << "^2");
+            used[index] = true;
+        }
+    }
+
+    // all channels together render each sample exactly once, independent of
+    // the number of samples per frame, and the weighted accumulation converges
+    // to the image of one sample per frame
+    Values values(jitter::nSamples);
+    for (size_t i = 0; i < values.size(); ++i)
+        values[i] = .5f + .5f * std::sin(float(i * i) * .37f);
+
+    const Samples perFrames[] = {{1}, {2}, {3}, {16}, {1, 2, 4, 8, 8, 3}};
+    for (uint32_t nChannels = 1; nChannels <= 8; ++nChannels)
+    {
+        float expected = 0.f;
+        _run(nChannels, {1}, values, expected);
+        for (const Samples& perFrame : perFrames)
+        {
+            float result = 0.f;
+            _run(nChannels, perFrame, values, result);
+            TESTINFO(std::abs(result - expected) < 1e-5f,
+                     nChannels << " channels: " << result
+                               << " != " << expected);
+        }
+    }
+
+    // unweighted accumulation of the frame averages is biased
+    float expected = 0.f;
+    float unweighted = 0.f;
+    _run(3, {1}, values, expected);
+    _run(3, {16}, values, unweighted, false);
+    TESTINFO(std::abs(unweighted - expected) > 1e-3f,
+             unweighted << " == " << expected);
+
+    // stratified convergence: the error after 4^k samples is bound by the
+    // cells crossed by an edge
+    const float edges[][2] = {{0.f, .5f}, {1.f, 0.f}, {.3f, .4f}, {-2.f, 1.3f}};
+    for (const auto& edge : edges)
+    {
+        const float coverage = _getCoverage(edge[0], edge[1]);
+        for (uint32_t k = 1; k <= 4; ++k)
+        {
+            const uint32_t nSamples = 1u << (2 * k);
+            const float error =
+                std::abs(_estimateCoverage(edge[0], edge[1], nSamples) -
+                         coverage);
+            TESTINFO(error <= 2.f / float(1u << k),
+                     "y = " << edge[0] << "x + " << edge[1] << ": error "
+                            << error << " after " << nSamples << " samples");
+        }
+    }
+    return EXIT_SUCCESS;
+}
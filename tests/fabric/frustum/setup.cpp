@@ -0,0 +1,203 @@
+
+/* Copyright (c) 2026, The Equalizer authors, see AUTHORS
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <lunchbox/test.h>
+
+#include <eq/fabric/frustumSetup.h>
+#include <eq/fabric/renderContext.h>
+#include <eq/fabric/wall.h>
+
+#include <cmath>
+
+using namespace eq::fabric;
+
+// Tests the frusta computed from a wall description and their recomputation
+// for late-latched head positions, as done by the render clients. The expected
+// values are derived by hand from the frustum formulas of the server compound.
+
+namespace
+{
+const float epsilon = 0.0001f;
+const float nearPlane = .1f;
+const float farPlane = 100.f;
+const Vector3f eyeOffset(-.03f, 0.f, 0.f); // left eye relative to the head
+
+bool _equals(const Frustumf& a, const Frustumf& b)
+{
+    return std::abs(a.left() - b.left()) < epsilon &&
+           std::abs(a.right() - b.right()) < epsilon &&
+           std::abs(a.bottom() - b.bottom()) < epsilon &&
+           std::abs(a.top() - b.top()) < epsilon &&
+           std::abs(a.nearPlane() - b.nearPlane()) < epsilon &&
+           std::abs(a.farPlane() - b.farPlane()) < epsilon;
+}
+
+bool _equals(const Matrix4f& a, const Matrix4f& b)
+{
+    for (size_t i = 0; i < 16; ++i)
+        if (std::abs(a.array[i] - b.array[i]) >= epsilon)
+            return false;
+    return true;
+}
+
+Matrix4f _translate(const Vector3f& translation)
+{
+    Matrix4f matrix;
+    matrix.setTranslation(translation);
+    return matrix;
+}
+
+void _check(const RenderContext& context, const RenderContext& expected,
+            const Vector3f& head)
+{
+    TESTINFO(_equals(context.frustum, expected.frustum),
+             head << ": " << context.frustum << " != " << expected.frustum);
+    TESTINFO(_equals(context.ortho, expected.ortho),
+             head << ": " << context.ortho << " != " << expected.ortho);
+    TESTINFO(_equals(context.headTransform, expected.headTransform),
+             head << ": " << context.headTransform
+                  << " != " << expected.headTransform);
+    TESTINFO(_equals(context.orthoTransform, expected.orthoTransform),
+             head << ": " << context.orthoTransform
+                  << " != " << expected.orthoTransform);
+}
+
+/** Recompute a context for a new head matrix, as Channel does when drawing. */
+void _latch(const FrustumSetup& setup, const Matrix4f& head,
+            RenderContext& context)
+{
+    setup.compute(context, setup.getEyePosition(head, eyeOffset),
+                  setup.getEyePosition(head, Vector3f()), head.inverse());
+}
+
+/**
+ * @return the left eye context of the 1.6x1.0 wall one unit in front of the
+ *         origin, for a head translated to the given position.
+ */
+RenderContext _expectFixed(const Vector3f& head)
+{
+    // eye and cyclop eye in wall coordinates
+    const Vector3f eye(head.x() + eyeOffset.x(), head.y(), head.z() + 1.f);
+    const Vector3f cyclop(head.x(), head.y(), head.z() + 1.f);
+    const float ratio = nearPlane / eye.z();
+
+    RenderContext context;
+    context.frustum =
+        Frustumf((-.8f - eye.x()) * ratio, (.8f - eye.x()) * ratio,
+                 (-.5f - eye.y()) * ratio, (.5f - eye.y()) * ratio, nearPlane,
+                 farPlane);
+    context.ortho = Frustumf(-.8f - cyclop.x(), .8f - cyclop.x(),
+                             -.5f - cyclop.y(), .5f - cyclop.y(), nearPlane,
+                             farPlane);
+
+    // -trans(eye) * wall transform
+    context.headTransform = _translate(Vector3f(-eye.x(), -eye.y(), -head.z()));
+    context.orthoTransform = context.headTransform;
+    context.orthoTransform.array[8] += (cyclop.x() - eye.x()) / eye.z();
+    return context;
+}
+
+/** @return the left eye context of the same wall mounted to the head. */
+RenderContext _expectHMD(const Vector3f& head)
+{
+    const float ratio = nearPlane; // eye is one unit from the wall
+    const float eyeX = eyeOffset.x();
+
+    RenderContext context;
+    context.frustum = Frustumf((-.8f - eyeX) * ratio, (.8f - eyeX) * ratio,
+                               -.5f * ratio, .5f * ratio, nearPlane, farPlane);
+    context.ortho = Frustumf(-.8f, .8f, -.5f, .5f, nearPlane, farPlane);
+
+    // -trans(eye) * wall transform * inverse head
+    context.headTransform =
+        _translate(Vector3f(-eyeX - head.x(), -head.y(), -head.z()));
+    Matrix4f shear = _translate(Vector3f(-eyeX, 0.f, 0.f));
+    shear.array[8] = -eyeX;
+    context.orthoTransform = shear * _translate(-head);
+    return context;
+}
+}
+
+int main(int, char**)
+{
+    // 1.6x1.0 wall one unit in front of the origin
+    FrustumSetup setup;
+    setup.transform = _translate(Vector3f(0.f, 0.f, 1.f));
+    setup.destination = Vector2i(1600, 1000);
+    setup.width = 1.6f;
+    setup.height = 1.f;
+    TEST(!setup.isHMD());
+
+    RenderContext context;
+    context.frustum = Frustumf(-1.f, 1.f, -1.f, 1.f, 1.f, 100.f);
+    context.ortho = context.frustum;
+    setup.compute(context, Vector3f(), Vector3f(), Matrix4f());
+
+    // centered eye: symmetric frustum, eye at the wall origin
+    Frustumf expected(-.8f, .8f, -.5f, .5f, 1.f, 100.f);
+    TESTINFO(_equals(context.frustum, expected), context.frustum);
+    TESTINFO(_equals(context.ortho, expected), context.ortho);
+    TESTINFO(_equals(context.headTransform, Matrix4f()),
+             context.headTransform);
+
+    // off-axis eye: asymmetric frustum, eye translated to the origin
+    setup.compute(context, Vector3f(.4f, .25f, 0.f), Vector3f(), Matrix4f());
+    expected = Frustumf(-1.2f, .4f, -.75f, .25f, 1.f, 100.f);
+    TESTINFO(_equals(context.frustum, expected), context.frustum);
+    TESTINFO(_equals(context.headTransform,
+                     _translate(Vector3f(-.4f, -.25f, 0.f))),
+             context.headTransform);
+
+    // pixel and viewport decomposition
+    context.pixel = Pixel(1, 0, 2, 1);
+    context.vp = Viewport(.5f, 0.f, .5f, 1.f);
+    setup.compute(context, Vector3f(), Vector3f(), Matrix4f());
+    const float pixelWidth = 1.6f / 1600.f;
+    expected = Frustumf(pixelWidth * .5f, .8f + pixelWidth * .5f, -.5f, .5f,
+                        1.f, 100.f);
+    TESTINFO(_equals(context.frustum, expected), context.frustum);
+
+    // late latching: a context computed for the initial head position and
+    // recomputed for a newer one yields the frusta of the newer position
+    RenderContext initial;
+    initial.frustum = Frustumf(-1.f, 1.f, -1.f, 1.f, nearPlane, farPlane);
+    initial.ortho = initial.frustum;
+    _latch(setup, Matrix4f(), initial);
+    _check(initial, _expectFixed(Vector3f()), Vector3f());
+
+    Vector3f head(.1f, -.2f, .3f);
+    for (size_t i = 0; i < 50; ++i)
+    {
+        head += Vector3f(.01f, .005f, -.002f);
+        RenderContext latched = initial;
+        _latch(setup, _translate(head), latched);
+        _check(latched, _expectFixed(head), head);
+    }
+
+    // HMD walls move with the head: the frusta do not change, the head
+    // transforms follow the head matrix
+    setup.type = Wall::TYPE_HMD;
+    TEST(setup.isHMD());
+    _latch(setup, Matrix4f(), initial);
+    _check(initial, _expectHMD(Vector3f()), Vector3f());
+
+    RenderContext latched = initial;
+    _latch(setup, _translate(head), latched);
+    _check(latched, _expectHMD(head), head);
+
+    return EXIT_SUCCESS;
+}
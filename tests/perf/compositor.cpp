@@ -0,0 +1,495 @@
+
+/* Copyright (c) 2026, The Equalizer authors, see AUTHORS
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#define TEST_RUNTIME 1200 // seconds
+#include <lunchbox/test.h>
+
+#include <eq/compositor.h>
+#include <eq/image.h>
+#include <eq/imageOp.h>
+#include <eq/init.h>
+#include <eq/nodeFactory.h>
+#include <eq/pixelData.h>
+
+#include <lunchbox/clock.h>
+#include <pression/plugins/compressor.h>
+
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+// Benchmarks the CPU compositor and all compressor plugins using procedurally
+// generated color and depth images with a controlled coverage and noise.
+//
+// Usage: perf-compositor [--full] [--csv file] [--json file]
+// The default sweep is small enough to be run as a unit test, --full runs all
+// resolutions, source counts and coverages. Results are printed as CSV, one
+// record per measurement; --csv and --json additionally write them to the
+// given files for regression tracking.
+
+namespace
+{
+const size_t nRepeats = 5;
+
+struct Format
+{
+    const char* name;
+    uint32_t internalFormat;
+    uint32_t externalFormat;
+    uint32_t pixelSize;
+    bool composite; // supported by the CPU compositor
+};
+
+const Format colorFormats[] = {
+    {"RGBA8", EQ_COMPRESSOR_DATATYPE_RGBA, EQ_COMPRESSOR_DATATYPE_RGBA, 4,
+     true},
+    {"BGRA8", EQ_COMPRESSOR_DATATYPE_RGBA, EQ_COMPRESSOR_DATATYPE_BGRA, 4,
+     true},
+    {"RGBA16F", EQ_COMPRESSOR_DATATYPE_RGBA16F, EQ_COMPRESSOR_DATATYPE_RGBA16F,
+     8, false},
+    {"RGBA32F", EQ_COMPRESSOR_DATATYPE_RGBA32F, EQ_COMPRESSOR_DATATYPE_RGBA32F,
+     16, false}};
+
+const Format depthFormat = {"DEPTH", EQ_COMPRESSOR_DATATYPE_DEPTH,
+                            EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT, 4, true};
+
+struct Params
+{
+    eq::PixelViewport pvp;
+    size_t nSources;
+    const Format* format;
+    float coverage; // fraction of non-empty pixels
+    float noise;    // amplitude of per-pixel noise, 0..1
+};
+
+struct Record
+{
+    std::string operation;
+    std::string name;
+    Params params;
+    uint64_t bytes;
+    uint64_t outBytes;
+    float time; // minimum over all repetitions, ms
+};
+typedef std::vector<Record> Records;
+
+/** Deterministic random generator, independent of the platform rand(). */
+class Random
+{
+public:
+    explicit Random(const uint32_t seed)
+        : _state(seed * 2654435761u + 1u)
+    {
+    }
+    uint32_t next()
+    {
+        _state = _state * 1664525u + 1013904223u;
+        return _state;
+    }
+    float nextf() { return float(next() >> 8) / float(1u << 24); }
+private:
+    uint32_t _state;
+};
+
+// Each row has one contiguous non-empty span of coverage * width pixels,
+// which wobbles horizontally to produce compressible but non-trivial shapes.
+template <class T>
+void _fill(const Params& params, const uint32_t seed, T writePixel)
+{
+    Random random(seed);
+    const int32_t width = params.pvp.w;
+    const int32_t height = params.pvp.h;
+    const int32_t span = int32_t(params.coverage * width + .5f);
+    const float phase = random.nextf() * 6.28f;
+
+    for (int32_t y = 0; y < height; ++y)
+    {
+        const float wobble = .5f + .5f * std::sin(phase + y * 6.28f / height);
+        const int32_t start = int32_t(wobble * (width - span));
+        for (int32_t x = 0; x < width; ++x)
+        {
+            const bool empty = x < start || x >= start + span;
+            const float noise = params.noise * (random.nextf() - .5f);
+            writePixel(y * width + x, x, y, empty, noise);
+        }
+    }
+}
+
+void _setPixels(eq::Image& image, const eq::Frame::Buffer buffer,
+                const Format& format, const eq::PixelViewport& pvp,
+                const std::vector<uint8_t>& data)
+{
+    eq::PixelData pixels;
+    pixels.internalFormat = format.internalFormat;
+    pixels.externalFormat = format.externalFormat;
+    pixels.pixelSize = format.pixelSize;
+    pixels.pvp = pvp;
+    pixels.pixels = const_cast<uint8_t*>(data.data());
+    image.setPixelViewport(pvp);
+    image.setPixelData(buffer, pixels);
+}
+
+uint8_t _toByte(const float value)
+{
+    return uint8_t(LB_MIN(LB_MAX(value, 0.f), 1.f) * 255.f + .5f);
+}
+
+uint16_t _toHalf(const float value)
+{
+    // generated values are below two, no need for inf, nan or denormals
+    if (value < 6.2e-5f)
+        return 0;
+    uint32_t bits;
+    ::memcpy(&bits, &value, 4);
+    return uint16_t((((bits >> 23) - 112) << 10) | ((bits >> 13) & 0x3ff));
+}
+
+void _generateColor(eq::Image& image, const Params& params,
+                    const uint32_t seed, const bool premultiplied)
+{
+    const eq::PixelViewport& pvp = params.pvp;
+    const Format& format = *params.format;
+    std::vector<uint8_t> data(size_t(pvp.getArea()) * format.pixelSize);
+
+    _fill(params, seed, [&](const size_t i, const int32_t x, const int32_t y,
+                            const bool empty, const float noise) {
+        const float alpha = empty ? 0.f : .5f + .5f * (seed % 2);
+        float rgba[4] = {float(x) / pvp.w + noise, float(y) / pvp.h + noise,
+                         float(seed % 7) / 7.f + noise, alpha};
+        if (empty || premultiplied)
+            for (size_t j = 0; j < 3; ++j)
+                rgba[j] *= alpha;
+
+        switch (format.pixelSize)
+        {
+        case 4:
+            for (size_t j = 0; j < 4; ++j)
+                data[i * 4 + j] = _toByte(rgba[j]);
+            break;
+        case 8:
+            for (size_t j = 0; j < 4; ++j)
+            {
+                const uint16_t half = _toHalf(rgba[j]);
+                ::memcpy(&data[i * 8 + j * 2], &half, 2);
+            }
+            break;
+        case 16:
+            ::memcpy(&data[i * 16], rgba, 16);
+            break;
+        default:
+            LBUNIMPLEMENTED;
+        }
+    });
+    _setPixels(image, eq::Frame::Buffer::color, format, pvp, data);
+}
+
+void _generateDepth(eq::Image& image, const Params& params, const uint32_t seed)
+{
+    const eq::PixelViewport& pvp = params.pvp;
+    std::vector<uint8_t> data(size_t(pvp.getArea()) * 4);
+    uint32_t* depth = reinterpret_cast<uint32_t*>(data.data());
+
+    // a slanted plane per source, offset by the source index
+    const float offset = float(seed % 16) / 16.f;
+    _fill(params, seed, [&](const size_t i, const int32_t x, const int32_t y,
+                            const bool empty, const float noise) {
+        if (empty)
+        {
+            depth[i] = 0xffffffffu;
+            return;
+        }
+        const float z = .25f * (offset + float(x + y) / (pvp.w + pvp.h)) +
+                        .1f * noise + .25f;
+        depth[i] = uint32_t(LB_MIN(LB_MAX(z, 0.f), .999f) * 4294967295.f);
+    });
+    _setPixels(image, eq::Frame::Buffer::depth, depthFormat, pvp, data);
+}
+
+template <class F>
+float _measure(F func)
+{
+    lunchbox::Clock clock;
+    float best = std::numeric_limits<float>::max();
+    for (size_t i = 0; i < nRepeats; ++i)
+    {
+        clock.reset();
+        func();
+        best = LB_MIN(best, clock.getTimef());
+    }
+    return best;
+}
+
+void _benchmarkCompositor(const Params& params, Records& records)
+{
+    if (!params.format->composite)
+        return;
+
+    const size_t nSources = params.nSources;
+    std::vector<eq::Image> images(nSources);
+    const uint64_t colorBytes =
+        uint64_t(params.pvp.getArea()) * params.format->pixelSize;
+
+    // 2D: each source renders one vertical stripe of the destination
+    {
+        eq::ImageOps ops;
+        for (size_t i = 0; i < nSources; ++i)
+        {
+            Params stripe = params;
+            stripe.pvp.x = int32_t(params.pvp.w * i / nSources);
+            stripe.pvp.w =
+                int32_t(params.pvp.w * (i + 1) / nSources) - stripe.pvp.x;
+            _generateColor(images[i], stripe, uint32_t(i), false);
+
+            eq::ImageOp op;
+            op.image = &images[i];
+            op.buffers = eq::Frame::Buffer::color;
+            ops.push_back(op);
+        }
+        const float time = _measure([&] {
+            TEST(eq::Compositor::mergeImagesCPU(ops, false));
+        });
+        records.push_back({"composite", "2D", params, colorBytes, colorBytes,
+                           time});
+    }
+
+    // Pixel: each source renders every nSources-th column
+    {
+        eq::ImageOps ops;
+        for (size_t i = 0; i < nSources; ++i)
+        {
+            Params columns = params;
+            columns.pvp.x = 0;
+            columns.pvp.w = int32_t((params.pvp.w - i + nSources - 1) /
+                                    nSources);
+            images[i].reset();
+            _generateColor(images[i], columns, uint32_t(i), false);
+
+            eq::RenderContext context;
+            context.pixel = eq::Pixel(uint32_t(i), 0, uint32_t(nSources), 1);
+            images[i].setContext(context);
+
+            eq::ImageOp op;
+            op.image = &images[i];
+            op.buffers = eq::Frame::Buffer::color;
+            ops.push_back(op);
+        }
+        const float time = _measure([&] {
+            TEST(eq::Compositor::mergeImagesCPU(ops, false));
+        });
+        records.push_back({"composite", "pixel", params, colorBytes,
+                           colorBytes, time});
+    }
+
+    // DB: full-size color and depth images from all sources
+    {
+        eq::ImageOps ops;
+        for (size_t i = 0; i < nSources; ++i)
+        {
+            images[i].reset();
+            _generateColor(images[i], params, uint32_t(i), false);
+            _generateDepth(images[i], params, uint32_t(i));
+
+            eq::ImageOp op;
+            op.image = &images[i];
+            op.buffers = eq::Frame::Buffer::color | eq::Frame::Buffer::depth;
+            ops.push_back(op);
+        }
+        const float time = _measure([&] {
+            TEST(eq::Compositor::mergeImagesCPU(ops, false));
+        });
+        records.push_back({"composite", "DB", params,
+                           colorBytes * 2 * nSources, colorBytes * 2, time});
+    }
+
+    // Blend: premultiplied color-only images with alpha, back to front
+    {
+        eq::ImageOps ops;
+        for (size_t i = 0; i < nSources; ++i)
+        {
+            images[i].reset();
+            images[i].setAlphaUsage(true);
+            _generateColor(images[i], params, uint32_t(i), true);
+
+            eq::ImageOp op;
+            op.image = &images[i];
+            op.buffers = eq::Frame::Buffer::color;
+            ops.push_back(op);
+        }
+        const float time = _measure([&] {
+            TEST(eq::Compositor::mergeImagesCPU(ops, true));
+        });
+        records.push_back({"composite", "blend", params,
+                           colorBytes * nSources, colorBytes, time});
+    }
+}
+
+void _benchmarkCompressor(const Params& params, eq::Image& image,
+                          const eq::Frame::Buffer buffer, Records& records)
+{
+    eq::Image destImage;
+    const uint64_t size = image.getPixelDataSize(buffer);
+
+    for (const uint32_t name : image.findCompressors(buffer))
+    {
+        if (!image.allocCompressor(buffer, name))
+            continue;
+
+        std::ostringstream plugin;
+        plugin << "0x" << std::hex << name;
+
+        // force recompression for each measurement
+        const float compressTime = _measure([&] {
+            image.invalidateCompressedData(buffer);
+            image.compressPixelData(buffer);
+        });
+        const eq::PixelData& pixels = image.compressPixelData(buffer);
+        const uint64_t compressedSize =
+            pixels.compressedData.compressor == EQ_COMPRESSOR_NONE
+                ? size
+                : pixels.compressedData.getSize();
+
+        destImage.setPixelViewport(image.getPixelViewport());
+        const float decompressTime =
+            _measure([&] { destImage.setPixelData(buffer, pixels); });
+
+        Params bufferParams = params;
+        if (buffer == eq::Frame::Buffer::depth)
+            bufferParams.format = &depthFormat;
+        records.push_back({"compress", plugin.str(), bufferParams, size,
+                           compressedSize, compressTime});
+        records.push_back({"decompress", plugin.str(), bufferParams,
+                           compressedSize, size, decompressTime});
+    }
+}
+
+float _getThroughput(const Record& record)
+{
+    // MB/s of input data
+    return record.time > 0.f ? float(record.bytes) / 1048.576f / record.time
+                             : 0.f;
+}
+
+void _writeCSV(std::ostream& os, const Records& records)
+{
+    os << "operation,name,width,height,sources,format,coverage,noise,bytes,"
+       << "out_bytes,time_ms,mb_per_s" << std::endl;
+    for (const Record& r : records)
+        os << r.operation << ',' << r.name << ',' << r.params.pvp.w << ','
+           << r.params.pvp.h << ',' << r.params.nSources << ','
+           << r.params.format->name << ',' << r.params.coverage << ','
+           << r.params.noise << ',' << r.bytes << ',' << r.outBytes << ','
+           << r.time << ',' << _getThroughput(r) << std::endl;
+}
+
+void _writeJSON(std::ostream& os, const Records& records)
+{
+    os << "[" << std::endl;
+    for (Records::const_iterator i = records.begin(); i != records.end(); ++i)
+    {
+        const Record& r = *i;
+        os << "  { \"operation\": \"" << r.operation << "\", \"name\": \""
+           << r.name << "\", \"width\": " << r.params.pvp.w
+           << ", \"height\": " << r.params.pvp.h
+           << ", \"sources\": " << r.params.nSources << ", \"format\": \""
+           << r.params.format->name << "\", \"coverage\": " << r.params.coverage
+           << ", \"noise\": " << r.params.noise << ", \"bytes\": " << r.bytes
+           << ", \"out_bytes\": " << r.outBytes << ", \"time_ms\": " << r.time
+           << ", \"mb_per_s\": " << _getThroughput(r) << " }"
+           << (i + 1 == records.end() ? "" : ",") << std::endl;
+    }
+    os << "]" << std::endl;
+}
+}
+
+int main(int argc, char** argv)
+{
+    bool full = false;
+    std::string csvFile;
+    std::string jsonFile;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--full")
+            full = true;
+        else if (arg == "--csv" && i + 1 < argc)
+            csvFile = argv[++i];
+        else if (arg == "--json" && i + 1 < argc)
+            jsonFile = argv[++i];
+    }
+
+    eq::NodeFactory nodeFactory;
+    TEST(eq::init(0, 0, &nodeFactory));
+
+    std::vector<eq::PixelViewport> resolutions;
+    resolutions.push_back(eq::PixelViewport(0, 0, 640, 480));
+    std::vector<size_t> sources(1, 4);
+    std::vector<float> coverages(1, .5f);
+    std::vector<float> noises(1, .05f);
+    if (full)
+    {
+        resolutions.push_back(eq::PixelViewport(0, 0, 1920, 1080));
+        resolutions.push_back(eq::PixelViewport(0, 0, 3840, 2160));
+        sources = {2, 4, 8, 16};
+        coverages = {.1f, .25f, .5f, .75f, 1.f};
+        noises = {0.f, .05f, .25f};
+    }
+
+    Records records;
+    for (const eq::PixelViewport& pvp : resolutions)
+        for (const Format& format : colorFormats)
+            for (const float coverage : coverages)
+                for (const float noise : noises)
+                {
+                    Params params = {pvp, 1, &format, coverage, noise};
+
+                    eq::Image image;
+                    _generateColor(image, params, 0, false);
+                    _benchmarkCompressor(params, image,
+                                         eq::Frame::Buffer::color, records);
+                    if (format.composite) // depth once per resolution
+                    {
+                        _generateDepth(image, params, 0);
+                        if (&format == colorFormats)
+                            _benchmarkCompressor(params, image,
+                                                 eq::Frame::Buffer::depth,
+                                                 records);
+                    }
+
+                    for (const size_t nSources : sources)
+                    {
+                        params.nSources = nSources;
+                        _benchmarkCompositor(params, records);
+                    }
+                }
+
+    TEST(!records.empty());
+    _writeCSV(std::cout, records);
+
+    if (!csvFile.empty())
+    {
+        std::ofstream csv(csvFile.c_str());
+        _writeCSV(csv, records);
+    }
+    if (!jsonFile.empty())
+    {
+        std::ofstream json(jsonFile.c_str());
+        _writeJSON(json, records);
+    }
+
+    TEST(eq::exit());
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,348 @@
+
+/* Copyright (c) 2026, The Equalizer authors, see AUTHORS
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#define TEST_RUNTIME 600 // seconds
+#include <lunchbox/test.h>
+
+#include <eq/image.h>
+#include <eq/init.h>
+#include <eq/nodeFactory.h>
+#include <eq/pixelData.h>
+#include <eq/util/bufferPool.h>
+
+#include <lunchbox/clock.h>
+#include <pression/plugins/compressor.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <unistd.h>
+
+// Benchmarks the allocation of image memory for the viewport sequences of a
+// load-balanced 2D compound: each frame, the channel viewports move by a
+// random walk with occasional jumps, and the color, depth and compressed
+// buffers of all channels are reallocated. Compares malloc against the
+// eq::util::BufferPool, and measures Image::setPixelData using the pool.
+//
+// Usage: perf-imageAllocator [--full]
+// Reports the mean and 99th percentile latency of an allocation, including
+// the first write to each page, and the peak resident set size of each run.
+
+namespace
+{
+const size_t pageSize = 4096;
+
+/** Deterministic random generator, independent of the platform rand(). */
+class Random
+{
+public:
+    explicit Random(const uint32_t seed)
+        : _state(seed * 2654435761u + 1u)
+    {
+    }
+    uint32_t next()
+    {
+        _state = _state * 1664525u + 1013904223u;
+        return _state;
+    }
+    float nextf() { return float(next() >> 8) / float(1u << 24); }
+private:
+    uint32_t _state;
+};
+
+typedef std::vector<eq::PixelViewport> PVPs;
+typedef std::vector<PVPs> Frames;
+
+/**
+ * Vertical stripes of the destination, as assigned by a load equalizer. The
+ * splits drift by up to 2% per frame, and jump by up to 15% on one frame out
+ * of ten, e.g., when the model moves into another channel.
+ */
+Frames _generateFrames(const eq::PixelViewport& pvp, const size_t nChannels,
+                       const size_t nFrames)
+{
+    Random random(42);
+    std::vector<float> splits;
+    for (size_t i = 1; i < nChannels; ++i)
+        splits.push_back(float(i) / float(nChannels));
+
+    Frames frames(nFrames);
+    for (PVPs& pvps : frames)
+    {
+        for (float& split : splits)
+        {
+            const float range = random.nextf() < .1f ? .15f : .02f;
+            split += range * (2.f * random.nextf() - 1.f);
+            split = std::max(.01f, std::min(.99f, split));
+        }
+        std::sort(splits.begin(), splits.end());
+
+        int32_t x = 0;
+        for (size_t i = 0; i <= splits.size(); ++i)
+        {
+            const int32_t end = i == splits.size()
+                                    ? pvp.w
+                                    : int32_t(splits[i] * float(pvp.w));
+            pvps.push_back(eq::PixelViewport(x, 0, end - x, pvp.h));
+            x = end;
+        }
+    }
+    return frames;
+}
+
+size_t _getRSS()
+{
+    std::ifstream statm("/proc/self/statm");
+    size_t size = 0;
+    size_t resident = 0;
+    statm >> size >> resident;
+    return resident * size_t(::sysconf(_SC_PAGESIZE));
+}
+
+struct Result
+{
+    double mean; // ms
+    double p99;  // ms
+    size_t rss;  // peak during the run
+};
+
+Result _getResult(std::vector<double>& times, const size_t rss)
+{
+    Result result = {0., 0., rss};
+    if (times.empty())
+        return result;
+
+    for (const double time : times)
+        result.mean += time;
+    result.mean /= double(times.size());
+
+    std::sort(times.begin(), times.end());
+    result.p99 = times[times.size() * 99 / 100];
+    return result;
+}
+
+struct Malloc
+{
+    static void* alloc(const size_t size) { return ::malloc(size); }
+    static void free(void* buffer) { ::free(buffer); }
+    static void frameFinish() {}
+};
+
+struct Pool
+{
+    static void* alloc(const size_t size)
+    {
+        return eq::util::BufferPool::alloc(size);
+    }
+    static void free(void* buffer) { eq::util::BufferPool::free(buffer); }
+    static void frameFinish() { eq::util::BufferPool::trim(); }
+};
+
+/**
+ * Allocates color, depth and compressed color buffers for all channels of
+ * each frame. The buffers of a frame are released after the next frame has
+ * been allocated, as with a latency of one frame.
+ */
+template <class A>
+Result _benchmark(const Frames& frames)
+{
+    lunchbox::Clock clock;
+    Random random(7);
+    std::vector<double> times;
+    std::vector<void*> previous;
+    std::vector<void*> current;
+    size_t rss = 0;
+
+    for (const PVPs& pvps : frames)
+    {
+        for (const eq::PixelViewport& pvp : pvps)
+        {
+            const size_t size = size_t(pvp.getArea()) * 4;
+            const float ratio = .2f + .4f * random.nextf();
+            const size_t compressed = size_t(float(size) * ratio);
+            const size_t sizes[] = {size, size, compressed};
+            for (const size_t bytes : sizes)
+            {
+                clock.reset();
+                uint8_t* buffer = static_cast<uint8_t*>(A::alloc(bytes));
+                for (size_t i = 0; i < bytes; i += pageSize)
+                    buffer[i] = 0xff;
+                times.push_back(clock.getTimed());
+                current.push_back(buffer);
+            }
+        }
+        for (void* buffer : previous)
+            A::free(buffer);
+        rss = std::max(rss, _getRSS());
+        previous.swap(current);
+        current.clear();
+        A::frameFinish();
+    }
+    for (void* buffer : previous)
+        A::free(buffer);
+    A::frameFinish();
+    return _getResult(times, rss);
+}
+
+/** Reads back color and depth of each channel into a cached image. */
+Result _benchmarkImages(const Frames& frames, const size_t nChannels,
+                        const eq::PixelViewport& pvp)
+{
+    std::vector<uint8_t> data(size_t(pvp.getArea()) * 4, 0x7f);
+    std::vector<eq::Image> images(nChannels);
+    lunchbox::Clock clock;
+    std::vector<double> times;
+    size_t rss = 0;
+
+    eq::PixelData pixels;
+    pixels.pixels = data.data();
+    for (const PVPs& pvps : frames)
+    {
+        for (size_t i = 0; i < nChannels; ++i)
+        {
+            pixels.pvp = pvps[i];
+            images[i].setPixelViewport(pvps[i]);
+
+            clock.reset();
+            pixels.internalFormat = EQ_COMPRESSOR_DATATYPE_RGBA;
+            pixels.externalFormat = EQ_COMPRESSOR_DATATYPE_BGRA;
+            pixels.pixelSize = 4;
+            images[i].setPixelData(eq::Frame::Buffer::color, pixels);
+
+            pixels.internalFormat = EQ_COMPRESSOR_DATATYPE_DEPTH;
+            pixels.externalFormat = EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT;
+            images[i].setPixelData(eq::Frame::Buffer::depth, pixels);
+            times.push_back(clock.getTimed());
+        }
+        rss = std::max(rss, _getRSS());
+        eq::util::BufferPool::trim();
+    }
+    for (eq::Image& image : images)
+        image.flush();
+    return _getResult(times, rss);
+}
+
+void _print(const std::string& name, const Result& result)
+{
+    std::cout << std::setw(14) << name << " mean " << std::setw(9)
+              << result.mean * 1000. << " us, p99 " << std::setw(9)
+              << result.p99 * 1000. << " us, RSS " << std::setw(6)
+              << (result.rss >> 20) << " MB, pool cached " << std::setw(6)
+              << (eq::util::BufferPool::getCachedSize() >> 20) << " MB"
+              << std::endl;
+}
+
+void _testCapacity()
+{
+    TEST(eq::util::BufferPool::getCapacity(0) == 4096);
+    TEST(eq::util::BufferPool::getCapacity(4096) == 4096);
+    TEST(eq::util::BufferPool::getCapacity(4097) == 5120);
+    TEST(eq::util::BufferPool::getCapacity(1920 * 1080 * 4) == 8u << 20);
+
+    Random random(1);
+    for (size_t i = 0; i < 10000; ++i)
+    {
+        const size_t size = 4096 + (random.next() >> (random.next() % 32));
+        const size_t capacity = eq::util::BufferPool::getCapacity(size);
+        TESTINFO(capacity >= size && capacity * 4 <= size * 5 + 4,
+                 size << " -> " << capacity);
+    }
+}
+
+void _testAlignment()
+{
+    // small buffers come from the heap, large ones are mapped
+    std::vector<void*> buffers;
+    for (size_t size = 1; size < (64u << 20); size = size * 3 + 1)
+    {
+        void* buffer = eq::util::BufferPool::alloc(size);
+        TESTINFO(reinterpret_cast<uintptr_t>(buffer) % 64 == 0,
+                 size << ": " << buffer);
+        buffers.push_back(buffer);
+    }
+    for (void* buffer : buffers)
+        eq::util::BufferPool::free(buffer);
+}
+
+void _testTrim()
+{
+    const size_t size = 16u << 20;
+    void* buffer = eq::util::BufferPool::alloc(size);
+    TEST(eq::util::BufferPool::getUsedSize() >= size);
+    eq::util::BufferPool::trim();
+    eq::util::BufferPool::free(buffer);
+    TEST(eq::util::BufferPool::getCachedSize() >= size);
+
+    // the high-water mark keeps the buffer for the next frames
+    eq::util::BufferPool::trim();
+    TEST(eq::util::BufferPool::getCachedSize() >= size);
+
+    for (size_t i = 0; i < 16; ++i)
+        eq::util::BufferPool::trim();
+    TESTINFO(eq::util::BufferPool::getCachedSize() < size,
+             eq::util::BufferPool::getCachedSize());
+
+    // all nodes of a process trim the shared pool once per frame
+    buffer = eq::util::BufferPool::alloc(size);
+    eq::util::BufferPool::trim(1);
+    eq::util::BufferPool::free(buffer);
+    for (size_t i = 0; i < 32; ++i)
+        eq::util::BufferPool::trim(2);
+    TEST(eq::util::BufferPool::getCachedSize() >= size);
+
+    for (uint32_t i = 3; i < 20; ++i)
+        eq::util::BufferPool::trim(i);
+    TESTINFO(eq::util::BufferPool::getCachedSize() < size,
+             eq::util::BufferPool::getCachedSize());
+}
+}
+
+int main(int argc, char** argv)
+{
+    bool full = false;
+    for (int i = 1; i < argc; ++i)
+        if (std::string(argv[i]) == "--full")
+            full = true;
+
+    eq::NodeFactory nodeFactory;
+    TEST(eq::init(0, 0, &nodeFactory));
+
+    _testCapacity();
+    _testAlignment();
+    _testTrim();
+
+    const eq::PixelViewport pvp = full ? eq::PixelViewport(0, 0, 3840, 2160)
+                                       : eq::PixelViewport(0, 0, 1920, 1200);
+    const size_t nChannels = full ? 8 : 4;
+    const Frames frames = _generateFrames(pvp, nChannels, full ? 2000 : 200);
+
+    _print("malloc", _benchmark<Malloc>(frames));
+    _print("pool", _benchmark<Pool>(frames));
+    _print("setPixelData", _benchmarkImages(frames, nChannels, pvp));
+
+    TESTINFO(eq::util::BufferPool::getUsedSize() == 0,
+             eq::util::BufferPool::getUsedSize());
+    for (size_t i = 0; i < 17; ++i)
+        eq::util::BufferPool::trim();
+    TESTINFO(eq::util::BufferPool::getCachedSize() <= 8u << 20,
+             eq::util::BufferPool::getCachedSize());
+
+    TEST(eq::exit());
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,181 @@
+
+/* Copyright (c) 2026, The Equalizer authors, see AUTHORS
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Brings up a config of many render client processes on localhost, the first
+// of them never connecting back, and checks that the config initializes
+// without it within its launch timeout, well below the time of launching all
+// nodes one after another. The bring-up times of each node are logged by the
+// server.
+
+#include <eq/eq.h>
+#include <eq/server/global.h>
+#include <lunchbox/clock.h>
+#include <lunchbox/test.h>
+
+#include <fstream>
+
+namespace
+{
+const size_t nNodes = 16;
+const int32_t launchTimeout = 5000; // ms
+
+/**
+ * Write a config with one destination channel on each render client, and an
+ * optional first node whose launch command exits without connecting back.
+ */
+std::string _writeConfig(const std::string& name, const size_t nLive,
+                         const bool deadNode)
+{
+    const std::string filename =
+        std::string(EQ_TEST_BINARY_DIR) + "/" + name + ".eqc";
+    std::ofstream os(filename.c_str());
+    os << "#Equalizer 1.2 ascii" << std::endl
+       << "global" << std::endl
+       << "{" << std::endl
+       << "    EQ_WINDOW_IATTR_HINT_DRAWABLE FBO" << std::endl
+       << "    EQ_NODE_SATTR_LAUNCH_COMMAND \"%c\"" << std::endl
+       << "    EQ_NODE_IATTR_LAUNCH_TIMEOUT " << launchTimeout << std::endl
+       << "}" << std::endl
+       << "server" << std::endl
+       << "{" << std::endl
+       << "    connection { hostname \"127.0.0.1\" }" << std::endl
+       << "    config" << std::endl
+       << "    {" << std::endl
+       << "        name \"" << name << "\"" << std::endl
+       << "        appNode { connection { hostname \"127.0.0.1\" }}"
+       << std::endl;
+
+    const size_t nTotal = deadNode ? nLive + 1 : nLive;
+    for (size_t i = 0; i < nTotal; ++i)
+    {
+        os << "        node" << std::endl
+           << "        {" << std::endl
+           << "            name \"node" << i << "\"" << std::endl
+           << "            connection { hostname \"127.0.0.1\" }" << std::endl;
+        if (deadNode && i == 0) // launched, but exits without connecting
+            os << "            attributes { launch_command \"true\" }"
+               << std::endl;
+        os << "            pipe { window { channel { name \"channel" << i
+           << "\" }}}" << std::endl
+           << "        }" << std::endl;
+    }
+
+    for (size_t i = 0; i < nTotal; ++i)
+        os << "        compound" << std::endl
+           << "        {" << std::endl
+           << "            channel \"channel" << i << "\"" << std::endl
+           << "            wall" << std::endl
+           << "            {" << std::endl
+           << "                bottom_left  [ -.32 -.20 -.75 ]" << std::endl
+           << "                bottom_right [  .32 -.20 -.75 ]" << std::endl
+           << "                top_left     [ -.32  .20 -.75 ]" << std::endl
+           << "            }" << std::endl
+           << "        }" << std::endl;
+
+    os << "    }" << std::endl << "}" << std::endl;
+    return filename;
+}
+
+/** @return the time in ms to initialize the given config. */
+float _bringUp(eq::ClientPtr client, const std::string& filename,
+               const size_t nConfigNodes)
+{
+    eq::Global::setConfig(filename);
+    eq::ServerPtr server = new eq::Server;
+    TEST(client->connectServer(server));
+
+    eq::fabric::ConfigParams configParams;
+    eq::Config* config = server->chooseConfig(configParams);
+    TEST(config);
+    TEST(config->getNodes().size() == nConfigNodes);
+
+    lunchbox::Clock clock;
+    TEST(config->init(eq::uint128_t()));
+    const float time = clock.getTimef();
+
+    for (size_t i = 0; i < 10; ++i)
+    {
+        config->startFrame(eq::uint128_t());
+        config->finishFrame();
+    }
+    config->finishAllFrames();
+
+    TEST(config->exit());
+    server->releaseConfig(config);
+    client->disconnectServer(server);
+    return time;
+}
+
+bool _checkGPU(eq::ClientPtr client)
+{
+    eq::Global::setConfig("configs/config.eqc");
+    eq::ServerPtr server = new eq::Server;
+    TEST(client->connectServer(server));
+
+    eq::fabric::ConfigParams configParams;
+    eq::Config* config = server->chooseConfig(configParams);
+    const bool ok = config && config->init(eq::uint128_t());
+    if (ok)
+        config->exit();
+    if (config)
+        server->releaseConfig(config);
+    client->disconnectServer(server);
+
+    if (!ok)
+        std::cerr << "Can't get configuration - no GPU available?" << std::endl;
+    return ok;
+}
+}
+
+int main(const int argc, char** argv)
+{
+    // launched render clients run the client loop in initLocal and exit
+    eq::NodeFactory nodeFactory;
+    TEST(eq::init(argc, argv, &nodeFactory));
+
+    eq::ClientPtr client = new eq::Client;
+    client->addConnectionDescription(new co::ConnectionDescription);
+    TEST(client->initLocal(argc, argv));
+
+    if (_checkGPU(client))
+    {
+        eq::server::Global::instance()->setConfigIAttribute(
+            eq::server::Config::IATTR_ROBUSTNESS, eq::ON);
+
+        // the time of one launch, the config also has the app node
+        const float single =
+            _bringUp(client, _writeConfig("bringUpSingle", 1, false), 2);
+
+        const float time =
+            _bringUp(client, _writeConfig("bringUp", nNodes, true), nNodes + 2);
+        std::cout << "Brought up " << nNodes << " render clients in " << time
+                  << " ms, one in " << single << " ms" << std::endl;
+
+        // The unreachable first node delays the bring-up only by its own
+        // launch timeout, the other nodes are launched and connected while it
+        // is waited for. Launching the nodes one after another would take the
+        // timeout plus nNodes single launches.
+        const float serial = launchTimeout + nNodes * single;
+        TESTINFO(time < launchTimeout + .25f * nNodes * single,
+                 time << " ms, serial " << serial << " ms");
+    }
+
+    client->exitLocal();
+    TESTINFO(client->getRefCount() == 1, client);
+    TEST(eq::exit());
+    return EXIT_SUCCESS;
+}
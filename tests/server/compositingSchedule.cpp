@@ -0,0 +1,165 @@
+
+/* Copyright (c) 2026, The Equalizer authors, see AUTHORS
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Simulates binary-swap and radix-k compositing on the CPU and compares the
+// result against a direct depth merge of all source images.
+
+#include <eq/server/compositingSchedule.h>
+#include <lunchbox/test.h>
+
+#include <cstdlib>
+
+using eq::server::CompositingSchedule;
+
+namespace
+{
+const size_t width = 7;
+const size_t height = 97;
+const size_t nPixels = width * height;
+
+struct Image
+{
+    Image()
+        : color(nPixels, 0)
+        , depth(nPixels, 0xffffffffu)
+    {
+    }
+
+    std::vector<uint32_t> color;
+    std::vector<uint32_t> depth;
+};
+typedef std::vector<Image> Images;
+
+size_t _getRow(const uint32_t y)
+{
+    return size_t(uint64_t(y) * height / CompositingSchedule::UNIT);
+}
+
+// depth-composite the given stripe of source into dest
+void _merge(Image& dest, const Image& source,
+            const CompositingSchedule::Region& region)
+{
+    for (size_t i = _getRow(region.start) * width;
+         i < _getRow(region.end) * width; ++i)
+    {
+        if (source.depth[i] < dest.depth[i])
+        {
+            dest.depth[i] = source.depth[i];
+            dest.color[i] = source.color[i];
+        }
+    }
+}
+
+Images _generate(const size_t nSources)
+{
+    Images images(nSources);
+    for (size_t i = 0; i < nSources; ++i)
+    {
+        Image& image = images[i];
+        for (size_t j = 0; j < nPixels; ++j)
+        {
+            if (::rand() % 3 == 0) // empty
+                continue;
+
+            // unique depth values for a well-defined merge result
+            image.depth[j] = uint32_t(::rand() % 1000) * 64 + uint32_t(i);
+            image.color[j] = uint32_t(::rand());
+        }
+    }
+    return images;
+}
+
+void _test(const size_t nSources, const CompositingSchedule::Radices& radices)
+{
+    const CompositingSchedule schedule(nSources, radices);
+    const Images sources = _generate(nSources);
+
+    Image reference;
+    for (const Image& source : sources)
+        _merge(reference, source, CompositingSchedule::Region());
+
+    // each round reads from the images composited in the previous round
+    Images images = sources;
+    for (size_t round = 0; round < schedule.getNumRounds(); ++round)
+    {
+        const Images previous = images;
+        for (const CompositingSchedule::Transfer& transfer :
+             schedule.getTransfers(round))
+        {
+            TEST(transfer.from != transfer.to);
+            TEST(transfer.region == schedule.getRegion(round, transfer.to));
+            _merge(images[transfer.to], previous[transfer.from],
+                   transfer.region);
+        }
+    }
+
+    // final stripes partition the image
+    std::vector<size_t> coverage(CompositingSchedule::UNIT, 0);
+    Image result;
+    for (size_t i = 0; i < nSources; ++i)
+    {
+        const CompositingSchedule::Region& region = schedule.getRegion(i);
+        TESTINFO(region.start <= region.end, region);
+        for (uint32_t y = region.start; y < region.end; ++y)
+            ++coverage[y];
+
+        // color-only assembly on the destination
+        for (size_t j = _getRow(region.start) * width;
+             j < _getRow(region.end) * width; ++j)
+        {
+            result.color[j] = images[i].color[j];
+        }
+    }
+
+    for (size_t y = 0; y < coverage.size(); ++y)
+        TESTINFO(coverage[y] == 1, nSources << " sources, y " << y);
+    TESTINFO(result.color == reference.color, nSources << " sources");
+
+    // each source received one transfer per peer and round
+    size_t nTransfers = 0;
+    for (size_t round = 0; round < schedule.getNumRounds(); ++round)
+        nTransfers += schedule.getTransfers(round).size();
+
+    size_t expected = 0;
+    for (const size_t radix : radices)
+        expected += nSources * (radix - 1);
+    TESTINFO(nTransfers == expected, nTransfers << " != " << expected);
+}
+}
+
+int main(int, char**)
+{
+    ::srand(42);
+
+    const CompositingSchedule::Radices bs8 =
+        CompositingSchedule::getBinarySwapRadices(8);
+    TEST(bs8 == CompositingSchedule::Radices(3, 2));
+
+    const CompositingSchedule::Radices rk16 =
+        CompositingSchedule::getRadixKRadices(16, 4);
+    TEST(rk16 == CompositingSchedule::Radices(2, 4));
+
+    for (size_t n = 1; n <= 24; ++n)
+    {
+        _test(n, CompositingSchedule::getBinarySwapRadices(n));
+        _test(n, CompositingSchedule::getRadixKRadices(n, 4));
+        _test(n, CompositingSchedule::getRadixKRadices(n, 8));
+        _test(n, CompositingSchedule::Radices(1, n)); // direct send
+    }
+
+    return EXIT_SUCCESS;
+}
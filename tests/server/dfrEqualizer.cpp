@@ -0,0 +1,505 @@
+
+/* Copyright (c) 2026, The Equalizer authors, see AUTHORS
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Tests the region-varying mode of the DFR equalizer: the decomposition into
+// nested regions, the focus point and the zoom controller, replayed against
+// synthetic per-region frame time traces without rendering. Also checks that
+// the mode is only used when configured, and that it round-trips through the
+// config file format.
+
+#include <eq/server/channel.h>
+#include <eq/server/compound.h>
+#include <eq/server/compoundUpdateActivateVisitor.h>
+#include <eq/server/config.h>
+#include <eq/server/configVisitor.h>
+#include <eq/server/equalizers/dfrEqualizer.h>
+#include <eq/server/global.h>
+#include <eq/server/loader.h>
+#include <eq/server/server.h>
+#include <eq/fabric/wall.h>
+#include <lunchbox/init.h>
+#include <lunchbox/test.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <sstream>
+
+using eq::Matrix4f;
+using eq::Vector2f;
+using eq::server::DFREqualizer;
+using eq::fabric::Viewport;
+using eq::fabric::Viewports;
+using eq::fabric::Wall;
+typedef DFREqualizer::Region Region;
+typedef DFREqualizer::Regions Regions;
+
+namespace
+{
+const float epsilon = 0.0001f;
+const float budget = 1000.f / 30.f;
+const float damping = .5f;
+const float falloff = .5f;
+const size_t nFrames = 600;
+
+/** Deterministic jitter in [-amplitude, amplitude]. */
+class Random
+{
+public:
+    Random()
+        : _state(42)
+    {
+    }
+
+    float operator()(const float amplitude)
+    {
+        _state = _state * 1664525u + 1013904223u;
+        return amplitude * (float(_state >> 8) / float(1u << 23) - 1.f);
+    }
+
+private:
+    uint32_t _state;
+};
+
+float _getOverlap(const Viewport& a, const Viewport& b)
+{
+    const float w = std::min(a.x + a.w, b.x + b.w) - std::max(a.x, b.x);
+    const float h = std::min(a.y + a.h, b.y + b.h) - std::max(a.y, b.y);
+    return w > 0.f && h > 0.f ? w * h : 0.f;
+}
+
+void _testViewports(const Vector2f& focus, const size_t nRegions)
+{
+    const Viewports viewports =
+        DFREqualizer::computeViewports(focus, nRegions);
+    TEST(viewports.size() == 1 + (nRegions - 1) * 4);
+
+    float area = 0.f;
+    for (size_t i = 0; i < viewports.size(); ++i)
+    {
+        const Viewport& vp = viewports[i];
+        TESTINFO(vp.isValid(), vp);
+        TESTINFO(vp.x + vp.w <= 1.f + epsilon && vp.y + vp.h <= 1.f + epsilon,
+                 vp);
+        area += vp.getArea();
+        for (size_t j = i + 1; j < viewports.size(); ++j)
+            TESTINFO(_getOverlap(vp, viewports[j]) < epsilon,
+                     vp << " " << viewports[j]);
+    }
+    TESTINFO(std::abs(area - 1.f) < epsilon, area);
+
+    // the innermost region contains the focus
+    const Viewport& fovea = viewports.front();
+    const float size = std::pow(.5f, float(nRegions - 1));
+    TESTINFO(std::abs(fovea.w - size) < epsilon, fovea);
+    TESTINFO(fovea.x <= focus.x() && fovea.x + fovea.w >= focus.x(), fovea);
+    TESTINFO(fovea.y <= focus.y() && fovea.y + fovea.h >= focus.y(), fovea);
+}
+
+Matrix4f _getHead(const float x, const float y, const float angle)
+{
+    // rotation around the y axis, translation in x and y
+    Matrix4f head;
+    head.array[0] = std::cos(angle);
+    head.array[2] = -std::sin(angle);
+    head.array[8] = std::sin(angle);
+    head.array[10] = std::cos(angle);
+    head.array[12] = x;
+    head.array[13] = y;
+    return head;
+}
+
+void _testFocus(const Matrix4f& head, const Vector2f& expected)
+{
+    const Vector2f focus = DFREqualizer::computeFocus(Wall(), head);
+    TESTINFO((focus - expected).length() < epsilon, focus << " != "
+                                                          << expected);
+}
+
+/** Regions of a full HD destination, centered. */
+Regions _getRegions(const size_t nRegions)
+{
+    const Viewports viewports =
+        DFREqualizer::computeViewports(Vector2f(.5f, .5f), nRegions);
+    Regions regions(nRegions);
+    for (size_t i = 0; i < viewports.size(); ++i)
+    {
+        Region& region = regions[i == 0 ? 0 : 1 + (i - 1) / 4];
+        region.pixels += viewports[i].getArea() * 1920.f * 1080.f;
+        region.minZoom = 128.f / 1080.f;
+        region.maxZoom = 1.f;
+    }
+    return regions;
+}
+
+/** The isotropic zoom rendering all pixels within the budget. */
+float _getIsotropicZoom(const Regions& regions, const float cost)
+{
+    float pixels = 0.f;
+    for (const Region& region : regions)
+        pixels += region.pixels;
+    return std::min(std::sqrt(budget / (cost * pixels)), 1.f);
+}
+
+/**
+ * Replay a per-pixel cost trace: the frame rendered with the current zooms
+ * reports its time one frame later, as with the real statistics latency.
+ */
+void _replay(const size_t nRegions)
+{
+    Regions regions = _getRegions(nRegions);
+    Random random;
+
+    // 40 ms at full resolution, doubling in the middle of the trace
+    const float baseCost = 40.f / (1920.f * 1080.f);
+    std::vector<float> lastTimes(nRegions, 0.f);
+    Region steady[2];
+    Region spike[2];
+
+    for (size_t frame = 0; frame < nFrames; ++frame)
+    {
+        const bool loaded = frame >= 200 && frame < 400;
+        const float cost = baseCost * (loaded ? 2.f : 1.f);
+
+        for (size_t i = 0; i < nRegions; ++i)
+            regions[i].time = lastTimes[i];
+        DFREqualizer::adapt(regions, budget, damping, falloff);
+
+        for (size_t i = 0; i < nRegions; ++i)
+        {
+            Region& region = regions[i];
+            TESTINFO(region.zoom >= region.minZoom - epsilon &&
+                         region.zoom <= region.maxZoom + epsilon,
+                     region.zoom);
+            if (i > 0)
+                TESTINFO(region.zoom <= regions[i - 1].zoom + epsilon,
+                         frame << ": " << region.zoom << " > "
+                               << regions[i - 1].zoom);
+            lastTimes[i] = cost * region.pixels * region.zoom * region.zoom *
+                           (1.f + random(.05f));
+        }
+
+        // settled: the frame time matches the budget
+        if (frame % 200 > 50)
+        {
+            float time = 0.f;
+            for (const float t : lastTimes)
+                time += t;
+            TESTINFO(std::abs(time - budget) < budget * .1f,
+                     frame << ": " << time << " ms");
+        }
+
+        if (frame == 199)
+        {
+            steady[0] = regions.front();
+            steady[1] = regions.back();
+        }
+        if (frame == 399)
+        {
+            spike[0] = regions.front();
+            spike[1] = regions.back();
+        }
+    }
+
+    const float isotropic = _getIsotropicZoom(regions, baseCost);
+    const float isotropicSpike = _getIsotropicZoom(regions, baseCost * 2.f);
+    std::cout << nRegions << " regions: zoom " << steady[0].zoom << ".."
+              << steady[1].zoom << ", " << spike[0].zoom << ".."
+              << spike[1].zoom << " under load, isotropic " << isotropic
+              << ", " << isotropicSpike << std::endl;
+
+    // the periphery absorbs the load, the fovea keeps a higher resolution
+    // than an isotropic zoom
+    TEST(spike[1].zoom < steady[1].zoom);
+    TEST(spike[0].zoom <= steady[0].zoom);
+    if (nRegions > 1)
+    {
+        TEST(steady[0].zoom > isotropic);
+        TEST(spike[0].zoom > isotropicSpike);
+    }
+    else
+    {
+        TEST(std::abs(steady[0].zoom - isotropic) < .05f);
+        TEST(std::abs(spike[0].zoom - isotropicSpike) < .05f);
+    }
+}
+}
+
+namespace
+{
+/** Finds the DFR compound and marks all channels as running. */
+class Setup : public eq::server::ConfigVisitor
+{
+public:
+    Setup()
+        : compound(0)
+        , equalizer(0)
+    {
+    }
+
+    eq::server::VisitorResult visit(eq::server::Channel* channel) override
+    {
+        channel->setState(eq::server::STATE_RUNNING);
+        return eq::server::TRAVERSE_CONTINUE;
+    }
+
+    eq::server::VisitorResult visit(eq::server::Compound* compound_) override
+    {
+        for (eq::server::Equalizer* candidate : compound_->getEqualizers())
+        {
+            DFREqualizer* dfr = dynamic_cast<DFREqualizer*>(candidate);
+            if (!dfr)
+                continue;
+            compound = compound_;
+            equalizer = dfr;
+        }
+        return eq::server::TRAVERSE_CONTINUE;
+    }
+
+    eq::server::Compound* compound;
+    DFREqualizer* equalizer;
+};
+
+std::string _write(const eq::server::Equalizer* equalizer)
+{
+    std::ostringstream os;
+    os << equalizer;
+    return os.str();
+}
+
+/**
+ * @return a config with a DFR equalizer on a non-leaf compound with the given
+ *         number of children, the first of them on the destination channel.
+ */
+std::string _getConfig(const std::string& equalizer, const size_t nChildren)
+{
+    std::ostringstream os;
+    os << "server { config { appNode { pipe {"
+       << " window { channel { name \"channel\" }}";
+    for (size_t i = 1; i < nChildren; ++i)
+        os << " window { channel { name \"source" << i << "\" }}";
+    os << " }}"
+       << " compound { channel \"channel\""
+       << "  compound { " << equalizer;
+    for (size_t i = 0; i < nChildren; ++i)
+    {
+        const float width = 1.f / float(nChildren);
+        os << "   compound { ";
+        if (i > 0)
+            os << "channel \"source" << i << "\" outputframe {} ";
+        os << "viewport [ " << width * i << " 0 " << width << " 1 ] }";
+    }
+    os << "  }";
+    for (size_t i = 1; i < nChildren; ++i)
+        os << "  inputframe { name \"frame.source" << i << "\" }";
+    os << " }}}";
+    return os.str();
+}
+
+/**
+ * Run one frame of the DFR equalizer of the given config.
+ * @return the viewports of the children of the DFR compound.
+ */
+Viewports _runConfig(const std::string& equalizer, const size_t nChildren,
+                     const bool regions, const float falloff_)
+{
+    eq::server::Loader loader;
+    eq::server::ServerPtr server =
+        loader.parseServer(_getConfig(equalizer, nChildren).c_str());
+    TEST(server);
+    TEST(server->getConfigs().size() == 1);
+
+    Setup setup;
+    server->getConfigs().front()->accept(setup);
+    TEST(setup.equalizer);
+    TEST(setup.equalizer->getRegions() == regions);
+    TEST(setup.equalizer->getFalloff() == falloff_);
+
+    // written as parsed
+    const std::string written = _write(setup.equalizer);
+    TESTINFO((written.find("regions ON") != std::string::npos) == regions,
+             written);
+    TESTINFO((written.find("falloff") != std::string::npos) ==
+                 (falloff_ != .5f),
+             written);
+
+    eq::server::Compound* root = setup.compound->getParent();
+    TEST(root);
+    root->activate(eq::fabric::EYE_CYCLOP);
+    eq::server::CompoundUpdateActivateVisitor updater(1);
+    root->accept(updater);
+    TEST(setup.compound->isActive());
+    setup.equalizer->notifyUpdatePre(setup.compound, 1);
+
+    Viewports viewports;
+    for (const eq::server::Compound* child : setup.compound->getChildren())
+    {
+        viewports.push_back(child->getViewport());
+        // only the region mode zooms the children
+        TEST(regions || child->getZoom() == eq::fabric::Zoom::NONE);
+    }
+
+    root->deactivate(eq::fabric::EYE_CYCLOP);
+    eq::server::Global::clear();
+    server->deleteConfigs(); // break server <-> config ref circle
+    return viewports;
+}
+
+void _testConfig()
+{
+    // default: the compound is zoomed, the viewports of the children are left
+    // to the other equalizers
+    const std::string isotropic = "DFR_equalizer { framerate 15 }";
+    Viewports viewports = _runConfig(isotropic, 2, false, .5f);
+    TEST(viewports.size() == 2);
+    TESTINFO(viewports[0] == Viewport(0.f, 0.f, .5f, 1.f), viewports[0]);
+    TESTINFO(viewports[1] == Viewport(.5f, 0.f, .5f, 1.f), viewports[1]);
+    viewports = _runConfig(isotropic, 4, false, .5f);
+    for (size_t i = 0; i < viewports.size(); ++i)
+        TEST(std::abs(viewports[i].w - .25f) < epsilon);
+
+    // region mode, and its round-trip through the config file format
+    const std::string regions =
+        "DFR_equalizer { framerate 15 regions ON falloff .25 }";
+    const Viewports expected =
+        DFREqualizer::computeViewports(Vector2f(.5f, .5f), 2);
+    viewports = _runConfig(regions, 5, true, .25f);
+    TEST(viewports == expected);
+
+    eq::server::Loader loader;
+    eq::server::ServerPtr server =
+        loader.parseServer(_getConfig(regions, 5).c_str());
+    TEST(server);
+    Setup setup;
+    server->getConfigs().front()->accept(setup);
+    const std::string written = _write(setup.equalizer);
+    eq::server::Global::clear();
+    server->deleteConfigs();
+
+    viewports = _runConfig(written, 5, true, .25f);
+    TEST(viewports == expected);
+}
+}
+
+int main(int argc, char** argv)
+{
+    TEST(lunchbox::init(argc, argv));
+    _testConfig();
+
+    // viewports
+    TEST(DFREqualizer::computeViewports(Vector2f(.5f, .5f), 0).empty());
+    const Viewports single =
+        DFREqualizer::computeViewports(Vector2f(.5f, .5f), 1);
+    TEST(single.size() == 1 && single.front() == Viewport::FULL);
+
+    Random random;
+    for (size_t i = 0; i < 100; ++i)
+    {
+        const Vector2f focus(.5f + random(.5f), .5f + random(.5f));
+        _testViewports(focus, 1 + i % 4);
+    }
+    _testViewports(Vector2f(0.f, 0.f), 3);
+    _testViewports(Vector2f(1.f, 1.f), 3);
+
+    // focus on the default 1.6x1.0 wall one unit in front of the origin
+    _testFocus(Matrix4f(), Vector2f(.5f, .5f));
+    _testFocus(_getHead(.4f, .25f, 0.f), Vector2f(.75f, .75f));
+    _testFocus(_getHead(0.f, 0.f, std::atan(.4f)), Vector2f(.25f, .5f));
+    _testFocus(_getHead(2.f, 0.f, 0.f), Vector2f(1.f, .5f));
+    _testFocus(_getHead(0.f, 0.f, float(M_PI)), Vector2f(.5f, .5f));
+
+    // zooms: unknown times keep the current zoom
+    Regions regions = _getRegions(3);
+    std::vector<float> zooms =
+        DFREqualizer::computeZooms(regions, budget, falloff);
+    for (const float zoom : zooms)
+        TEST(zoom == 1.f);
+
+    // cheap regions render at full resolution
+    for (Region& region : regions)
+        region.time = 1.f;
+    zooms = DFREqualizer::computeZooms(regions, budget, falloff);
+    for (const float zoom : zooms)
+        TEST(zoom == 1.f);
+
+    // expensive regions fall off from the fovea and fill the budget
+    for (Region& region : regions)
+        region.time = 40.f;
+    zooms = DFREqualizer::computeZooms(regions, budget, falloff);
+    float time = 0.f;
+    for (size_t i = 0; i < regions.size(); ++i)
+    {
+        time += regions[i].time * zooms[i] * zooms[i];
+        if (i > 0)
+            TEST(std::abs(zooms[i] - zooms[i - 1] * falloff) < epsilon);
+    }
+    TESTINFO(std::abs(time - budget) < budget * .01f, time);
+
+    // overloaded regions are clamped to the minimum zoom
+    for (Region& region : regions)
+        region.time = 1e6f;
+    zooms = DFREqualizer::computeZooms(regions, budget, falloff);
+    for (size_t i = 0; i < regions.size(); ++i)
+        TEST(std::abs(zooms[i] - regions[i].minZoom) < epsilon);
+
+    // parallel pipes: the slowest pipe fills the budget, which allows higher
+    // zooms than rendering all regions on one pipe
+    for (Region& region : regions)
+        region.time = 40.f;
+    const std::vector<float> onePipe =
+        DFREqualizer::computeZooms(regions, budget, falloff);
+    for (size_t i = 0; i < regions.size(); ++i)
+    {
+        Region& region = regions[i];
+        region.pipePixels.assign(1 + (regions.size() - 1) * 4, 0.f);
+        if (i == 0)
+            region.pipePixels[0] = region.pixels;
+        else
+            for (size_t j = 0; j < 4; ++j)
+                region.pipePixels[1 + (i - 1) * 4 + j] = region.pixels * .25f;
+    }
+    zooms = DFREqualizer::computeZooms(regions, budget, falloff);
+    std::vector<float> pipeTimes(regions.front().pipePixels.size(), 0.f);
+    for (size_t i = 0; i < regions.size(); ++i)
+    {
+        const Region& region = regions[i];
+        TEST(zooms[i] > onePipe[i]);
+        for (size_t j = 0; j < pipeTimes.size(); ++j)
+            pipeTimes[j] += region.time * region.pipePixels[j] /
+                            region.pixels * zooms[i] * zooms[i];
+    }
+    const float maxTime = *std::max_element(pipeTimes.begin(),
+                                            pipeTimes.end());
+    TESTINFO(std::abs(maxTime - budget) < budget * .01f, maxTime);
+
+    // regions sharing one pipe are rendered one after another
+    for (Region& region : regions)
+        region.pipePixels.assign(1, region.pixels);
+    zooms = DFREqualizer::computeZooms(regions, budget, falloff);
+    for (size_t i = 0; i < regions.size(); ++i)
+        TEST(std::abs(zooms[i] - onePipe[i]) < epsilon);
+    for (Region& region : regions)
+        region.pipePixels.clear();
+
+    // controller replay
+    _replay(1);
+    _replay(2);
+    _replay(3);
+
+    TEST(lunchbox::exit());
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,236 @@
+
+/* Copyright (c) 2026, The Equalizer authors, see AUTHORS
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Offline simulator for DPlex compounds: replays synthetic per-source frame
+// times through a static round-robin schedule and through the schedule of the
+// DPlexEqualizer, and reports the variance of the output frame times.
+
+#include <eq/server/equalizers/dplexEqualizer.h>
+#include <lunchbox/test.h>
+
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+using eq::server::DPlexEqualizer;
+typedef DPlexEqualizer::Schedule Schedule;
+typedef DPlexEqualizer::Times Times;
+
+namespace
+{
+const size_t nFrames = 2000;
+const size_t nWarmup = 100;
+const float slowdown = 1.05f;
+
+/** Deterministic jitter in [-amplitude, amplitude]. */
+class Random
+{
+public:
+    Random()
+        : _state(42)
+    {
+    }
+
+    float operator()(const float amplitude)
+    {
+        _state = _state * 1664525u + 1013904223u;
+        return amplitude * (float(_state >> 8) / float(1u << 23) - 1.f);
+    }
+
+private:
+    uint32_t _state;
+};
+
+struct Result
+{
+    float mean;
+    float variance;
+};
+
+size_t _getSource(const Schedule& schedule, const size_t frame)
+{
+    size_t source = schedule.size();
+    for (size_t i = 0; i < schedule.size(); ++i)
+    {
+        if (frame % schedule[i].period != schedule[i].phase)
+            continue;
+        TESTINFO(source == schedule.size(),
+                 "frame " << frame << " rendered by two sources");
+        source = i;
+    }
+    TESTINFO(source < schedule.size(), "frame " << frame << " not rendered");
+    return source;
+}
+
+/**
+ * Simulate the config frame loop: frames start paced by the maximum frame
+ * rate and at most 'latency' frames ahead of the display. The latency is large
+ * enough to keep all sources busy, as needed by any DPlex config. Each source
+ * renders its frames in order, and the destination displays the frames in
+ * order.
+ */
+Result _simulate(const Times& times, const Schedule& schedule,
+                 const float interval, const float jitter)
+{
+    size_t latency = 0;
+    for (const DPlexEqualizer::Slot& slot : schedule)
+        latency = std::max(latency, size_t(slot.period));
+
+    Random random;
+    std::vector<float> available(times.size(), 0.f);
+    std::vector<float> start(nFrames, 0.f);
+    std::vector<float> display(nFrames, 0.f);
+
+    for (size_t frame = 0; frame < nFrames; ++frame)
+    {
+        if (frame > 0)
+            start[frame] = start[frame - 1] + interval;
+        if (frame > latency)
+            start[frame] =
+                std::max(start[frame], display[frame - latency - 1]);
+
+        const size_t source = _getSource(schedule, frame);
+        const float time = times[source] * (1.f + random(jitter));
+        const float begin = std::max(start[frame], available[source]);
+        available[source] = begin + time;
+
+        display[frame] = available[source];
+        if (frame > 0)
+            display[frame] = std::max(display[frame], display[frame - 1]);
+    }
+
+    double sum = 0.;
+    double sum2 = 0.;
+    const size_t nSamples = nFrames - nWarmup;
+    for (size_t frame = nWarmup; frame < nFrames; ++frame)
+    {
+        const double delta = display[frame] - display[frame - 1];
+        sum += delta;
+        sum2 += delta * delta;
+    }
+
+    Result result;
+    result.mean = float(sum / nSamples);
+    result.variance = float(sum2 / nSamples - result.mean * result.mean);
+    return result;
+}
+
+Schedule _getRoundRobin(const size_t nSources)
+{
+    Schedule schedule;
+    for (size_t i = 0; i < nSources; ++i)
+        schedule.push_back(DPlexEqualizer::Slot(nSources, i));
+    return schedule;
+}
+
+/** Pacing of the framerate_equalizer: average time per period. */
+float _getAverageInterval(const Times& times, const Schedule& schedule)
+{
+    float sum = 0.f;
+    for (size_t i = 0; i < times.size(); ++i)
+        sum += times[i] / schedule[i].period;
+    return sum / times.size() * slowdown;
+}
+
+std::ostream& operator<<(std::ostream& os, const Schedule& schedule)
+{
+    for (const DPlexEqualizer::Slot& slot : schedule)
+        os << slot.period << "/" << slot.phase << " ";
+    return os;
+}
+
+void _testCoverage(const Times& times)
+{
+    const Schedule schedule = DPlexEqualizer::computeSchedule(times, 16);
+    TEST(schedule.size() == times.size());
+
+    uint32_t cycle = 1;
+    for (const DPlexEqualizer::Slot& slot : schedule)
+    {
+        TEST(slot.phase < slot.period);
+        while (cycle % slot.period != 0)
+            ++cycle;
+    }
+    for (size_t frame = 0; frame < cycle; ++frame)
+        _getSource(schedule, frame);
+
+    const float roundRobin =
+        DPlexEqualizer::getInterval(times, _getRoundRobin(times.size()));
+    TEST(DPlexEqualizer::getInterval(times, schedule) <= roundRobin);
+}
+
+Result _compare(const std::string& name, const Times& times,
+                const float jitter)
+{
+    const Schedule roundRobin = _getRoundRobin(times.size());
+    const Schedule schedule = DPlexEqualizer::computeSchedule(times, 16);
+
+    const Result before = _simulate(times, roundRobin,
+                                    _getAverageInterval(times, roundRobin),
+                                    jitter);
+    const float interval =
+        DPlexEqualizer::getInterval(times, schedule) * slowdown;
+    const Result after = _simulate(times, schedule, interval, jitter);
+
+    std::cout << std::setw(14) << name << " static " << std::setw(7)
+              << before.mean << " ms, var " << std::setw(8) << before.variance
+              << " | dplex " << std::setw(7) << after.mean << " ms, var "
+              << std::setw(8) << after.variance << " | " << schedule
+              << std::endl;
+
+    TESTINFO(after.variance <= before.variance + 0.01f,
+             name << ": " << after.variance << " > " << before.variance);
+    return after;
+}
+}
+
+int main(int, char**)
+{
+    TEST(DPlexEqualizer::computeSchedule(Times(), 16).empty());
+
+    // homogeneous sources keep the round-robin schedule
+    Times times(4, 20.f);
+    Schedule schedule = DPlexEqualizer::computeSchedule(times, 16);
+    for (const DPlexEqualizer::Slot& slot : schedule)
+        TEST(slot.period == 4);
+
+    // one source twice as fast as the others renders every other frame
+    times = {20.f, 40.f, 40.f};
+    schedule = DPlexEqualizer::computeSchedule(times, 16);
+    TESTINFO(schedule[0].period == 2, schedule);
+    TESTINFO(schedule[1].period == 4, schedule);
+    TESTINFO(schedule[2].period == 4, schedule);
+
+    Random random;
+    for (size_t i = 0; i < 200; ++i)
+    {
+        times.resize(2 + i % 7);
+        for (float& time : times)
+            time = 30.f + random(25.f);
+        _testCoverage(times);
+    }
+
+    _compare("homogeneous", Times(3, 30.f), 0.05f);
+    _compare("one fast", {15.f, 30.f, 30.f}, 0.05f);
+    _compare("one slow", {20.f, 20.f, 20.f, 60.f}, 0.05f);
+    _compare("mixed", {12.f, 25.f, 25.f, 50.f, 50.f}, 0.1f);
+
+    const Result result = _compare("two fast", {10.f, 10.f, 40.f}, 0.f);
+    TESTINFO(std::abs(result.mean - 10.f * slowdown) < .5f,
+             result.mean);
+    return EXIT_SUCCESS;
+}
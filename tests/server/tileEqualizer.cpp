@@ -0,0 +1,212 @@
+
+/* Copyright (c) 2026, The Equalizer authors, see AUTHORS
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Tests the auto size mode of the tile equalizer: the validation of the size
+// bounds and the convergence of the tile size, replayed against a synthetic
+// tile pull model with per-tile overhead and jittered per-pixel cost.
+
+#include <eq/server/equalizers/tileEqualizer.h>
+#include <lunchbox/test.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+using eq::fabric::Vector2i;
+using eq::server::TileEqualizer;
+typedef TileEqualizer::FrameLoad FrameLoad;
+typedef TileEqualizer::FrameLoads FrameLoads;
+
+namespace
+{
+const int32_t width = 1920;
+const int32_t height = 1080;
+const size_t nSources = 4;
+const double overhead = 60.;      // per tile, in microseconds
+const double pixelTime = 24000.;  // full viewport, in microseconds
+const float damping = .5f;
+const size_t nFrames = 60;
+const size_t historySize = 8;
+const Vector2i minSize(16, 16);
+const Vector2i maxSize(512, 512);
+
+/** Deterministic jitter in [-amplitude, amplitude]. */
+class Random
+{
+public:
+    Random()
+        : _state(42)
+    {
+    }
+
+    double operator()(const double amplitude)
+    {
+        _state = _state * 1664525u + 1013904223u;
+        return amplitude * (double(_state >> 8) / double(1u << 23) - 1.);
+    }
+
+private:
+    uint32_t _state;
+};
+
+/** Relative pixel cost with a hot spot left of the center. */
+double _getDensity(const int32_t x, const int32_t y)
+{
+    const double dx = double(x - width / 3) / double(width / 6);
+    const double dy = double(y - height / 2) / double(height / 4);
+    return .4 + 6. * std::exp(-.5 * (dx * dx + dy * dy));
+}
+
+/** Render one frame: each tile goes to the first idle source. */
+FrameLoad _renderFrame(const Vector2i& size, const uint32_t frameNumber,
+                       Random& random)
+{
+    FrameLoad load;
+    load.frameNumber = frameNumber;
+    load.nReports = nSources;
+    load.area = int64_t(width) * int64_t(height);
+    load.endTimes.resize(nSources, 0);
+
+    for (int32_t y = 0; y < height; y += size.y())
+    {
+        for (int32_t x = 0; x < width; x += size.x())
+        {
+            const int32_t w = std::min(size.x(), width - x);
+            const int32_t h = std::min(size.y(), height - y);
+            const double area = double(w) * double(h);
+            const double cost =
+                overhead + pixelTime * area / double(load.area) *
+                               _getDensity(x + w / 2, y + h / 2) *
+                               (1. + random(.2));
+            const int64_t time = int64_t(cost + .5);
+
+            std::vector<int64_t>::iterator source =
+                std::min_element(load.endTimes.begin(), load.endTimes.end());
+            *source += time;
+            load.busyTime += time;
+            ++load.nTiles;
+        }
+    }
+    return load;
+}
+
+int64_t _getFrameTime(const FrameLoad& load)
+{
+    return *std::max_element(load.endTimes.begin(), load.endTimes.end());
+}
+
+/** @return the average frame time of a fixed tile size. */
+double _measure(const Vector2i& size)
+{
+    Random random;
+    double sum = 0.;
+    for (size_t i = 0; i < 16; ++i)
+        sum += double(_getFrameTime(_renderFrame(size, i, random)));
+    return sum / 16.;
+}
+
+void _testBounds()
+{
+    TileEqualizer equalizer;
+    TESTINFO(equalizer.getMinSize() == minSize, equalizer.getMinSize());
+    TESTINFO(equalizer.getMaxSize() == maxSize, equalizer.getMaxSize());
+
+    equalizer.setSizeBounds(Vector2i(32, 8), Vector2i(256, 64));
+    TEST(equalizer.getMinSize() == Vector2i(32, 8));
+    TEST(equalizer.getMaxSize() == Vector2i(256, 64));
+
+    equalizer.setSizeBounds(Vector2i(0, -4), Vector2i(64, 0));
+    TESTINFO(equalizer.getMinSize() == Vector2i(1, 1), equalizer.getMinSize());
+    TESTINFO(equalizer.getMaxSize() == Vector2i(64, 1), equalizer.getMaxSize());
+
+    equalizer.setSizeBounds(Vector2i(128, 128), Vector2i(64, 256));
+    TEST(equalizer.getMinSize() == Vector2i(128, 128));
+    TESTINFO(equalizer.getMaxSize() == Vector2i(128, 256),
+             equalizer.getMaxSize());
+}
+
+/** Adapt from the given start size, @return the last frame's tile size. */
+Vector2i _adapt(Vector2i size, const Vector2i& minBound,
+                const Vector2i& maxBound, double& frameTime)
+{
+    Random random;
+    FrameLoads history; // newest first
+    frameTime = 0.;
+    for (uint32_t frame = 0; frame < nFrames; ++frame)
+    {
+        history.insert(history.begin(), _renderFrame(size, frame, random));
+        if (history.size() > historySize)
+            history.pop_back();
+
+        if (frame >= nFrames - 10)
+            frameTime += double(_getFrameTime(history.front())) / 10.;
+
+        size = TileEqualizer::computeTileSize(history, nSources, size, damping,
+                                              minBound, maxBound);
+        TESTINFO(size.x() >= minBound.x() && size.y() >= minBound.y() &&
+                     size.x() <= maxBound.x() && size.y() <= maxBound.y(),
+                 size << " outside of [ " << minBound << " " << maxBound
+                      << " ]");
+    }
+    return size;
+}
+
+void _testConvergence()
+{
+    // Brute force the best square tile size of the model
+    double bestTime = std::numeric_limits<double>::max();
+    Vector2i best;
+    for (int32_t i = minSize.x(); i <= maxSize.x(); i += 8)
+    {
+        const double time = _measure(Vector2i(i, i));
+        if (time < bestTime)
+        {
+            bestTime = time;
+            best = Vector2i(i, i);
+        }
+    }
+
+    const Vector2i starts[] = {minSize, Vector2i(64, 64), maxSize};
+    for (const Vector2i& start : starts)
+    {
+        double frameTime = 0.;
+        const Vector2i size = _adapt(start, minSize, maxSize, frameTime);
+        std::cout << start << " -> " << size << ": " << frameTime
+                  << " us, best " << best << ": " << bestTime << " us"
+                  << std::endl;
+        TESTINFO(frameTime < bestTime * 1.1,
+                 start << " -> " << size << ": " << frameTime << " us, best "
+                       << best << ": " << bestTime << " us");
+        TESTINFO(frameTime < _measure(start), start);
+    }
+
+    // The bounds win over the model
+    double frameTime = 0.;
+    const Vector2i bound(128, 128);
+    TEST(_adapt(Vector2i(64, 64), bound, Vector2i(256, 256), frameTime)
+             .x() >= bound.x());
+    TEST(_adapt(Vector2i(64, 64), minSize, Vector2i(24, 24), frameTime) ==
+         Vector2i(24, 24));
+}
+}
+
+int main(int, char**)
+{
+    _testBounds();
+    _testConvergence();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,681 @@
+
+/* Copyright (c) 2026, The Equalizer authors, see AUTHORS
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Tests the cost model of the TreeEqualizer in two ways. A deterministic replay
+// of per-stage source profiles through the model and through the previous
+// single-time model reports the frames needed to converge and the steady-state
+// imbalance of both. A loaded DB compound then drives the TreeEqualizer itself
+// with synthetic statistics through its listener interface. Its ranges have to
+// converge to the equal-time solution of the sources, including the
+// compositing of an inner node on a leaf channel, and the convergence and
+// imbalance are reported as well.
+
+#include <lunchbox/test.h>
+
+#include <eq/server/channel.h>
+#include <eq/server/compound.h>
+#include <eq/server/compoundUpdateActivateVisitor.h>
+#include <eq/server/config.h>
+#include <eq/server/configVisitor.h>
+#include <eq/server/equalizers/treeEqualizer.h>
+#include <eq/server/global.h>
+#include <eq/server/loader.h>
+#include <eq/server/server.h>
+
+#include <lunchbox/init.h>
+
+#include <cmath>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+
+using namespace eq::server;
+typedef TreeEqualizer::Cost Cost;
+typedef TreeEqualizer::Stages Stages;
+
+namespace
+{
+const float damping = .5f;
+const float threshold = .1f;
+
+//-------------------------------------------------------------------- replay
+namespace replay
+{
+const size_t nFrames = 500;
+const size_t nSteady = 200;
+const size_t history = 8;
+const size_t latency = 1;
+
+/** Stage times of a source for the full work, in milliseconds. */
+struct Source
+{
+    float draw;
+    float readback;
+    float compress;
+    float transmit;
+};
+typedef std::vector<Source> Sources;
+
+struct Trace
+{
+    std::string name;
+    TreeEqualizer::Mode mode;
+    float composite; //!< time to composite one input
+    Sources sources;
+};
+
+/** Deterministic jitter in [-amplitude, amplitude]. */
+class Random
+{
+public:
+    Random()
+        : _state(42)
+    {
+    }
+
+    float operator()(const float amplitude)
+    {
+        _state = _state * 1664525u + 1013904223u;
+        return amplitude * (float(_state >> 8) / float(1u << 23) - 1.f);
+    }
+
+private:
+    uint32_t _state;
+};
+
+struct Node
+{
+    Node()
+        : source(0)
+        , nLeafs(1)
+        , split(.5f)
+        , work(0.f)
+        , legacyTime(1.f)
+    {
+    }
+
+    std::unique_ptr<Node> left;
+    std::unique_ptr<Node> right;
+    size_t source;
+    size_t nLeafs;
+    float split;
+    float work;
+
+    Cost cost;
+    std::deque<Stages> history;
+    std::deque<float> historyWork;
+    float legacyTime;
+};
+
+/** Same tree layout as TreeEqualizer::_buildTree. */
+std::unique_ptr<Node> _buildTree(const size_t begin, const size_t end)
+{
+    std::unique_ptr<Node> node(new Node);
+    if (end - begin == 1)
+    {
+        node->source = begin;
+        return node;
+    }
+
+    const size_t middle = begin + ((end - begin) >> 1);
+    node->left = _buildTree(begin, middle);
+    node->right = _buildTree(middle, end);
+    node->nLeafs = node->left->nLeafs + node->right->nLeafs;
+    return node;
+}
+
+void _assign(Node& node, const float work)
+{
+    node.work = work;
+    if (!node.left)
+        return;
+    _assign(*node.left, work * node.split);
+    _assign(*node.right, work * (1.f - node.split));
+}
+
+Stages _render(const Trace& trace, const Node& node, Random& random)
+{
+    const Source& source = trace.sources[node.source];
+    const float pixels = trace.mode == TreeEqualizer::MODE_DB ? 1.f : node.work;
+    const float jitter = 1.f + random(.02f);
+
+    Stages stages;
+    stages.draw = source.draw * node.work * jitter;
+    stages.readback = source.readback * pixels * jitter;
+    stages.compress = source.compress * pixels * jitter;
+    stages.transmit = source.transmit * pixels * jitter;
+    return stages;
+}
+
+/** @return the critical path time, updates the maximum imbalance. */
+float _getTime(const Trace& trace, const Node& node,
+               const std::vector<Stages>& stages, float& imbalance)
+{
+    if (!node.left)
+    {
+        const Stages& leaf = stages[node.source];
+        return leaf.draw + leaf.readback + leaf.compress + leaf.transmit;
+    }
+
+    const float left = _getTime(trace, *node.left, stages, imbalance);
+    const float right = _getTime(trace, *node.right, stages, imbalance);
+    const float time = std::max(left, right);
+    imbalance = std::max(imbalance, std::abs(left - right) / time);
+    return time + trace.composite;
+}
+
+void _collect(const Node& node, std::vector<const Node*>& leafs)
+{
+    if (!node.left)
+    {
+        leafs[node.source] = &node;
+        return;
+    }
+    _collect(*node.left, leafs);
+    _collect(*node.right, leafs);
+}
+
+void _add(Node& node, const Stages& stages, const float work)
+{
+    if (work <= 0.f)
+        return;
+    node.history.push_back(stages);
+    node.historyWork.push_back(work);
+    if (node.history.size() > history)
+    {
+        node.history.pop_front();
+        node.historyWork.pop_front();
+    }
+
+    // previous model: slowest of draw and transmit
+    node.legacyTime = std::max(stages.draw + stages.readback, stages.transmit);
+}
+
+/** The split of the TreeEqualizer using the per-stage cost model. */
+void _split(const Trace& trace, Node& node)
+{
+    if (!node.left)
+    {
+        if (node.history.empty())
+        {
+            node.cost = Cost(0.f, 1.f);
+            return;
+        }
+
+        node.cost = Cost();
+        for (size_t i = 0; i < node.history.size(); ++i)
+        {
+            const Cost cost = TreeEqualizer::predict(node.history[i],
+                                                     node.historyWork[i],
+                                                     trace.mode);
+            node.cost.fixed += cost.fixed;
+            node.cost.rate += cost.rate;
+        }
+        node.cost.fixed /= float(node.history.size());
+        node.cost.rate /= float(node.history.size());
+        return;
+    }
+
+    _split(trace, *node.left);
+    _split(trace, *node.right);
+    node.cost = TreeEqualizer::combine(node.left->cost, node.right->cost,
+                                       node.work, trace.composite);
+    const float split = TreeEqualizer::computeSplit(node.left->cost,
+                                                    node.right->cost,
+                                                    node.work);
+    node.split = (1.f - damping) * split + damping * node.split;
+}
+
+/** The split of the previous TreeEqualizer using one time per leaf. */
+void _legacySplit(Node& node)
+{
+    if (!node.left)
+        return;
+
+    Node& left = *node.left;
+    Node& right = *node.right;
+    _legacySplit(left);
+    _legacySplit(right);
+    node.legacyTime = left.legacyTime + right.legacyTime;
+
+    const float target =
+        node.legacyTime * float(left.nLeafs) / float(node.nLeafs);
+    float split = 0.f;
+    if (left.legacyTime >= target)
+        split = target / left.legacyTime * node.split;
+    else
+    {
+        const float timeLeft = target - left.legacyTime;
+        split = node.split + timeLeft / right.legacyTime * (1.f - node.split);
+    }
+    node.split = (1.f - damping) * split + damping * node.split;
+}
+
+struct Result
+{
+    size_t convergence; //!< first frame staying below the threshold
+    float imbalance;    //!< mean steady-state imbalance
+    float time;         //!< mean steady-state frame time
+};
+
+Result _replay(const Trace& trace, const bool legacy)
+{
+    const size_t nSources = trace.sources.size();
+    std::unique_ptr<Node> tree = _buildTree(0, nSources);
+    std::vector<const Node*> leafs(nSources);
+    _collect(*tree, leafs);
+
+    Random random;
+    std::deque<std::vector<Stages>> pending;
+    std::deque<std::vector<float>> pendingWork;
+    Result result = {0, 0.f, 0.f};
+
+    for (size_t frame = 0; frame < nFrames; ++frame)
+    {
+        if (legacy)
+            _legacySplit(*tree);
+        else
+            _split(trace, *tree);
+        _assign(*tree, 1.f);
+
+        std::vector<Stages> stages(nSources);
+        std::vector<float> works(nSources);
+        for (size_t i = 0; i < nSources; ++i)
+        {
+            stages[i] = _render(trace, *leafs[i], random);
+            works[i] = leafs[i]->work;
+        }
+
+        float imbalance = 0.f;
+        const float time = _getTime(trace, *tree, stages, imbalance);
+        if (imbalance > threshold)
+            result.convergence = frame + 1;
+        if (frame >= nFrames - nSteady)
+        {
+            result.imbalance += imbalance / float(nSteady);
+            result.time += time / float(nSteady);
+        }
+
+        // statistics arrive after the configured latency
+        pending.push_back(stages);
+        pendingWork.push_back(works);
+        if (pending.size() > latency)
+        {
+            for (size_t i = 0; i < nSources; ++i)
+                _add(const_cast<Node&>(*leafs[i]), pending.front()[i],
+                     pendingWork.front()[i]);
+            pending.pop_front();
+            pendingWork.pop_front();
+        }
+    }
+    return result;
+}
+
+void _compare(const Trace& trace)
+{
+    const Result before = _replay(trace, true);
+    const Result after = _replay(trace, false);
+
+    std::cout << std::setw(14) << trace.name << " previous: converged @ "
+              << std::setw(3) << before.convergence << ", imbalance "
+              << std::setw(9) << before.imbalance << ", " << std::setw(7)
+              << before.time << " ms | predictive: converged @ "
+              << std::setw(3) << after.convergence << ", imbalance "
+              << std::setw(9) << after.imbalance << ", " << std::setw(7)
+              << after.time << " ms" << std::endl;
+
+    TESTINFO(after.convergence < nFrames - nSteady,
+             trace.name << " converged @ " << after.convergence);
+    TESTINFO(after.imbalance < threshold,
+             trace.name << " imbalance " << after.imbalance);
+    TESTINFO(after.imbalance <= before.imbalance + .01f,
+             trace.name << ": " << after.imbalance << " > "
+                        << before.imbalance);
+    TESTINFO(after.time <= before.time * 1.01f,
+             trace.name << ": " << after.time << " > " << before.time);
+}
+
+void _run()
+{
+    // recorded source profiles: draw, readback, compress, transmit
+    _compare({"2D draw", TreeEqualizer::MODE_VERTICAL, 1.f,
+              {{40.f, 4.f, 2.f, 8.f},
+               {40.f, 4.f, 2.f, 8.f},
+               {60.f, 4.f, 2.f, 8.f},
+               {80.f, 4.f, 2.f, 8.f}}});
+    _compare({"2D transmit", TreeEqualizer::MODE_VERTICAL, 1.f,
+              {{10.f, 4.f, 6.f, 20.f},
+               {10.f, 4.f, 6.f, 40.f},
+               {10.f, 4.f, 6.f, 40.f},
+               {10.f, 4.f, 6.f, 60.f}}});
+    _compare({"DB draw", TreeEqualizer::MODE_DB, 2.f,
+              {{60.f, 2.f, 1.f, 4.f},
+               {90.f, 2.f, 1.f, 4.f},
+               {60.f, 2.f, 1.f, 4.f},
+               {120.f, 2.f, 1.f, 4.f},
+               {60.f, 2.f, 1.f, 4.f}}});
+    _compare({"DB transmit", TreeEqualizer::MODE_DB, 3.f,
+              {{80.f, 5.f, 5.f, 20.f},
+               {80.f, 5.f, 5.f, 20.f},
+               {80.f, 5.f, 5.f, 26.f},
+               {80.f, 5.f, 5.f, 20.f},
+               {80.f, 5.f, 5.f, 20.f},
+               {80.f, 5.f, 5.f, 20.f},
+               {80.f, 5.f, 5.f, 20.f},
+               {80.f, 5.f, 5.f, 20.f}}});
+}
+}
+
+//------------------------------------------------------------------ compound
+// A destination channel assembling three sources, sort-last. The first leaf
+// draws on the destination channel, the final assembly of the destination runs
+// in the task of the root compound. In the tree config, the first leaf also
+// composites the output of the second leaf in its own task, which is the
+// compositing of the inner node above both.
+const char* const flatConfig =
+    "server { config { appNode { pipe {"
+    "    window { channel { name \"channel0\" }}"
+    "    window { channel { name \"channel1\" }}"
+    "    window { channel { name \"channel2\" }}"
+    "    window { channel { name \"channel3\" }}}}"
+    "  compound { channel \"channel0\" buffer [ COLOR DEPTH ]"
+    "    tree_equalizer { mode DB damping .5 }"
+    "    compound {}"
+    "    compound { channel \"channel1\" outputframe { name \"f1\" }}"
+    "    compound { channel \"channel2\" outputframe { name \"f2\" }}"
+    "    compound { channel \"channel3\" outputframe { name \"f3\" }}"
+    "    inputframe { name \"f1\" } inputframe { name \"f2\" }"
+    "    inputframe { name \"f3\" }}}}";
+
+const char* const treeConfig =
+    "server { config { appNode { pipe {"
+    "    window { channel { name \"channel0\" }}"
+    "    window { channel { name \"channel1\" }}"
+    "    window { channel { name \"channel2\" }}"
+    "    window { channel { name \"channel3\" }}}}"
+    "  compound { channel \"channel0\" buffer [ COLOR DEPTH ]"
+    "    tree_equalizer { mode DB damping .5 }"
+    "    compound { inputframe { name \"f1\" }}"
+    "    compound { channel \"channel1\" outputframe { name \"f1\" }}"
+    "    compound { channel \"channel2\" outputframe { name \"f2\" }}"
+    "    compound { channel \"channel3\" outputframe { name \"f3\" }}"
+    "    inputframe { name \"f2\" } inputframe { name \"f3\" }}}}";
+
+const size_t nLeafs = 4;
+const size_t nSteady = 20;
+const float scale = 1000.f; // float ms to integer statistics time
+
+/** Stage times of a leaf: draw for the full range, the others per frame. */
+struct Source
+{
+    float draw;
+    float readback;
+    float transmit;
+    float assemble; // compositing of the leaf's inputs
+};
+
+class Setup : public ConfigVisitor
+{
+public:
+    Setup()
+        : root(0)
+    {
+    }
+
+    VisitorResult visit(Channel* channel) override
+    {
+        channel->setState(STATE_RUNNING);
+        return TRAVERSE_CONTINUE;
+    }
+
+    VisitorResult visit(Compound* compound) override
+    {
+        if (!compound->getEqualizers().empty())
+            root = compound;
+        return TRAVERSE_CONTINUE;
+    }
+
+    Compound* root;
+};
+
+void _add(Statistics& statistics, const Statistic::Type type,
+          const uint32_t task, const uint32_t frame, const float time)
+{
+    Statistic stat;
+    stat.type = type;
+    stat.frameNumber = frame;
+    stat.task = task;
+    stat.startTime = 0;
+    stat.endTime = int64_t(std::round(time * scale));
+    statistics.push_back(stat);
+}
+
+/**
+ * @return the compositing after each leaf on the inner node above the first
+ *         two leafs, which is only done by the first leaf in the tree config.
+ */
+float _getComposite(const Source* sources, const size_t i, const bool tree)
+{
+    return tree && i < 2 ? sources[0].assemble : 0.f;
+}
+
+/** @return the range widths equalizing the time of all sources. */
+std::vector<float> _solve(const Source* sources, const bool tree)
+{
+    float rates = 0.f;
+    float fixed = 0.f;
+    for (size_t i = 0; i < nLeafs; ++i)
+    {
+        const Source& source = sources[i];
+        const float cost = source.readback + source.transmit +
+                           _getComposite(sources, i, tree);
+        rates += 1.f / source.draw;
+        fixed += cost / source.draw;
+    }
+
+    const float time = (1.f + fixed) / rates;
+    std::vector<float> widths;
+    for (size_t i = 0; i < nLeafs; ++i)
+    {
+        const Source& source = sources[i];
+        const float cost = source.readback + source.transmit +
+                           _getComposite(sources, i, tree);
+        widths.push_back((time - cost) / source.draw);
+    }
+    return widths;
+}
+
+/** @return the largest relative time difference of the children of a node. */
+float _getImbalance(const float left, const float right)
+{
+    return std::abs(left - right) / std::max(std::max(left, right), 1.f);
+}
+
+/**
+ * Run frames [begin, end) and report the statistics of each leaf for the
+ * range it was assigned. The destination channel additionally reports its
+ * final assembly in the root task, which does not depend on the split.
+ */
+void _run(Compound* root, TreeEqualizer* equalizer, const Source* sources,
+          const bool tree, const uint32_t begin, const uint32_t end)
+{
+    const Compounds& leafs = root->getChildren();
+    TEST(leafs.size() == nLeafs);
+
+    size_t convergence = 0;
+    float imbalance = 0.f;
+    for (uint32_t frame = begin; frame < end; ++frame)
+    {
+        CompoundUpdateActivateVisitor updater(frame);
+        root->accept(updater);
+        TEST(root->isActive());
+        root->fireUpdatePre(frame);
+
+        float times[nLeafs];
+        for (size_t i = 0; i < nLeafs; ++i)
+        {
+            Compound* leaf = leafs[i];
+            const Source& source = sources[i];
+            const Range& range = leaf->getRange();
+            const uint32_t task = leaf->getTaskID();
+            TEST(leaf->getViewport() == Viewport::FULL);
+
+            const float draw = source.draw * (range.end - range.start);
+            times[i] = draw + source.readback + source.transmit;
+
+            Statistics statistics;
+            _add(statistics, Statistic::CHANNEL_DRAW, task, frame, draw);
+            _add(statistics, Statistic::CHANNEL_READBACK, task, frame,
+                 source.readback);
+            _add(statistics, Statistic::CHANNEL_FRAME_TRANSMIT, task,
+                 frame, source.transmit);
+            if (source.assemble > 0.f)
+            {
+                _add(statistics, Statistic::CHANNEL_ASSEMBLE, task, frame,
+                     source.assemble + 1.f);
+                _add(statistics, Statistic::CHANNEL_FRAME_WAIT_READY, task,
+                     frame, 1.f);
+            }
+
+            if (leaf->getChannel() == root->getChannel())
+            {
+                const uint32_t rootTask = root->getTaskID();
+                _add(statistics, Statistic::CHANNEL_ASSEMBLE, rootTask,
+                     frame, 60.f);
+                _add(statistics, Statistic::CHANNEL_FRAME_WAIT_READY,
+                     rootTask, frame, 10.f);
+            }
+
+            equalizer->notifyLoadData(leaf->getChannel(), frame, statistics,
+                                      Viewport());
+        }
+
+        // critical path of the binary tree ((0, 1), (2, 3))
+        const float left = std::max(times[0], times[1]) +
+                           _getComposite(sources, 0, tree);
+        const float right = std::max(times[2], times[3]);
+        const float frameImbalance =
+            std::max(std::max(_getImbalance(times[0], times[1]),
+                              _getImbalance(times[2], times[3])),
+                     _getImbalance(left, right));
+        if (frameImbalance > threshold)
+            convergence = frame + 1 - begin;
+        if (frame >= end - nSteady)
+            imbalance += frameImbalance / float(nSteady);
+    }
+
+    std::cout << (tree ? "  tree" : "  flat")
+              << " compound: converged @ " << std::setw(3) << convergence
+              << ", imbalance " << std::setw(9) << imbalance << std::endl;
+    TESTINFO(convergence < end - begin - nSteady, convergence);
+}
+
+void _testRanges(Compound* root, const Source* sources, const bool tree)
+{
+    const std::vector<float> widths = _solve(sources, tree);
+    const Compounds& leafs = root->getChildren();
+    float start = 0.f;
+
+    for (size_t i = 0; i < nLeafs; ++i)
+    {
+        const Range& range = leafs[i]->getRange();
+        TESTINFO(std::abs(range.start - start) < .0001f,
+                 i << ": " << range << " after " << start);
+        TESTINFO(std::abs(range.end - range.start - widths[i]) < .01f,
+                 i << ": " << range << " != " << widths[i]);
+        start = range.end;
+    }
+    TESTINFO(std::abs(start - 1.f) < .0001f, start);
+}
+
+void _testCompound(const char* config, const bool tree)
+{
+    Loader loader;
+    ServerPtr server = loader.parseServer(config);
+    TEST(server);
+    TEST(server->getConfigs().size() == 1);
+
+    Setup setup;
+    server->getConfigs().front()->accept(setup);
+    Compound* root = setup.root;
+    TEST(root);
+    TreeEqualizer* equalizer =
+        dynamic_cast<TreeEqualizer*>(root->getEqualizers().front());
+    TEST(equalizer);
+    root->activate(eq::fabric::EYE_CYCLOP);
+
+    // draw, readback, transmit and assembly of received inputs in ms
+    Source sources[nLeafs] = {{10.f, 0.f, 0.f, 2.f},
+                              {20.f, 1.f, 2.f, 0.f},
+                              {20.f, 1.f, 2.f, 0.f},
+                              {40.f, 2.f, 3.f, 0.f}};
+    _run(root, equalizer, sources, tree, 1, 60);
+    _testRanges(root, sources, tree);
+
+    // the last source slows down
+    sources[3].draw = 80.f;
+    _run(root, equalizer, sources, tree, 60, 120);
+    _testRanges(root, sources, tree);
+
+    root->deactivate(eq::fabric::EYE_CYCLOP);
+    Global::clear();
+    server->deleteConfigs(); // break server <-> config ref circle
+}
+
+void _testModel()
+{
+    const Cost fast(0.f, 10.f);
+    const Cost slow(0.f, 30.f);
+    TEST(std::abs(TreeEqualizer::computeSplit(fast, slow, 1.f) - .75f) <
+         .0001f);
+    TEST(std::abs(TreeEqualizer::computeSplit(slow, fast, .5f) - .25f) <
+         .0001f);
+    TEST(TreeEqualizer::computeSplit(Cost(40.f, 10.f), fast, 1.f) == 0.f);
+    TEST(TreeEqualizer::computeSplit(Cost(), Cost(), 1.f) == .5f);
+
+    const Cost both = TreeEqualizer::combine(fast, slow, 1.f, 2.f);
+    TEST(std::abs(both(1.f) - fast(.75f) - 2.f) < .0001f);
+    TEST(std::abs(both(1.f) - slow(.25f) - 2.f) < .0001f);
+    const Cost fixed = TreeEqualizer::combine(Cost(40.f, 10.f), fast, 1.f, 0.f);
+    TEST(fixed.fixed == fast.fixed && fixed.rate == fast.rate);
+
+    // the compositing is part of the inner nodes, not of the leaf
+    Stages stages;
+    stages.draw = 8.f;
+    stages.readback = 2.f;
+    stages.transmit = 3.f;
+    stages.composite = 1.f;
+    Cost cost = TreeEqualizer::predict(stages, .5f, TreeEqualizer::MODE_DB);
+    TEST(cost.fixed == 5.f && cost.rate == 16.f);
+    cost = TreeEqualizer::predict(stages, .5f, TreeEqualizer::MODE_VERTICAL);
+    TEST(cost.fixed == 0.f && cost.rate == 26.f);
+}
+}
+
+int main(int argc, char** argv)
+{
+    TEST(lunchbox::init(argc, argv));
+    _testModel();
+    replay::_run();
+
+    _testCompound(flatConfig, false);
+    _testCompound(treeConfig, true);
+
+    TEST(lunchbox::exit());
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,723 @@
+
+/* Copyright (c) 2026, The Equalizer authors, see AUTHORS
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+// Tests the cost model of the ViewEqualizer, and replays per-frame costs of
+// multi-view configurations through a loaded config. Each frame, the
+// ViewEqualizer of the config assigns the source usages in notifyUpdatePre and
+// receives the statistics of the sources through their channels. In a second
+// run of the same config, the previous assignment, which balanced the draw
+// times of the views only, assigns the usages. Reports the predicted and the
+// achieved frame times of both.
+//
+// The work of each view is split between its sources proportional to their
+// usage over their time for the whole view, as a converged load equalizer
+// would. The previous assignment is a copy of the former
+// ViewEqualizer::_update, since it is not part of the tree anymore.
+
+#include <lunchbox/test.h>
+
+#include <eq/server/channel.h>
+#include <eq/server/compound.h>
+#include <eq/server/compoundUpdateActivateVisitor.h>
+#include <eq/server/compoundUpdateDataVisitor.h>
+#include <eq/server/compoundVisitor.h>
+#include <eq/server/config.h>
+#include <eq/server/configVisitor.h>
+#include <eq/server/equalizers/viewEqualizer.h>
+#include <eq/server/global.h>
+#include <eq/server/loader.h>
+#include <eq/server/node.h>
+#include <eq/server/pipe.h>
+#include <eq/server/server.h>
+
+#include <lunchbox/init.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+using namespace eq::server;
+typedef ViewEqualizer::Cost Cost;
+typedef ViewEqualizer::Costs Costs;
+typedef ViewEqualizer::Shares Shares;
+
+namespace
+{
+const size_t nWarmup = 10;
+const float minUsage = .1f;
+const float scale = 1000.f; // float ms to integer statistics time
+
+typedef std::vector<Costs> Trace;
+
+Trace _load(const std::string& filename)
+{
+    std::ifstream file(filename.c_str());
+    TESTINFO(file.is_open(), filename);
+
+    Trace trace;
+    size_t nPipes = 0;
+    size_t nViews = 0;
+    std::string line;
+    while (std::getline(file, line))
+    {
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        std::istringstream stream(line);
+        std::string token;
+        stream >> token;
+        if (token == "pipes")
+            stream >> nPipes;
+        else if (token == "views")
+            stream >> nViews;
+        else if (token == "frame")
+            trace.push_back(Costs(nViews, std::vector<Cost>(nPipes)));
+        else
+        {
+            const size_t view = std::stoul(token);
+            TESTINFO(!trace.empty() && view < nViews, line);
+            for (size_t i = 0; i < nPipes; ++i)
+            {
+                Cost& cost = trace.back()[view][i];
+                stream >> cost.draw >> cost.transfer;
+                cost.available = true;
+            }
+        }
+    }
+    TESTINFO(!trace.empty(), filename);
+    return trace;
+}
+
+float _getMax(const std::vector<float>& times)
+{
+    float max = 0.f;
+    for (const float time : times)
+        max = std::max(max, time);
+    return max;
+}
+
+/** @return the time to render and transmit the whole view. */
+float _getTime(const Cost& cost)
+{
+    return cost.draw + cost.transfer;
+}
+
+/** @return the pipe of the destination channel, i.e., without transfer. */
+size_t _getDestination(const Costs& costs, const size_t view)
+{
+    size_t destination = 0;
+    for (size_t i = 0; i < costs[view].size(); ++i)
+    {
+        const Cost& cost = costs[view][i];
+        if (cost.transfer == 0.f)
+            destination = i;
+    }
+    return destination;
+}
+
+/** @return available pipes of unknown cost. */
+Costs _getCosts(const size_t nViews, const size_t nPipes)
+{
+    return Costs(nViews, std::vector<Cost>(nPipes, Cost(0.f, 0.f)));
+}
+
+/**
+ * @return a config with one pipe per trace pipe, and one child compound per
+ *         view with a source on each pipe.
+ */
+std::string _getConfig(const Costs& costs, const bool viewEqualizer)
+{
+    const size_t nViews = costs.size();
+    const size_t nPipes = costs.front().size();
+
+    std::ostringstream config;
+    config << "server { config { appNode {";
+    for (size_t i = 0; i < nPipes; ++i)
+        config << " pipe { window { channel { name \"channel" << i
+               << "\" }}}";
+    config << " } compound {";
+    if (viewEqualizer)
+        config << " view_equalizer {}";
+
+    for (size_t i = 0; i < nViews; ++i)
+    {
+        const size_t destination = _getDestination(costs, i);
+        config << " compound { channel \"channel" << destination << "\"";
+        for (size_t j = 0; j < nPipes; ++j)
+        {
+            if (j == destination)
+                config << " compound {}";
+            else
+                config << " compound { channel \"channel" << j
+                       << "\" outputframe { name \"view" << i << ".channel"
+                       << j << "\" }}";
+        }
+        for (size_t j = 0; j < nPipes; ++j)
+            if (j != destination)
+                config << " inputframe { name \"view" << i << ".channel" << j
+                       << "\" }";
+        config << " }";
+    }
+    config << " }}}";
+    return config.str();
+}
+
+class Setup : public ConfigVisitor
+{
+public:
+    VisitorResult visit(Channel* channel) override
+    {
+        channel->setState(STATE_RUNNING);
+        return TRAVERSE_CONTINUE;
+    }
+};
+
+size_t _getIndex(const Pipes& pipes, const Compound* source)
+{
+    const Pipes::const_iterator i =
+        std::find(pipes.begin(), pipes.end(), source->getPipe());
+    TEST(i != pipes.end());
+    return size_t(i - pipes.begin());
+}
+
+void _add(Statistics& statistics, const Statistic::Type type,
+          const uint32_t task, const uint32_t frame, int64_t& time,
+          const float duration)
+{
+    Statistic stat;
+    stat.type = type;
+    stat.frameNumber = frame;
+    stat.task = task;
+    stat.startTime = time;
+    time += int64_t(std::round(duration * scale));
+    stat.endTime = time;
+    statistics.push_back(stat);
+}
+
+void _update(Compound* root, const uint32_t frame)
+{
+    CompoundUpdateActivateVisitor activator(frame);
+    root->accept(activator);
+    CompoundUpdateDataVisitor updater(frame);
+    root->accept(updater);
+}
+
+/**
+ * Render one frame with the true costs: split the work of each view between
+ * its used sources, and report the statistics of each source through its
+ * channel. Each pipe renders the sources of all views one after another.
+ *
+ * @return the shares of each view rendered by each pipe.
+ */
+Shares _render(Compound* root, const Pipes& pipes, const Costs& truth,
+               const uint32_t frame)
+{
+    const Compounds& views = root->getChildren();
+    Shares shares(views.size(), std::vector<float>(pipes.size(), 0.f));
+    std::vector<Statistics> statistics(pipes.size());
+    std::vector<Channel*> channels(pipes.size(), 0);
+    std::vector<int64_t> times(pipes.size(), 0);
+
+    for (size_t i = 0; i < views.size(); ++i)
+    {
+        const Compounds& sources = views[i]->getChildren();
+        float sum = 0.f;
+        for (const Compound* source : sources)
+            if (source->isActive())
+                sum += source->getUsage() /
+                       _getTime(truth[i][_getIndex(pipes, source)]);
+        TESTINFO(sum > 0.f, "view " << i << " has no resources");
+
+        float start = 0.f;
+        for (Compound* source : sources)
+        {
+            if (!source->isActive() || source->getUsage() <= 0.f)
+                continue;
+
+            const size_t j = _getIndex(pipes, source);
+            const Cost& cost = truth[i][j];
+            const float share = source->getUsage() / _getTime(cost) / sum;
+            source->setViewport(Viewport(start, 0.f, share, 1.f));
+            source->updateInheritData(frame);
+            start += share;
+            shares[i][j] = share;
+
+            const uint32_t task = source->getTaskID();
+            channels[j] = source->getChannel();
+            _add(statistics[j], Statistic::CHANNEL_DRAW, task, frame,
+                 times[j], share * cost.draw);
+            _add(statistics[j], Statistic::CHANNEL_FRAME_TRANSMIT, task,
+                 frame, times[j], share * cost.transfer);
+        }
+    }
+
+    for (size_t j = 0; j < pipes.size(); ++j)
+        if (channels[j])
+            channels[j]->fireLoadData(frame, statistics[j], Viewport());
+    return shares;
+}
+
+//--------------------------------------------------------- former assignment
+namespace former
+{
+typedef lunchbox::PtrHash<Pipe*, float> PipeUsage;
+
+class SelfAssigner : public CompoundVisitor
+{
+public:
+    SelfAssigner(const Pipe* self, float& nResources, PipeUsage& pipeUsage)
+        : _self(self)
+        , _nResources(nResources)
+        , _pipeUsage(pipeUsage)
+        , _numChannels(0)
+    {
+    }
+
+    virtual VisitorResult visitLeaf(Compound* compound)
+    {
+        if (!compound->isActive())
+            return TRAVERSE_CONTINUE;
+
+        Pipe* pipe = compound->getPipe();
+        if (pipe != _self)
+            return TRAVERSE_CONTINUE;
+
+        if (_pipeUsage.find(pipe) == _pipeUsage.end())
+            _pipeUsage[pipe] = 0.0f;
+
+        float& pipeUsage = _pipeUsage[pipe];
+        if (pipeUsage >= 1.0f)
+        {
+            compound->setUsage(0.f);
+            return TRAVERSE_TERMINATE;
+        }
+
+        if (pipeUsage > 0.0f) // pipe already partly used
+        {
+            const float use = LB_MAX(1.0f - pipeUsage, minUsage);
+            compound->setUsage(use);
+            _nResources -= use;
+            pipeUsage = 1.0f; // Don't use more than twice
+        }
+        else
+        {
+            const float use = LB_MIN(1.0f, _nResources);
+            compound->setUsage(use);
+            _nResources -= use;
+            pipeUsage = use;
+        }
+        ++_numChannels;
+        return TRAVERSE_TERMINATE;
+    }
+
+    uint32_t getNumChannels() const { return _numChannels; }
+private:
+    const Pipe* const _self;
+    float& _nResources;
+    PipeUsage& _pipeUsage;
+    uint32_t _numChannels;
+};
+
+class PreviousAssigner : public CompoundVisitor
+{
+public:
+    PreviousAssigner(const Pipe* self, float& nResources, PipeUsage& pipeUsage)
+        : _self(self)
+        , _nResources(nResources)
+        , _pipeUsage(pipeUsage)
+        , _numChannels(0)
+    {
+    }
+
+    virtual VisitorResult visitLeaf(Compound* compound)
+    {
+        if (!compound->isActive())
+            return TRAVERSE_CONTINUE;
+
+        Pipe* pipe = compound->getPipe();
+        if (compound->getUsage() == 0.0f || // not previously used
+            pipe == _self)                  // already assigned above
+        {
+            return TRAVERSE_CONTINUE;
+        }
+
+        compound->setUsage(0.0f);    // reset to unused
+        if (_nResources <= minUsage) // done
+            return TRAVERSE_CONTINUE;
+
+        if (_pipeUsage.find(pipe) == _pipeUsage.end())
+            _pipeUsage[pipe] = 0.0f;
+
+        float& pipeUsage = _pipeUsage[pipe];
+        if (pipeUsage > 0.0f) // pipe already partly used
+            return TRAVERSE_CONTINUE;
+
+        float use = LB_MIN(1.0f, _nResources);
+        if (use + minUsage > 1.0f)
+            use = 1.0f;
+
+        pipeUsage = use;
+        compound->setUsage(use);
+        _nResources -= use;
+        ++_numChannels;
+        return TRAVERSE_CONTINUE;
+    }
+
+    uint32_t getNumChannels() const { return _numChannels; }
+private:
+    const Pipe* const _self;
+    float& _nResources;
+    PipeUsage& _pipeUsage;
+    uint32_t _numChannels;
+};
+
+class NewAssigner : public CompoundVisitor
+{
+public:
+    NewAssigner(float& nResources, PipeUsage& pipeUsage)
+        : _nResources(nResources)
+        , _pipeUsage(pipeUsage)
+        , _numChannels(0)
+        , _fallback(0)
+    {
+    }
+
+    virtual VisitorResult visitLeaf(Compound* compound)
+    {
+        if (!compound->isActive())
+            return TRAVERSE_CONTINUE;
+
+        if (!_fallback)
+            _fallback = compound;
+
+        if (compound->getUsage() != 0.0f) // already used
+            return TRAVERSE_CONTINUE;
+
+        Pipe* pipe = compound->getPipe();
+        if (_pipeUsage.find(pipe) == _pipeUsage.end())
+            _pipeUsage[pipe] = 0.0f;
+
+        float& pipeUsage = _pipeUsage[pipe];
+        if (pipeUsage >= 1.0f)
+            return TRAVERSE_CONTINUE;
+
+        if (pipeUsage > 0.0f) // pipe already partly used
+        {
+            const float use = LB_MAX(1.0f - pipeUsage, minUsage);
+            compound->setUsage(use);
+            _nResources -= use;
+            pipeUsage = 1.0f; // Don't use more than twice
+        }
+        else
+        {
+            const float use = LB_MIN(1.0f, _nResources);
+            compound->setUsage(use);
+            _nResources -= use;
+            pipeUsage = use;
+        }
+        ++_numChannels;
+
+        if (_nResources <= minUsage)
+            return TRAVERSE_TERMINATE; // done
+        return TRAVERSE_CONTINUE;
+    }
+
+    uint32_t getNumChannels() const { return _numChannels; }
+    Compound* getFallback() { return _fallback; }
+private:
+    float& _nResources;
+    PipeUsage& _pipeUsage;
+    uint32_t _numChannels;
+    Compound* _fallback;
+};
+
+/**
+ * @return the load time of each view as measured by the former listener:
+ *         the slower of draw and transmit of each used source, summed up and
+ *         weighted by the square root of the number of sources.
+ */
+std::vector<float> _getLoads(const Costs& truth, const Shares& shares)
+{
+    std::vector<float> loads(truth.size(), 0.f);
+    for (size_t i = 0; i < truth.size(); ++i)
+    {
+        size_t nResources = 0;
+        for (size_t j = 0; j < truth[i].size(); ++j)
+        {
+            if (shares[i][j] <= 0.f)
+                continue;
+            const Cost& cost = truth[i][j];
+            loads[i] += shares[i][j] * std::max(cost.draw, cost.transfer);
+            ++nResources;
+        }
+        if (nResources > 0)
+            loads[i] *= std::sqrt(float(nResources)) / float(nResources);
+    }
+    return loads;
+}
+
+/**
+ * Assign the usage of the sources as the former ViewEqualizer::_update.
+ *
+ * @return the time per resource it balances for.
+ */
+float _assign(Compound* root, const std::vector<float>& loads,
+              const size_t nPipes)
+{
+    float totalTime = 0.f;
+    for (const float load : loads)
+        totalTime += load;
+    const float resourceTime = totalTime / float(nPipes);
+
+    const Compounds& children = root->getChildren();
+    const size_t size = children.size();
+    PipeUsage pipeUsage;
+    std::vector<float> leftOvers(size, 0.f);
+    std::vector<uint32_t> missing(size, 0);
+
+    // use self
+    for (size_t i = 0; i < size; ++i)
+    {
+        Compound* child = children[i];
+        leftOvers[i] = loads[i] / resourceTime;
+        SelfAssigner assigner(child->getPipe(), leftOvers[i], pipeUsage);
+        child->accept(assigner);
+        missing[i] = assigner.getNumChannels();
+    }
+
+    // use previous' frames resources
+    for (size_t i = 0; i < size; ++i)
+    {
+        Compound* child = children[i];
+        PreviousAssigner assigner(child->getPipe(), leftOvers[i], pipeUsage);
+        child->accept(assigner);
+        missing[i] += assigner.getNumChannels();
+    }
+
+    // satisfy left-overs
+    for (size_t i = 0; i < size; ++i)
+    {
+        float& leftOver = leftOvers[i];
+        if (leftOver <= minUsage && missing[i] > 0)
+            continue;
+
+        NewAssigner assigner(leftOver, pipeUsage);
+        children[i]->accept(assigner);
+        missing[i] += assigner.getNumChannels();
+
+        if (missing[i] == 0) // assign at least one resource
+        {
+            Compound* fallback = assigner.getFallback();
+            TEST(fallback);
+            fallback->setUsage(leftOver);
+        }
+    }
+    return resourceTime;
+}
+}
+
+struct Result
+{
+    Result()
+        : predicted(0.f)
+        , achieved(0.f)
+        , error(0.f)
+    {
+    }
+
+    float predicted; //!< mean predicted frame time
+    float achieved;  //!< mean achieved frame time
+    float error;     //!< mean relative prediction error
+
+    void add(const float predicted_, const float achieved_, const float n)
+    {
+        predicted += predicted_ / n;
+        achieved += achieved_ / n;
+        error += std::abs(predicted_ - achieved_) / achieved_ / n;
+    }
+};
+
+std::ostream& operator<<(std::ostream& os, const Result& result)
+{
+    return os << std::setw(7) << result.predicted << " ms predicted, "
+              << std::setw(7) << result.achieved << " ms achieved, "
+              << std::setw(5) << result.error * 100.f << "% error";
+}
+
+Result _replay(const Trace& trace, const bool viewEqualizer)
+{
+    Loader loader;
+    ServerPtr server =
+        loader.parseServer(_getConfig(trace.front(), viewEqualizer).c_str());
+    TEST(server);
+    TEST(server->getConfigs().size() == 1);
+
+    Config* config = server->getConfigs().front();
+    Setup setup;
+    config->accept(setup);
+    TEST(config->getCompounds().size() == 1);
+    TEST(config->getNodes().size() == 1);
+
+    Compound* root = config->getCompounds().front();
+    const Pipes& pipes = config->getNodes().front()->getPipes();
+    ViewEqualizer* equalizer = 0;
+    if (viewEqualizer)
+    {
+        TEST(root->getEqualizers().size() == 1);
+        equalizer = dynamic_cast<ViewEqualizer*>(root->getEqualizers().front());
+        TEST(equalizer);
+    }
+    root->activate(eq::fabric::EYE_CYCLOP);
+
+    const float nFrames = float(trace.size() - nWarmup);
+    std::vector<float> loads(trace.front().size(), 1.f);
+    Result result;
+    for (size_t i = 0; i < trace.size(); ++i)
+    {
+        const uint32_t frame = uint32_t(i + 1);
+        const Costs& truth = trace[i];
+
+        _update(root, frame);
+        float predicted = 0.f;
+        if (equalizer)
+            predicted = _getMax(equalizer->getPredictedTimes()) / scale;
+        else
+            predicted = former::_assign(root, loads, pipes.size());
+
+        const Shares shares = _render(root, pipes, truth, frame);
+        for (size_t j = 0; j < shares.size(); ++j)
+        {
+            float sum = 0.f;
+            for (const float share : shares[j])
+                sum += share;
+            TESTINFO(std::abs(sum - 1.f) < .001f, frame << ": " << sum);
+        }
+
+        const float achieved =
+            _getMax(ViewEqualizer::predictTimes(truth, shares));
+        if (i >= nWarmup)
+            result.add(predicted, achieved, nFrames);
+        if (!equalizer)
+            loads = former::_getLoads(truth, shares);
+    }
+
+    root->deactivate(eq::fabric::EYE_CYCLOP);
+    Global::clear();
+    server->deleteConfigs(); // break server <-> config ref circle
+    return result;
+}
+
+void _compare(const std::string& filename, const float gain)
+{
+    const Trace trace = _load(filename);
+    const Result current = _replay(trace, true);
+    const Result previous = _replay(trace, false);
+
+    std::cout << std::setw(12) << filename << " current: " << current
+              << " | previous: " << previous << std::endl;
+    TESTINFO(current.achieved < previous.achieved * gain,
+             current.achieved << " >= " << previous.achieved);
+    TESTINFO(current.error < .1f, current.error);
+}
+
+void _testModel()
+{
+    // one view on its own pipe
+    Costs costs = _getCosts(1, 1);
+    costs[0][0] = Cost(20.f, 0.f);
+    Shares shares = ViewEqualizer::computeShares(costs, Shares());
+    TEST(shares.size() == 1 && shares[0].size() == 1);
+    TESTINFO(shares[0][0] > .999f, shares[0][0]);
+    TESTINFO(std::abs(ViewEqualizer::predictTimes(costs, shares)[0] - 20.f) <
+                 .01f,
+             ViewEqualizer::predictTimes(costs, shares)[0]);
+
+    // two equal pipes share the work
+    costs = _getCosts(1, 2);
+    costs[0][0] = Cost(20.f, 0.f);
+    costs[0][1] = Cost(20.f, 0.f);
+    shares = ViewEqualizer::computeShares(costs, Shares());
+    TESTINFO(std::abs(shares[0][0] - .5f) < .01f, shares[0][0]);
+    TESTINFO(std::abs(ViewEqualizer::predictTimes(costs, shares)[0] - 10.f) <
+                 .1f,
+             ViewEqualizer::predictTimes(costs, shares)[0]);
+
+    // an expensive transfer limits the share of a remote pipe
+    costs[0][1] = Cost(20.f, 100.f);
+    shares = ViewEqualizer::computeShares(costs, Shares());
+    TESTINFO(std::abs(shares[0][1] - 1.f / 7.f) < .01f, shares[0][1]);
+
+    costs[0][1] = Cost(20.f, 20.f);
+    shares = ViewEqualizer::computeShares(costs, Shares());
+    TESTINFO(std::abs(shares[0][1] - 1.f / 3.f) < .01f, shares[0][1]);
+
+    // hysteresis: small improvements keep the current shares
+    Shares current = shares;
+    costs[0][1] = Cost(19.f, 20.f);
+    TEST(ViewEqualizer::computeShares(costs, current) == current);
+    costs[0][1] = Cost(10.f, 5.f);
+    TEST(ViewEqualizer::computeShares(costs, current) != current);
+
+    // unavailable pipes are never used
+    costs = _getCosts(2, 2);
+    costs[0][0] = Cost(10.f, 0.f);
+    costs[0][1] = Cost();
+    costs[1][0] = Cost(10.f, 0.f);
+    costs[1][1] = Cost(10.f, 0.f);
+    shares = ViewEqualizer::computeShares(costs, Shares());
+    TEST(shares[0][0] > .999f && shares[0][1] == 0.f);
+    TESTINFO(shares[1][1] > .99f, shares[1][1]);
+
+    // unknown costs from throughput and work: pipe 1 is twice as slow
+    costs = _getCosts(2, 2);
+    costs[0][0] = Cost(10.f, 0.f);
+    costs[0][1] = Cost(20.f, 4.f);
+    costs[1][0] = Cost(30.f, 0.f);
+    ViewEqualizer::estimateCosts(costs);
+    TESTINFO(std::abs(costs[1][1].draw - 60.f) < .1f, costs[1][1].draw);
+    TEST(costs[1][1].transfer == 0.f);
+
+    // ... and the mean transfer of the child
+    costs[0][0].draw = 0.f;
+    ViewEqualizer::estimateCosts(costs);
+    TESTINFO(std::abs(costs[0][0].draw - 10.f) < .1f, costs[0][0].draw);
+    TEST(costs[0][0].transfer == 4.f);
+
+    // nothing known: uniform costs
+    costs = _getCosts(2, 3);
+    ViewEqualizer::estimateCosts(costs);
+    for (const std::vector<Cost>& row : costs)
+        for (const Cost& cost : row)
+            TEST(cost.draw == 1.f && cost.transfer == 0.f);
+}
+}
+
+int main(int argc, char** argv)
+{
+    TEST(lunchbox::init(argc, argv));
+    _testModel();
+
+    // slow network: lending remote pipes does not pay off
+    _compare("viewEqualizer/wall.trace", .9f);
+    // fast network: at least as good as the previous assignment
+    _compare("viewEqualizer/cave.trace", 1.02f);
+
+    TEST(lunchbox::exit());
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,248 @@
+
+/* Copyright (c) 2026, The Equalizer authors, see AUTHORS
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <lunchbox/test.h>
+
+#include <eq/server/channel.h>
+#include <eq/server/compound.h>
+#include <eq/server/config.h>
+#include <eq/server/configVisitor.h>
+#include <eq/server/global.h>
+#include <eq/server/loader.h>
+#include <eq/server/segment.h>
+#include <eq/server/server.h>
+#include <eq/server/view.h>
+
+#include <lunchbox/file.h>
+#include <lunchbox/init.h>
+
+#include <cstring>
+
+// Tests that the cached, batched frustum update of the destination compounds
+// of all examples/configs/*.eqc files yields bitwise the same frusta as the
+// direct computation.
+
+using namespace eq::server;
+
+namespace
+{
+class DestinationFinder : public ConfigVisitor
+{
+public:
+    virtual VisitorResult visit(Compound* compound)
+    {
+        Channel* channel = compound->getChannel();
+        if (!channel)
+            return TRAVERSE_CONTINUE;
+        if (!compound->isDestination())
+            return TRAVERSE_PRUNE;
+
+        if (channel->getSegment() && channel->getView())
+            compounds.push_back(compound);
+        return TRAVERSE_PRUNE;
+    }
+
+    Compounds compounds;
+};
+
+struct Expected
+{
+    Frustum::Type type;
+    Wall wall;
+    Projection projection;
+    Vector4i overdraw;
+};
+
+void _applyOverdraw(const Channel* channel, Wall& wall, Vector4i& overdraw)
+{
+    const Segment* segment = channel->getSegment();
+    const View* view = channel->getView();
+    const Viewport& segmentVP = segment->getViewport();
+    const Viewport& viewVP = view->getViewport();
+    const Vector2i& pixels = view->getOverdraw();
+    overdraw = Vector4i();
+
+    if (pixels.x() && viewVP.x < segmentVP.x)
+        overdraw.x() = pixels.x();
+    if (pixels.x() && viewVP.getXEnd() > segmentVP.getXEnd())
+        overdraw.z() = pixels.x();
+    if (pixels.y() && viewVP.y < segmentVP.y)
+        overdraw.y() = pixels.y();
+    if (pixels.y() && viewVP.getYEnd() > segmentVP.getYEnd())
+        overdraw.w() = pixels.y();
+
+    const PixelViewport& pvp = channel->getPixelViewport();
+    if (overdraw.x() > 0)
+        wall.resizeLeft(float(pvp.w + overdraw.x()) / float(pvp.w));
+    if (overdraw.z() > 0)
+        wall.resizeRight(float(pvp.w + overdraw.x() + overdraw.z()) /
+                         float(pvp.w + overdraw.x()));
+    if (overdraw.y() > 0)
+        wall.resizeBottom(float(pvp.h + overdraw.y()) / float(pvp.h));
+    if (overdraw.w() > 0)
+        wall.resizeTop(float(pvp.h + overdraw.y() + overdraw.w()) /
+                       float(pvp.h + overdraw.y()));
+}
+
+/** The unbatched, uncached computation of Compound::updateFrustum. */
+Expected _compute(const Compound* compound, const Vector3f& eye,
+                  const float ratio)
+{
+    const Channel* channel = compound->getChannel();
+    const Segment* segment = channel->getSegment();
+    const View* view = channel->getView();
+    Expected expected;
+
+    if (view->getCurrentType() != Frustum::TYPE_NONE)
+    {
+        expected.type = view->getCurrentType();
+        expected.wall = view->getWall();
+        expected.projection = view->getProjection();
+        expected.wall.apply(
+            view->getViewport().getCoverage(segment->getViewport()));
+        expected.wall.moveFocus(eye, ratio);
+    }
+    else
+    {
+        const Channel* output = segment->getChannel();
+        expected.type = segment->getCurrentType();
+        expected.wall = segment->getWall();
+        expected.projection = segment->getProjection();
+        expected.wall.moveFocus(eye, ratio);
+        expected.wall.apply(
+            output->getViewport().getCoverage(channel->getViewport()));
+    }
+
+    _applyOverdraw(channel, expected.wall, expected.overdraw);
+    expected.wall.scale(view->getModelUnit());
+    expected.projection = expected.wall;
+    return expected;
+}
+
+template <class T>
+bool _same(const T& a, const T& b)
+{
+    return ::memcmp(&a, &b, sizeof(T)) == 0;
+}
+
+void _check(const Compound* compound, const Expected& expected,
+            const std::string& name)
+{
+    if (expected.type == Frustum::TYPE_NONE) // not updated
+        return;
+
+    const Channel* channel = compound->getChannel();
+    TESTINFO(compound->getFrustumType() == expected.type, name);
+    TESTINFO(_same(channel->getOverdraw(), expected.overdraw), name);
+
+    if (expected.type == Frustum::TYPE_WALL)
+    {
+        const Wall& wall = compound->getWall();
+        TESTINFO(_same(wall.bottomLeft, expected.wall.bottomLeft) &&
+                     _same(wall.bottomRight, expected.wall.bottomRight) &&
+                     _same(wall.topLeft, expected.wall.topLeft) &&
+                     wall.type == expected.wall.type,
+                 name << ": " << wall << " != " << expected.wall);
+    }
+    else
+    {
+        const Projection& projection = compound->getProjection();
+        TESTINFO(_same(projection.origin, expected.projection.origin) &&
+                     _same(projection.distance,
+                           expected.projection.distance) &&
+                     _same(projection.fov, expected.projection.fov) &&
+                     _same(projection.hpr, expected.projection.hpr),
+                 name << ": " << projection << " != "
+                      << expected.projection);
+    }
+}
+
+void _check(const Compounds& compounds, const Vector3f& eye,
+            const float ratio, const std::string& name)
+{
+    for (const Compound* compound : compounds)
+        _check(compound, _compute(compound, eye, ratio), name);
+}
+}
+
+int main(int argc, char** argv)
+{
+    TEST(lunchbox::init(argc, argv));
+
+    Loader loader;
+    const lunchbox::Strings configs =
+        lunchbox::searchDirectory("configs", ".*\\.eqc");
+    TESTINFO(configs.size() > 20, configs.size());
+
+    const Vector3f eye(.1f, -.2f, .3f);
+    const float ratio = .7f;
+
+    for (const std::string& config : configs)
+    {
+        const std::string& filename = "configs/" + config;
+        ServerPtr server = loader.loadFile(filename);
+        TESTINFO(server.isValid(), "Load of " << filename << " failed");
+
+        Loader::addOutputCompounds(server);
+        Loader::addDestinationViews(server);
+        Loader::addDefaultObserver(server);
+        Loader::convertTo11(server);
+        Loader::convertTo12(server);
+
+        DestinationFinder finder;
+        server->getConfigs().front()->accept(finder);
+        const Compounds& compounds = finder.compounds;
+
+        // initial computation, followed by unchanged updates using the cache
+        Compound::updateFrusta(compounds, Vector3f(), 1.f);
+        _check(compounds, Vector3f(), 1.f, filename);
+        Compound::updateFrusta(compounds, Vector3f(), 1.f);
+        _check(compounds, Vector3f(), 1.f, filename);
+
+        // changed focus, batched and single
+        Compound::updateFrusta(compounds, eye, ratio);
+        _check(compounds, eye, ratio, filename);
+        for (Compound* compound : compounds)
+        {
+            compound->updateFrustum(Vector3f(), 1.f);
+            _check(compound, _compute(compound, Vector3f(), 1.f), filename);
+        }
+
+        // changed view parameters invalidate the cache
+        for (Compound* compound : compounds)
+        {
+            View* view = compound->getChannel()->getView();
+            if (compound->getChannel()->getPixelViewport().hasArea())
+                view->setOverdraw(Vector2i(16, 8));
+            view->setModelUnit(.5f);
+        }
+        Compound::updateFrusta(compounds, eye, ratio);
+        _check(compounds, eye, ratio, filename);
+
+        // explicitly set frusta invalidate the cache
+        for (Compound* compound : compounds)
+            compound->setWall(Wall());
+        Compound::updateFrusta(compounds, eye, ratio);
+        _check(compounds, eye, ratio, filename);
+
+        Global::clear();
+        server->deleteConfigs(); // break server <-> config ref circle
+    }
+
+    TEST(lunchbox::exit());
+    return EXIT_SUCCESS;
+}
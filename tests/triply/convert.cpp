@@ -0,0 +1,143 @@
+
+/* Copyright (c) 2026, The Equalizer authors, see AUTHORS
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Tests that converting a PLY model into the binary triply format gives the
+// same bytes for one conversion job and for concurrent jobs sharing the cores,
+// as done by eqPlyConverter.
+
+#define EQ_SYSTEM_INCLUDES
+#include <lunchbox/test.h>
+
+#include <triply/vertexBufferRoot.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace
+{
+const size_t nJobs = 4;
+
+/**
+ * Write a height field of (size-1)^2*2 triangles. Every tenth triangle is
+ * repeated with rotated indices, which sorts equal to the original on all
+ * axes.
+ */
+void _writePly(const std::string& filename, const size_t size)
+{
+    std::vector<triply::Triangle> triangles;
+    for (size_t y = 0; y < size - 1; ++y)
+    {
+        for (size_t x = 0; x < size - 1; ++x)
+        {
+            const triply::Index i = y * size + x;
+            triangles.push_back(triply::Triangle(i, i + 1, i + size));
+            triangles.push_back(
+                triply::Triangle(i + 1, i + size + 1, i + size));
+            if (i % 10 == 0)
+                triangles.push_back(triply::Triangle(i + 1, i + size, i));
+        }
+    }
+
+    std::ofstream file(filename.c_str());
+    file << "ply\nformat ascii 1.0\n"
+         << "element vertex " << size * size << "\n"
+         << "property float x\nproperty float y\nproperty float z\n"
+         << "element face " << triangles.size() << "\n"
+         << "property list uchar int vertex_indices\nend_header\n";
+
+    for (size_t y = 0; y < size; ++y)
+    {
+        for (size_t x = 0; x < size; ++x)
+        {
+            const float u = float(x) / float(size - 1) * 2.f - 1.f;
+            const float v = float(y) / float(size - 1) * 2.f - 1.f;
+            file << u << " " << v << " "
+                 << .2f * std::sin(u * 5.f) * std::cos(v * 3.f) << "\n";
+        }
+    }
+    for (const triply::Triangle& triangle : triangles)
+        file << "3 " << triangle[0] << " " << triangle[1] << " " << triangle[2]
+             << "\n";
+    TEST(file.good());
+}
+
+/** Convert the PLY file using the given threads, @return the binary. */
+std::string _convert(const std::string& filename,
+                     const size_t nThreads LB_UNUSED)
+{
+#ifdef _OPENMP
+    omp_set_num_threads(int(nThreads));
+#endif
+    const std::string binary = triply::getArchitectureFilename(filename);
+    ::remove(binary.c_str());
+
+    triply::VertexBufferRoot model;
+    model.disableProgress();
+    TESTINFO(model.readFromFile(filename), filename);
+
+    std::ifstream file(binary.c_str(), std::ios::binary);
+    TESTINFO(file, binary);
+    std::ostringstream data;
+    data << file.rdbuf();
+    ::remove(binary.c_str());
+    return data.str();
+}
+}
+
+int main(int, char**)
+{
+    const size_t nCores = std::max(std::thread::hardware_concurrency(), 1u);
+    std::vector<std::string> filenames;
+    for (size_t i = 0; i <= nJobs; ++i)
+    {
+        std::ostringstream filename;
+        filename << "convert" << i << ".ply";
+        filenames.push_back(filename.str());
+        _writePly(filename.str(), 200);
+    }
+
+    // one job using one and all cores
+    const std::string serial = _convert(filenames.front(), 1);
+    TEST(serial.size() > 0);
+    TEST(_convert(filenames.front(), nCores) == serial);
+
+    // concurrent jobs, sharing the cores
+    std::vector<std::string> binaries(nJobs);
+    std::vector<std::thread> jobs;
+    for (size_t i = 0; i < nJobs; ++i)
+        jobs.push_back(std::thread([&filenames, &binaries, i, nCores] {
+            binaries[i] = _convert(filenames[i + 1],
+                                   std::max(nCores / nJobs, size_t(1)));
+        }));
+    for (std::thread& job : jobs)
+        job.join();
+
+    for (size_t i = 0; i < nJobs; ++i)
+        TESTINFO(binaries[i] == serial, "job " << i << " differs");
+
+    for (const std::string& filename : filenames)
+        ::remove(filename.c_str());
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,327 @@
+
+/* Copyright (c) 2026, The Equalizer authors, see AUTHORS
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Tests the level of detail hierarchy of triply kd-trees without GL context
+
+#define EQ_SYSTEM_INCLUDES
+#include <lunchbox/test.h>
+
+#include <triply/vertexBufferData.h>
+#include <triply/vertexBufferRoot.h>
+#include <triply/vertexBufferState.h>
+#include <triply/vertexClustering.h>
+#include <triply/vertexData.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <map>
+
+using namespace triply;
+
+namespace
+{
+/*  A rendering state for culling only, never used for GL calls.  */
+class State : public VertexBufferState
+{
+public:
+    State()
+        : VertexBufferState(reinterpret_cast<const GLEWContext*>(this))
+    {
+        setViewportSize(Vector2f(1000.f, 1000.f));
+    }
+
+    GLuint getDisplayList(const void*) final { return INVALID; }
+    GLuint newDisplayList(const void*) final { return INVALID; }
+    GLuint getBufferObject(const void*) final { return INVALID; }
+    GLuint newBufferObject(const void*) final { return INVALID; }
+    void deleteAll() final {}
+};
+
+typedef std::map<const VertexBufferBase*, const VertexBufferBase*> LODMap;
+
+/*  A height field of (size-1)^2*2 triangles in [-1,1]^2.  */
+void _createHeightField(VertexData& data, const size_t size)
+{
+    for (size_t y = 0; y < size; ++y)
+    {
+        for (size_t x = 0; x < size; ++x)
+        {
+            const float u = float(x) / float(size - 1) * 2.f - 1.f;
+            const float v = float(y) / float(size - 1) * 2.f - 1.f;
+            data.vertices.push_back(
+                Vertex(u, v, .2f * std::sin(u * 5.f) * std::cos(v * 3.f)));
+        }
+    }
+    for (size_t y = 0; y < size - 1; ++y)
+    {
+        for (size_t x = 0; x < size - 1; ++x)
+        {
+            const Index i = y * size + x;
+            data.triangles.push_back(Triangle(i, i + 1, i + size));
+            data.triangles.push_back(Triangle(i + 1, i + size + 1, i + size));
+        }
+    }
+    data.calculateNormals();
+}
+
+Index _getTriangles(const VertexBufferBase& node)
+{
+    const VertexBufferBase* lod = node.getLOD();
+    return (lod ? *lod : node).getNumberOfVertices() / 3;
+}
+
+/*  Check the simplified representations, return the map of LOD to node.  */
+void _testTree(const VertexBufferBase& node, LODMap& lods)
+{
+    const VertexBufferBase* left = node.getLeft();
+    const VertexBufferBase* right = node.getRight();
+    if (!left && !right)
+    {
+        TEST(!node.getLOD());
+        TEST(node.getLODError() == 0.f);
+        return;
+    }
+
+    TEST(left && right);
+    _testTree(*left, lods);
+    _testTree(*right, lods);
+
+    const VertexBufferBase* lod = node.getLOD();
+    TEST(lod);
+    lods[lod] = &node;
+
+    const Index triangles = _getTriangles(*left) + _getTriangles(*right);
+    TESTINFO(_getTriangles(node) <= triangles / 4,
+             _getTriangles(node) << " > " << triangles << " / 4");
+    TEST(node.getLODError() > 0.f);
+    TEST(node.getLODError() >= left->getLODError());
+    TEST(node.getLODError() >= right->getLODError());
+}
+
+void _testClustering()
+{
+    VertexData heightField;
+    _createHeightField(heightField, 50);
+
+    VertexBufferData data;
+    data.vertices = heightField.vertices;
+    data.normals = heightField.normals;
+    for (const Triangle& triangle : heightField.triangles)
+        for (size_t i = 0; i < 3; ++i)
+            data.indices.push_back(ShortIndex(triangle[i]));
+
+    BoundingBox box{data.vertices[0], data.vertices[0]};
+    for (const Vertex& vertex : data.vertices)
+        box.merge(vertex);
+
+    VertexClustering clustering;
+    clustering.add(data, 0, data.vertices.size(), 0, data.indices.size());
+    TEST(clustering.getNumTriangles() == heightField.triangles.size());
+
+    VertexBufferData output;
+    const Index budget = clustering.getNumTriangles() / 4;
+    const float error = clustering.simplify(box, budget, output);
+
+    TEST(!output.indices.empty());
+    TEST(output.indices.size() / 3 <= budget);
+    TEST(output.normals.size() == output.vertices.size());
+    TEST(output.colors.empty());
+    for (const ShortIndex index : output.indices)
+        TEST(index < output.vertices.size());
+
+    // each output vertex represents input vertices within the error
+    TEST(error > 0.f && error < box.getSize().length());
+    for (const Vertex& simplified : output.vertices)
+    {
+        float distance = std::numeric_limits<float>::max();
+        for (const Vertex& vertex : data.vertices)
+            distance = std::min(distance, (vertex - simplified).length());
+        TESTINFO(distance <= error * 1.0001f, distance << " > " << error);
+    }
+
+    // no triangle budget removes everything
+    TEST(clustering.simplify(box, 0, output) == box.getSize().length());
+    TEST(output.vertices.empty() && output.indices.empty());
+}
+
+void _testScreenError()
+{
+    State state;
+    Matrix4f view;
+    view.setTranslation(vmml::Vector3f(0.f, 0.f, -10.f));
+    const vmml::Frustumf frustum(-1.f, 1.f, -1.f, 1.f, 1.f, 100.f);
+    state.setProjectionModelViewMatrix(frustum.computePerspectiveMatrix() *
+                                       view);
+
+    // one unit spans 1/10th of the viewport at distance 10
+    const BoundingBox box{Vertex(-.01f, -.01f, -.01f), Vertex(.01f, .01f, .01f)};
+    const float error = state.getScreenError(box, .1f);
+    TESTINFO(std::abs(error - 5.f) < .1f, error);
+
+    const BoundingBox behind{Vertex(-1.f, -1.f, 9.f), Vertex(1.f, 1.f, 11.f)};
+    TEST(state.getScreenError(behind, .1f) ==
+         std::numeric_limits<float>::max());
+}
+
+size_t _cull(const VertexBufferRoot& root, State& state, const float tolerance,
+             const LODMap& lods)
+{
+    state.setLODTolerance(tolerance);
+    VertexBufferRoot::Nodes nodes;
+    root.cull(state, nodes);
+
+    size_t triangles = 0;
+    std::vector<std::pair<float, float>> ranges;
+    for (const VertexBufferBase* node : nodes)
+    {
+        triangles += node->getNumberOfVertices() / 3;
+        ranges.push_back({node->getRange()[0], node->getRange()[1]});
+
+        const auto i = lods.find(node);
+        if (i == lods.end())
+            continue;
+
+        // simplified node: within tolerance and in range
+        TESTINFO(tolerance > 0.f, "LOD selected for full resolution");
+        const VertexBufferBase& parent = *i->second;
+        const float error = state.getScreenError(parent.getBoundingBox(),
+                                                 parent.getLODError());
+        TESTINFO(error <= tolerance, error << " > " << tolerance);
+        TEST(parent.getRange()[0] >= state.getRange()[0]);
+        TEST(parent.getRange()[1] < state.getRange()[1] ||
+             state.getRange()[1] >= 1.f);
+    }
+
+    // selected nodes partition the model without gaps or overlap
+    std::sort(ranges.begin(), ranges.end());
+    TEST(!ranges.empty());
+    for (size_t i = 1; i < ranges.size(); ++i)
+        TESTINFO(std::abs(ranges[i].first - ranges[i - 1].second) < 1e-5f,
+                 ranges[i - 1].second << " != " << ranges[i].first);
+    return triangles;
+}
+
+void _testSelection(const VertexBufferRoot& root, const LODMap& lods)
+{
+    State state;
+    Matrix4f view;
+    view.setTranslation(vmml::Vector3f(0.f, 0.f, -3.f));
+    const vmml::Frustumf frustum(-1.f, 1.f, -1.f, 1.f, 1.f, 100.f);
+    const Matrix4f projection = frustum.computePerspectiveMatrix();
+    state.setProjectionModelViewMatrix(projection * view);
+
+    // full resolution renders the whole model
+    const size_t full = _cull(root, state, 0.f, lods);
+    TEST(full == root.getNumberOfVertices() / 3);
+
+    // coarsening reduces the triangle count monotonically
+    size_t previous = full;
+    for (float tolerance = .25f; tolerance < 1000.f; tolerance *= 2.f)
+    {
+        const size_t triangles = _cull(root, state, tolerance, lods);
+        TESTINFO(triangles <= previous, triangles << " > " << previous);
+        previous = triangles;
+    }
+    TEST(previous < full / 10);
+
+    // without tolerance limit the root's representation is used, unless
+    // rounding places the end of its range after the end of the full range
+    VertexBufferRoot::Nodes nodes;
+    state.setLODTolerance(std::numeric_limits<float>::max());
+    root.cull(state, nodes);
+    if (root.getRange()[1] <= 1.f)
+        TEST(nodes.size() == 1 && nodes[0] == root.getLOD());
+
+    // farther away, fewer triangles are needed
+    const size_t near = _cull(root, state, 2.f, lods);
+    view.setTranslation(vmml::Vector3f(0.f, 0.f, -30.f));
+    state.setProjectionModelViewMatrix(projection * view);
+    const size_t far = _cull(root, state, 2.f, lods);
+    TESTINFO(far < near, far << " >= " << near);
+
+    // database decomposition only simplifies nodes fully in range, with the
+    // same half-open test as the culling
+    const float range[2] = {.25f, .75f};
+    state.setRange(Range(range));
+    _cull(root, state, 2.f, lods);
+
+    const float left[2] = {0.f, root.getLeft()->getRange()[1]};
+    state.setRange(Range(left));
+    state.setLODTolerance(std::numeric_limits<float>::max());
+    nodes.clear();
+    root.cull(state, nodes);
+    TEST(std::find(nodes.begin(), nodes.end(), root.getLeft()->getLOD()) ==
+         nodes.end());
+}
+
+bool _isLittleEndian()
+{
+    const unsigned short test = 1;
+    return *reinterpret_cast<const unsigned char*>(&test) == 1;
+}
+
+void _compareTrees(const VertexBufferBase& a, const VertexBufferBase& b)
+{
+    TEST(a.getLODError() == b.getLODError());
+    TEST(!a.getLOD() == !b.getLOD());
+    if (a.getLOD())
+        TEST(a.getLOD()->getNumberOfVertices() ==
+             b.getLOD()->getNumberOfVertices());
+    TEST(!a.getLeft() == !b.getLeft());
+    if (a.getLeft())
+    {
+        _compareTrees(*a.getLeft(), *b.getLeft());
+        _compareTrees(*a.getRight(), *b.getRight());
+    }
+}
+
+void _testCache(VertexBufferRoot& root)
+{
+    const std::string filename("lodTest.ply");
+    const std::string cache = filename + (_isLittleEndian() ? ".le" : ".be") +
+                              std::to_string(sizeof(void*) * 8) + ".bin";
+    TEST(root.writeToFile(filename));
+
+    VertexBufferRoot loaded;
+    TEST(loaded.readFromFile(filename));
+    _compareTrees(root, loaded);
+    ::remove(cache.c_str());
+}
+}
+
+int main(int, char**)
+{
+    _testClustering();
+    _testScreenError();
+
+    VertexData data;
+    _createHeightField(data, 300);
+    data.scale(2.f);
+
+    VertexBufferRoot root;
+    boost::progress_display progress(12);
+    root.setupTree(data, progress);
+
+    LODMap lods;
+    _testTree(root, lods);
+    TEST(root.getNumberOfVertices() / 3 == data.triangles.size());
+
+    _testSelection(root, lods);
+    _testCache(root);
+    return EXIT_SUCCESS;
+}
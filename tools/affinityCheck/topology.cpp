@@ -0,0 +1,215 @@
+
+/* Copyright (c) 2026, The Equalizer authors, see AUTHORS
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Reports the CPU, NUMA and GPU topology of this machine, and optionally the
+// placement of the threads and memory of a running process, e.g., an
+// Equalizer render client using automatic thread affinity.
+
+#include <hwloc.h>
+
+#include <cstdlib>
+#include <dirent.h>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+
+namespace
+{
+std::string _toString(hwloc_const_bitmap_t bitmap)
+{
+    char* string = 0;
+    hwloc_bitmap_list_asprintf(&string, bitmap);
+    const std::string result(string ? string : "");
+    free(string);
+    return result;
+}
+
+/** @return the sockets covered by the given cpu set. */
+std::string _getSockets(hwloc_topology_t topology, hwloc_const_cpuset_t cpus)
+{
+    if (hwloc_bitmap_isincluded(hwloc_topology_get_topology_cpuset(topology),
+                                cpus))
+        return "all";
+
+    std::ostringstream sockets;
+    const int nSockets = hwloc_get_nbobjs_by_type(topology, HWLOC_OBJ_SOCKET);
+    for (int i = 0; i < nSockets; ++i)
+    {
+        const hwloc_obj_t socket =
+            hwloc_get_obj_by_type(topology, HWLOC_OBJ_SOCKET, unsigned(i));
+        if (hwloc_bitmap_intersects(socket->cpuset, cpus))
+            sockets << (sockets.tellp() > 0 ? "," : "") << i;
+    }
+    return sockets.str();
+}
+
+void _printTopology(hwloc_topology_t topology)
+{
+    const int nSockets = hwloc_get_nbobjs_by_type(topology, HWLOC_OBJ_SOCKET);
+    const int nNodes = hwloc_get_nbobjs_by_type(topology, HWLOC_OBJ_NUMANODE);
+    std::cout << nSockets << " socket(s), " << nNodes << " NUMA node(s)"
+              << std::endl;
+
+    for (int i = 0; i < nSockets; ++i)
+    {
+        const hwloc_obj_t socket =
+            hwloc_get_obj_by_type(topology, HWLOC_OBJ_SOCKET, unsigned(i));
+        hwloc_nodeset_t nodes = hwloc_bitmap_alloc();
+        hwloc_cpuset_to_nodeset(topology, socket->cpuset, nodes);
+
+        std::cout << "  socket " << i << ": "
+                  << hwloc_get_nbobjs_inside_cpuset_by_type(topology,
+                                                            socket->cpuset,
+                                                            HWLOC_OBJ_CORE)
+                  << " cores, cpus " << _toString(socket->cpuset)
+                  << ", NUMA nodes " << _toString(nodes) << std::endl;
+        hwloc_bitmap_free(nodes);
+    }
+
+    for (hwloc_obj_t osdev = hwloc_get_next_osdev(topology, 0); osdev;
+         osdev = hwloc_get_next_osdev(topology, osdev))
+    {
+        if (osdev->attr->osdev.type != HWLOC_OBJ_OSDEV_GPU)
+            continue;
+
+        const hwloc_obj_t parent =
+            hwloc_get_non_io_ancestor_obj(topology, osdev);
+        std::cout << "  GPU " << osdev->name << " on socket(s) "
+                  << _getSockets(topology, parent->cpuset) << std::endl;
+    }
+}
+
+void _printThreads(hwloc_topology_t topology, const std::string& pid)
+{
+    const std::string taskDir = "/proc/" + pid + "/task";
+    DIR* dir = opendir(taskDir.c_str());
+    if (!dir)
+    {
+        std::cerr << "Can't open " << taskDir << std::endl;
+        return;
+    }
+
+    std::cout << "Threads of process " << pid << ":" << std::endl;
+    hwloc_cpuset_t bound = hwloc_bitmap_alloc();
+    hwloc_cpuset_t last = hwloc_bitmap_alloc();
+    while (const dirent* entry = readdir(dir))
+    {
+        if (entry->d_name[0] == '.')
+            continue;
+
+        const hwloc_pid_t tid = atoi(entry->d_name);
+        std::string name;
+        std::ifstream comm((taskDir + "/" + entry->d_name + "/comm").c_str());
+        std::getline(comm, name);
+
+        std::cout << "  " << tid << " " << name;
+        if (hwloc_get_proc_cpubind(topology, tid, bound,
+                                   HWLOC_CPUBIND_THREAD) == 0)
+        {
+            const std::string sockets = _getSockets(topology, bound);
+            if (sockets == "all")
+                std::cout << ": unbound";
+            else
+                std::cout << ": bound to socket(s) " << sockets;
+        }
+        if (hwloc_get_proc_last_cpu_location(topology, tid, last,
+                                             HWLOC_CPUBIND_THREAD) == 0)
+            std::cout << ", running on cpu " << _toString(last)
+                      << " of socket " << _getSockets(topology, last);
+        std::cout << std::endl;
+    }
+    hwloc_bitmap_free(last);
+    hwloc_bitmap_free(bound);
+    closedir(dir);
+}
+
+/** Sum the pages of each NUMA node used by the process. */
+void _printMemory(const std::string& pid)
+{
+    std::ifstream maps(("/proc/" + pid + "/numa_maps").c_str());
+    std::map<unsigned, size_t> pages;
+    size_t total = 0;
+    std::string token;
+    while (maps >> token)
+    {
+        if (token.size() < 3 || token[0] != 'N' ||
+            token.find('=') == std::string::npos)
+        {
+            continue;
+        }
+
+        const size_t equal = token.find('=');
+        const size_t nPages = strtoul(token.c_str() + equal + 1, 0, 10);
+        pages[unsigned(strtoul(token.c_str() + 1, 0, 10))] += nPages;
+        total += nPages;
+    }
+
+    if (total == 0)
+    {
+        std::cout << "No NUMA memory information for process " << pid
+                  << std::endl;
+        return;
+    }
+
+    std::cout << "Memory pages of process " << pid << ":" << std::endl;
+    for (const auto& node : pages)
+        std::cout << "  NUMA node " << node.first << ": " << node.second
+                  << " pages (" << node.second * 100 / total << "%)"
+                  << std::endl;
+}
+}
+
+int main(const int argc, char** argv)
+{
+    if (argc > 2 || (argc == 2 && std::string(argv[1]) == "--help"))
+    {
+        std::cout << "Usage: " << argv[0] << " [pid]" << std::endl;
+        return EXIT_SUCCESS;
+    }
+
+    hwloc_topology_t topology;
+    if (hwloc_topology_init(&topology) < 0)
+    {
+        std::cerr << "hwloc_topology_init() failed" << std::endl;
+        return EXIT_FAILURE;
+    }
+#if HWLOC_API_VERSION >= 0x00020000
+    hwloc_topology_set_io_types_filter(topology,
+                                       HWLOC_TYPE_FILTER_KEEP_IMPORTANT);
+#else
+    hwloc_topology_set_flags(topology, HWLOC_TOPOLOGY_FLAG_IO_BRIDGES |
+                                           HWLOC_TOPOLOGY_FLAG_IO_DEVICES);
+#endif
+    if (hwloc_topology_load(topology) < 0)
+    {
+        std::cerr << "hwloc_topology_load() failed" << std::endl;
+        hwloc_topology_destroy(topology);
+        return EXIT_FAILURE;
+    }
+
+    _printTopology(topology);
+    if (argc == 2)
+    {
+        _printThreads(topology, argv[1]);
+        _printMemory(argv[1]);
+    }
+
+    hwloc_topology_destroy(topology);
+    return EXIT_SUCCESS;
+}
@@ -29,8 +29,63 @@
 #include <eq/eq.h>
 #include <triply/vertexBufferRoot.h>
 
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <thread>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+namespace po = boost::program_options;
+
 namespace
 {
+// Peak memory use of a conversion relative to the size of the PLY file: the
+// vertex data with its normals and the kd-tree data built from it.
+const size_t memoryFactor = 4;
+
+struct Job
+{
+    enum State
+    {
+        PENDING,
+        CACHED,
+        CONVERTED,
+        FAILED
+    };
+
+    explicit Job(const std::string& filename_)
+        : filename(filename_)
+        , size(0)
+        , hash(0)
+        , vertices(0)
+        , time(0.f)
+        , state(PENDING)
+    {
+        std::ifstream file(filename.c_str(), std::ios::binary | std::ios::ate);
+        if (file)
+            size = size_t(file.tellg());
+    }
+
+    size_t getMemory() const { return size * memoryFactor; }
+    std::string filename;
+    size_t size;     //!< of the PLY file in bytes
+    uint64_t hash;   //!< of the PLY file content
+    size_t vertices; //!< of the converted model
+    float time;      //!< of the cache check or conversion in ms
+    State state;
+};
+typedef std::vector<Job> Jobs;
+
 static bool _isPlyfile(const std::string& filename)
 {
     const size_t size = filename.length();
@@ -44,52 +99,318 @@ static bool _isPlyfile(const std::string& filename)
     }
     return true;
 }
+
+void _findFiles(eq::Strings filenames, Jobs& jobs)
+{
+    while (!filenames.empty())
+    {
+        const std::string filename = filenames.back();
+        filenames.pop_back();
+
+        if (_isPlyfile(filename))
+        {
+            jobs.push_back(Job(filename));
+            continue;
+        }
+
+        const std::string basename = lunchbox::getFilename(filename);
+        if (basename == "." || basename == "..")
+            continue;
+
+        // recursively search directories
+        const eq::Strings& subFiles = lunchbox::searchDirectory(filename, ".*");
+
+        for (eq::StringsCIter i = subFiles.begin(); i != subFiles.end(); ++i)
+            filenames.push_back(filename + '/' + *i);
+    }
 }
 
-int main(const int argc, char** argv)
+/**
+ * @return a 64 bit hash of the file content and the binary file version, 0 if
+ *         the file can't be read.
+ */
+uint64_t _hashFile(const std::string& filename)
 {
-    eq::Strings filenames;
-    for (int i = 1; i < argc; ++i)
+    std::ifstream file(filename.c_str(), std::ios::binary);
+    if (!file)
+        return 0;
+
+    // binaries of an older format or triangle order are converted again
+    uint64_t hash = 14695981039346656037ull ^ triply::FILE_VERSION;
+    std::vector<uint64_t> buffer(1 << 17);
+    while (file)
     {
-        if (std::string(argv[i]) == "--help")
+        char* data = reinterpret_cast<char*>(buffer.data());
+        file.read(data, buffer.size() * sizeof(uint64_t));
+        const size_t size = size_t(file.gcount());
+        const size_t nWords = (size + 7) / 8;
+        std::fill(data + size, data + nWords * 8, 0);
+
+        for (size_t i = 0; i < nWords; ++i)
         {
-            std::cout << lunchbox::getFilename(argv[0]) << " .ply files"
-                      << std::endl
-                      << "  Convert polygonal meshes to eqPly binary kd-Tree"
-                      << std::endl;
-            return EXIT_SUCCESS;
+            hash = (hash ^ buffer[i]) * 1099511628211ull;
+            hash ^= hash >> 32;
         }
+        hash ^= size;
+    }
+    return hash ? hash : 1;
+}
+
+std::string _getHashFilename(const std::string& filename)
+{
+    return triply::getArchitectureFilename(filename) + ".hash";
+}
+
+bool _exists(const std::string& filename)
+{
+    return std::ifstream(filename.c_str()).good();
+}
+
+/** @return true if the binary cache is up to date with the PLY file. */
+bool _isCached(const Job& job)
+{
+    std::ifstream file(_getHashFilename(job.filename).c_str());
+    uint64_t hash = 0;
+    file >> std::hex >> hash;
+    return file && hash == job.hash &&
+           _exists(triply::getArchitectureFilename(job.filename));
+}
+
+void _convert(Job& job)
+{
+    const lunchbox::Clock clock;
+    const std::string binary = triply::getArchitectureFilename(job.filename);
+    const std::string hashFile = _getHashFilename(job.filename);
+
+    // the model loads any existing binary, even if it is outdated
+    ::remove(binary.c_str());
+    ::remove(hashFile.c_str());
 
-        filenames.push_back(argv[i]);
+    triply::VertexBufferRoot model;
+    model.disableProgress();
+    if (model.readFromFile(job.filename) && _exists(binary))
+    {
+        std::ofstream file(hashFile.c_str());
+        file << std::hex << job.hash << std::endl;
+        job.vertices = model.getNumberOfVertices();
+        job.state = Job::CONVERTED;
     }
+    else
+    {
+        LBWARN << "Can't convert model: " << job.filename << std::endl;
+        job.state = Job::FAILED;
+    }
+    job.time = clock.getTimef();
+}
 
-    while (!filenames.empty())
+std::ostream& operator<<(std::ostream& os, const Job& job)
+{
+    static const char* const states[] = {"pending", "cached", "converted",
+                                         "failed"};
+    const float mb = float(job.size) / 1048576.f;
+    os << std::setw(9) << states[job.state] << std::fixed
+       << std::setprecision(2) << std::setw(9) << job.time / 1000.f << " s "
+       << std::setw(9) << mb << " MB " << std::setw(9)
+       << (job.time > 0.f ? mb * 1000.f / job.time : 0.f) << " MB/s ";
+    if (job.state == Job::CONVERTED)
+        os << std::setw(10) << job.vertices << " vertices ";
+    return os << job.filename;
+}
+
+/** Runs the conversions within the given number of jobs and memory budget. */
+class Scheduler
+{
+public:
+    Scheduler(Jobs& jobs, const size_t memory)
+        : _memory(memory)
+        , _used(0)
     {
-        const std::string filename = filenames.back();
-        filenames.pop_back();
+        for (Job& job : jobs)
+            if (job.state == Job::PENDING)
+                _pending.push_back(&job);
 
-        if (_isPlyfile(filename))
+        // start the largest files first, to not end with a single large one
+        std::sort(_pending.begin(), _pending.end(),
+                  [](const Job* a, const Job* b) { return a->size > b->size; });
+    }
+
+    /** Run nJobs conversions concurrently, using nThreads threads each. */
+    void run(const size_t nJobs, const size_t nThreads)
+    {
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < nJobs; ++i)
+            threads.push_back(
+                std::thread([this, nThreads] { _run(nThreads); }));
+        for (std::thread& thread : threads)
+            thread.join();
+    }
+
+private:
+    const size_t _memory;
+    size_t _used;
+    std::vector<Job*> _pending;
+    std::mutex _mutex;
+    std::condition_variable _condition;
+
+    void _run(const size_t nThreads LB_UNUSED)
+    {
+#ifdef _OPENMP
+        omp_set_num_threads(int(nThreads));
+#endif
+        while (Job* job = _pop())
         {
-            triply::VertexBufferRoot* model = new triply::VertexBufferRoot;
-            if (!model->readFromFile(filename.c_str()))
-                LBWARN << "Can't load model: " << filename << std::endl;
+            _convert(*job);
 
-            delete model;
+            std::lock_guard<std::mutex> lock(_mutex);
+            _used -= job->getMemory();
+            std::cout << *job << std::endl;
+            _condition.notify_all();
         }
-        else
+    }
+
+    /**
+     * @return the next job fitting into the memory budget, or nullptr if all
+     *         jobs are started. A job exceeding the budget on its own is run
+     *         when no other job is running.
+     */
+    Job* _pop()
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        while (!_pending.empty())
         {
-            const std::string basename = lunchbox::getFilename(filename);
-            if (basename == "." || basename == "..")
-                continue;
+            for (auto i = _pending.begin(); i != _pending.end(); ++i)
+            {
+                Job* job = *i;
+                if (_used > 0 && _used + job->getMemory() > _memory)
+                    continue;
 
-            // recursively search directories
-            const eq::Strings& subFiles =
-                lunchbox::searchDirectory(filename, ".*");
+                _pending.erase(i);
+                _used += job->getMemory();
+                return job;
+            }
+            _condition.wait(lock);
+        }
+        return nullptr;
+    }
+};
+
+size_t _getPhysicalMemory()
+{
+#if defined(_SC_PHYS_PAGES) && defined(_SC_PAGESIZE)
+    const long pages = sysconf(_SC_PHYS_PAGES);
+    const long pageSize = sysconf(_SC_PAGESIZE);
+    if (pages > 0 && pageSize > 0)
+        return size_t(pages) * size_t(pageSize);
+#endif
+    return size_t(4) << 30;
+}
+}
 
-            for (eq::StringsCIter i = subFiles.begin(); i != subFiles.end();
-                 ++i)
-                filenames.push_back(filename + '/' + *i);
+int main(const int argc, char** argv)
+{
+    const size_t nCores = std::max(1u, std::thread::hardware_concurrency());
+    size_t nJobs = nCores;
+    size_t memory = _getPhysicalMemory() / 2 / 1048576;
+    bool force = false;
+    eq::Strings filenames;
+
+    po::options_description options(
+        lunchbox::getFilename(argv[0]) + " [options] .ply files|directories\n"
+                                         "  Convert polygonal meshes to eqPly "
+                                         "binary kd-Tree");
+    options.add_options()("help,h", "produce help message")(
+        "jobs,j", po::value<size_t>(&nJobs)->default_value(nJobs),
+        "number of models converted concurrently")(
+        "memory,m", po::value<size_t>(&memory)->default_value(memory),
+        "memory budget for concurrent conversions in MB")(
+        "force,f", po::bool_switch(&force),
+        "convert models with an up-to-date binary cache")(
+        "input", po::value<eq::Strings>(&filenames), ".ply files");
+
+    po::positional_options_description positional;
+    positional.add("input", -1);
+
+    po::variables_map variableMap;
+    try
+    {
+        po::store(po::command_line_parser(argc, argv)
+                      .options(options)
+                      .positional(positional)
+                      .run(),
+                  variableMap);
+        po::notify(variableMap);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl << options << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if (variableMap.count("help"))
+    {
+        std::cout << options << std::endl;
+        return EXIT_SUCCESS;
+    }
+
+    const lunchbox::Clock clock;
+    Jobs jobs;
+    _findFiles(filenames, jobs);
+    nJobs = std::max(size_t(1), std::min(nJobs, jobs.size()));
+
+    // hash all files and skip the ones with an up-to-date binary
+    std::atomic<size_t> next(0);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < nJobs; ++i)
+    {
+        threads.push_back(std::thread([&] {
+            for (size_t j = next++; j < jobs.size(); j = next++)
+            {
+                Job& job = jobs[j];
+                const lunchbox::Clock jobClock;
+                job.hash = _hashFile(job.filename);
+                if (!force && _isCached(job))
+                {
+                    job.state = Job::CACHED;
+                    job.time = jobClock.getTimef();
+                }
+            }
+        }));
+    }
+    for (std::thread& thread : threads)
+        thread.join();
+
+    for (const Job& job : jobs)
+        if (job.state == Job::CACHED)
+            std::cout << job << std::endl;
+
+    // share the cores between the concurrent conversions
+    Scheduler scheduler(jobs, memory * 1048576);
+    scheduler.run(nJobs, std::max(size_t(1), nCores / nJobs));
+
+    size_t nConverted = 0;
+    size_t nCached = 0;
+    size_t nFailed = 0;
+    size_t size = 0;
+    for (const Job& job : jobs)
+    {
+        switch (job.state)
+        {
+        case Job::CONVERTED:
+            ++nConverted;
+            size += job.size;
+            break;
+        case Job::CACHED:
+            ++nCached;
+            break;
+        default:
+            ++nFailed;
         }
     }
-    return EXIT_SUCCESS;
+
+    const float time = clock.getTimef() / 1000.f;
+    std::cout << nConverted << " converted, " << nCached << " cached, "
+              << nFailed << " failed in " << std::fixed
+              << std::setprecision(2) << time << " s, "
+              << float(size) / 1048576.f / time << " MB/s" << std::endl;
+    return nFailed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
 }